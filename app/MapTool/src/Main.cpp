@@ -0,0 +1,437 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Logger.h"
+#include "Result.h"
+#include "fs/DiskIO.h"
+#include "fs/File.h"
+#include "fs/Reader.h"
+#include "gl/ResourceManager.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EntityNode.h"
+#include "mdl/EnvironmentConfig.h"
+#include "mdl/ExportOptions.h"
+#include "mdl/GameAssetContext.h"
+#include "mdl/GameInfo.h"
+#include "mdl/GroupNode.h"
+#include "mdl/Issue.h"
+#include "mdl/LayerNode.h"
+#include "mdl/Map.h"
+#include "mdl/MapFileSerializer.h"
+#include "mdl/MapFormat.h"
+#include "mdl/MapHeader.h"
+#include "mdl/NodeWriter.h"
+#include "mdl/ParseGameConfig.h"
+#include "mdl/PatchNode.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/overload.h"
+#include "kd/result.h"
+#include "kd/task_manager.h"
+
+#include "vm/bbox.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+// clang-format off
+#include <windows.h>
+#include <psapi.h>
+// clang-format on
+#else
+#include <sys/resource.h>
+#endif
+
+namespace tb
+{
+namespace
+{
+
+const auto WorldBounds = vm::bbox3d{-32768.0, 32768.0};
+
+struct Options
+{
+  std::filesystem::path mapPath;
+  std::filesystem::path gameConfigPath;
+  std::filesystem::path gamePath;
+  mdl::MapFormat mapFormat = mdl::MapFormat::Unknown;
+  bool validate = false;
+  std::optional<std::filesystem::path> savePath;
+  mdl::MapFormat saveFormat = mdl::MapFormat::Unknown;
+  std::optional<std::filesystem::path> exportObjPath;
+  bool verbose = false;
+};
+
+class StdErrLogger : public Logger
+{
+private:
+  bool m_verbose;
+
+public:
+  explicit StdErrLogger(const bool verbose)
+    : m_verbose{verbose}
+  {
+  }
+
+private:
+  void doLog(const LogLevel level, const std::string_view message) override
+  {
+    switch (level)
+    {
+    case LogLevel::Debug:
+    case LogLevel::Info:
+      if (m_verbose)
+      {
+        std::cerr << message << '\n';
+      }
+      break;
+    case LogLevel::Warn:
+      std::cerr << "Warning: " << message << '\n';
+      break;
+    case LogLevel::Error:
+      std::cerr << "Error: " << message << '\n';
+      break;
+    }
+  }
+};
+
+void printUsage()
+{
+  std::cout
+    << "Usage: MapTool --gameConfig <path> [options] <map file>\n"
+    << "\n"
+    << "Loads a map without any user interface and reports how long each step took.\n"
+    << "\n"
+    << "Options:\n"
+    << "  --gameConfig path   Path to the GameConfig.cfg file of the map's game\n"
+    << "  --gamePath path     Path to the game directory\n"
+    << "  --format name       Format of the map file, detected if omitted\n"
+    << "  --validate          Run all validators on the map\n"
+    << "  --save path         Save the map to the given file\n"
+    << "  --saveFormat name   Format to save the map in, defaults to the map's format\n"
+    << "  --exportObj path    Export the map to the given OBJ file\n"
+    << "  --verbose           Print informational log messages\n";
+}
+
+Result<Options> parseOptions(const std::vector<std::string>& arguments)
+{
+  const auto optionsWithValue = std::vector<std::string>{
+    "--gameConfig", "--gamePath", "--format", "--save", "--saveFormat", "--exportObj"};
+
+  auto options = Options{};
+
+  for (size_t i = 0; i < arguments.size(); ++i)
+  {
+    const auto& argument = arguments[i];
+    if (std::ranges::find(optionsWithValue, argument) != optionsWithValue.end())
+    {
+      if (i + 1 == arguments.size())
+      {
+        return Error{"Missing value for option " + argument};
+      }
+
+      const auto& value = arguments[++i];
+      if (argument == "--gameConfig")
+      {
+        options.gameConfigPath = value;
+      }
+      else if (argument == "--gamePath")
+      {
+        options.gamePath = value;
+      }
+      else if (argument == "--format" || argument == "--saveFormat")
+      {
+        const auto mapFormat = mdl::formatFromName(value);
+        if (mapFormat == mdl::MapFormat::Unknown)
+        {
+          return Error{"Unknown map format: " + value};
+        }
+        (argument == "--format" ? options.mapFormat : options.saveFormat) = mapFormat;
+      }
+      else if (argument == "--save")
+      {
+        options.savePath = value;
+      }
+      else if (argument == "--exportObj")
+      {
+        options.exportObjPath = value;
+      }
+    }
+    else if (argument == "--validate")
+    {
+      options.validate = true;
+    }
+    else if (argument == "--verbose")
+    {
+      options.verbose = true;
+    }
+    else if (argument.starts_with("--") || !options.mapPath.empty())
+    {
+      return Error{"Unexpected argument: " + argument};
+    }
+    else
+    {
+      options.mapPath = argument;
+    }
+  }
+
+  if (options.mapPath.empty())
+  {
+    return Error{"Missing map file"};
+  }
+  if (options.gameConfigPath.empty())
+  {
+    return Error{"Missing game configuration"};
+  }
+
+  return options;
+}
+
+Result<mdl::GameInfo> loadGameInfo(const std::filesystem::path& path)
+{
+  const auto absPath = std::filesystem::absolute(path);
+  return fs::Disk::openFile(absPath) | kdl::and_then([&](auto file) {
+           auto reader = file->reader().buffer();
+           return mdl::parseGameConfig(reader.stringView(), absPath);
+         })
+         | kdl::transform([](auto gameConfig) {
+             return mdl::makeGameInfo(std::move(gameConfig));
+           });
+}
+
+/**
+ * Converts the UV coordinate systems of all brushes if the given map format uses a
+ * different kind of UV coordinate system than the world's map format.
+ */
+void convertBrushes(mdl::WorldNode& worldNode, const mdl::MapFormat mapFormat)
+{
+  const auto toParallel = mdl::isParallelUVCoordSystem(mapFormat);
+  if (toParallel == mdl::isParallelUVCoordSystem(worldNode.mapFormat()))
+  {
+    return;
+  }
+
+  worldNode.accept(kdl::overload(
+    [](auto&& thisLambda, mdl::WorldNode& node) { node.visitChildren(thisLambda); },
+    [](auto&& thisLambda, mdl::LayerNode& node) { node.visitChildren(thisLambda); },
+    [](auto&& thisLambda, mdl::GroupNode& node) { node.visitChildren(thisLambda); },
+    [](auto&& thisLambda, mdl::EntityNode& node) { node.visitChildren(thisLambda); },
+    [&](mdl::BrushNode& brushNode) {
+      const auto& brush = brushNode.brush();
+      brushNode.setBrush(
+        toParallel ? brush.convertToParallel() : brush.convertToParaxial());
+    },
+    [](mdl::PatchNode&) {}));
+}
+
+Result<void> saveMap(
+  mdl::Map& map, const std::filesystem::path& path, const mdl::MapFormat mapFormat)
+{
+  convertBrushes(map.worldNode(), mapFormat);
+
+  return fs::Disk::withOutputStream(std::filesystem::absolute(path), [&](auto& stream) {
+    mdl::writeMapHeader(stream, map.gameInfo().gameConfig.name, mapFormat);
+
+    auto writer = mdl::NodeWriter{
+      map.worldNode(), mdl::MapFileSerializer::create(mapFormat, stream)};
+    writer.writeMap(map.taskManager());
+  });
+}
+
+size_t validateMap(mdl::Map& map)
+{
+  const auto validators = map.worldNode().registeredValidators();
+
+  auto issueCount = size_t(0);
+  map.worldNode().accept(kdl::overload(
+    [&](auto&& thisLambda, mdl::WorldNode& node) {
+      issueCount += node.issues(validators).size();
+      node.visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, mdl::LayerNode& node) {
+      issueCount += node.issues(validators).size();
+      node.visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, mdl::GroupNode& node) {
+      issueCount += node.issues(validators).size();
+      node.visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, mdl::EntityNode& node) {
+      issueCount += node.issues(validators).size();
+      node.visitChildren(thisLambda);
+    },
+    [&](mdl::BrushNode& node) { issueCount += node.issues(validators).size(); },
+    [&](mdl::PatchNode& node) { issueCount += node.issues(validators).size(); }));
+
+  return issueCount;
+}
+
+/**
+ * Returns the peak resident memory of this process in bytes, if available.
+ */
+std::optional<size_t> peakMemoryUsage()
+{
+#ifdef _WIN32
+  auto counters = PROCESS_MEMORY_COUNTERS{};
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+  {
+    return size_t(counters.PeakWorkingSetSize);
+  }
+  return std::nullopt;
+#else
+  auto usage = rusage{};
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef __APPLE__
+    // macOS reports bytes
+    return size_t(usage.ru_maxrss);
+#else
+    // Linux reports kilobytes
+    return size_t(usage.ru_maxrss) * 1024u;
+#endif
+  }
+  return std::nullopt;
+#endif
+}
+
+/**
+ * Runs the given function, prints how long it took and returns its result.
+ */
+template <typename F>
+auto timed(const std::string_view phase, const F& function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  auto result = function();
+  const auto duration = std::chrono::steady_clock::now() - start;
+
+  const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+  fmt::print("{:<10} {:>8} ms\n", phase, ms.count());
+  return result;
+}
+
+Result<void> processMap(mdl::Map& map, const Options& options)
+{
+  if (options.validate)
+  {
+    const auto issueCount = timed("validate", [&]() { return validateMap(map); });
+    fmt::print("{:<10} {:>8}\n", "issues", issueCount);
+  }
+
+  if (options.savePath)
+  {
+    const auto mapFormat = options.saveFormat != mdl::MapFormat::Unknown
+                             ? options.saveFormat
+                             : map.worldNode().mapFormat();
+    if (auto result =
+          timed("save", [&]() { return saveMap(map, *options.savePath, mapFormat); });
+        result.is_error())
+    {
+      return result;
+    }
+  }
+
+  if (options.exportObjPath)
+  {
+    const auto exportOptions = mdl::ObjExportOptions{
+      std::filesystem::absolute(*options.exportObjPath),
+      mdl::ObjMtlPathMode::RelativeToGamePath};
+    if (auto result = timed("export", [&]() { return map.exportAs(exportOptions); });
+        result.is_error())
+    {
+      return result;
+    }
+  }
+
+  return Result<void>{};
+}
+
+Result<void> run(const Options& options)
+{
+  auto logger = StdErrLogger{options.verbose};
+  auto taskManager = kdl::task_manager{};
+  auto resourceManager = gl::ResourceManager{};
+
+  const auto environmentConfig = mdl::EnvironmentConfig{
+    .appFolderPath = std::filesystem::current_path(),
+    .userDataFolderPath = {},
+    .tempFolderPath = std::filesystem::temp_directory_path(),
+    .defaultAssetFolderPaths = {},
+  };
+
+  return loadGameInfo(options.gameConfigPath) | kdl::and_then([&](auto gameInfo) {
+           // the map keeps a reference to the game info, so it must not escape this scope
+           return timed(
+                    "load",
+                    [&]() {
+                      return mdl::Map::loadMap(
+                        environmentConfig,
+                        gameInfo,
+                        options.gamePath,
+                        options.mapFormat,
+                        WorldBounds,
+                        std::filesystem::absolute(options.mapPath),
+                        taskManager,
+                        resourceManager,
+                        std::make_shared<mdl::GameAssetContext>(),
+                        logger);
+                    })
+                  | kdl::and_then([&](auto map) { return processMap(*map, options); });
+         });
+}
+
+} // namespace
+} // namespace tb
+
+int main(int argc, char* argv[])
+{
+  using namespace tb;
+
+  auto arguments = std::vector<std::string>{};
+  for (size_t i = 1; i < size_t(argc); ++i)
+  {
+    arguments.emplace_back(argv[i]);
+  }
+
+  if (arguments.empty() || arguments == std::vector<std::string>{"--help"})
+  {
+    printUsage();
+    return arguments.empty() ? 1 : 0;
+  }
+
+  return parseOptions(arguments) | kdl::and_then(run) | kdl::transform([]() {
+           if (const auto peakMemory = peakMemoryUsage())
+           {
+             fmt::print("{:<10} {:>8} MB\n", "memory", *peakMemory / (1024u * 1024u));
+           }
+           return 0;
+         })
+         | kdl::transform_error([](const auto& e) {
+             std::cerr << "Error: " << e.msg << '\n';
+             return 1;
+           })
+         | kdl::value();
+}
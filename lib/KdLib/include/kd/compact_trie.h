@@ -641,6 +641,34 @@ private:
       }
     }
 
+    /**
+     * Adds the values stored under the given key to the given output iterator. The key is
+     * matched against this node's key first, and the search descends into the only child
+     * that can contain the remainder, so no match state is needed.
+     *
+     * @tparam O the type of the output iterator
+     * @param key the key to look up
+     * @param out the output iterator
+     */
+    template <typename O>
+    void find_values(const std::string_view key, O out) const
+    {
+      if (!key.starts_with(m_key))
+      {
+        return;
+      }
+
+      const auto remainder = key.substr(m_key.size());
+      if (remainder.empty())
+      {
+        get_values(out);
+      }
+      else if (const auto it = m_children.find(remainder); it != m_children.end())
+      {
+        it->find_values(remainder, out);
+      }
+    }
+
     /**
      * Adds the keys of all nodes in this subtree to the given output iterator.
      *
@@ -872,6 +900,20 @@ public:
     m_root.find_matches(pattern, {0u}, nullptr, state, out);
   }
 
+  /**
+   * Finds all values stored under the given key and adds them to the given output
+   * iterator. Unlike `find_matches`, the key is not interpreted as a pattern.
+   *
+   * @tparam O the type of the output iterator
+   * @param key the key to look up
+   * @param out the output iterator
+   */
+  template <typename O>
+  void find_values(const std::string_view key, O out) const
+  {
+    m_root.find_values(key, out);
+  }
+
   /**
    * Adds the keys of all nodes in this trie to the give output iterator.
    *
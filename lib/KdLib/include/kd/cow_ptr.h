@@ -0,0 +1,101 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <compare>
+#include <memory>
+#include <ostream>
+#include <utility>
+
+namespace kdl
+{
+
+/**
+ * A pointer to an immutable value that is shared between copies until one of them is
+ * modified.
+ *
+ * Copying a cow_ptr only copies the pointer. Calling mutate() copies the value first if
+ * it is shared with another cow_ptr, so that modifications are never visible through
+ * other copies.
+ *
+ * Comparing and printing a cow_ptr compares and prints the values it points to.
+ *
+ * Copies may be used from different threads, but a single cow_ptr must not be copied and
+ * mutated concurrently.
+ *
+ * @tparam T the type of the value, must be copy constructible
+ */
+template <typename T>
+class cow_ptr
+{
+private:
+  std::shared_ptr<T> m_ptr;
+
+public:
+  cow_ptr()
+    : m_ptr{std::make_shared<T>()}
+  {
+  }
+
+  explicit cow_ptr(T value)
+    : m_ptr{std::make_shared<T>(std::move(value))}
+  {
+  }
+
+  const T& operator*() const { return *m_ptr; }
+  const T* operator->() const { return m_ptr.get(); }
+  const T* get() const { return m_ptr.get(); }
+
+  /**
+   * Returns a modifiable reference to the value, copying it first if it is shared with
+   * another cow_ptr.
+   */
+  T& mutate()
+  {
+    if (m_ptr.use_count() > 1)
+    {
+      m_ptr = std::make_shared<T>(std::as_const(*m_ptr));
+    }
+    return *m_ptr;
+  }
+
+  /**
+   * Indicates whether this and the given cow_ptr point to the same value.
+   */
+  bool shares_with(const cow_ptr& other) const { return m_ptr == other.m_ptr; }
+
+  friend bool operator==(const cow_ptr& lhs, const cow_ptr& rhs)
+  {
+    return lhs.shares_with(rhs) || *lhs == *rhs;
+  }
+
+  friend auto operator<=>(const cow_ptr& lhs, const cow_ptr& rhs)
+  {
+    return *lhs <=> *rhs;
+  }
+
+  friend std::ostream& operator<<(std::ostream& lhs, const cow_ptr& rhs)
+  {
+    return lhs << *rhs;
+  }
+};
+
+} // namespace kdl
@@ -518,6 +518,20 @@ public:
     }
   }
 
+  /**
+   * Rotates this list so that the given item becomes its first item. The cyclic order of
+   * the items is not changed.
+   *
+   * @param item the item to move to the front, which must be contained in this list
+   */
+  void rotate_to_front(T* item)
+  {
+    contract_pre(item != nullptr);
+    assert(contains(item));
+
+    m_head = item;
+  }
+
   /**
    * Moves all items from the given list to the end of this list. Afterwards, the given
    * list will be empty.
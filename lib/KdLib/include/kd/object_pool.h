@@ -0,0 +1,285 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// The pool hides use after free errors from the address sanitizer, so we disable it in
+// sanitized builds.
+#if defined(__SANITIZE_ADDRESS__)
+#define KDL_OBJECT_POOL_DISABLED
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define KDL_OBJECT_POOL_DISABLED
+#endif
+#endif
+
+namespace kdl
+{
+
+/**
+ * Allocates storage for objects of type T from large chunks of contiguous memory.
+ *
+ * Objects that are allocated one after another are placed next to each other in memory,
+ * which improves locality for linked data structures whose nodes are allocated
+ * individually. Freed storage is kept in a free list and reused by later allocations.
+ *
+ * Every thread allocates from its own chunk and caches freed storage in its own free
+ * list, so most allocations and deallocations do not require any synchronization. Once a
+ * thread's free list grows beyond a few batches, a batch of storage is moved to a free
+ * list that is shared by all threads, and a thread whose free list is empty takes a batch
+ * from the shared free list before it allocates a new chunk. When a thread exits, its
+ * free list and the unused rest of its chunk are moved to the shared free list. Storage
+ * that is freed by a different thread than the one that allocated it is therefore
+ * eventually reused by any thread.
+ *
+ * The chunks are never returned to the system. The memory used by the pool is bounded by
+ * the maximum number of objects that were alive at the same time plus the storage cached
+ * by each running thread, which is at most two batches and one chunk.
+ *
+ * The pool is meant to be used to implement class specific operator new and delete. In
+ * builds with the address sanitizer enabled, it falls back to the global operators.
+ *
+ * @tparam T the type of the objects to allocate
+ */
+template <typename T>
+class object_pool
+{
+private:
+  union slot
+  {
+    slot* next;
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  static constexpr std::size_t default_chunk_size = 256;
+  static constexpr std::size_t batch_size = 64;
+
+  struct shared_state
+  {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<slot[]>> chunks;
+    slot* free_list = nullptr;
+  };
+
+  struct thread_state
+  {
+    slot* free_list = nullptr;
+    std::size_t free_count = 0;
+    slot* chunk_begin = nullptr;
+    slot* chunk_end = nullptr;
+    std::size_t reserved = 0;
+  };
+
+  struct thread_exit_guard
+  {
+    thread_state& state;
+
+    ~thread_exit_guard() { release_all(state); }
+  };
+
+  static shared_state& shared()
+  {
+    // intentionally leaked so that objects can still be freed during static destruction
+    static auto* instance = new shared_state{};
+    return *instance;
+  }
+
+  static thread_state& local_state()
+  {
+    // The state is trivially destructible so that it can still be used after the guard
+    // has released its storage during thread exit.
+    thread_local auto state = thread_state{};
+    thread_local auto guard = thread_exit_guard{state};
+    return state;
+  }
+
+  static std::size_t available(const thread_state& state)
+  {
+    return static_cast<std::size_t>(state.chunk_end - state.chunk_begin);
+  }
+
+  static void allocate_chunk(thread_state& state, const std::size_t size)
+  {
+    auto chunk = std::unique_ptr<slot[]>{new slot[size]};
+    state.chunk_begin = chunk.get();
+    state.chunk_end = chunk.get() + size;
+
+    auto& pool = shared();
+    const auto lock = std::lock_guard{pool.mutex};
+    pool.chunks.push_back(std::move(chunk));
+  }
+
+  static void push_shared(slot* first, slot* last) noexcept
+  {
+    auto& pool = shared();
+    const auto lock = std::lock_guard{pool.mutex};
+    last->next = pool.free_list;
+    pool.free_list = first;
+  }
+
+  static bool acquire_batch(thread_state& state)
+  {
+    auto& pool = shared();
+    const auto lock = std::lock_guard{pool.mutex};
+    if (!pool.free_list)
+    {
+      return false;
+    }
+
+    auto* last = pool.free_list;
+    auto count = std::size_t{1};
+    while (last->next && count < batch_size)
+    {
+      last = last->next;
+      ++count;
+    }
+
+    state.free_list = pool.free_list;
+    state.free_count = count;
+    pool.free_list = last->next;
+    last->next = nullptr;
+    return true;
+  }
+
+  static void release_batch(thread_state& state) noexcept
+  {
+    auto* first = state.free_list;
+    auto* last = first;
+    for (std::size_t i = 1; i < batch_size; ++i)
+    {
+      last = last->next;
+    }
+
+    state.free_list = last->next;
+    state.free_count -= batch_size;
+    push_shared(first, last);
+  }
+
+  static void free_slot(thread_state& state, slot* freed) noexcept
+  {
+    freed->next = state.free_list;
+    state.free_list = freed;
+    if (++state.free_count >= 2 * batch_size)
+    {
+      release_batch(state);
+    }
+  }
+
+  static void free_unused_chunk(thread_state& state) noexcept
+  {
+    while (state.chunk_begin != state.chunk_end)
+    {
+      free_slot(state, state.chunk_begin++);
+    }
+  }
+
+  static void release_all(thread_state& state) noexcept
+  {
+    free_unused_chunk(state);
+
+    if (auto* first = state.free_list)
+    {
+      auto* last = first;
+      while (last->next)
+      {
+        last = last->next;
+      }
+      push_shared(first, last);
+    }
+
+    state = thread_state{};
+  }
+
+public:
+  /**
+   * Returns storage for one object of type T.
+   */
+  static void* allocate()
+  {
+#ifdef KDL_OBJECT_POOL_DISABLED
+    return ::operator new(sizeof(T));
+#else
+    auto& state = local_state();
+    if (state.reserved > 0 && state.chunk_begin != state.chunk_end)
+    {
+      --state.reserved;
+      return state.chunk_begin++;
+    }
+
+    if (state.free_list || acquire_batch(state))
+    {
+      auto* result = state.free_list;
+      state.free_list = result->next;
+      --state.free_count;
+      return result;
+    }
+
+    if (state.chunk_begin == state.chunk_end)
+    {
+      allocate_chunk(state, default_chunk_size);
+    }
+    return state.chunk_begin++;
+#endif
+  }
+
+  /**
+   * Returns the given storage to the pool. The given pointer must have been returned by
+   * allocate().
+   */
+  static void deallocate(void* ptr) noexcept
+  {
+#ifdef KDL_OBJECT_POOL_DISABLED
+    ::operator delete(ptr);
+#else
+    free_slot(local_state(), static_cast<slot*>(ptr));
+#endif
+  }
+
+  /**
+   * Makes the next count allocations on the calling thread return adjacent storage,
+   * bypassing the free list. At most one chunk is allocated for this; the unused rest of
+   * the previous chunk is added to the free list.
+   *
+   * Use this before allocating a known number of objects that are accessed together.
+   */
+  static void reserve(const std::size_t count)
+  {
+#ifndef KDL_OBJECT_POOL_DISABLED
+    auto& state = local_state();
+    if (available(state) < count)
+    {
+      free_unused_chunk(state);
+      allocate_chunk(state, std::max(count, default_chunk_size));
+    }
+    state.reserved = count;
+#else
+    (void)count;
+#endif
+  }
+};
+
+} // namespace kdl
@@ -156,6 +156,35 @@ TEST_CASE("compact_trie")
     CHECK(find(index, "") == std::vector<std::string>{});
   }
 
+  SECTION("find_values")
+  {
+    index.insert("key", "value");
+    index.insert("key2", "value");
+    index.insert("key22", "value2");
+    index.insert("k*", "value3");
+
+    const auto findValues = [&](const std::string& key) {
+      auto values = std::vector<std::string>{};
+      index.find_values(key, std::back_inserter(values));
+      return values;
+    };
+
+    CHECK(findValues("whoops") == std::vector<std::string>{});
+    CHECK(findValues("key222") == std::vector<std::string>{});
+    CHECK(findValues("k") == std::vector<std::string>{});
+    CHECK(findValues("") == std::vector<std::string>{});
+    CHECK_THAT(findValues("key"), UnorderedRangeEquals({"value"}));
+    CHECK_THAT(findValues("key22"), UnorderedRangeEquals({"value2"}));
+    CHECK_THAT(findValues("k*"), UnorderedRangeEquals({"value3"}));
+
+    index.insert("key", "value4");
+    index.insert("key", "value4");
+    CHECK_THAT(findValues("key"), UnorderedRangeEquals({"value", "value4", "value4"}));
+
+    CHECK(index.remove("key", "value"));
+    CHECK_THAT(findValues("key"), UnorderedRangeEquals({"value4", "value4"}));
+  }
+
   SECTION("find_matches_with_wildcards")
   {
     index.insert("key", "value");
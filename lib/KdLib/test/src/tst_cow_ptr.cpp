@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kd/cow_ptr.h"
+
+#include <compare>
+#include <sstream>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace kdl
+{
+
+TEST_CASE("cow_ptr")
+{
+  SECTION("copies share the value")
+  {
+    const auto original = cow_ptr<std::string>{"value"};
+    const auto copy = original;
+
+    CHECK(copy.shares_with(original));
+    CHECK(copy.get() == original.get());
+    CHECK(*copy == "value");
+  }
+
+  SECTION("mutate copies a shared value")
+  {
+    const auto original = cow_ptr<std::string>{"value"};
+    auto copy = original;
+
+    copy.mutate() = "other";
+
+    CHECK_FALSE(copy.shares_with(original));
+    CHECK(*original == "value");
+    CHECK(*copy == "other");
+  }
+
+  SECTION("mutate does not copy an unshared value")
+  {
+    auto ptr = cow_ptr<std::string>{"value"};
+    const auto* value = ptr.get();
+
+    ptr.mutate() = "other";
+
+    CHECK(ptr.get() == value);
+    CHECK(*ptr == "other");
+  }
+
+  SECTION("mutate does not copy a value that is no longer shared")
+  {
+    auto ptr = cow_ptr<std::string>{"value"};
+    {
+      const auto copy = ptr;
+    }
+    const auto* value = ptr.get();
+
+    ptr.mutate() = "other";
+    CHECK(ptr.get() == value);
+  }
+
+  SECTION("comparison compares values")
+  {
+    CHECK(cow_ptr<std::string>{"a"} == cow_ptr<std::string>{"a"});
+    CHECK(cow_ptr<std::string>{"a"} != cow_ptr<std::string>{"b"});
+    CHECK(cow_ptr<std::string>{"a"} < cow_ptr<std::string>{"b"});
+  }
+
+  SECTION("printing prints the value")
+  {
+    auto str = std::stringstream{};
+    str << cow_ptr<std::string>{"value"};
+    CHECK(str.str() == "value");
+  }
+}
+
+} // namespace kdl
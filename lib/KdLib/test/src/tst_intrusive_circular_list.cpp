@@ -605,6 +605,23 @@ TEST_CASE("intrusive_circular_list_test.reverse")
   assertList({e3, e2, e1}, l);
 }
 
+TEST_CASE("intrusive_circular_list_test.rotate_to_front")
+{
+  auto* e1 = new element();
+  auto* e2 = new element();
+  auto* e3 = new element();
+  list l({e1, e2, e3});
+
+  l.rotate_to_front(e2);
+  assertList({e2, e3, e1}, l);
+
+  l.rotate_to_front(e2);
+  assertList({e2, e3, e1}, l);
+
+  l.rotate_to_front(e1);
+  assertList({e1, e2, e3}, l);
+}
+
 TEST_CASE("intrusive_circular_list_test.append_list")
 {
   list from;
@@ -0,0 +1,187 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kd/object_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace kdl
+{
+namespace
+{
+
+struct pooled
+{
+  double x;
+  double y;
+  double z;
+  std::size_t value;
+
+  static void* operator new(std::size_t) { return object_pool<pooled>::allocate(); }
+  static void operator delete(void* ptr) noexcept
+  {
+    object_pool<pooled>::deallocate(ptr);
+  }
+};
+
+struct cross_thread_pooled
+{
+  double x;
+  double y;
+  double z;
+
+  static void* operator new(std::size_t)
+  {
+    return object_pool<cross_thread_pooled>::allocate();
+  }
+  static void operator delete(void* ptr) noexcept
+  {
+    object_pool<cross_thread_pooled>::deallocate(ptr);
+  }
+};
+
+} // namespace
+
+TEST_CASE("object_pool")
+{
+  SECTION("allocated objects are aligned and distinct")
+  {
+    auto objects = std::vector<pooled*>{};
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+      auto* object = new pooled{0.0, 0.0, 0.0, i};
+      CHECK(reinterpret_cast<std::uintptr_t>(object) % alignof(pooled) == 0u);
+      objects.push_back(object);
+    }
+
+    for (std::size_t i = 0; i < objects.size(); ++i)
+    {
+      CHECK(objects[i]->value == i);
+    }
+
+    for (auto* object : objects)
+    {
+      delete object;
+    }
+  }
+
+#ifndef KDL_OBJECT_POOL_DISABLED
+  SECTION("freed storage is reused")
+  {
+    auto* object = new pooled{};
+    auto* storage = static_cast<void*>(object);
+    delete object;
+
+    object = new pooled{};
+    CHECK(static_cast<void*>(object) == storage);
+    delete object;
+  }
+
+  SECTION("reserved storage is adjacent")
+  {
+    // populate the free list
+    delete new pooled{};
+    delete new pooled{};
+
+    object_pool<pooled>::reserve(10);
+
+    auto objects = std::vector<pooled*>{};
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+      objects.push_back(new pooled{});
+    }
+
+    for (std::size_t i = 1; i < objects.size(); ++i)
+    {
+      CHECK(
+        reinterpret_cast<std::uintptr_t>(objects[i])
+        == reinterpret_cast<std::uintptr_t>(objects[i - 1]) + sizeof(pooled));
+    }
+
+    for (auto* object : objects)
+    {
+      delete object;
+    }
+  }
+
+  SECTION("storage freed by another thread is reused")
+  {
+    auto objects = std::vector<cross_thread_pooled*>{};
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+      objects.push_back(new cross_thread_pooled{});
+    }
+
+    const auto storage = std::set<void*>{objects.begin(), objects.end()};
+
+    for (std::size_t round = 0; round < 3; ++round)
+    {
+      auto thread = std::thread{[&]() {
+        for (auto* object : objects)
+        {
+          delete object;
+        }
+      }};
+      thread.join();
+
+      objects.clear();
+      for (std::size_t i = 0; i < 1000; ++i)
+      {
+        objects.push_back(new cross_thread_pooled{});
+      }
+
+      CHECK(std::ranges::all_of(
+        objects, [&](auto* object) { return storage.contains(object); }));
+    }
+
+    for (auto* object : objects)
+    {
+      delete object;
+    }
+  }
+#endif
+
+  SECTION("objects can be freed by another thread")
+  {
+    auto objects = std::vector<pooled*>{};
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+      objects.push_back(new pooled{});
+    }
+
+    auto thread = std::thread{[&]() {
+      for (auto* object : objects)
+      {
+        delete object;
+      }
+      delete new pooled{};
+    }};
+    thread.join();
+  }
+}
+
+} // namespace kdl
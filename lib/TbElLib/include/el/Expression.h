@@ -122,6 +122,13 @@ public:
 
   ExpressionNode optimize(EvaluationContext& context) const;
 
+  /**
+   * Returns the names of the variables read by this expression, sorted and without
+   * duplicates. The result of evaluating this expression only depends on the values of
+   * these variables.
+   */
+  std::vector<std::string> variableNames() const;
+
   const std::optional<FileLocation>& location() const;
 
   std::string asString() const;
@@ -0,0 +1,119 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "el/Expression.h"
+#include "el/Value.h"
+#include "el/VariableStore.h"
+
+#include "kd/ranges/to.h"
+
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::el
+{
+
+struct VariableValuesHash
+{
+  size_t operator()(const std::vector<Value>& values) const;
+};
+
+/**
+ * Memoizes the results of evaluating an expression.
+ *
+ * The result of evaluating an expression only depends on the values of the variables it
+ * reads, so the results are keyed on these values only. Variable stores that agree on
+ * these values share a result, even if they differ in other variables.
+ *
+ * If the cache holds more than the given maximum number of results, it is cleared. This
+ * cache can be used from multiple threads concurrently.
+ *
+ * @tparam T the type of the cached results
+ */
+template <typename T>
+class ExpressionCache
+{
+private:
+  static constexpr size_t DefaultMaxSize = 1024;
+
+  std::vector<std::string> m_variableNames;
+  size_t m_maxSize;
+
+  mutable std::mutex m_mutex;
+  mutable std::unordered_map<std::vector<Value>, T, VariableValuesHash> m_results;
+
+public:
+  explicit ExpressionCache(
+    const ExpressionNode& expression, const size_t maxSize = DefaultMaxSize)
+    : m_variableNames{expression.variableNames()}
+    , m_maxSize{maxSize}
+  {
+  }
+
+  /**
+   * Returns the cached result for the values of the given variable store. If no result is
+   * cached, the given function is called to compute it.
+   *
+   * @param variableStore the variable store to read the variable values from
+   * @param evaluate a function that evaluates the expression with the variable store
+   * @return the cached or computed result
+   */
+  template <typename F>
+  T get(const VariableStore& variableStore, const F& evaluate) const
+  {
+    auto key = m_variableNames | std::views::transform([&](const auto& name) {
+                 return variableStore.value(name);
+               })
+               | kdl::ranges::to<std::vector>();
+
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      if (const auto it = m_results.find(key); it != m_results.end())
+      {
+        return it->second;
+      }
+    }
+
+    auto result = evaluate();
+
+    const auto lock = std::lock_guard{m_mutex};
+    if (m_results.size() >= m_maxSize)
+    {
+      m_results.clear();
+    }
+    m_results.emplace(std::move(key), result);
+    return result;
+  }
+
+  /**
+   * Returns the number of cached results.
+   */
+  size_t size() const
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    return m_results.size();
+  }
+};
+
+} // namespace tb::el
@@ -1432,6 +1432,47 @@ ExpressionNode ExpressionNode::optimize(EvaluationContext& context) const
     m_location};
 }
 
+std::vector<std::string> ExpressionNode::variableNames() const
+{
+  auto result = std::vector<std::string>{};
+  accept(kdl::overload(
+    [](const LiteralExpression&) {},
+    [&](const VariableExpression& expression) {
+      result.push_back(expression.variableName);
+    },
+    [](const auto& thisLambda, const ArrayExpression& expression) {
+      for (const auto& element : expression.elements)
+      {
+        element.accept(thisLambda);
+      }
+    },
+    [](const auto& thisLambda, const MapExpression& expression) {
+      for (const auto& [key, element] : expression.elements)
+      {
+        element.accept(thisLambda);
+      }
+    },
+    [](const auto& thisLambda, const UnaryExpression& expression) {
+      expression.operand.accept(thisLambda);
+    },
+    [](const auto& thisLambda, const BinaryExpression& expression) {
+      expression.leftOperand.accept(thisLambda);
+      expression.rightOperand.accept(thisLambda);
+    },
+    [](const auto& thisLambda, const SubscriptExpression& expression) {
+      expression.leftOperand.accept(thisLambda);
+      expression.rightOperand.accept(thisLambda);
+    },
+    [](const auto& thisLambda, const SwitchExpression& expression) {
+      for (const auto& case_ : expression.cases)
+      {
+        case_.accept(thisLambda);
+      }
+    }));
+
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
+}
+
 const std::optional<FileLocation>& ExpressionNode::location() const
 {
   return m_location;
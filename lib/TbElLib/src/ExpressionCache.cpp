@@ -0,0 +1,41 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "el/ExpressionCache.h"
+
+#include "kd/hash_utils.h"
+
+#include <string>
+
+namespace tb::el
+{
+
+size_t VariableValuesHash::operator()(const std::vector<Value>& values) const
+{
+  // Value's std::hash specialization hashes the identity of a value, but the keys must be
+  // compared by their contents
+  auto result = kdl::hash(values.size());
+  for (const auto& value : values)
+  {
+    result = kdl::combine_hash(result, kdl::hash(value.asString()));
+  }
+  return result;
+}
+
+} // namespace tb::el
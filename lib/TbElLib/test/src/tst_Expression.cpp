@@ -1208,6 +1208,30 @@ TEST_CASE("Expression")
       preorderVisit("{{ x -> 1 }}")
       == std::vector<std::string>{"{{ x -> 1 }}", "x -> 1", "x", "1"});
   }
+  SECTION("variableNames")
+  {
+    using T = std::tuple<std::string, std::vector<std::string>>;
+
+    // clang-format off
+    const auto
+    [expression,             expectedVariableNames] = GENERATE(values<T>({
+    {"1",                    {}},
+    {"a",                    {"a"}},
+    {"[b, a, b]",            {"a", "b"}},
+    {"{x:a, y:[b]}",         {"a", "b"}},
+    {"-a",                   {"a"}},
+    {"a + b * c",            {"a", "b", "c"}},
+    {"a[b..c]",              {"a", "b", "c"}},
+    {"{{ a == 1 -> b, c }}", {"a", "b", "c"}},
+    }));
+    // clang-format on
+
+    CAPTURE(expression);
+
+    CHECK(
+      parseExpression(ParseMode::Strict, expression).value().variableNames()
+      == expectedVariableNames);
+  }
 }
 
 } // namespace tb::el
@@ -0,0 +1,89 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "el/ExpressionCache.h"
+#include "el/ParseExpression.h"
+#include "el/Value.h"
+#include "el/VariableStore.h"
+
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::el
+{
+
+TEST_CASE("ExpressionCache")
+{
+  const auto expression = parseExpression(ParseMode::Strict, "a + b").value();
+
+  auto evaluationCount = 0;
+  const auto evaluate = [&](const VariableStore& variableStore) {
+    return [&]() {
+      ++evaluationCount;
+      return variableStore.value("a").asString() + variableStore.value("b").asString();
+    };
+  };
+
+  SECTION("Caches results by the values of the variables read by the expression")
+  {
+    auto cache = ExpressionCache<std::string>{expression};
+
+    const auto store1 =
+      VariableTable{{{"a", Value{"x"}}, {"b", Value{"y"}}, {"c", Value{1}}}};
+    const auto store2 =
+      VariableTable{{{"a", Value{"x"}}, {"b", Value{"y"}}, {"c", Value{2}}}};
+    const auto store3 = VariableTable{{{"a", Value{"x"}}, {"b", Value{"z"}}}};
+
+    CHECK(cache.get(store1, evaluate(store1)) == R"("x""y")");
+    CHECK(evaluationCount == 1);
+
+    CHECK(cache.get(store1, evaluate(store1)) == R"("x""y")");
+    CHECK(evaluationCount == 1);
+
+    CHECK(cache.get(store2, evaluate(store2)) == R"("x""y")");
+    CHECK(evaluationCount == 1);
+
+    CHECK(cache.get(store3, evaluate(store3)) == R"("x""z")");
+    CHECK(evaluationCount == 2);
+    CHECK(cache.size() == 2u);
+  }
+
+  SECTION("Clears the cache when it is full")
+  {
+    auto cache = ExpressionCache<std::string>{expression, 2u};
+
+    const auto store1 = VariableTable{{{"a", Value{1}}}};
+    const auto store2 = VariableTable{{{"a", Value{2}}}};
+    const auto store3 = VariableTable{{{"a", Value{3}}}};
+
+    cache.get(store1, evaluate(store1));
+    cache.get(store2, evaluate(store2));
+    CHECK(cache.size() == 2u);
+
+    cache.get(store3, evaluate(store3));
+    CHECK(cache.size() == 1u);
+    CHECK(evaluationCount == 3);
+
+    cache.get(store1, evaluate(store1));
+    CHECK(evaluationCount == 4);
+  }
+}
+
+} // namespace tb::el
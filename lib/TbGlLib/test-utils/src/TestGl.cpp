@@ -19,6 +19,8 @@
 
 #include "gl/TestGl.h"
 
+#include <algorithm>
+
 namespace tb::gl
 {
 
@@ -130,7 +132,11 @@ GLint TestGl::getUniformLocation(const GLuint, const GLchar*)
   return -1;
 }
 
-void TestGl::genBuffers(GLsizei, GLuint*) {}
+void TestGl::genBuffers(const GLsizei n, GLuint* buffers)
+{
+  // Vbo expects nonzero buffer names
+  std::fill_n(buffers, n, 1u);
+}
 void TestGl::deleteBuffers(GLsizei, const GLuint*) {}
 
 void TestGl::bindBuffer(GLenum, GLuint) {}
@@ -0,0 +1,117 @@
+# Compares two benchmark result files written by the benchmark-json reporter and fails if
+# any benchmark got slower by more than the given threshold.
+#
+# Usage:
+#   cmake -DBASELINE=baseline.json -DCURRENT=current.json [-DTHRESHOLD=0.1] \
+#     -P CompareBenchmarks.cmake
+#
+# THRESHOLD is the relative slowdown of the mean that is tolerated, e.g. 0.1 for 10%.
+# Benchmarks that only exist in one of the files are reported, but do not fail the
+# comparison.
+
+if(NOT DEFINED BASELINE OR NOT DEFINED CURRENT)
+  message(FATAL_ERROR "BASELINE and CURRENT must be set")
+endif()
+
+if(NOT DEFINED THRESHOLD)
+  set(THRESHOLD 0.1)
+endif()
+
+# Reads the means of all benchmarks in the given file into <prefix>_NAMES and
+# <prefix>_MEAN_<index>.
+function(read_benchmarks FILE PREFIX)
+  file(READ "${FILE}" JSON_STR)
+  string(JSON COUNT LENGTH "${JSON_STR}" benchmarks)
+
+  set(NAMES "")
+  if(COUNT GREATER 0)
+    math(EXPR LAST "${COUNT} - 1")
+    foreach(I RANGE ${LAST})
+      string(JSON NAME GET "${JSON_STR}" benchmarks ${I} name)
+      string(JSON MEAN GET "${JSON_STR}" benchmarks ${I} mean)
+      list(APPEND NAMES "${NAME}")
+      set(${PREFIX}_MEAN_${I} "${MEAN}" PARENT_SCOPE)
+    endforeach()
+  endif()
+  set(${PREFIX}_NAMES "${NAMES}" PARENT_SCOPE)
+endfunction()
+
+# Formats the given duration in nanoseconds with a suitable unit.
+function(format_duration NS OUT)
+  if(NS GREATER_EQUAL 10000000)
+    math(EXPR VALUE "${NS} / 1000000" OUTPUT_FORMAT DECIMAL)
+    set(${OUT} "${VALUE} ms" PARENT_SCOPE)
+  elseif(NS GREATER_EQUAL 10000)
+    math(EXPR VALUE "${NS} / 1000" OUTPUT_FORMAT DECIMAL)
+    set(${OUT} "${VALUE} us" PARENT_SCOPE)
+  else()
+    set(${OUT} "${NS} ns" PARENT_SCOPE)
+  endif()
+endfunction()
+
+# math(EXPR) only supports integers, so durations are truncated to whole nanoseconds and
+# ratios are computed in per mille.
+function(truncate VALUE OUT)
+  string(REGEX REPLACE "[.eE].*$" "" INTEGER "${VALUE}")
+  if(INTEGER STREQUAL "")
+    set(INTEGER 0)
+  endif()
+  set(${OUT} "${INTEGER}" PARENT_SCOPE)
+endfunction()
+
+read_benchmarks("${BASELINE}" BASE)
+read_benchmarks("${CURRENT}" CUR)
+
+# Convert the threshold to the maximum tolerated ratio in per mille. A leading 1 is
+# prepended to the fractional digits to prevent them from being parsed as octal.
+if(NOT THRESHOLD MATCHES "^([0-9]*)\\.?([0-9]*)$")
+  message(FATAL_ERROR "Invalid threshold: ${THRESHOLD}")
+endif()
+set(THRESHOLD_INT "${CMAKE_MATCH_1}")
+string(SUBSTRING "${CMAKE_MATCH_2}000" 0 3 THRESHOLD_FRAC)
+if(THRESHOLD_INT STREQUAL "")
+  set(THRESHOLD_INT 0)
+endif()
+math(EXPR MAX_RATIO "${THRESHOLD_INT} * 1000 + 1${THRESHOLD_FRAC}")
+
+set(REGRESSIONS 0)
+set(CUR_INDEX 0)
+foreach(NAME IN LISTS CUR_NAMES)
+  list(FIND BASE_NAMES "${NAME}" BASE_INDEX)
+  if(BASE_INDEX EQUAL -1)
+    message(STATUS "NEW        ${NAME}")
+  else()
+    truncate("${BASE_MEAN_${BASE_INDEX}}" BASE_NS)
+    truncate("${CUR_MEAN_${CUR_INDEX}}" CUR_NS)
+    format_duration(${BASE_NS} BASE_STR)
+    format_duration(${CUR_NS} CUR_STR)
+
+    if(BASE_NS GREATER 0)
+      math(EXPR RATIO "${CUR_NS} * 1000 / ${BASE_NS}")
+    else()
+      set(RATIO 1000)
+    endif()
+    math(EXPR CHANGE "${RATIO} - 1000")
+    math(EXPR CHANGE_PERCENT "${CHANGE} / 10")
+
+    if(RATIO GREATER MAX_RATIO)
+      set(STATUS "SLOWER    ")
+      math(EXPR REGRESSIONS "${REGRESSIONS} + 1")
+    else()
+      set(STATUS "OK        ")
+    endif()
+    message(STATUS "${STATUS} ${NAME}: ${BASE_STR} -> ${CUR_STR} (${CHANGE_PERCENT}%)")
+  endif()
+  math(EXPR CUR_INDEX "${CUR_INDEX} + 1")
+endforeach()
+
+foreach(NAME IN LISTS BASE_NAMES)
+  list(FIND CUR_NAMES "${NAME}" INDEX)
+  if(INDEX EQUAL -1)
+    message(STATUS "MISSING    ${NAME}")
+  endif()
+endforeach()
+
+if(REGRESSIONS GREATER 0)
+  message(FATAL_ERROR "${REGRESSIONS} benchmark(s) regressed by more than ${THRESHOLD}")
+endif()
@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fmt/format.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_case_info.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <catch2/reporters/catch_reporter_streaming_base.hpp>
+
+namespace tb::mdl
+{
+namespace
+{
+
+std::string escapeJson(const std::string& str)
+{
+  auto result = std::string{};
+  result.reserve(str.size());
+  for (const auto c : str)
+  {
+    switch (c)
+    {
+    case '"':
+      result += "\\\"";
+      break;
+    case '\\':
+      result += "\\\\";
+      break;
+    case '\n':
+      result += "\\n";
+      break;
+    default:
+      result += c;
+      break;
+    }
+  }
+  return result;
+}
+
+/**
+ * Writes the results of all benchmarks as a JSON document. Every benchmark is identified
+ * by its test case name and its own name, separated by a slash. All durations are given
+ * in nanoseconds.
+ *
+ * The output only contains the benchmark results and no information about the machine or
+ * the time of the run, so that results of different runs can be compared directly. Use
+ * with `--reporter benchmark-json::out=<file>`.
+ */
+class BenchmarkJsonReporter : public Catch::StreamingReporterBase
+{
+private:
+  struct Result
+  {
+    std::string name;
+    double mean;
+    double lowerBound;
+    double upperBound;
+    double standardDeviation;
+    size_t samples;
+    size_t iterations;
+  };
+
+  std::vector<Result> m_results;
+
+public:
+  using StreamingReporterBase::StreamingReporterBase;
+
+  static std::string getDescription()
+  {
+    return "Reports benchmark results as JSON for regression tracking";
+  }
+
+  void benchmarkEnded(const Catch::BenchmarkStats<>& stats) override
+  {
+    m_results.push_back(Result{
+      currentTestCaseInfo->name + "/" + stats.info.name,
+      stats.mean.point.count(),
+      stats.mean.lower_bound.count(),
+      stats.mean.upper_bound.count(),
+      stats.standardDeviation.point.count(),
+      static_cast<size_t>(stats.info.samples),
+      static_cast<size_t>(stats.info.iterations),
+    });
+  }
+
+  void testRunEnded(const Catch::TestRunStats& stats) override
+  {
+    StreamingReporterBase::testRunEnded(stats);
+
+    m_stream << "{\n  \"version\": 1,\n  \"benchmarks\": [";
+    for (size_t i = 0; i < m_results.size(); ++i)
+    {
+      const auto& result = m_results[i];
+      m_stream << (i == 0 ? "\n" : ",\n")
+               << fmt::format(
+                    R"(    {{"name": "{}", "mean": {}, "lower_bound": {}, )"
+                    R"("upper_bound": {}, "standard_deviation": {}, )"
+                    R"("samples": {}, "iterations": {}}})",
+                    escapeJson(result.name),
+                    result.mean,
+                    result.lowerBound,
+                    result.upperBound,
+                    result.standardDeviation,
+                    result.samples,
+                    result.iterations);
+    }
+    m_stream << "\n  ]\n}\n";
+  }
+};
+
+} // namespace
+
+CATCH_REGISTER_REPORTER("benchmark-json", BenchmarkJsonReporter)
+
+} // namespace tb::mdl
@@ -0,0 +1,131 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+
+#include "TestParserStatus.h"
+#include "fs/TestUtils.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/CircleShape.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/NodeReader.h"
+#include "mdl/NodeWriter.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/contracts.h"
+#include "kd/result.h"
+#include "kd/task_manager.h"
+
+#include "vm/vec.h"
+
+#include <sstream>
+
+namespace tb::mdl
+{
+namespace
+{
+
+std::unique_ptr<WorldNode> createEmptyWorld(const MapFormat mapFormat)
+{
+  return std::make_unique<WorldNode>(EntityPropertyConfig{}, Entity{}, mapFormat);
+}
+
+} // namespace
+
+std::vector<Brush> createBrushSet(const size_t gridSize)
+{
+  const auto builder = BrushBuilder{MapFormat::Valve, BenchmarkWorldBounds};
+
+  auto result = std::vector<Brush>{};
+  result.reserve(gridSize * gridSize);
+
+  for (size_t x = 0; x < gridSize; ++x)
+  {
+    for (size_t y = 0; y < gridSize; ++y)
+    {
+      const auto min = vm::vec3d{double(x) * 128.0, double(y) * 128.0, 0.0};
+      const auto bounds = vm::bbox3d{min, min + vm::vec3d{96.0, 96.0, 128.0}};
+
+      switch ((x + y) % 8)
+      {
+      case 5:
+        result.push_back(builder
+                           .createCylinder(
+                             bounds, EdgeAlignedCircle{16}, vm::axis::z, "material")
+                           .value());
+        break;
+      case 6:
+        result.push_back(
+          builder.createCone(bounds, EdgeAlignedCircle{12}, vm::axis::z, "material")
+            .value());
+        break;
+      case 7:
+        result.push_back(builder.createIcoSphere(bounds, 1, "material").value());
+        break;
+      default:
+        result.push_back(builder.createCuboid(bounds, "material").value());
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+std::unique_ptr<WorldNode> createWorld(
+  std::vector<Brush> brushes, const MapFormat mapFormat)
+{
+  auto worldNode = createEmptyWorld(mapFormat);
+  for (auto& brush : brushes)
+  {
+    worldNode->defaultLayer()->addChild(new BrushNode{std::move(brush)});
+  }
+  return worldNode;
+}
+
+std::string writeWorld(const WorldNode& worldNode, kdl::task_manager& taskManager)
+{
+  auto stream = std::ostringstream{};
+  auto writer = NodeWriter{worldNode, stream};
+  writer.writeMap(taskManager);
+  return stream.str();
+}
+
+std::unique_ptr<WorldNode> readFixture(
+  const std::filesystem::path& path,
+  const MapFormat mapFormat,
+  kdl::task_manager& taskManager)
+{
+  const auto str = fs::readTextFile(std::filesystem::current_path() / "fixture" / path);
+
+  auto status = TestParserStatus{};
+  auto nodes = NodeReader::read(
+                 str, mapFormat, BenchmarkWorldBounds, {}, status, taskManager)
+               | kdl::value();
+  contract_assert(!nodes.empty());
+
+  auto worldNode = createEmptyWorld(mapFormat);
+  worldNode->defaultLayer()->addChildren(nodes);
+  return worldNode;
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "vm/bbox.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace kdl
+{
+class task_manager;
+}
+
+namespace tb::mdl
+{
+class Brush;
+enum class MapFormat;
+class WorldNode;
+
+inline const auto BenchmarkWorldBounds = vm::bbox3d{8192.0};
+
+/**
+ * Creates a synthetic set of brushes resembling a typical map: a grid of mostly boxes,
+ * with some cylinders, cones and spheres mixed in. The brushes use the Valve map format.
+ */
+std::vector<Brush> createBrushSet(size_t gridSize = 16);
+
+/**
+ * Creates a world node with the given map format and adds a brush node for each of the
+ * given brushes to its default layer.
+ */
+std::unique_ptr<WorldNode> createWorld(std::vector<Brush> brushes, MapFormat mapFormat);
+
+/**
+ * Serializes the given world to a string in its map format.
+ */
+std::string writeWorld(const WorldNode& worldNode, kdl::task_manager& taskManager);
+
+/**
+ * Reads the given map fixture and returns a world containing its contents. The path is
+ * relative to the fixture directory of TbMdlLibTest, which is copied next to the
+ * benchmark executable.
+ */
+std::unique_ptr<WorldNode> readFixture(
+  const std::filesystem::path& path, MapFormat mapFormat, kdl::task_manager& taskManager);
+
+} // namespace tb::mdl
@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushNode.h"
+#include "mdl/Group.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LinkedGroupUtils.h"
+#include "mdl/TestUtils.h"
+
+#include "kd/result.h"
+#include "kd/task_manager.h"
+
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include <memory>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+
+TEST_CASE("Linked group benchmarks")
+{
+  auto taskManager = kdl::task_manager{};
+
+  auto groupNode = GroupNode{Group{"group"}};
+  for (auto& brush : createBrushSet(4))
+  {
+    groupNode.addChild(new BrushNode{std::move(brush)});
+  }
+
+  auto linkedGroupNodes = std::vector<std::unique_ptr<GroupNode>>{};
+  auto targetGroupNodes = std::vector<GroupNode*>{};
+  for (size_t i = 0; i < 8; ++i)
+  {
+    auto linkedGroupNode = std::unique_ptr<GroupNode>{
+      static_cast<GroupNode*>(groupNode.cloneRecursively(BenchmarkWorldBounds))};
+    transformNode(
+      *linkedGroupNode,
+      vm::translation_matrix(vm::vec3d{0.0, 0.0, double(i + 1) * 256.0}),
+      BenchmarkWorldBounds);
+
+    targetGroupNodes.push_back(linkedGroupNode.get());
+    linkedGroupNodes.push_back(std::move(linkedGroupNode));
+  }
+
+  BENCHMARK("Clone linked groups")
+  {
+    auto result = std::vector<std::unique_ptr<Node>>{};
+    result.reserve(targetGroupNodes.size());
+    for (const auto* targetGroupNode : targetGroupNodes)
+    {
+      result.emplace_back(targetGroupNode->cloneRecursively(BenchmarkWorldBounds));
+    }
+    return result;
+  };
+
+  BENCHMARK("Update linked groups")
+  {
+    return updateLinkedGroups(
+             groupNode, targetGroupNodes, BenchmarkWorldBounds, taskManager)
+           | kdl::value();
+  };
+
+  BENCHMARK("Update linked groups incrementally")
+  {
+    return updateLinkedGroupsIncrementally(
+             groupNode, targetGroupNodes, BenchmarkWorldBounds, taskManager)
+           | kdl::value();
+  };
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,125 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+#include "TestParserStatus.h"
+#include "fs/TestUtils.h"
+#include "mdl/Brush.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/MapFormat.h"
+#include "mdl/Node.h"
+#include "mdl/NodeReader.h"
+#include "mdl/NodeWriter.h"
+#include "mdl/WorldNode.h"
+#include "mdl/WorldReader.h"
+
+#include "kd/result.h"
+#include "kd/task_manager.h"
+
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+namespace
+{
+
+std::unique_ptr<WorldNode> readWorld(
+  const std::string& str, const MapFormat mapFormat, kdl::task_manager& taskManager)
+{
+  auto status = TestParserStatus{};
+  auto reader = WorldReader{str, mapFormat, EntityPropertyConfig{}};
+  return reader.read(BenchmarkWorldBounds, status, taskManager) | kdl::value();
+}
+
+std::vector<std::unique_ptr<Node>> readNodes(
+  const std::string& str, const MapFormat mapFormat, kdl::task_manager& taskManager)
+{
+  auto status = TestParserStatus{};
+  auto nodes = NodeReader::read(
+                 str, mapFormat, BenchmarkWorldBounds, {}, status, taskManager)
+               | kdl::value();
+
+  auto result = std::vector<std::unique_ptr<Node>>{};
+  result.reserve(nodes.size());
+  for (auto* node : nodes)
+  {
+    result.emplace_back(node);
+  }
+  return result;
+}
+
+std::string readFixtureFile(const std::filesystem::path& path)
+{
+  return fs::readTextFile(std::filesystem::current_path() / "fixture" / path);
+}
+
+} // namespace
+
+TEST_CASE("Map reader benchmarks")
+{
+  auto taskManager = kdl::task_manager{};
+
+  const auto synthetic =
+    writeWorld(*createWorld(createBrushSet(32), MapFormat::Valve), taskManager);
+  const auto subtrahend = readFixtureFile("mdl/Brush/subtrahend.map");
+  const auto curvetut = readFixtureFile("mdl/Brush/curvetut-crash.map");
+
+  BENCHMARK("Read synthetic world")
+  {
+    return readWorld(synthetic, MapFormat::Valve, taskManager);
+  };
+
+  BENCHMARK("Read subtrahend.map")
+  {
+    return readNodes(subtrahend, MapFormat::Standard, taskManager);
+  };
+
+  BENCHMARK("Read curvetut-crash.map")
+  {
+    return readNodes(curvetut, MapFormat::Valve, taskManager);
+  };
+}
+
+TEST_CASE("Map writer benchmarks")
+{
+  auto taskManager = kdl::task_manager{};
+
+  const auto synthetic = createWorld(createBrushSet(32), MapFormat::Valve);
+  const auto subtrahend =
+    readFixture("mdl/Brush/subtrahend.map", MapFormat::Standard, taskManager);
+
+  BENCHMARK("Write synthetic world")
+  {
+    return writeWorld(*synthetic, taskManager);
+  };
+
+  BENCHMARK("Write subtrahend.map")
+  {
+    return writeWorld(*subtrahend, taskManager);
+  };
+}
+
+} // namespace tb::mdl
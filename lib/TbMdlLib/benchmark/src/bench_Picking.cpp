@@ -0,0 +1,105 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+#include "mdl/Brush.h"
+#include "mdl/EditorContext.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/PickResult.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/task_manager.h"
+
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+namespace
+{
+
+/**
+ * Creates a grid of rays that are cast diagonally downwards across the given bounds.
+ */
+std::vector<vm::ray3d> createRays(const vm::bbox3d& bounds, const size_t gridSize)
+{
+  const auto size = bounds.size();
+  const auto direction = vm::normalize(vm::vec3d{1, 1, -1});
+
+  auto result = std::vector<vm::ray3d>{};
+  result.reserve(gridSize * gridSize);
+
+  for (size_t x = 0; x < gridSize; ++x)
+  {
+    for (size_t y = 0; y < gridSize; ++y)
+    {
+      const auto origin = vm::vec3d{
+        bounds.min.x() + size.x() * double(x) / double(gridSize) - size.z(),
+        bounds.min.y() + size.y() * double(y) / double(gridSize) - size.z(),
+        bounds.max.z() + 1.0};
+      result.emplace_back(origin, direction);
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("Picking benchmarks")
+{
+  auto taskManager = kdl::task_manager{};
+
+  const auto editorContext = EditorContext{};
+
+  const auto pickAll = [&](WorldNode& worldNode, const std::vector<vm::ray3d>& rays) {
+    auto hits = size_t(0);
+    for (const auto& ray : rays)
+    {
+      auto pickResult = PickResult::byDistance();
+      worldNode.pick(editorContext, ray, pickResult);
+      hits += pickResult.size();
+    }
+    return hits;
+  };
+
+  auto synthetic = createWorld(createBrushSet(32), MapFormat::Valve);
+  const auto syntheticRays = createRays(synthetic->defaultLayer()->logicalBounds(), 32);
+
+  auto subtrahend =
+    readFixture("mdl/Brush/subtrahend.map", MapFormat::Standard, taskManager);
+  const auto subtrahendRays = createRays(subtrahend->defaultLayer()->logicalBounds(), 32);
+
+  BENCHMARK("Pick synthetic world")
+  {
+    return pickAll(*synthetic, syntheticRays);
+  };
+
+  BENCHMARK("Pick subtrahend.map")
+  {
+    return pickAll(*subtrahend, subtrahendRays);
+  };
+}
+
+} // namespace tb::mdl
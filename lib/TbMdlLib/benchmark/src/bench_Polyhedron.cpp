@@ -0,0 +1,168 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/MapFormat.h"
+#include "mdl/Polyhedron3.h"
+
+#include "kd/result.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+namespace
+{
+
+Brush createSubtrahend(const Brush& brush)
+{
+  const auto builder = BrushBuilder{MapFormat::Valve, BenchmarkWorldBounds};
+  const auto center = brush.bounds().center();
+  const auto bounds = vm::bbox3d{center - vm::vec3d{32, 32, 96}, center};
+  return builder.createCuboid(bounds, "subtrahend").value();
+}
+
+BrushFace createClipFace(const Brush& brush)
+{
+  const auto center = brush.bounds().center();
+  return BrushFace::create(
+           center,
+           center + vm::vec3d{0, 1, 1},
+           center + vm::vec3d{1, 0, 1},
+           BrushFaceAttributes{"clip"},
+           MapFormat::Valve)
+    .value();
+}
+
+std::vector<vm::vec3d> createRandomPoints(const size_t count)
+{
+  auto rng = std::mt19937{0};
+  auto coordinate = std::uniform_real_distribution<double>{-512.0, 512.0};
+
+  auto result = std::vector<vm::vec3d>{};
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    result.emplace_back(coordinate(rng), coordinate(rng), coordinate(rng));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("Polyhedron benchmarks")
+{
+  const auto brushes = createBrushSet();
+
+  auto polyhedra = std::vector<Polyhedron3>{};
+  polyhedra.reserve(brushes.size());
+  for (const auto& brush : brushes)
+  {
+    polyhedra.emplace_back(brush.vertexPositions());
+  }
+
+  const auto brushVertices = [&]() {
+    auto result = std::vector<std::vector<vm::vec3d>>{};
+    result.reserve(brushes.size());
+    for (const auto& brush : brushes)
+    {
+      result.push_back(brush.vertexPositions());
+    }
+    return result;
+  }();
+
+  const auto randomPoints = createRandomPoints(10000);
+
+  BENCHMARK("Convex hull of brush vertices")
+  {
+    auto result = std::vector<Polyhedron3>{};
+    result.reserve(brushVertices.size());
+    for (const auto& vertices : brushVertices)
+    {
+      result.emplace_back(vertices);
+    }
+    return result;
+  };
+
+  BENCHMARK("Convex hull of random points")
+  {
+    return Polyhedron3{randomPoints};
+  };
+
+  BENCHMARK("Copy polyhedra")
+  {
+    return std::vector<Polyhedron3>{polyhedra};
+  };
+
+  BENCHMARK("Copy brushes")
+  {
+    return std::vector<Brush>{brushes};
+  };
+
+  BENCHMARK("Update geometry from faces")
+  {
+    auto result = std::vector<Brush>{};
+    result.reserve(brushes.size());
+    for (const auto& brush : brushes)
+    {
+      result.push_back(Brush::create(BenchmarkWorldBounds, brush.faces()).value());
+    }
+    return result;
+  };
+
+  BENCHMARK_ADVANCED("Clip brushes")(Catch::Benchmark::Chronometer meter)
+  {
+    auto copies = std::vector<std::vector<Brush>>(size_t(meter.runs()), brushes);
+    meter.measure([&](const int i) {
+      for (auto& brush : copies[size_t(i)])
+      {
+        brush.clip(BenchmarkWorldBounds, createClipFace(brush)).ignore();
+      }
+    });
+  };
+
+  BENCHMARK("Subtract brushes")
+  {
+    auto result = std::vector<Result<Brush>>{};
+    for (const auto& brush : brushes)
+    {
+      const auto subtrahend = createSubtrahend(brush);
+      auto fragments =
+        brush.subtract(MapFormat::Valve, BenchmarkWorldBounds, "material", subtrahend);
+      result.insert(
+        result.end(),
+        std::make_move_iterator(fragments.begin()),
+        std::make_move_iterator(fragments.end()));
+    }
+    return result;
+  };
+}
+
+} // namespace tb::mdl
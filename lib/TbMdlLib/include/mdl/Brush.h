@@ -46,8 +46,6 @@ enum class MapFormat;
 class Brush
 {
 private:
-  class CopyCallback;
-
   /**
    * Epsilon value to use when finding a vertex after applying a vertex operation
    */
@@ -59,7 +57,13 @@ public:
 
 private:
   std::vector<BrushFace> m_faces;
-  std::unique_ptr<BrushGeometry> m_geometry;
+
+  /**
+   * The geometry is never modified once it has been created; every operation that changes
+   * the brush replaces it. This allows copies of a brush to share it until one of them is
+   * changed. The faces of each copy refer to the shared geometry.
+   */
+  std::shared_ptr<BrushGeometry> m_geometry;
 
   kdl_reflect_decl(Brush, m_faces);
 
@@ -26,6 +26,7 @@
 #include "mdl/BrushGeometry.h"
 #include "mdl/Tag.h"
 
+#include "kd/cow_ptr.h"
 #include "kd/reflection_decl.h"
 
 #include "vm/plane.h"
@@ -90,7 +91,9 @@ public:
 private:
   BrushFace::Points m_points;
   vm::plane3d m_boundary;
-  BrushFaceAttributes m_attributes;
+
+  // shared between copies of this face until one of them changes its attributes
+  kdl::cow_ptr<BrushFaceAttributes> m_attributes;
 
   AssetReference<gl::Material> m_materialReference;
   std::unique_ptr<UVCoordSystem> m_uvCoordSystem;
@@ -290,7 +293,10 @@ public: // brush renderer
   void setMarked(bool marked) const;
   bool isMarked() const;
 
-private: // implement Taggable interface
+public: // implement Taggable interface
+  void updateTags(TagManager& tagManager) override;
+
+private:
   void doAcceptTagVisitor(TagVisitor& visitor) override;
   void doAcceptTagVisitor(ConstTagVisitor& visitor) const override;
 };
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Macros.h"
+#include "mdl/CompactNodeContents.h"
 #include "mdl/NodeContents.h"
 #include "mdl/SwapNodeContentsCommand.h"
 
@@ -37,7 +38,7 @@ namespace detail
 {
 
 std::vector<BrushNode*> collectBrushNodes(
-  const std::vector<std::pair<Node*, NodeContents>>& nodes);
+  const std::vector<std::pair<Node*, CompactNodeContents>>& nodes);
 
 } // namespace detail
 
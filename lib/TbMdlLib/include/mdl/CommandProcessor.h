@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -50,6 +51,10 @@ enum class TransactionScope;
  * The command processor supports nested transactions. Each transaction can be committed
  * or rolled back individually. Committing a nested transaction adds it as a command to
  * the containing transaction.
+ *
+ * The memory used by the undo stack can be limited. If the commands on the undo stack
+ * exceed the limit, then the oldest commands are discarded. The most recently executed
+ * command is always kept.
  */
 class CommandProcessor
 {
@@ -66,6 +71,12 @@ private:
    */
   std::chrono::milliseconds m_collationInterval;
 
+  /**
+   * The maximum estimated memory in bytes used by the commands on the undo stack, or
+   * nullopt if the undo stack is not limited.
+   */
+  std::optional<size_t> m_undoMemoryLimit;
+
   /**
    * Holds the commands that were executed so far, with the most recently executed command
    * at the end of the vector.
@@ -144,6 +155,13 @@ public:
    */
   Notifier<const std::string&, bool, bool> transactionUndoneNotifier;
 
+  /**
+   * Notifies observers when commands were discarded from the undo stack to stay within
+   * the undo memory limit. Passes the number of discarded commands and their estimated
+   * memory size in bytes.
+   */
+  Notifier<size_t, size_t> undoCommandsDiscardedNotifier;
+
   /**
    * Indicates whether command collation is enabled.
    */
@@ -154,6 +172,24 @@ public:
    */
   void setIsCollationEnabled(bool isCollationEnabled);
 
+  /**
+   * Returns the maximum estimated memory in bytes used by the commands on the undo stack,
+   * or nullopt if the undo stack is not limited.
+   */
+  std::optional<size_t> undoMemoryLimit() const;
+
+  /**
+   * Sets the maximum estimated memory in bytes used by the commands on the undo stack.
+   * If the current undo stack exceeds the given limit, the oldest commands are discarded
+   * immediately.
+   */
+  void setUndoMemoryLimit(std::optional<size_t> undoMemoryLimit);
+
+  /**
+   * Returns the estimated memory in bytes used by the commands on the undo stack.
+   */
+  size_t undoMemorySize() const;
+
   /**
    * Indicates whether there is any command on the undo stack.
    */
@@ -369,6 +405,12 @@ private:
    */
   bool pushToUndoStack(std::unique_ptr<UndoableCommand> command, bool collate);
 
+  /**
+   * Discards the oldest commands from the undo stack until the remaining commands don't
+   * exceed the undo memory limit, keeping at least the topmost command.
+   */
+  void discardUndoCommandsOverLimit();
+
   /**
    * Pops the topmost command from the undo stack and returns it.
    *
@@ -0,0 +1,114 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Result.h"
+#include "mdl/BrushFace.h"
+#include "mdl/NodeContents.h"
+
+#include "vm/bbox.h"
+
+#include <variant>
+#include <vector>
+
+namespace tb::mdl
+{
+class Node;
+
+/**
+ * Stores the contents of a node in a compact form for undo and redo.
+ *
+ * Brushes make up the bulk of the contents stored in the undo history, and most of a
+ * brush's memory is taken up by its geometry. Since the geometry can be rebuilt from the
+ * brush faces, a stored brush is reduced to one of the following:
+ *
+ * - If the stored brush has the same face planes as the node's current brush, only the
+ *   faces whose attributes or UV coordinate systems differ are stored. This is the case
+ *   for changes to the UV coordinates or the material of some faces.
+ * - Otherwise, only the faces are stored, and the geometry is rebuilt when the contents
+ *   are expanded.
+ *
+ * Since a compacted brush refers to the node's current brush, it can only be expanded if
+ * the node's contents haven't changed since the contents were compacted. This holds for
+ * contents stored in the undo history because the commands are undone and redone in
+ * order. When two commands are collated, the contents of the first command must be
+ * rebased onto the node's current contents, see rebase().
+ *
+ * Other node contents are stored as they are.
+ */
+class CompactNodeContents
+{
+private:
+  struct BrushFaces
+  {
+    std::vector<BrushFace> faces;
+  };
+
+  struct BrushFaceChanges
+  {
+    std::vector<std::pair<size_t, BrushFace>> changedFaces;
+  };
+
+  std::variant<NodeContents, BrushFaces, BrushFaceChanges> m_contents;
+
+  explicit CompactNodeContents(
+    std::variant<NodeContents, BrushFaces, BrushFaceChanges> contents);
+
+public:
+  /**
+   * Stores the given contents as they are.
+   */
+  explicit CompactNodeContents(NodeContents contents);
+
+  /**
+   * Compacts the given contents, which are meant to replace the current contents of the
+   * given node when they are expanded again.
+   */
+  static CompactNodeContents compact(NodeContents contents, const Node& node);
+
+  /**
+   * Restores the original contents. The given node must be the node that was passed to
+   * compact(), and its contents must not have changed since.
+   *
+   * Returns an error if the brush geometry cannot be rebuilt. These contents are left
+   * unchanged, so they remain valid if expanding the contents of another node fails.
+   */
+  Result<NodeContents> expand(const Node& node, const vm::bbox3d& worldBounds) const;
+
+  /**
+   * Makes these contents refer to the current contents of the given node. These contents
+   * must refer to the contents restored by the given intermediate contents, which in turn
+   * must refer to the node's current contents.
+   *
+   * This is used when a command is collated with the next command that changes the same
+   * node: the first command must then restore its contents from the node's contents
+   * after the second command was done.
+   */
+  void rebase(const CompactNodeContents& intermediateContents, const Node& node);
+
+  bool isCompact() const;
+
+  /**
+   * Returns an estimate of the memory in bytes used by the stored contents.
+   */
+  size_t memorySize() const;
+};
+
+} // namespace tb::mdl
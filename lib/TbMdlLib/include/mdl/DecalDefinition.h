@@ -21,9 +21,12 @@
 
 #include "Result.h"
 #include "el/Expression.h"
+#include "el/ExpressionCache.h"
 
 #include "kd/reflection_decl.h"
 
+#include <memory>
+
 namespace tb
 {
 struct FileLocation;
@@ -48,6 +51,13 @@ class DecalDefinition
 private:
   el::ExpressionNode m_expression;
 
+  /**
+   * Memoizes the decal specifications by the values of the variables read by the decal
+   * expression. Shared between copies of this definition.
+   */
+  std::shared_ptr<el::ExpressionCache<Result<DecalSpecification>>>
+    m_decalSpecificationCache;
+
 public:
   DecalDefinition();
   explicit DecalDefinition(const FileLocation& location);
@@ -22,7 +22,11 @@
 #include "Color.h"
 #include "Result.h"
 #include "mdl/EntityDefinition.h"
+#include "mdl/EntityDefinitionClassInfo.h"
 
+#include "kd/reflection_decl.h"
+
+#include <filesystem>
 #include <vector>
 
 namespace tb
@@ -31,13 +35,43 @@ class ParserStatus;
 
 namespace mdl
 {
-struct EntityDefinitionClassInfo;
 struct PropertyDefinition;
 
 // exposed for testing
 std::vector<EntityDefinitionClassInfo> resolveInheritance(
   ParserStatus& status, const std::vector<EntityDefinitionClassInfo>& classInfos);
 
+/**
+ * The class infos parsed from a single entity definition file.
+ *
+ * Included files are not parsed. Instead, each include records the path as given in the
+ * file and the number of class infos that precede it.
+ */
+struct EntityDefinitionFileContents
+{
+  struct Include
+  {
+    size_t position;
+    std::filesystem::path path;
+
+    kdl_reflect_decl(Include, position, path);
+  };
+
+  std::vector<EntityDefinitionClassInfo> classInfos;
+  std::vector<Include> includes;
+
+  kdl_reflect_decl(EntityDefinitionFileContents, classInfos, includes);
+};
+
+/**
+ * Resolves the inheritance of the given class infos and creates entity definitions for
+ * all classes that are not base classes.
+ */
+Result<std::vector<EntityDefinition>> createEntityDefinitions(
+  ParserStatus& status,
+  const std::vector<EntityDefinitionClassInfo>& classInfos,
+  const Color& defaultEntityColor);
+
 class EntityDefinitionParser
 {
 private:
@@ -48,10 +82,12 @@ public:
   virtual ~EntityDefinitionParser();
 
   Result<std::vector<EntityDefinition>> parseDefinitions(ParserStatus& status);
+  Result<EntityDefinitionFileContents> parseFileContents(ParserStatus& status);
 
 private:
   virtual std::vector<EntityDefinitionClassInfo> parseClassInfos(
     ParserStatus& status) = 0;
+  virtual EntityDefinitionFileContents doParseFileContents(ParserStatus& status);
 };
 
 } // namespace mdl
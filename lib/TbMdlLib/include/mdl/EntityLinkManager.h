@@ -21,15 +21,20 @@
 
 #include "kd/reflection_decl.h"
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+namespace kdl
+{
+class task_manager;
+}
+
 namespace tb::mdl
 {
 class EntityNodeBase;
-class NodeIndex;
 
 struct LinkEnd
 {
@@ -39,31 +44,86 @@ struct LinkEnd
   kdl_reflect_decl(LinkEnd, node, propertyKey);
 };
 
+/**
+ * Maintains the links between entity nodes that are established by their link source and
+ * link target properties.
+ *
+ * The link graph is stored compactly: property keys are interned, and every node stores
+ * its outgoing and incoming links in flat arrays, one per link property key. The link
+ * ends are found using an index of the link property values of all added nodes, so adding
+ * and removing a node only touches the nodes it is linked with.
+ */
 class EntityLinkManager
 {
 public:
   using LinkEnds = std::unordered_set<LinkEnd>;
   using LinkEndsForPropertyKey = std::unordered_map<std::string, LinkEnds>;
-  using LinksForEntityNode =
-    std::unordered_map<const EntityNodeBase*, LinkEndsForPropertyKey>;
 
 private:
-  const NodeIndex& m_nodeIndex;
-
-  LinksForEntityNode m_linkSources;
-  LinksForEntityNode m_linkTargets;
+  using PropertyKeyId = std::uint32_t;
+
+  struct CompactLinkEnd
+  {
+    const EntityNodeBase* node;
+    PropertyKeyId propertyKey;
+
+    bool operator==(const CompactLinkEnd& other) const = default;
+  };
+
+  struct LinkProperty
+  {
+    PropertyKeyId propertyKey;
+    std::string value;
+  };
+
+  /**
+   * The opposite link ends for one link property key of a node. An empty array means that
+   * the node has the property, but the opposite link end is missing.
+   */
+  struct Adjacency
+  {
+    PropertyKeyId propertyKey;
+    std::vector<CompactLinkEnd> linkEnds;
+  };
+
+  struct NodeLinks
+  {
+    std::vector<LinkProperty> sourceProperties;
+    std::vector<LinkProperty> targetProperties;
+    std::vector<Adjacency> linksFrom;
+    std::vector<Adjacency> linksTo;
+  };
+
+  using LinkEndsByValue = std::unordered_map<std::string, std::vector<CompactLinkEnd>>;
+
+  std::vector<std::string> m_propertyKeys;
+  std::unordered_map<std::string, PropertyKeyId> m_propertyKeyIds;
+
+  std::unordered_map<const EntityNodeBase*, NodeLinks> m_nodeLinks;
+  LinkEndsByValue m_linkSourcesByValue;
+  LinkEndsByValue m_linkTargetsByValue;
 
 public:
-  explicit EntityLinkManager(const NodeIndex& nodeIndex);
-
-  const LinkEndsForPropertyKey& linksFrom(const EntityNodeBase& sourceNode) const;
-  const LinkEnds& linksFrom(
+  LinkEndsForPropertyKey linksFrom(const EntityNodeBase& sourceNode) const;
+  LinkEnds linksFrom(
     const EntityNodeBase& sourceNode, const std::string& sourcePropertyKey) const;
 
-  const LinkEndsForPropertyKey& linksTo(const EntityNodeBase& targetNode) const;
-  const LinkEnds& linksTo(
+  LinkEndsForPropertyKey linksTo(const EntityNodeBase& targetNode) const;
+  LinkEnds linksTo(
     const EntityNodeBase& targetNode, const std::string& targetPropertyKey) const;
 
+  /**
+   * Returns the target node of every link from the given node.
+   */
+  std::vector<const EntityNodeBase*> linkTargetNodes(
+    const EntityNodeBase& sourceNode) const;
+
+  /**
+   * Returns the source node of every link to the given node.
+   */
+  std::vector<const EntityNodeBase*> linkSourceNodes(
+    const EntityNodeBase& targetNode) const;
+
   bool hasLink(
     const EntityNodeBase& sourceNode,
     const EntityNodeBase& targetNode,
@@ -89,14 +149,29 @@ public:
   void addEntityNode(EntityNodeBase& entityNode);
   void removeEntityNode(EntityNodeBase& entityNode);
 
+  /**
+   * Adds all links between the given entity nodes. This has the same effect as adding
+   * the nodes one by one, but the link properties of the nodes are collected and the
+   * links of the source nodes are resolved in parallel.
+   *
+   * The link manager must be empty.
+   */
+  void addEntityNodes(
+    const std::vector<EntityNodeBase*>& entityNodes, kdl::task_manager& taskManager);
+
   void clear();
 
 private:
-  void addLinksFrom(EntityNodeBase& sourceNode);
-  void addLinksTo(EntityNodeBase& targetNode);
+  PropertyKeyId internPropertyKey(const std::string& propertyKey);
+  const PropertyKeyId* findPropertyKeyId(const std::string& propertyKey) const;
+
+  const NodeLinks* findNodeLinks(const EntityNodeBase& node) const;
+  std::vector<std::string> getPropertyKeysWithMissingLinkEnd(
+    const std::vector<Adjacency>& adjacencies) const;
+  LinkEndsForPropertyKey expandLinks(const std::vector<Adjacency>& adjacencies) const;
+  LinkEnds expandLinkEnds(const std::vector<CompactLinkEnd>& linkEnds) const;
 
-  void removeLinksFrom(const EntityNodeBase& sourceNode);
-  void removeLinksTo(const EntityNodeBase& targetNode);
+  void addLink(const CompactLinkEnd& sourceLinkEnd, const CompactLinkEnd& targetLinkEnd);
 };
 
 } // namespace tb::mdl
@@ -23,6 +23,7 @@
 #include "gl/ResourceId.h"
 #include "mdl/EntityModel.h"
 #include "mdl/ModelSpecification.h"
+#include "mdl/SharedResourceCache.h"
 
 #include "kd/path_hash.h"
 
@@ -58,6 +59,7 @@ namespace mdl
 class EntityModelFrame;
 class EntityNode;
 class Quake3Shader;
+class Quake3ShaderCache;
 
 enum class Orientation;
 
@@ -68,12 +70,15 @@ class EntityModelManager
 private:
   const GameInfo& m_gameInfo;
   const fs::FileSystem& m_gameFileSystem;
+  Quake3ShaderCache& m_shaderCache;
 
-  CreateEntityModelDataResource m_createResource;
+  CreateFileResource<EntityModelData> m_createResource;
   Logger& m_logger;
 
-  // Cache Quake 3 shaders to use when loading models
-  std::vector<Quake3Shader> m_shaders;
+  // Cache Quake 3 shaders to use when loading models. Models are loaded asynchronously,
+  // so every loader keeps a reference to the shaders that were current when it was
+  // created.
+  std::shared_ptr<const std::vector<Quake3Shader>> m_shaders;
 
   mutable std::unordered_map<std::filesystem::path, EntityModel, kdl::path_hash> m_models;
   mutable std::unordered_map<ModelSpecification, std::unique_ptr<gl::MaterialRenderer>>
@@ -86,7 +91,8 @@ public:
   EntityModelManager(
     const GameInfo& gameInfo,
     const fs::FileSystem& gameFilesystem,
-    CreateEntityModelDataResource createResource,
+    Quake3ShaderCache& shaderCache,
+    CreateFileResource<EntityModelData> createResource,
     Logger& logger);
   ~EntityModelManager();
 
@@ -59,6 +59,13 @@ public: // entity model
   const vm::bbox3d& modelBounds() const;
   void setModel(const EntityModel* model);
 
+  /**
+   * Models are loaded asynchronously. Until a model's data is available, the entity's
+   * bounds are computed from its definition only. Call this when the data of this
+   * entity's model has finished loading so that the bounds include the model.
+   */
+  void modelDataDidLoad();
+
 private: // implement Node interface
   const vm::bbox3d& doGetLogicalBounds() const override;
   const vm::bbox3d& doGetPhysicalBounds() const override;
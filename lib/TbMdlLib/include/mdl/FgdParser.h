@@ -115,6 +115,7 @@ private:
 
 private:
   std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status) override;
+  EntityDefinitionFileContents doParseFileContents(ParserStatus& status) override;
 
   void parseClassInfoOrInclude(
     ParserStatus& status, std::vector<EntityDefinitionClassInfo>& classInfos);
@@ -171,6 +172,7 @@ private:
   Color parseColor();
   std::string parseString();
 
+  std::filesystem::path parseIncludePath();
   std::vector<EntityDefinitionClassInfo> parseInclude(ParserStatus& status);
   std::vector<EntityDefinitionClassInfo> handleInclude(
     ParserStatus& status, const std::filesystem::path& path);
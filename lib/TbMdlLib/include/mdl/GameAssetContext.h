@@ -0,0 +1,57 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "gl/Texture.h"
+#include "mdl/EntityDefinitionFileCache.h"
+#include "mdl/Quake3ShaderCache.h"
+#include "mdl/SharedResourceCache.h"
+
+namespace tb::mdl
+{
+class EntityModelData;
+
+/**
+ * Holds the assets that can be shared between the documents that are open for the same
+ * game. This includes the parsed shaders and entity definition files as well as the
+ * textures and entity models that have been loaded.
+ *
+ * A context is released when the last document using it is closed, see
+ * GameAssetContextManager.
+ */
+class GameAssetContext
+{
+private:
+  Quake3ShaderCache m_shaderCache;
+  EntityDefinitionFileCache m_entityDefinitionFileCache;
+  SharedResourceCache<gl::Texture> m_textureResourceCache;
+  SharedResourceCache<EntityModelData> m_entityModelDataResourceCache;
+
+public:
+  GameAssetContext();
+  ~GameAssetContext();
+
+  Quake3ShaderCache& shaderCache();
+  EntityDefinitionFileCache& entityDefinitionFileCache();
+  SharedResourceCache<gl::Texture>& textureResourceCache();
+  SharedResourceCache<EntityModelData>& entityModelDataResourceCache();
+};
+
+} // namespace tb::mdl
@@ -0,0 +1,51 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace tb::mdl
+{
+class GameAssetContext;
+
+/**
+ * Hands out the asset contexts for the games that have open documents. Every document
+ * for the same game receives the same context. The manager only keeps weak references
+ * to the contexts, so a context is released when the last document using it is closed.
+ */
+class GameAssetContextManager
+{
+private:
+  std::unordered_map<std::string, std::weak_ptr<GameAssetContext>> m_contexts;
+
+public:
+  GameAssetContextManager();
+  ~GameAssetContextManager();
+
+  /**
+   * Returns the asset context for the game with the given name, creating a new context
+   * if no document currently uses one.
+   */
+  std::shared_ptr<GameAssetContext> acquire(const std::string& gameName);
+};
+
+} // namespace tb::mdl
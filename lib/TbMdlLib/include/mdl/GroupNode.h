@@ -66,6 +66,12 @@ private:
 
   bool m_hasPendingChanges = false;
 
+  /**
+   * The descendants whose contents have changed if the pending changes only affect the
+   * contents of these descendants, or nullopt otherwise.
+   */
+  std::optional<std::vector<const Node*>> m_pendingContentChanges;
+
 public:
   explicit GroupNode(Group group);
 
@@ -85,6 +91,21 @@ public:
   bool hasPendingChanges() const;
   void setHasPendingChanges(bool hasPendingChanges);
 
+  /**
+   * Returns the descendants whose contents have changed if the pending changes of this
+   * group only affect the contents of these descendants. Returns nullopt if this group
+   * has no pending changes or if its pending changes may affect any descendant, e.g.
+   * because nodes were added or removed.
+   */
+  const std::optional<std::vector<const Node*>>& pendingContentChanges() const;
+
+  /**
+   * Marks this group as having pending changes that affect the contents of the given
+   * descendants. If this group already has pending changes that are not limited to the
+   * contents of its descendants, then the given nodes are not recorded.
+   */
+  void addPendingContentChanges(const std::vector<const Node*>& nodes);
+
 private:
   void setEditState(EditState editState);
   void setAncestorEditState(EditState editState);
@@ -25,6 +25,7 @@
 #include "mdl/EntityNode.h" // IWYU pragma: keep
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
+#include "mdl/NodeContents.h"
 #include "mdl/NodeVisitor.h"
 #include "mdl/PatchNode.h" // IWYU pragma: keep
 #include "mdl/WorldNode.h"
@@ -34,6 +35,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -141,6 +143,56 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
   const vm::bbox3d& worldBounds,
   kdl::task_manager& taskManager);
 
+/**
+ * The changes required to update the members of a link set from one of its members.
+ */
+struct LinkedGroupUpdates
+{
+  /**
+   * Pairs of group nodes and the new children that should replace their children.
+   */
+  UpdateLinkedGroupsResult childrenToReplace;
+
+  /**
+   * Pairs of nodes and the new contents that should replace their contents.
+   */
+  std::vector<std::pair<Node*, NodeContents>> contentsToSwap;
+};
+
+/**
+ * Maps changed linked group nodes to those of their descendants whose contents have
+ * changed. A changed linked group node without an entry may have arbitrary changes.
+ */
+using ChangedLinkedNodes =
+  std::unordered_map<const GroupNode*, std::unordered_set<const Node*>>;
+
+/**
+ * Updates the given target group nodes from the given source group node like
+ * `updateLinkedGroups`, but only returns updates for the nodes that have changed.
+ *
+ * If a target group node has the same structure as the source group node, then each
+ * descendant of the source node is transformed into the target group and compared to its
+ * corresponding node in the target group. Only the corresponding nodes whose contents
+ * differ are returned in `contentsToSwap`, the other nodes are left untouched.
+ *
+ * If the structure of a target group node differs from the structure of the source group
+ * node, e.g. because nodes were added to or removed from the source group, then the
+ * children of the target group node are replaced as in `updateLinkedGroups` and returned
+ * in `childrenToReplace`.
+ *
+ * If `changedNodes` is not null, then only the descendants of the source group node
+ * contained in it are transformed into the target groups and compared, because the other
+ * descendants are known to be unchanged.
+ *
+ * The operation fails under the same conditions as `updateLinkedGroups`.
+ */
+Result<LinkedGroupUpdates> updateLinkedGroupsIncrementally(
+  const GroupNode& sourceGroupNode,
+  const std::vector<GroupNode*>& targetGroupNodes,
+  const vm::bbox3d& worldBounds,
+  kdl::task_manager& taskManager,
+  const std::unordered_set<const Node*>* changedNodes = nullptr);
+
 std::vector<Error> initializeLinkIds(const std::vector<Node*>& nodes);
 
 /**
@@ -25,15 +25,34 @@
 
 #include <filesystem>
 
+namespace kdl
+{
+class task_manager;
+}
+
 namespace tb
 {
+class Logger;
 class ParserStatus;
 
 namespace mdl
 {
+class EntityDefinitionFileCache;
 
 Result<std::vector<EntityDefinition>> loadEntityDefinitions(
   const std::filesystem::path& path, const Color& defaultColor, ParserStatus& status);
 
+/**
+ * Loads the entity definitions like the function above, but only parses the files that
+ * are not contained in the given cache or whose contents have changed. Included files are
+ * read and parsed in parallel, and the newly parsed files are added to the cache.
+ */
+Result<std::vector<EntityDefinition>> loadEntityDefinitions(
+  const std::filesystem::path& path,
+  const Color& defaultColor,
+  EntityDefinitionFileCache& cache,
+  kdl::task_manager& taskManager,
+  Logger& logger);
+
 } // namespace mdl
 } // namespace tb
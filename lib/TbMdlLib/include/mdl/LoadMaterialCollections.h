@@ -23,6 +23,7 @@
 #include "gl/TextureResource.h"
 #include "mdl/Palette.h"
 #include "mdl/Quake3Shader.h"
+#include "mdl/SharedResourceCache.h"
 
 #include <filesystem>
 #include <optional>
@@ -50,6 +51,7 @@ class FileSystem;
 
 namespace mdl
 {
+class Quake3ShaderCache;
 struct MaterialConfig;
 
 Result<gl::Material> loadMaterial(
@@ -67,5 +69,25 @@ Result<std::vector<gl::MaterialCollection>> loadMaterialCollections(
   kdl::task_manager& taskManager,
   Logger& logger);
 
+Result<std::vector<gl::MaterialCollection>> loadMaterialCollections(
+  const fs::FileSystem& fs,
+  const MaterialConfig& materialConfig,
+  const gl::CreateTextureResource& createResource,
+  Quake3ShaderCache& shaderCache,
+  kdl::task_manager& taskManager,
+  Logger& logger);
+
+/**
+ * Loads the material collections, passing the path of the texture file of every
+ * material to the given function when creating its texture resource.
+ */
+Result<std::vector<gl::MaterialCollection>> loadMaterialCollections(
+  const fs::FileSystem& fs,
+  const MaterialConfig& materialConfig,
+  const CreateFileResource<gl::Texture>& createResource,
+  Quake3ShaderCache& shaderCache,
+  kdl::task_manager& taskManager,
+  Logger& logger);
+
 } // namespace mdl
 } // namespace tb
@@ -41,6 +41,7 @@ namespace mdl
 {
 struct MaterialConfig;
 class Quake3Shader;
+class Quake3ShaderCache;
 
 Result<std::vector<Quake3Shader>> loadShaders(
   const fs::FileSystem& fs,
@@ -48,5 +49,17 @@ Result<std::vector<Quake3Shader>> loadShaders(
   kdl::task_manager& taskManager,
   Logger& logger);
 
+/**
+ * Loads the shaders like the function above, but only parses the shader scripts that
+ * are not contained in the given cache or whose contents have changed. The newly parsed
+ * scripts are added to the cache.
+ */
+Result<std::vector<Quake3Shader>> loadShaders(
+  const fs::FileSystem& fs,
+  const MaterialConfig& materialConfig,
+  Quake3ShaderCache& cache,
+  kdl::task_manager& taskManager,
+  Logger& logger);
+
 } // namespace mdl
 } // namespace tb
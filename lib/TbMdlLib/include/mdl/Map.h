@@ -71,12 +71,15 @@ class EntityDefinitionManager;
 class EntityLinkManager;
 class EntityModelManager;
 class FaceHandleManager;
+class GameAssetContext;
 class GameFileSystem;
 class Grid;
 class GroupNode;
 class Issue;
 class LayerNode;
+class MaterialIndex;
 class Node;
+class NodeChangeBatcher;
 class NodeIndex;
 class PickResult;
 class PointTrace;
@@ -92,6 +95,7 @@ enum class VisualEffect;
 
 struct EnvironmentConfig;
 struct GameInfo;
+struct NodeChanges;
 struct SelectionChange;
 struct SoftMapBounds;
 
@@ -105,6 +109,7 @@ private:
   const GameInfo& m_gameInfo;
   std::filesystem::path m_gamePath;
   std::unique_ptr<GameFileSystem> m_gameFileSystem;
+  std::shared_ptr<GameAssetContext> m_assetContext;
 
   kdl::task_manager& m_taskManager;
   gl::ResourceManager& m_resourceManager;
@@ -122,6 +127,7 @@ private:
   vm::bbox3d m_worldBounds;
 
   std::unique_ptr<NodeIndex> m_nodeIndex;
+  std::unique_ptr<MaterialIndex> m_materialIndex;
   std::unique_ptr<EntityLinkManager> m_entityLinkManager;
 
   std::unique_ptr<VertexHandleManager> m_vertexHandles;
@@ -140,6 +146,7 @@ private:
   std::unique_ptr<RepeatStack> m_repeatStack;
 
   std::unique_ptr<CommandProcessor> m_commandProcessor;
+  std::unique_ptr<NodeChangeBatcher> m_nodeChangeBatcher;
 
   std::filesystem::path m_path = DefaultDocumentName;
   size_t m_lastSaveModificationCount = 0;
@@ -170,6 +177,14 @@ public: // notification
   Notifier<const std::vector<Node*>&> nodeVisibilityDidChangeNotifier;
   Notifier<const std::vector<Node*>&> nodeLockingDidChangeNotifier;
 
+  /**
+   * Notifies about added and changed nodes and about changes of node visibility and
+   * locking. Within a transaction that the user cannot observe, and during undo and redo,
+   * these notifications are delivered as a single batch when the transaction ends.
+   * Removals are only delivered by the nodesWillBeRemoved and nodesWereRemoved notifiers.
+   */
+  Notifier<const NodeChanges&> nodeChangesNotifier;
+
   Notifier<> groupWasOpenedNotifier;
   Notifier<> groupWasClosedNotifier;
 
@@ -198,6 +213,7 @@ public: // misc
     const vm::bbox3d& worldBounds,
     kdl::task_manager& taskManager,
     gl::ResourceManager& resourceManager,
+    std::shared_ptr<GameAssetContext> assetContext,
     Logger& logger);
 
   Map(
@@ -209,6 +225,7 @@ public: // misc
     std::filesystem::path path,
     kdl::task_manager& taskManager,
     gl::ResourceManager& resourceManager,
+    std::shared_ptr<GameAssetContext> assetContext,
     Logger& logger);
 
   ~Map();
@@ -221,6 +238,7 @@ public: // misc
     const vm::bbox3d& worldBounds,
     kdl::task_manager& taskManager,
     gl::ResourceManager& resourceManager,
+    std::shared_ptr<GameAssetContext> assetContext,
     Logger& logger);
 
   static Result<std::unique_ptr<Map>> loadMap(
@@ -232,6 +250,7 @@ public: // misc
     std::filesystem::path path,
     kdl::task_manager& taskManager,
     gl::ResourceManager& resourceManager,
+    std::shared_ptr<GameAssetContext> assetContext,
     Logger& logger);
 
   Logger& logger();
@@ -292,6 +311,8 @@ public: // misc
                        : std::vector<NodeType*>{};
   }
 
+  const MaterialIndex& materialIndex() const;
+
   const EntityLinkManager& entityLinkManager() const;
 
 public: // game path
@@ -349,6 +370,9 @@ private:
   void updateFaceTagsAfterResourcesWhereProcessed(
     const std::vector<gl::ResourceId>& resourceIds);
 
+  void updateEntityBoundsAfterResourcesWereProcessed(
+    const std::vector<gl::ResourceId>& resourceIds);
+
 private: // validation
   void registerValidators();
 
@@ -411,6 +435,9 @@ public: // command processing
   bool isCommandCollationEnabled() const;
   void setIsCommandCollationEnabled(bool isCommandCollationEnabled);
 
+  std::optional<size_t> undoMemoryLimit() const;
+  void setUndoMemoryLimit(std::optional<size_t> undoMemoryLimit);
+
   using RepeatableCommand = std::function<void()>;
   void pushRepeatableCommand(RepeatableCommand command);
   bool canRepeatCommands() const;
@@ -446,6 +473,7 @@ private: // observers
   void entityDefinitionsDidChange();
   void modsWillChange();
   void modsDidChange();
+  void undoCommandsDiscarded(size_t count, size_t memorySize);
 };
 
 } // namespace mdl
@@ -73,4 +73,12 @@ bool canUpdateLinkedGroups(const std::vector<Node*>& nodes);
 void setHasPendingChanges(
   const std::vector<GroupNode*>& groupNodes, bool hasPendingChanges);
 
+/**
+ * Marks the given group nodes as having pending changes that only affect the contents of
+ * the given changed nodes. Each group node records those changed nodes which are its
+ * descendants, so that only their linked duplicates need to be updated.
+ */
+void addPendingContentChanges(
+  const std::vector<GroupNode*>& groupNodes, const std::vector<Node*>& changedNodes);
+
 } // namespace tb::mdl
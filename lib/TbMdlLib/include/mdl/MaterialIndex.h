@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mdl/BrushFaceHandle.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::mdl
+{
+class BrushNode;
+class Node;
+
+/**
+ * Maps material names to the brush nodes whose faces use them.
+ *
+ * Material names are compared case insensitively. For every material, the index stores
+ * the brush nodes that have at least one face with that material along with the number
+ * of such faces, so queries only touch the matching brushes.
+ *
+ * The index must be kept up to date by removing nodes before they change and adding them
+ * again afterwards.
+ */
+class MaterialIndex
+{
+private:
+  struct Entry
+  {
+    std::unordered_map<BrushNode*, size_t> brushNodes;
+    size_t faceCount = 0;
+  };
+
+  std::unordered_map<std::string, Entry> m_index;
+
+public:
+  void addNode(Node& node);
+  void removeNode(Node& node);
+
+  void clear();
+
+  /**
+   * Returns the brush nodes that have at least one face with the given material.
+   */
+  std::vector<BrushNode*> findBrushNodes(std::string_view materialName) const;
+
+  /**
+   * Returns handles of all brush faces with the given material.
+   */
+  std::vector<BrushFaceHandle> findBrushFaces(std::string_view materialName) const;
+
+  /**
+   * Returns the number of brush faces with the given material.
+   */
+  size_t usageCount(std::string_view materialName) const;
+
+  /**
+   * Returns the names of all materials that are used by at least one brush face. The
+   * names are returned in lower case.
+   */
+  std::vector<std::string> materialNames() const;
+
+private:
+  void addBrushNode(BrushNode& brushNode);
+  void removeBrushNode(BrushNode& brushNode);
+  const Entry* findEntry(std::string_view materialName) const;
+};
+
+} // namespace tb::mdl
@@ -21,12 +21,14 @@
 
 #include "Result.h"
 #include "el/Expression.h"
+#include "el/ExpressionCache.h"
 #include "mdl/ModelSpecification.h"
 
 #include "kd/reflection_decl.h"
 
 #include "vm/vec.h"
 
+#include <memory>
 #include <optional>
 
 namespace tb
@@ -49,6 +51,13 @@ class ModelDefinition
 private:
   el::ExpressionNode m_expression;
 
+  /**
+   * Memoizes the model specifications by the values of the variables read by the model
+   * expression. Shared between copies of this definition.
+   */
+  std::shared_ptr<el::ExpressionCache<Result<ModelSpecification>>>
+    m_modelSpecificationCache;
+
 public:
   ModelDefinition();
   explicit ModelDefinition(const FileLocation& location);
@@ -0,0 +1,85 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Notifier.h"
+#include "mdl/NodeChanges.h"
+
+#include <vector>
+
+namespace tb::mdl
+{
+class Node;
+enum class TransactionScope;
+
+/**
+ * Collects node notifications while a transaction whose intermediate states cannot be
+ * observed by the user is open, and delivers them as a single batch when that
+ * transaction ends. This allows observers such as the map renderer to update every
+ * affected node once per user action instead of once per command.
+ *
+ * While no such transaction is open, every notification is delivered immediately.
+ *
+ * Removed nodes are not batched because they may be deleted once the transaction ends.
+ * Instead, a removed node and its descendants are dropped from the pending changes.
+ * Observers must therefore handle removals via the regular notifications.
+ */
+class NodeChangeBatcher
+{
+private:
+  Notifier<const NodeChanges&>& m_nodeChangesNotifier;
+  std::vector<TransactionScope> m_openTransactions;
+  NodeChanges m_pendingChanges;
+
+public:
+  explicit NodeChangeBatcher(Notifier<const NodeChanges&>& nodeChangesNotifier);
+
+  /**
+   * Indicates whether notifications are currently collected instead of being delivered.
+   */
+  bool isBatching() const;
+
+  /**
+   * Opens a transaction with the given scope. Notifications are collected while any
+   * open transaction has scope TransactionScope::Oneshot.
+   */
+  void startTransaction(TransactionScope scope);
+
+  /**
+   * Closes the innermost open transaction. Delivers the collected notifications if no
+   * more notifications are to be collected.
+   *
+   * Precondition: there is an open transaction
+   */
+  void endTransaction();
+
+public: // notification
+  void nodesWereAdded(const std::vector<Node*>& nodes);
+  void nodesWereRemoved(const std::vector<Node*>& nodes);
+  void nodesDidChange(const std::vector<Node*>& nodes);
+  void nodeVisibilityDidChange(const std::vector<Node*>& nodes);
+  void nodeLockingDidChange(const std::vector<Node*>& nodes);
+
+private:
+  void notify(NodeChanges nodeChanges);
+  void flush();
+};
+
+} // namespace tb::mdl
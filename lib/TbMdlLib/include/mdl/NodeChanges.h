@@ -0,0 +1,49 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "kd/reflection_decl.h"
+
+#include <vector>
+
+namespace tb::mdl
+{
+class Node;
+
+/**
+ * A batch of node notifications, see NodeChangeBatcher.
+ *
+ * Each vector contains a node at most once. Nodes that were added are not contained in
+ * any of the other vectors since their entire state is new anyway.
+ */
+struct NodeChanges
+{
+  std::vector<Node*> addedNodes;
+  std::vector<Node*> changedNodes;
+  std::vector<Node*> visibilityChangedNodes;
+  std::vector<Node*> lockingChangedNodes;
+
+  bool empty() const;
+
+  kdl_reflect_decl(
+    NodeChanges, addedNodes, changedNodes, visibilityChangedNodes, lockingChangedNodes);
+};
+
+} // namespace tb::mdl
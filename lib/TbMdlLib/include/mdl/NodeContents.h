@@ -29,6 +29,7 @@
 
 namespace tb::mdl
 {
+class Node;
 
 class NodeContents
 {
@@ -46,4 +47,12 @@ public:
   std::variant<Layer, Group, Entity, Brush, BezierPatch>& get();
 };
 
+/**
+ * Replaces the contents of the given node with the given contents and returns the
+ * previous contents of the node.
+ *
+ * The type of the given contents must match the type of the node.
+ */
+NodeContents swapNodeContents(Node& node, NodeContents contents);
+
 } // namespace tb::mdl
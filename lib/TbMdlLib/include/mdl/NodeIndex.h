@@ -21,21 +21,122 @@
 
 #include "kd/compact_trie_forward.h"
 
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace tb::mdl
 {
+class BrushNode;
+class EntityNode;
+class EntityNodeBase;
+class GroupNode;
+class LayerNode;
 class Node;
+class PatchNode;
+class WorldNode;
 
-using NodeStringIndex = kdl::compact_trie<Node*>;
+enum class NodeKind
+{
+  World,
+  Layer,
+  Group,
+  Entity,
+  Brush,
+  Patch,
+};
+
+/**
+ * An entry in the node index. The kind of the node is stored along with the node so that
+ * typed queries can filter the results without casting every node.
+ */
+struct NodeIndexEntry
+{
+  Node* node;
+  NodeKind kind;
+
+  bool operator==(const NodeIndexEntry& other) const = default;
+};
+
+} // namespace tb::mdl
+
+template <>
+struct std::hash<tb::mdl::NodeIndexEntry>
+{
+  std::size_t operator()(const tb::mdl::NodeIndexEntry& entry) const noexcept;
+};
 
+namespace tb::mdl
+{
+
+using NodeStringIndex = kdl::compact_trie<NodeIndexEntry>;
+
+namespace detail
+{
+
+template <typename NodeType>
+constexpr bool isNodeKindType()
+{
+  return std::is_same_v<NodeType, WorldNode> || std::is_same_v<NodeType, LayerNode>
+         || std::is_same_v<NodeType, GroupNode> || std::is_same_v<NodeType, EntityNode>
+         || std::is_same_v<NodeType, BrushNode> || std::is_same_v<NodeType, PatchNode>
+         || std::is_same_v<NodeType, EntityNodeBase>;
+}
+
+template <typename NodeType>
+constexpr bool hasNodeKind(const NodeKind kind)
+{
+  if constexpr (std::is_same_v<NodeType, WorldNode>)
+  {
+    return kind == NodeKind::World;
+  }
+  else if constexpr (std::is_same_v<NodeType, LayerNode>)
+  {
+    return kind == NodeKind::Layer;
+  }
+  else if constexpr (std::is_same_v<NodeType, GroupNode>)
+  {
+    return kind == NodeKind::Group;
+  }
+  else if constexpr (std::is_same_v<NodeType, EntityNode>)
+  {
+    return kind == NodeKind::Entity;
+  }
+  else if constexpr (std::is_same_v<NodeType, BrushNode>)
+  {
+    return kind == NodeKind::Brush;
+  }
+  else if constexpr (std::is_same_v<NodeType, PatchNode>)
+  {
+    return kind == NodeKind::Patch;
+  }
+  else
+  {
+    static_assert(std::is_same_v<NodeType, EntityNodeBase>);
+    return kind == NodeKind::World || kind == NodeKind::Entity;
+  }
+}
+
+} // namespace detail
+
+/**
+ * Indexes nodes by the strings they contain, such as entity property keys and values,
+ * group names and material names, and finds them using glob patterns.
+ *
+ * Besides a trie of all strings, the index maintains a trie of the reversed strings.
+ * Patterns without wildcards are answered by looking up the string in the trie directly,
+ * and patterns of the form `*suffix` are answered from the reversed trie. All other
+ * patterns are matched against the trie.
+ */
 class NodeIndex
 {
 private:
   std::unique_ptr<NodeStringIndex> m_index;
+  std::unique_ptr<NodeStringIndex> m_reverseIndex;
 
 public:
   NodeIndex();
@@ -46,6 +147,12 @@ public:
   void addNode(Node& node);
   void removeNode(Node& node);
 
+  /**
+   * Adds the given nodes, but not their children. This is faster than adding the nodes
+   * one by one because the strings are inserted in sorted order.
+   */
+  void addNodes(const std::vector<Node*>& nodes);
+
   void clear();
 
   template <typename NodeType = Node>
@@ -53,14 +160,31 @@ public:
   {
     if constexpr (std::is_same_v<NodeType, Node>)
     {
-      return doFindNodes(pattern);
+      auto result = std::vector<Node*>{};
+      for (const auto& entry : doFindNodes(pattern))
+      {
+        result.push_back(entry.node);
+      }
+      return result;
+    }
+    else if constexpr (detail::isNodeKindType<NodeType>())
+    {
+      auto result = std::vector<NodeType*>{};
+      for (const auto& entry : doFindNodes(pattern))
+      {
+        if (detail::hasNodeKind<NodeType>(entry.kind))
+        {
+          result.push_back(static_cast<NodeType*>(entry.node));
+        }
+      }
+      return result;
     }
     else
     {
       auto result = std::vector<NodeType*>{};
-      for (auto* node : doFindNodes(pattern))
+      for (const auto& entry : doFindNodes(pattern))
       {
-        if (auto* nodeWithType = dynamic_cast<NodeType*>(node))
+        if (auto* nodeWithType = dynamic_cast<NodeType*>(entry.node))
         {
           result.push_back(nodeWithType);
         }
@@ -70,7 +194,10 @@ public:
   }
 
 private:
-  std::vector<Node*> doFindNodes(std::string_view pattern) const;
+  void insert(std::string_view key, const NodeIndexEntry& entry);
+  void remove(std::string_view key, const NodeIndexEntry& entry);
+
+  std::vector<NodeIndexEntry> doFindNodes(std::string_view pattern) const;
 };
 
 } // namespace tb::mdl
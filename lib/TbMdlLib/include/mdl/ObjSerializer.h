@@ -22,13 +22,16 @@
 #include "mdl/ExportOptions.h"
 #include "mdl/NodeSerializer.h"
 
+#include "kd/hash_utils.h"
+
 #include "vm/vec.h"
 
 #include <array>
+#include <functional>
 #include <iosfwd>
-#include <map>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -53,7 +56,22 @@ public:
   class IndexMap
   {
   private:
-    std::map<V, size_t> m_map;
+    struct Hash
+    {
+      size_t operator()(const V& v) const
+      {
+        // std::hash maps 0.0 and -0.0 to the same value, which is consistent with
+        // vm::vec's equality operator
+        auto result = std::hash<typename V::type>{}(v[0]);
+        for (size_t i = 1; i < V::size; ++i)
+        {
+          result = kdl::combine_hash(result, std::hash<typename V::type>{}(v[i]));
+        }
+        return result;
+      }
+    };
+
+    std::unordered_map<V, size_t, Hash> m_map;
     std::vector<V> m_list;
 
   public:
@@ -122,6 +140,13 @@ public:
   friend std::ostream& operator<<(std::ostream& str, const Object& object);
 
 private:
+  struct BrushFaceGeometry
+  {
+    vm::vec3d normal;
+    std::vector<vm::vec3d> positions;
+    std::vector<vm::vec2f> uvCoords;
+  };
+
   std::ostream& m_objStream;
   std::ostream& m_mtlStream;
   std::string m_mtlFilename;
@@ -131,6 +156,9 @@ private:
   IndexMap<vm::vec2f> m_uvCoords;
   IndexMap<vm::vec3d> m_normals;
 
+  // computed in parallel when the file is started, consumed when the brushes are visited
+  std::unordered_map<const BrushNode*, std::vector<BrushFaceGeometry>> m_brushGeometry;
+
   std::optional<BrushObject> m_currentBrush;
   std::vector<Object> m_objects;
 
@@ -154,6 +182,9 @@ private:
   void doBrushFace(const BrushFace& face) override;
 
   void doPatch(const PatchNode& patchNode) override;
+
+  static BrushFaceGeometry computeBrushFaceGeometry(const BrushFace& face);
+  void addBrushFace(const BrushFace& face, const BrushFaceGeometry& geometry);
 };
 
 } // namespace mdl
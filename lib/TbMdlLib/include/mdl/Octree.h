@@ -31,11 +31,13 @@
 #include "vm/scalar.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
 #include <optional>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -362,6 +364,57 @@ private:
       node);
   }
 
+  /**
+   * Builds a node with the given address that contains the given data. The data that
+   * does not fit into a quadrant of the node is stored in the node itself, the remaining
+   * data is distributed among the quadrants. Every quadrant that receives data is built
+   * from the smallest node that contains all of its data, skipping unnecessary inner
+   * nodes like insert_into_node does.
+   */
+  static node build_node(
+    const detail::node_address& address,
+    std::vector<std::pair<detail::node_address, U>> addressed_data)
+  {
+    auto data = std::vector<U>{};
+    auto addressed_data_by_quadrant =
+      std::array<std::vector<std::pair<detail::node_address, U>>, 8>{};
+
+    for (auto& [data_address, d] : addressed_data)
+    {
+      if (const auto quadrant = get_quadrant(address, data_address))
+      {
+        addressed_data_by_quadrant[*quadrant].emplace_back(data_address, std::move(d));
+      }
+      else
+      {
+        data.push_back(std::move(d));
+      }
+    }
+
+    if (std::ranges::all_of(
+          addressed_data_by_quadrant, [](const auto& q) { return q.empty(); }))
+    {
+      return leaf_node{address, std::move(data)};
+    }
+
+    auto result = inner_node{address, std::move(data)};
+    for (size_t quadrant = 0; quadrant < 8; ++quadrant)
+    {
+      auto& quadrant_data = addressed_data_by_quadrant[quadrant];
+      if (!quadrant_data.empty())
+      {
+        auto container_address = quadrant_data.front().first;
+        for (const auto& [data_address, d] : quadrant_data)
+        {
+          container_address = get_container(container_address, data_address);
+        }
+        result.children[quadrant] =
+          build_node(container_address, std::move(quadrant_data));
+      }
+    }
+    return result;
+  }
+
 private:
   std::optional<node> m_root;
   T m_min_size;
@@ -458,6 +511,92 @@ public:
     return true;
   }
 
+  /**
+   * Insert all of the given bounds and data at once.
+   *
+   * If this tree contains fewer data items than are being inserted, the tree is rebuilt
+   * bottom up from the addresses of the existing and the new data. Otherwise, the data is
+   * inserted one by one because rebuilding the tree would be more expensive.
+   *
+   * @param bounds_and_data the bounds and data to insert
+   * @return true if all data was inserted and false if any data was already present
+   */
+  bool bulk_insert(const std::vector<std::pair<vm::bbox<T, 3>, U>>& bounds_and_data)
+  {
+    if (m_node_address_for_data.size() > bounds_and_data.size())
+    {
+      auto all_inserted = true;
+      for (const auto& [bounds, data] : bounds_and_data)
+      {
+        all_inserted = insert(bounds, data) && all_inserted;
+      }
+      return all_inserted;
+    }
+
+    auto addressed_data = std::vector<std::pair<detail::node_address, U>>{};
+    addressed_data.reserve(m_node_address_for_data.size() + bounds_and_data.size());
+    for (const auto& [data, address] : m_node_address_for_data)
+    {
+      addressed_data.emplace_back(address, data);
+    }
+
+    auto all_inserted = true;
+    m_node_address_for_data.reserve(addressed_data.capacity());
+    for (const auto& [bounds, data] : bounds_and_data)
+    {
+      contract_pre(!vm::is_nan(bounds.min) && !vm::is_nan(bounds.max));
+
+      const auto address = detail::get_container(bounds, m_min_size);
+      if (m_node_address_for_data.emplace(data, address).second)
+      {
+        addressed_data.emplace_back(address, data);
+      }
+      else
+      {
+        all_inserted = false;
+      }
+    }
+
+    if (addressed_data.empty())
+    {
+      return all_inserted;
+    }
+
+    // the root is the smallest root address that contains the addresses of all data
+    auto root_address = std::optional<detail::node_address>{};
+    const auto expand_root_address = [&](const detail::node_address& address) {
+      if (!root_address || address.size > root_address->size)
+      {
+        root_address = address;
+      }
+    };
+
+    for (const auto& [address, data] : addressed_data)
+    {
+      if (is_root(address))
+      {
+        expand_root_address(address);
+      }
+    }
+    for (const auto& [address, data] : addressed_data)
+    {
+      if (!is_root(address) && (!root_address || !root_address->contains(address)))
+      {
+        expand_root_address(get_root(address));
+      }
+    }
+
+    m_root = build_node(*root_address, std::move(addressed_data));
+
+    // data that does not fit into a quadrant of the root is stored in the root and
+    // addressed by it, see update_root_address
+    for (const auto& data : get_data(*m_root))
+    {
+      m_node_address_for_data.insert_or_assign(data, *root_address);
+    }
+
+    return all_inserted;
+  }
 
   /**
    * Removes the node with the given data from this tree.
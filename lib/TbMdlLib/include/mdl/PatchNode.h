@@ -73,14 +73,23 @@ std::vector<vm::vec3d> computeGridNormals(
 // public for testing
 PatchGrid makePatchGrid(const BezierPatch& patch, size_t subdivisionsPerSurface);
 
+/**
+ * Returns the smallest number of subdivisions per surface (at most
+ * maxSubdivisionsPerSurface) for which the tessellated grid deviates from the given patch
+ * by no more than a fixed tolerance, both in position and in UV coordinates.
+ */
+size_t computeSubdivisionsPerSurface(
+  const BezierPatch& patch, size_t maxSubdivisionsPerSurface);
+
 class PatchNode : public Node, public Object
 {
 public:
   static const HitType::Type PatchHitType;
+  static constexpr size_t DefaultSubdivisionsPerSurface = 3u;
 
 private:
   BezierPatch m_patch;
-  PatchGrid m_grid;
+  size_t m_renderSubdivisionsPerSurface;
 
 public:
   explicit PatchNode(BezierPatch patch);
@@ -93,7 +102,22 @@ public:
 
   void setMaterial(gl::Material* material);
 
-  const PatchGrid& grid() const;
+  /**
+   * Computes the grid with the default number of subdivisions per surface. This grid is
+   * used for picking.
+   */
+  PatchGrid grid() const;
+
+  /**
+   * Computes the grid with the given number of subdivisions per surface, which must not
+   * exceed DefaultSubdivisionsPerSurface.
+   */
+  PatchGrid grid(size_t subdivisionsPerSurface) const;
+
+  /**
+   * Computes the coarsest grid that approximates the patch closely enough for rendering.
+   */
+  PatchGrid renderGrid() const;
 
 private: // implement Node interface
   const std::string& doGetName() const override;
@@ -28,6 +28,7 @@
 #include "vm/util.h"
 #include "vm/vec.h"
 
+#include <cstddef>
 #include <initializer_list>
 #include <limits>
 #include <optional>
@@ -122,6 +123,13 @@ private:
   explicit Polyhedron_Vertex(const vm::vec<T, 3>& position);
 
 public:
+  /**
+   * Allocates vertices from a kdl::object_pool so that the vertices of a polyhedron are
+   * stored close to each other.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   /**
    * Returns the position of this vertex.
    */
@@ -274,6 +282,13 @@ private:
   explicit Polyhedron_Edge(HalfEdge* first, HalfEdge* second = nullptr);
 
 public:
+  /**
+   * Allocates edges from a kdl::object_pool so that the edges of a polyhedron are
+   * stored close to each other.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   /**
    * Returns the origin of the first half edge.
    */
@@ -595,6 +610,13 @@ private:
   explicit Polyhedron_HalfEdge(Vertex* origin);
 
 public:
+  /**
+   * Allocates half edges from a kdl::object_pool so that the half edges of a polyhedron
+   * are stored close to each other.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   /**
    * Returns the origin vertex of this half edge.
    */
@@ -826,6 +848,13 @@ private:
   explicit Polyhedron_Face(HalfEdgeList&& boundary, const vm::plane<T, 3>& plane);
 
 public:
+  /**
+   * Allocates faces from a kdl::object_pool so that the faces of a polyhedron are
+   * stored close to each other.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   /**
    * Returns the circular list of half edges that make up the boundary of this face.
    */
@@ -1714,14 +1743,47 @@ private: // Convex hull; adding and removing points
    * polyhedron is that the resulting polyhedron is the convex hull of the union of the
    * polyhedron's vertices and the given points.
    *
-   * Duplicates in the given vector are discarded. Furthermore, the remaining points are
-   * sorted in descending order of their distance from the center of their bounding box.
+   * Duplicates in the given vector are discarded. The remaining points are sorted and
+   * added one by one until this polyhedron has a volume. The rest of the points are then
+   * added in the manner of the quickhull algorithm, see addPointsToPolyhedron().
    * Therefore, the result of calling this method is different from the result of
    * repeatedly calling addPoint() for every point in the given vector.
    *
    * @param points the points to add to this polyhedron
    */
   void addPoints(std::vector<vm::vec<T, 3>> points);
+
+public:
+  // public for testing
+  /**
+   * Adds the given points to this polyhedron like addPoints(), but calls addPoint() for
+   * every point in sorted order, even if the point is removed again later.
+   *
+   * The result is the same as the result of addPoints(), except that if coplanar faces
+   * were merged, the boundary of the merged face may start at a different vertex.
+   *
+   * @param points the points to add to this polyhedron
+   */
+  void addPointsIncrementally(std::vector<vm::vec<T, 3>> points);
+
+private:
+  /**
+   * Adds the given points to this polyhedron, which must already have a volume.
+   *
+   * Every point is assigned to the conflict list of one face that it is above of, and
+   * points that are not above any face are discarded. Then the point that is farthest
+   * above its face is added to the polyhedron, and the points in the conflict lists of
+   * the faces that were removed or changed by adding it are assigned to the new faces.
+   * This is repeated until all conflict lists are empty.
+   *
+   * Finally, the boundary of every face added by this function is rotated so that it
+   * starts at its greatest vertex, which is where it would start if the points had been
+   * added in sorted order.
+   *
+   * @param points the points to add
+   * @param planeEpsilon the plane epsilon to use for point status checks
+   */
+  void addPointsToPolyhedron(std::vector<vm::vec<T, 3>> points, T planeEpsilon);
   /**
    * Adds the given point to this polyhedron. The effect of adding the given point to a
    * polyhedron is that the resulting polyhedron is the convex hull of the union of the
@@ -2295,6 +2357,21 @@ public: // Subtraction
    */
   std::vector<Polyhedron> subtract(const Polyhedron& subtrahend) const;
 
+public: // Merging
+  /**
+   * Merges this polyhedron with the given polyhedron if their union is convex. This
+   * polyhedron remains unchanged.
+   *
+   * The union of two convex polyhedra is convex if they touch at a pair of faces lying
+   * on the same plane with opposite normals, and if the vertices of either polyhedron
+   * are behind or on the planes of all other faces of the other polyhedron. This is
+   * used to recombine fragments of a CSG subtraction.
+   *
+   * @param other the polyhedron to merge with this polyhedron
+   * @return the union of both polyhedra or std::nullopt if the union is not convex
+   */
+  std::optional<Polyhedron> merge(const Polyhedron& other) const;
+
 private:
   /* ====================== Implementation in Polyhedron_Queries.h ======================
    */
@@ -22,7 +22,9 @@
 #include "mdl/Polyhedron.h"
 
 #include "kd/contracts.h"
+#include "kd/vector_utils.h"
 
+#include <optional>
 #include <vector>
 
 namespace tb::mdl
@@ -317,6 +319,63 @@ private:
   }
 };
 
+/**
+ * Checks whether the given faces lie on the same plane and have opposite normals.
+ */
+template <typename T, typename FP, typename VP>
+bool opposite(
+  const Polyhedron_Face<T, FP, VP>& lhs, const Polyhedron_Face<T, FP, VP>& rhs)
+{
+  if (T(1) + vm::dot(lhs.normal(), rhs.normal()) >= vm::constants<T>::colinear_epsilon())
+  {
+    return false;
+  }
+
+  for (const auto* halfEdge : rhs.boundary())
+  {
+    if (
+      lhs.pointStatus(
+        halfEdge->origin()->position(), vm::constants<T>::point_status_epsilon())
+      != vm::plane_status::inside)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Checks whether all vertices of the given polyhedron are behind or on the planes of the
+ * faces of the other polyhedron, except for the given face.
+ */
+template <typename T, typename FP, typename VP>
+bool behindFaces(
+  const Polyhedron<T, FP, VP>& polyhedron,
+  const Polyhedron<T, FP, VP>& other,
+  const Polyhedron_Face<T, FP, VP>& excludedFace)
+{
+  for (const auto* face : other.faces())
+  {
+    if (face == &excludedFace)
+    {
+      continue;
+    }
+
+    for (const auto* vertex : polyhedron.vertices())
+    {
+      if (
+        face->pointStatus(vertex->position(), vm::constants<T>::point_status_epsilon())
+        == vm::plane_status::above)
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 } // namespace detail
 
 template <typename T, typename FP, typename VP>
@@ -348,4 +407,29 @@ std::vector<Polyhedron<T, FP, VP>> Polyhedron<T, FP, VP>::subtract(
   return subtract.result();
 }
 
+template <typename T, typename FP, typename VP>
+std::optional<Polyhedron<T, FP, VP>> Polyhedron<T, FP, VP>::merge(
+  const Polyhedron& other) const
+{
+  if (!polyhedron() || !other.polyhedron() || !bounds().intersects(other.bounds()))
+  {
+    return std::nullopt;
+  }
+
+  for (const auto* face : m_faces)
+  {
+    for (const auto* otherFace : other.faces())
+    {
+      if (
+        detail::opposite(*face, *otherFace) && detail::behindFaces(other, *this, *face)
+        && detail::behindFaces(*this, other, *otherFace))
+      {
+        return Polyhedron{kdl::vec_concat(vertexPositions(), other.vertexPositions())};
+      }
+    }
+  }
+
+  return std::nullopt;
+}
+
 } // namespace tb::mdl
@@ -32,6 +32,7 @@
 #include "vm/util.h"
 
 #include <list>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -52,10 +53,156 @@ T computePlaneEpsilon(const std::vector<vm::vec<T, 3>>& points)
     vm::get_max_component(size) / T(10) * vm::constants<T>::point_status_epsilon();
   return std::max(computedEpsilon, defaultEpsilon);
 }
+
+/**
+ * Stores points as separate arrays of coordinates so that the distances of all points to
+ * a plane can be computed in a simple loop over contiguous memory, which the compiler can
+ * vectorize.
+ */
+template <typename T>
+class PointArrays
+{
+private:
+  std::vector<T> m_x;
+  std::vector<T> m_y;
+  std::vector<T> m_z;
+
+public:
+  bool empty() const { return m_x.empty(); }
+
+  size_t size() const { return m_x.size(); }
+
+  vm::vec<T, 3> operator[](const size_t i) const
+  {
+    return vm::vec<T, 3>{m_x[i], m_y[i], m_z[i]};
+  }
+
+  void push_back(const vm::vec<T, 3>& point)
+  {
+    m_x.push_back(point.x());
+    m_y.push_back(point.y());
+    m_z.push_back(point.z());
+  }
+
+  void append(const PointArrays& other)
+  {
+    m_x.insert(m_x.end(), other.m_x.begin(), other.m_x.end());
+    m_y.insert(m_y.end(), other.m_y.begin(), other.m_y.end());
+    m_z.insert(m_z.end(), other.m_z.begin(), other.m_z.end());
+  }
+
+  /**
+   * Computes the signed distances of all points to the given plane.
+   */
+  void distancesTo(const vm::plane<T, 3>& plane, std::vector<T>& distances) const
+  {
+    const auto count = size();
+    const auto nx = plane.normal.x();
+    const auto ny = plane.normal.y();
+    const auto nz = plane.normal.z();
+    const auto d = plane.distance;
+
+    distances.resize(count);
+
+    const auto* x = m_x.data();
+    const auto* y = m_y.data();
+    const auto* z = m_z.data();
+    auto* out = distances.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+      out[i] = nx * x[i] + ny * y[i] + nz * z[i] - d;
+    }
+  }
+};
+
+/**
+ * The points that are above a face of a convex hull under construction.
+ */
+template <typename T>
+struct ConflictList
+{
+  PointArrays<T> points;
+  size_t farthest = 0;
+  T farthestDistance = T(0);
+
+  void push_back(const vm::vec<T, 3>& point, const T distance)
+  {
+    if (points.empty() || distance > farthestDistance)
+    {
+      farthest = points.size();
+      farthestDistance = distance;
+    }
+    points.push_back(point);
+  }
+};
+
+/**
+ * Assigns each of the given points to the conflict list of the first of the given faces
+ * that it is above of. Points which are not above any of the faces are discarded.
+ */
+template <typename T, typename F>
+void assignConflictPoints(
+  PointArrays<T> points,
+  const std::vector<F*>& faces,
+  std::unordered_map<F*, ConflictList<T>>& conflictLists,
+  const T planeEpsilon)
+{
+  auto distances = std::vector<T>{};
+  for (auto* face : faces)
+  {
+    if (points.empty())
+    {
+      break;
+    }
+
+    points.distancesTo(face->plane(), distances);
+
+    auto remainingPoints = PointArrays<T>{};
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      if (distances[i] > planeEpsilon)
+      {
+        conflictLists[face].push_back(points[i], distances[i]);
+      }
+      else
+      {
+        remainingPoints.push_back(points[i]);
+      }
+    }
+    points = std::move(remainingPoints);
+  }
+}
+
 } // namespace detail
 
 template <typename T, typename FP, typename VP>
 void Polyhedron<T, FP, VP>::addPoints(std::vector<vm::vec<T, 3>> points)
+{
+  if (points.empty())
+  {
+    return;
+  }
+
+  points = kdl::vec_sort_and_remove_duplicates(std::move(points));
+  const auto planeEpsilon = detail::computePlaneEpsilon(points);
+
+  // Add the points one by one until this polyhedron has a volume. From then on, the
+  // points can be added using conflict lists.
+  auto it = points.begin();
+  while (it != points.end() && !polyhedron())
+  {
+    addPoint(*it++, planeEpsilon);
+  }
+
+  auto remainingPoints = std::vector<vm::vec<T, 3>>(it, points.end());
+  if (!remainingPoints.empty())
+  {
+    addPointsToPolyhedron(std::move(remainingPoints), planeEpsilon);
+  }
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron<T, FP, VP>::addPointsIncrementally(std::vector<vm::vec<T, 3>> points)
 {
   if (!points.empty())
   {
@@ -69,6 +216,138 @@ void Polyhedron<T, FP, VP>::addPoints(std::vector<vm::vec<T, 3>> points)
   }
 }
 
+template <typename T, typename FP, typename VP>
+void Polyhedron<T, FP, VP>::addPointsToPolyhedron(
+  std::vector<vm::vec<T, 3>> points, const T planeEpsilon)
+{
+  contract_pre(polyhedron());
+
+  using ConflictList = detail::ConflictList<T>;
+  using PointArrays = detail::PointArrays<T>;
+
+  auto conflictLists = std::unordered_map<Face*, ConflictList>{};
+
+  // The faces that exist before any point is added keep their boundaries, see below.
+  auto initialFaces = std::unordered_set<Face*>(m_faces.begin(), m_faces.end());
+
+  auto initialPoints = PointArrays{};
+  for (const auto& point : points)
+  {
+    initialPoints.push_back(point);
+  }
+  detail::assignConflictPoints(
+    std::move(initialPoints),
+    std::vector<Face*>(m_faces.begin(), m_faces.end()),
+    conflictLists,
+    planeEpsilon);
+
+  while (!conflictLists.empty())
+  {
+    // Find the point that is farthest above its face. The faces are searched in order so
+    // that the result does not depend on the iteration order of the conflict lists.
+    auto eyeIt = conflictLists.end();
+    for (auto* face : m_faces)
+    {
+      if (const auto it = conflictLists.find(face);
+          it != conflictLists.end()
+          && (eyeIt == conflictLists.end()
+              || it->second.farthestDistance > eyeIt->second.farthestDistance))
+      {
+        eyeIt = it;
+      }
+    }
+    contract_assert(eyeIt != conflictLists.end());
+
+    // The face is visible from the eye point and will be removed when it is added, so the
+    // other points in its conflict list must be reassigned.
+    auto unassignedPoints = PointArrays{};
+    const auto& eyeConflictList = eyeIt->second;
+    const auto eyePoint = eyeConflictList.points[eyeConflictList.farthest];
+    for (size_t i = 0; i < eyeConflictList.points.size(); ++i)
+    {
+      if (i != eyeConflictList.farthest)
+      {
+        unassignedPoints.push_back(eyeConflictList.points[i]);
+      }
+    }
+    conflictLists.erase(eyeIt);
+
+    auto* vertex = addPoint(eyePoint, planeEpsilon);
+
+    // Forget the removed faces because new faces may reuse their addresses later.
+    const auto faces = std::unordered_set<Face*>(m_faces.begin(), m_faces.end());
+    std::erase_if(initialFaces, [&](auto* face) { return !faces.contains(face); });
+
+    if (vertex)
+    {
+      // Only the faces incident to the new vertex are new or have changed, all other
+      // faces are either unchanged or were removed.
+      auto newFaces = std::vector<Face*>{};
+      auto* firstEdge = vertex->leaving();
+      auto* curEdge = firstEdge;
+      do
+      {
+        newFaces.push_back(curEdge->face());
+        curEdge = curEdge->nextIncident();
+      } while (curEdge != firstEdge);
+
+      for (auto it = conflictLists.begin(); it != conflictLists.end();)
+      {
+        if (!faces.contains(it->first) || vertex->incident(it->first))
+        {
+          unassignedPoints.append(it->second.points);
+          it = conflictLists.erase(it);
+        }
+        else
+        {
+          ++it;
+        }
+      }
+
+      detail::assignConflictPoints(
+        std::move(unassignedPoints), newFaces, conflictLists, planeEpsilon);
+    }
+    else
+    {
+      // The point was not added, but this polyhedron may still have changed, so all
+      // points must be reassigned.
+      for (auto& [face, conflictList] : conflictLists)
+      {
+        unassignedPoints.append(conflictList.points);
+      }
+      conflictLists.clear();
+
+      detail::assignConflictPoints(
+        std::move(unassignedPoints),
+        std::vector<Face*>(m_faces.begin(), m_faces.end()),
+        conflictLists,
+        planeEpsilon);
+    }
+  }
+
+  // The boundary of every face added by addPoint() starts at the added vertex. When the
+  // points are added in sorted order, this is the greatest vertex of the face, so the
+  // boundaries of the new faces are rotated to start there. This keeps the boundaries,
+  // and thereby the points of brush faces created from them, independent of the order in
+  // which the points were added above.
+  for (auto* face : m_faces)
+  {
+    if (!initialFaces.contains(face))
+    {
+      auto& boundary = face->boundary();
+      auto* greatest = boundary.front();
+      for (auto* halfEdge : boundary)
+      {
+        if (greatest->origin()->position() < halfEdge->origin()->position())
+        {
+          greatest = halfEdge;
+        }
+      }
+      boundary.rotate_to_front(greatest);
+    }
+  }
+}
+
 template <typename T, typename FP, typename VP>
 typename Polyhedron<T, FP, VP>::Vertex* Polyhedron<T, FP, VP>::addPoint(
   const vm::vec<T, 3>& position, const T planeEpsilon)
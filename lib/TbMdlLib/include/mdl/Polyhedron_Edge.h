@@ -22,6 +22,7 @@
 #include "mdl/Polyhedron.h"
 
 #include "kd/contracts.h"
+#include "kd/object_pool.h"
 
 #include "vm/distance.h"
 #include "vm/plane.h"
@@ -29,6 +30,8 @@
 #include "vm/segment.h"
 #include "vm/vec.h"
 
+#include <cstddef>
+
 namespace tb::mdl
 {
 
@@ -75,6 +78,20 @@ Polyhedron_Edge<T, FP, VP>::Polyhedron_Edge(HalfEdge* first, HalfEdge* second)
   }
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Edge<T, FP, VP>::operator new(const std::size_t size)
+{
+  contract_pre(size == sizeof(Polyhedron_Edge));
+
+  return kdl::object_pool<Polyhedron_Edge>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Edge<T, FP, VP>::operator delete(void* ptr) noexcept
+{
+  kdl::object_pool<Polyhedron_Edge>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 typename Polyhedron_Edge<T, FP, VP>::Vertex* Polyhedron_Edge<T, FP, VP>::firstVertex()
   const
@@ -23,6 +23,7 @@
 #include "mdl/Polyhedron.h"
 
 #include "kd/contracts.h"
+#include "kd/object_pool.h"
 #include "kd/optional_utils.h"
 
 #include "vm/constants.h"
@@ -33,6 +34,7 @@
 #include "vm/util.h"
 #include "vm/vec.h"
 
+#include <cstddef>
 #include <unordered_set>
 
 namespace tb::mdl
@@ -79,6 +81,20 @@ Polyhedron_Face<T, FP, VP>::Polyhedron_Face(
   countAndSetFace(m_boundary.front(), m_boundary.back(), this);
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Face<T, FP, VP>::operator new(const std::size_t size)
+{
+  contract_pre(size == sizeof(Polyhedron_Face));
+
+  return kdl::object_pool<Polyhedron_Face>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Face<T, FP, VP>::operator delete(void* ptr) noexcept
+{
+  kdl::object_pool<Polyhedron_Face>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 const typename Polyhedron_Face<T, FP, VP>::HalfEdgeList& Polyhedron_Face<T, FP, VP>::
   boundary() const
@@ -22,6 +22,7 @@
 #include "mdl/Polyhedron.h"
 
 #include "kd/contracts.h"
+#include "kd/object_pool.h"
 #include "kd/range_utils.h"
 
 #include "vm/bbox.h"
@@ -273,6 +274,7 @@ public:
     const CopyCallback& callback)
     : m_destination{destination}
   {
+    reserve(originalFaces, originalEdges, originalVertices);
     copyVertices(originalVertices, callback);
     copyFaces(originalFaces, callback);
     copyEdges(originalEdges);
@@ -280,6 +282,26 @@ public:
   }
 
 private:
+  /**
+   * Reserves storage for the copied elements up front. This places the copy's vertices,
+   * half edges, edges and faces in adjacent memory and avoids rehashing the maps.
+   */
+  void reserve(
+    const FaceList& originalFaces,
+    const EdgeList& originalEdges,
+    const VertexList& originalVertices)
+  {
+    const auto halfEdgeCount = 2u * originalEdges.size();
+
+    m_vertexMap.reserve(originalVertices.size());
+    m_halfEdgeMap.reserve(halfEdgeCount);
+
+    kdl::object_pool<Vertex>::reserve(originalVertices.size());
+    kdl::object_pool<HalfEdge>::reserve(halfEdgeCount);
+    kdl::object_pool<Edge>::reserve(originalEdges.size());
+    kdl::object_pool<Face>::reserve(originalFaces.size());
+  }
+
   void copyVertices(const VertexList& originalVertices, const CopyCallback& callback)
   {
     for (const auto* currentVertex : originalVertices)
@@ -23,6 +23,9 @@
 
 #include "kd/contracts.h"
 #include "kd/intrusive_circular_list.h"
+#include "kd/object_pool.h"
+
+#include <cstddef>
 
 namespace tb::mdl
 {
@@ -64,6 +67,20 @@ Polyhedron_Vertex<T, FP, VP>::Polyhedron_Vertex(const vm::vec<T, 3>& position)
 {
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Vertex<T, FP, VP>::operator new(const std::size_t size)
+{
+  contract_pre(size == sizeof(Polyhedron_Vertex));
+
+  return kdl::object_pool<Polyhedron_Vertex>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Vertex<T, FP, VP>::operator delete(void* ptr) noexcept
+{
+  kdl::object_pool<Polyhedron_Vertex>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 const vm::vec<T, 3>& Polyhedron_Vertex<T, FP, VP>::position() const
 {
@@ -0,0 +1,80 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mdl/Quake3Shader.h"
+
+#include "kd/path_hash.h"
+
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::mdl
+{
+
+/**
+ * Caches the shaders parsed from Quake 3 shader scripts so that reloading the shaders
+ * only parses the scripts whose contents have changed.
+ *
+ * The cache is not synchronized. Concurrent calls to find are safe, but insert must not
+ * be called concurrently with any other function.
+ */
+class Quake3ShaderCache
+{
+public:
+  struct Key
+  {
+    std::filesystem::path path;
+    size_t contentSize = 0;
+    size_t contentHash = 0;
+
+    bool operator==(const Key& other) const = default;
+  };
+
+  static Key makeKey(std::filesystem::path path, std::string_view contents);
+
+private:
+  struct Entry
+  {
+    Key key;
+    std::vector<Quake3Shader> shaders;
+  };
+
+  std::unordered_map<std::filesystem::path, Entry, kdl::path_hash> m_entries;
+
+public:
+  /**
+   * Returns the shaders cached for the given key, or nullptr if the script identified by
+   * the key's path has not been cached or if its contents have changed.
+   */
+  const std::vector<Quake3Shader>* find(const Key& key) const;
+
+  /**
+   * Caches the given shaders, replacing any shaders cached for the key's path.
+   */
+  void insert(Key key, std::vector<Quake3Shader> shaders);
+
+  size_t size() const;
+  void clear();
+};
+
+} // namespace tb::mdl
@@ -52,6 +52,12 @@ class Quake3ShaderTokenizer : public Tokenizer<Quake3ShaderToken::Type>
 public:
   explicit Quake3ShaderTokenizer(std::string_view str);
 
+  /**
+   * Discards the remaining tokens of the current entry without creating them. Stops
+   * before a closing brace or after the end of the current line.
+   */
+  void discardRemainderOfEntry();
+
 private:
   Token emitToken() override;
 };
@@ -0,0 +1,169 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "gl/CreateResource.h"
+#include "gl/Resource.h"
+
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <variant>
+#include <vector>
+
+namespace tb
+{
+namespace fs
+{
+class FileSystem;
+}
+
+namespace mdl
+{
+
+/**
+ * Creates a resource for the file at the given path.
+ */
+template <typename T>
+using CreateFileResource = std::function<std::shared_ptr<gl::Resource<T>>(
+  const std::filesystem::path&, gl::ResourceLoader<T>)>;
+
+struct DiskFile
+{
+  std::filesystem::path path;
+  std::filesystem::file_time_type modificationTime;
+};
+
+/**
+ * Returns the file on disk that contains the file at the given path. This is either the
+ * file itself or the image file such as a pak or a wad file that contains it.
+ *
+ * Returns nullopt if the file is not backed by a file on disk.
+ */
+std::optional<DiskFile> findDiskFile(
+  const fs::FileSystem& fs, const std::filesystem::path& path);
+
+/**
+ * Shares the resources loaded from the same files between several documents.
+ *
+ * A resource is identified by the search paths of the game file system it was loaded
+ * from, by its path in that file system and by the file on disk that contains it. It is
+ * validated using the modification time of that file. The cache only keeps weak
+ * references to the resources, so a resource is released once the last document using it
+ * releases it.
+ *
+ * Only resources that are ready are shared. The loaders of the other resources may refer
+ * to the file system of the document that created them, which might be destroyed before
+ * the resource is loaded.
+ *
+ * The cache is not synchronized and must only be used from the main thread.
+ */
+template <typename T>
+class SharedResourceCache
+{
+public:
+  struct Key
+  {
+    std::vector<std::filesystem::path> searchPaths;
+    std::filesystem::path path;
+    std::filesystem::path diskPath;
+
+    auto operator<=>(const Key& other) const = default;
+  };
+
+private:
+  struct Entry
+  {
+    std::filesystem::file_time_type modificationTime;
+    std::weak_ptr<gl::Resource<T>> resource;
+  };
+
+  std::map<Key, Entry> m_entries;
+
+public:
+  /**
+   * Returns the resource cached for the given key if it is ready and if the file it was
+   * loaded from has not been modified since. Otherwise, returns nullptr.
+   */
+  std::shared_ptr<gl::Resource<T>> find(
+    const Key& key, const std::filesystem::file_time_type modificationTime) const
+  {
+    if (const auto it = m_entries.find(key);
+        it != m_entries.end() && it->second.modificationTime == modificationTime)
+    {
+      if (auto resource = it->second.resource.lock();
+          resource && std::holds_alternative<gl::ResourceReady<T>>(resource->state()))
+      {
+        return resource;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * Caches the given resource, replacing any resource cached for the given key.
+   */
+  void insert(
+    Key key,
+    const std::filesystem::file_time_type modificationTime,
+    const std::shared_ptr<gl::Resource<T>>& resource)
+  {
+    m_entries.insert_or_assign(std::move(key), Entry{modificationTime, resource});
+  }
+
+  /**
+   * Returns the resource cached for the file at the given path in the given file system
+   * or creates a new resource using the given loader and caches it.
+   *
+   * Resources for files that are not backed by a file on disk are never cached.
+   */
+  std::shared_ptr<gl::Resource<T>> getOrCreate(
+    const fs::FileSystem& fs,
+    std::vector<std::filesystem::path> searchPaths,
+    const std::filesystem::path& path,
+    gl::ResourceLoader<T> resourceLoader,
+    const gl::CreateResource<T>& createResource)
+  {
+    auto diskFile = findDiskFile(fs, path);
+    if (!diskFile)
+    {
+      return createResource(std::move(resourceLoader));
+    }
+
+    auto key = Key{std::move(searchPaths), path, std::move(diskFile->path)};
+    if (auto resource = find(key, diskFile->modificationTime))
+    {
+      return resource;
+    }
+
+    auto resource = createResource(std::move(resourceLoader));
+    insert(std::move(key), diskFile->modificationTime, resource);
+    return resource;
+  }
+
+  size_t size() const { return m_entries.size(); }
+
+  void clear() { m_entries.clear(); }
+};
+
+} // namespace mdl
+} // namespace tb
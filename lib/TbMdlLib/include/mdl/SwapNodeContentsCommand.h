@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Macros.h"
+#include "mdl/CompactNodeContents.h"
 #include "mdl/NodeContents.h"
 #include "mdl/UpdateLinkedGroupsCommandBase.h"
 
@@ -31,10 +32,14 @@ namespace tb::mdl
 {
 class Node;
 
+/**
+ * Replaces the contents of the given nodes. The replaced contents are stored in a compact
+ * form for undo, see CompactNodeContents.
+ */
 class SwapNodeContentsCommand : public UpdateLinkedGroupsCommandBase
 {
 protected:
-  std::vector<std::pair<Node*, NodeContents>> m_nodes;
+  std::vector<std::pair<Node*, CompactNodeContents>> m_nodes;
 
 public:
   SwapNodeContentsCommand(
@@ -46,6 +51,8 @@ public:
 
   bool doCollateWith(UndoableCommand& command) override;
 
+  size_t doGetMemorySize() const override;
+
   deleteCopyAndMove(SwapNodeContentsCommand);
 };
 
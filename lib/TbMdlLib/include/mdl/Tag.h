@@ -28,9 +28,17 @@
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
-namespace tb::mdl
+namespace tb
+{
+namespace gl
+{
+class Material;
+}
+
+namespace mdl
 {
 class ConstTagVisitor;
 class TagManager;
@@ -270,6 +278,37 @@ public:
   virtual size_t selectOption(const std::vector<std::string>& options) = 0;
 };
 
+/**
+ * Describes which properties of a brush face the result of a tag matcher depends on. The
+ * tag manager uses this to evaluate all smart tags of a brush face at once instead of
+ * visiting the face once per tag matcher.
+ */
+enum class TagMatcherFaceDependency
+{
+  /**
+   * The matcher never matches a brush face.
+   */
+  None,
+  /**
+   * The matcher only depends on the face's material, see TagMatcher::matchesFaceMaterial.
+   */
+  Material,
+  /**
+   * The matcher matches a face if its resolved content flags have any of the bits in
+   * TagMatcher::faceFlags set.
+   */
+  ContentFlags,
+  /**
+   * The matcher matches a face if its resolved surface flags have any of the bits in
+   * TagMatcher::faceFlags set.
+   */
+  SurfaceFlags,
+  /**
+   * The matcher must be evaluated against every face.
+   */
+  Face,
+};
+
 /**
  * Decides whether a taggable object should be tagged with a particular smart tag.
  */
@@ -288,6 +327,30 @@ public:
    */
   virtual bool matches(const Taggable& taggable) const = 0;
 
+  /**
+   * Returns which properties of a brush face this matcher depends on. The default
+   * implementation returns TagMatcherFaceDependency::Face.
+   */
+  virtual TagMatcherFaceDependency faceDependency() const;
+
+  /**
+   * Indicates whether this matcher matches a brush face with the given material name and
+   * material. Only called if faceDependency returns TagMatcherFaceDependency::Material.
+   *
+   * @param materialName the material name of the face
+   * @param material the material of the face, or nullptr if it is not loaded
+   * @return true if this matcher matches a face with the given material
+   */
+  virtual bool matchesFaceMaterial(
+    std::string_view materialName, const gl::Material* material) const;
+
+  /**
+   * Returns the flags to test a brush face's content or surface flags against. Only
+   * called if faceDependency returns TagMatcherFaceDependency::ContentFlags or
+   * TagMatcherFaceDependency::SurfaceFlags.
+   */
+  virtual int faceFlags() const;
+
   /**
    * Modifies the current selection so that this tag matcher would match it.
    *
@@ -367,6 +430,11 @@ public:
    */
   bool matches(const Taggable& taggable) const;
 
+  /**
+   * Returns the matcher of this smart tag.
+   */
+  const TagMatcher& matcher() const;
+
   /**
    * Updates the given tag depending on whether or not the matcher matches against it.
    *
@@ -408,4 +476,6 @@ public:
 
   void appendToStream(std::ostream& str) const override;
 };
-} // namespace tb::mdl
+
+} // namespace mdl
+} // namespace tb
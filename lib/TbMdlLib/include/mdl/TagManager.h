@@ -20,13 +20,19 @@
 #pragma once
 
 #include "mdl/Tag.h"
+#include "mdl/TagType.h"
 
 #include "kd/vector_set.h"
 
+#include <array>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace tb::mdl
 {
+class BrushFace;
 
 /**
  * Manages the tags used in a document and updates smart tags on taggable objects.
@@ -42,8 +48,27 @@ private:
     bool operator()(const std::string& lhs, const std::string& rhs) const;
   };
 
+  using FlagTagMasks = std::array<TagType::Type, sizeof(int) * 8>;
+
   kdl::vector_set<SmartTag, TagCmp> m_smartTags;
 
+  /**
+   * The smart tags compiled for matching brush faces, see TagMatcherFaceDependency.
+   * Material and face tags are stored as indices into m_smartTags. The flag tag masks
+   * contain, for every flag bit, the types of the smart tags whose flags contain that
+   * bit.
+   */
+  TagType::Type m_smartTagMask = TagType::NoType;
+  std::vector<size_t> m_materialTags;
+  std::vector<size_t> m_faceTags;
+  FlagTagMasks m_contentFlagTags = {};
+  FlagTagMasks m_surfaceFlagTags = {};
+
+  /**
+   * The types of the material tags matching each material, see precomputeMaterialTags.
+   */
+  std::unordered_map<const gl::Material*, TagType::Type> m_materialTagMasks;
+
 public:
   /**
    * Returns a vector containing all smart tags registered with this manager.
@@ -113,8 +138,38 @@ public:
    */
   void updateTags(Taggable& taggable) const;
 
+  /**
+   * Update the smart tags of the given brush face. This evaluates tags that only depend
+   * on the face's material using the masks computed by precomputeMaterialTags and tests
+   * content and surface flags against precompiled masks. Since this function does not
+   * modify the tag manager, it can be called for different faces concurrently.
+   *
+   * @param face the face to update
+   */
+  void updateTags(BrushFace& face) const;
+
+  /**
+   * Returns the types of all smart tags matching the given brush face.
+   *
+   * @param face the face to match
+   */
+  TagType::Type matchTags(const BrushFace& face) const;
+
+  /**
+   * Evaluates all smart tags that only depend on a face's material against the given
+   * materials and stores the results. Previously stored results are discarded. Must be
+   * called whenever materials are loaded or unloaded, since the results are keyed by the
+   * material's address.
+   *
+   * @param materials the materials to evaluate
+   */
+  void precomputeMaterialTags(const std::vector<const gl::Material*>& materials);
+
 private:
   size_t freeTagIndex();
+  void compileFaceMatchers();
+  TagType::Type matchMaterialTags(
+    std::string_view materialName, const gl::Material* material) const;
 };
 
 } // namespace tb::mdl
@@ -67,6 +67,9 @@ public:
   explicit MaterialNameTagMatcher(std::string pattern);
   std::unique_ptr<TagMatcher> clone() const override;
   bool matches(const Taggable& taggable) const override;
+  TagMatcherFaceDependency faceDependency() const override;
+  bool matchesFaceMaterial(
+    std::string_view materialName, const gl::Material* material) const override;
   void appendToStream(std::ostream& str) const override;
 
 private:
@@ -84,6 +87,9 @@ public:
   explicit SurfaceParmTagMatcher(kdl::vector_set<std::string> parameters);
   std::unique_ptr<TagMatcher> clone() const override;
   bool matches(const Taggable& taggable) const override;
+  TagMatcherFaceDependency faceDependency() const override;
+  bool matchesFaceMaterial(
+    std::string_view materialName, const gl::Material* material) const override;
   void appendToStream(std::ostream& str) const override;
 
 private:
@@ -115,6 +121,7 @@ protected:
 
 public:
   bool matches(const Taggable& taggable) const override;
+  int faceFlags() const override;
   void enable(TagMatcherCallback& callback, Map& map) const override;
   void disable(TagMatcherCallback& callback, Map& map) const override;
   bool canEnable() const override;
@@ -127,6 +134,7 @@ class ContentFlagsTagMatcher : public FlagsTagMatcher
 public:
   explicit ContentFlagsTagMatcher(int flags);
   std::unique_ptr<TagMatcher> clone() const override;
+  TagMatcherFaceDependency faceDependency() const override;
 };
 
 class SurfaceFlagsTagMatcher : public FlagsTagMatcher
@@ -134,6 +142,7 @@ class SurfaceFlagsTagMatcher : public FlagsTagMatcher
 public:
   explicit SurfaceFlagsTagMatcher(int flags);
   std::unique_ptr<TagMatcher> clone() const override;
+  TagMatcherFaceDependency faceDependency() const override;
 };
 
 class EntityClassNameTagMatcher : public TagMatcher
@@ -151,6 +160,7 @@ public:
 
 public:
   bool matches(const Taggable& taggable) const override;
+  TagMatcherFaceDependency faceDependency() const override;
   void enable(TagMatcherCallback& callback, Map& map) const override;
   void disable(TagMatcherCallback& callback, Map& map) const override;
   bool canEnable() const override;
@@ -22,6 +22,7 @@
 #include "Macros.h"
 #include "mdl/Command.h"
 
+#include <optional>
 #include <string>
 
 namespace tb::mdl
@@ -31,6 +32,7 @@ class UndoableCommand : public Command
 {
 private:
   size_t m_modificationCount;
+  mutable std::optional<size_t> m_memorySize;
 
 protected:
   UndoableCommand(std::string name, bool updateModificationCount);
@@ -45,11 +47,21 @@ public:
 
   virtual bool collateWith(UndoableCommand& command);
 
+  /**
+   * Returns an estimate of the memory in bytes that this command uses to store the
+   * information required to undo and redo it.
+   *
+   * The estimate is cached until the command is executed, undone or collated again.
+   */
+  size_t memorySize() const;
+
 protected:
   virtual bool doPerformUndo(Map& map) = 0;
 
   virtual bool doCollateWith(UndoableCommand& command);
 
+  virtual size_t doGetMemorySize() const;
+
   void setModificationCount(Map& map) const;
   void resetModificationCount(Map& map) const;
 
@@ -31,7 +31,9 @@ class GroupNode;
 class UpdateLinkedGroupsCommand : public UpdateLinkedGroupsCommandBase
 {
 public:
-  explicit UpdateLinkedGroupsCommand(std::vector<GroupNode*> changedLinkedGroups);
+  explicit UpdateLinkedGroupsCommand(
+    std::vector<GroupNode*> changedLinkedGroups,
+    ChangedLinkedNodes changedLinkedNodes = {});
   ~UpdateLinkedGroupsCommand() override;
 
   bool doPerformDo(Map& map) override;
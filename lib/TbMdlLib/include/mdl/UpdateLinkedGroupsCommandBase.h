@@ -38,7 +38,8 @@ protected:
   UpdateLinkedGroupsCommandBase(
     std::string name,
     bool updateModificationCount,
-    std::vector<GroupNode*> changedLinkedGroups = {});
+    std::vector<GroupNode*> changedLinkedGroups = {},
+    ChangedLinkedNodes changedLinkedNodes = {});
 
 public:
   ~UpdateLinkedGroupsCommandBase() override;
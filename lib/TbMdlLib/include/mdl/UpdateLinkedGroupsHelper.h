@@ -20,16 +20,14 @@
 #pragma once
 
 #include "Result.h"
+#include "mdl/LinkedGroupUtils.h"
 
-#include <memory>
-#include <utility>
 #include <variant>
 #include <vector>
 
 namespace tb::mdl
 {
 class GroupNode;
-class Node;
 class Map;
 
 /**
@@ -44,22 +42,25 @@ bool checkLinkedGroupsToUpdate(const std::vector<GroupNode*>& changedLinkedGroup
  * A helper class to add support for updating linked groups to commands.
  *
  * The class is initialized with a vector of group nodes whose changes should be
- * propagated to the members of their respective link sets. When applyLinkedGroupUpdates
- * is first called, a replacement node is created for each linked group that needs to be
- * updated, and these linked groups are replaced with their replacements. Calling
- * applyLinkedGroupUpdates replaces the replacement nodes with their original
- * corresponding groups again, effectively undoing the change.
+ * propagated to the members of their respective link sets, and optionally with the nodes
+ * whose contents have changed in these groups. When applyLinkedGroupUpdates is first
+ * called, the updates for the linked groups are computed and applied. Only the contents of
+ * the linked duplicates of the changed nodes are compared and replaced, or the contents of
+ * all linked nodes if the changed nodes of a group are unknown, unless the structure of a
+ * linked group has changed, in which case all of its children are replaced. Calling
+ * undoLinkedGroupUpdates restores the original contents and children again, effectively
+ * undoing the change.
  */
 class UpdateLinkedGroupsHelper
 {
 private:
   using ChangedLinkedGroups = std::vector<GroupNode*>;
-  using LinkedGroupUpdates =
-    std::vector<std::pair<Node*, std::vector<std::unique_ptr<Node>>>>;
   std::variant<ChangedLinkedGroups, LinkedGroupUpdates> m_state;
+  ChangedLinkedNodes m_changedLinkedNodes;
 
 public:
-  explicit UpdateLinkedGroupsHelper(ChangedLinkedGroups changedLinkedGroups);
+  explicit UpdateLinkedGroupsHelper(
+    ChangedLinkedGroups changedLinkedGroups, ChangedLinkedNodes changedLinkedNodes = {});
   ~UpdateLinkedGroupsHelper();
 
   Result<void> applyLinkedGroupUpdates(Map& map);
@@ -69,9 +70,12 @@ public:
 private:
   Result<void> computeLinkedGroupUpdates(Map& map);
   static Result<LinkedGroupUpdates> computeLinkedGroupUpdates(
-    const ChangedLinkedGroups& changedLinkedGroups, Map& map);
+    const ChangedLinkedGroups& changedLinkedGroups,
+    const ChangedLinkedNodes& changedLinkedNodes,
+    Map& map);
 
-  void doApplyOrUndoLinkedGroupUpdates(Map& map);
+  void doApplyLinkedGroupUpdates(Map& map);
+  void doUndoLinkedGroupUpdates(Map& map);
 };
 
 } // namespace tb::mdl
@@ -19,19 +19,33 @@
 
 #pragma once
 
+#include "Macros.h"
 #include "gl/Camera.h"
 #include "mdl/BrushNode.h"
 #include "mdl/HitType.h"
 #include "mdl/PickResult.h"
 
 #include "kd/contracts.h"
+#include "kd/hash_utils.h"
 #include "kd/map_utils.h"
 #include "kd/ranges/to.h"
 #include "kd/vector_utils.h"
 
+#include "vm/bbox.h"
+#include "vm/intersection.h"
+#include "vm/polygon.h"
+#include "vm/ray.h"
+#include "vm/segment.h"
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <cmath>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <ranges>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace tb
@@ -45,6 +59,14 @@ namespace mdl
 {
 class Grid;
 
+/**
+ * Returns the bounds of the given handle, which are used to place the handle into the
+ * spatial index of its handle manager.
+ */
+vm::bbox3d handleBounds(const vm::vec3d& handle);
+vm::bbox3d handleBounds(const vm::segment3d& handle);
+vm::bbox3d handleBounds(const vm::polygon3d& handle);
+
 class VertexHandleManagerBase
 {
 public:
@@ -105,13 +127,20 @@ public:
 protected:
   /**
    * Represents the status of a handle, i.e., how many duplicates exist at the same
-   * coordinates and whether or not all of these are selected.
+   * coordinates, whether or not all of these are selected, and which brushes the
+   * duplicates belong to.
    */
   struct HandleInfo
   {
     size_t count = 0;
     bool selected = false;
 
+    /**
+     * The brushes whose handles were added at these coordinates. This can contain fewer
+     * than count elements if handles were added without a brush.
+     */
+    std::vector<const BrushNode*> brushNodes;
+
     /**
      * Sets this handle to selected.
      *
@@ -144,10 +173,60 @@ protected:
     void dec() { --count; }
   };
 
+  using HandleMap = std::map<H, HandleInfo>;
+  using HandleEntry = typename HandleMap::value_type;
+
+  /**
+   * The edge length of the cells of the first level of the spatial index. The edge
+   * length doubles with every level.
+   */
+  static constexpr auto CellSize = 64.0;
+
+  /**
+   * A cell of the spatial index. Contains the handles whose bounds are centered in the
+   * cell, and the union of their bounds, which may exceed the cell.
+   */
+  struct HandleCell
+  {
+    vm::bbox3d bounds;
+    std::vector<HandleEntry*> entries;
+  };
+
+  struct CellKeyHash
+  {
+    size_t operator()(const vm::vec3l& key) const
+    {
+      return kdl::hash(key.x(), key.y(), key.z());
+    }
+  };
+
+  /**
+   * A level of the spatial index. A handle is stored in the first level whose cells are
+   * at least as large as the handle's bounds, so no handle extends more than half a cell
+   * beyond the cell that contains it.
+   */
+  struct HandleLevel
+  {
+    double cellSize;
+    std::unordered_map<vm::vec3l, HandleCell, CellKeyHash> cells;
+
+    /**
+     * The union of the bounds of all handles that were added to this level since it was
+     * last empty. This is not shrunk when handles are removed.
+     */
+    vm::bbox3d bounds;
+  };
+
   /**
    * Maps a handle position to its info.
    */
-  std::map<H, HandleInfo> m_handles;
+  HandleMap m_handles;
+
+  /**
+   * Spatial index of the handles in m_handles, used to skip handles that are far away
+   * from a pick ray or from a handle to select.
+   */
+  std::vector<HandleLevel> m_levels;
 
   /**
    * The total number of selected handles, not counting duplicates.
@@ -155,6 +234,7 @@ protected:
   size_t m_selectedHandleCount = 0;
 
 public:
+  VertexHandleManagerBaseT() = default;
   ~VertexHandleManagerBaseT() override = default;
 
 public:
@@ -285,10 +365,19 @@ public:
    *
    * @param handle the handle to add
    */
-  void add(const Handle& handle)
+  void add(const Handle& handle) { insert(handle).inc(); }
+
+  /**
+   * Adds the given handle of the given brush to this manager.
+   *
+   * @param handle the handle to add
+   * @param brushNode the brush that the handle belongs to
+   */
+  void add(const Handle& handle, const BrushNode& brushNode)
   {
-    m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo
-                             // means its default constructor is called
+    auto& info = insert(handle);
+    info.inc();
+    info.brushNodes.push_back(&brushNode);
   }
 
   /**
@@ -298,16 +387,62 @@ public:
    * @return true if the given handle was contained in this manager (and therefore
    * removed) and false otherwise
    */
-  bool remove(const Handle& handle)
+  bool remove(const Handle& handle) { return removeHandle(handle, nullptr); }
+
+  /**
+   * Removes the given handle of the given brush from this manager.
+   *
+   * @param handle the handle to remove
+   * @param brushNode the brush that the handle belongs to
+   * @return true if the given handle was contained in this manager (and therefore
+   * removed) and false otherwise
+   */
+  bool remove(const Handle& handle, const BrushNode& brushNode)
+  {
+    return removeHandle(handle, &brushNode);
+  }
+
+  /**
+   * Removes all handles from this manager.
+   */
+  void clear()
+  {
+    m_levels.clear();
+    m_handles.clear();
+    m_selectedHandleCount = 0;
+  }
+
+private:
+  HandleInfo& insert(const Handle& handle)
+  {
+    const auto [it, inserted] = m_handles.try_emplace(handle);
+    if (inserted)
+    {
+      addToIndex(*it);
+    }
+    return it->second;
+  }
+
+  bool removeHandle(const Handle& handle, const BrushNode* brushNode)
   {
     if (const auto it = m_handles.find(handle); it != m_handles.end())
     {
       auto& info = it->second;
       info.dec();
 
+      if (brushNode)
+      {
+        if (const auto bIt = std::ranges::find(info.brushNodes, brushNode);
+            bIt != info.brushNodes.end())
+        {
+          info.brushNodes.erase(bIt);
+        }
+      }
+
       if (info.count == 0)
       {
         deselect(info);
+        removeFromIndex(*it);
         m_handles.erase(it);
       }
       return true;
@@ -316,15 +451,74 @@ public:
     return false;
   }
 
-  /**
-   * Removes all handles from this manager.
-   */
-  void clear()
+  static vm::vec3l cellKey(const vm::vec3d& position, const double cellSize)
   {
-    m_handles.clear();
-    m_selectedHandleCount = 0;
+    return vm::vec3l{
+      long(std::floor(position.x() / cellSize)),
+      long(std::floor(position.y() / cellSize)),
+      long(std::floor(position.z() / cellSize))};
+  }
+
+  static size_t levelIndex(const vm::bbox3d& bounds)
+  {
+    const auto extent = vm::get_max_component(bounds.size());
+
+    auto index = size_t(0);
+    for (auto cellSize = CellSize; cellSize < extent; cellSize *= 2.0)
+    {
+      ++index;
+    }
+    return index;
+  }
+
+  void addToIndex(HandleEntry& entry)
+  {
+    const auto bounds = handleBounds(entry.first);
+    const auto index = levelIndex(bounds);
+    while (m_levels.size() <= index)
+    {
+      m_levels.push_back(
+        HandleLevel{std::ldexp(CellSize, int(m_levels.size())), {}, bounds});
+    }
+
+    auto& level = m_levels[index];
+    level.bounds = level.cells.empty() ? bounds : vm::merge(level.bounds, bounds);
+
+    auto& cell = level.cells[cellKey(bounds.center(), level.cellSize)];
+    cell.bounds = cell.entries.empty() ? bounds : vm::merge(cell.bounds, bounds);
+    cell.entries.push_back(&entry);
   }
 
+  void removeFromIndex(HandleEntry& entry)
+  {
+    const auto bounds = handleBounds(entry.first);
+    const auto index = levelIndex(bounds);
+    contract_assert(index < m_levels.size());
+
+    auto& level = m_levels[index];
+    const auto it = level.cells.find(cellKey(bounds.center(), level.cellSize));
+    contract_assert(it != level.cells.end());
+
+    auto& cell = it->second;
+    std::erase(cell.entries, &entry);
+
+    if (cell.entries.empty())
+    {
+      level.cells.erase(it);
+    }
+    else
+    {
+      auto builder = vm::bbox3d::builder{};
+      for (const auto* cellEntry : cell.entries)
+      {
+        builder.add(handleBounds(cellEntry->first));
+      }
+      cell.bounds = builder.bounds();
+    }
+  }
+
+public:
+
   /**
    * Selects the given range of handles.
    *
@@ -382,9 +576,9 @@ public:
    */
   void deselectAll()
   {
-    for (auto& [handle, info] : m_handles)
+    for (auto it = m_handles.begin(); it != m_handles.end() && anySelected(); ++it)
     {
-      deselect(info);
+      deselect(it->second);
     }
   }
 
@@ -416,15 +610,43 @@ public:
   }
 
 private:
+  /**
+   * Calls the given function for the info of every handle that is equal to the given
+   * handle up to a small epsilon. The centers of the bounds of such handles are at most
+   * epsilon apart, so only the cells around the given handle's center are searched.
+   * Such handles may have been stored in a neighbouring level, so every level is
+   * searched.
+   */
   template <typename F>
   void forEachCloseHandle(const H& otherHandle, F fun)
   {
     static const auto epsilon = 0.001 * 0.001;
-    for (auto& [handle, info] : m_handles)
+
+    const auto center = handleBounds(otherHandle).center();
+    for (auto& level : m_levels)
     {
-      if (compare(otherHandle, handle, epsilon) == 0)
+      const auto minKey = cellKey(center - vm::vec3d::fill(epsilon), level.cellSize);
+      const auto maxKey = cellKey(center + vm::vec3d::fill(epsilon), level.cellSize);
+
+      for (auto x = minKey.x(); x <= maxKey.x(); ++x)
       {
-        fun(info);
+        for (auto y = minKey.y(); y <= maxKey.y(); ++y)
+        {
+          for (auto z = minKey.z(); z <= maxKey.z(); ++z)
+          {
+            if (const auto it = level.cells.find(vm::vec3l{x, y, z});
+                it != level.cells.end())
+            {
+              for (auto* entry : it->second.entries)
+              {
+                if (compare(otherHandle, entry->first, epsilon) == 0)
+                {
+                  fun(entry->second);
+                }
+              }
+            }
+          }
+        }
       }
     }
   }
@@ -465,6 +687,188 @@ private:
     }
   }
 
+protected:
+  /**
+   * Calls the given function for every handle that the given pick ray might hit.
+   *
+   * Handles are picked by testing the pick ray against spheres around points on the
+   * handles, or in the case of face handles, after intersecting the pick ray with the
+   * handle. The radius of these spheres is twice the handle radius scaled by the
+   * camera's perspective scaling factor at the sphere's center. Since the scaling factor
+   * is an affine function of the position, the radius of any sphere that the pick ray
+   * hits can be bounded by the scaling factor along the pick ray. This is used to walk
+   * the cells of every level along the pick ray and to only visit the cells around
+   * them, which never skips a handle that would be hit.
+   */
+  template <typename F>
+  void forEachHandleNearRay(
+    const vm::ray3d& pickRay,
+    const gl::Camera& camera,
+    const double handleRadius,
+    F fun) const
+  {
+    const auto scaling = [&](const vm::vec3d& position) {
+      return double(camera.perspectiveScalingFactor(vm::vec3f{position}));
+    };
+    const auto pickRadius = [&](const vm::vec3d& position) {
+      return 2.0 * handleRadius * std::abs(scaling(position));
+    };
+
+    // how much the pick radius can grow per unit of distance
+    const auto growth =
+      2.0 * handleRadius
+      * std::abs(
+        scaling(pickRay.origin + vm::vec3d{camera.direction()})
+        - scaling(pickRay.origin));
+
+    for (const auto& level : m_levels)
+    {
+      if (!level.cells.empty())
+      {
+        forEachCellNearRay(level, pickRay, pickRadius, growth, [&](const auto& cell) {
+          for (const auto* entry : cell.entries)
+          {
+            fun(entry->first);
+          }
+        });
+      }
+    }
+  }
+
+private:
+  /**
+   * Calls the given function for every cell of the given level that contains a handle
+   * which might be hit by the given pick ray.
+   *
+   * The pick ray is clipped to the bounds of the level expanded by the largest pick
+   * radius within them, and the cells that the clipped ray passes through are visited
+   * in order. A handle point that is hit within the pick radius r(p) of a point q on
+   * the ray satisfies |p - q| <= r(p) <= r(q) + growth * |p - q|, so it is at most
+   * r(q) / (1 - growth) away from the cell containing q, and the center of its handle is
+   * at most another half cell away. All cells whose keys are within that distance are
+   * therefore searched at every step. If the pick radius grows too quickly for this
+   * bound, every cell of the level is tested.
+   */
+  template <typename R, typename F>
+  static void forEachCellNearRay(
+    const HandleLevel& level,
+    const vm::ray3d& pickRay,
+    const R& pickRadius,
+    const double growth,
+    F fun)
+  {
+    const auto isNearRay = [&](const vm::bbox3d& bounds, const double tolerance) {
+      const auto pickBounds = bounds.expand(tolerance);
+      return pickBounds.contains(pickRay.origin)
+             || vm::intersect_ray_bbox(pickRay, pickBounds);
+    };
+
+    auto maxPickRadius = 0.0;
+    for (const auto& vertex : level.bounds.vertices())
+    {
+      maxPickRadius = std::max(maxPickRadius, pickRadius(vertex));
+    }
+
+    if (growth >= 1.0)
+    {
+      for (const auto& [key, cell] : level.cells)
+      {
+        if (isNearRay(cell.bounds, maxPickRadius))
+        {
+          fun(cell);
+        }
+      }
+      return;
+    }
+
+    // clip the pick ray to the search bounds
+    const auto searchBounds = level.bounds.expand(maxPickRadius);
+    auto tNear = 0.0;
+    auto tFar = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < 3; ++i)
+    {
+      const auto origin = pickRay.origin[i];
+      const auto direction = pickRay.direction[i];
+      if (direction == 0.0)
+      {
+        if (origin < searchBounds.min[i] || origin > searchBounds.max[i])
+        {
+          return;
+        }
+      }
+      else
+      {
+        const auto t1 = (searchBounds.min[i] - origin) / direction;
+        const auto t2 = (searchBounds.max[i] - origin) / direction;
+        tNear = std::max(tNear, std::min(t1, t2));
+        tFar = std::min(tFar, std::max(t1, t2));
+      }
+    }
+
+    if (tNear > tFar)
+    {
+      return;
+    }
+
+    const auto cellSize = level.cellSize;
+    auto key = cellKey(vm::point_at_distance(pickRay, tNear), cellSize);
+    auto step = vm::vec3l{};
+    auto tNext = vm::vec3d::fill(std::numeric_limits<double>::max());
+    auto tDelta = vm::vec3d::fill(std::numeric_limits<double>::max());
+    for (size_t i = 0; i < 3; ++i)
+    {
+      const auto direction = pickRay.direction[i];
+      if (direction != 0.0)
+      {
+        step[i] = direction > 0.0 ? 1 : -1;
+        const auto boundary = double(direction > 0.0 ? key[i] + 1 : key[i]) * cellSize;
+        tNext[i] = (boundary - pickRay.origin[i]) / direction;
+        tDelta[i] = cellSize / std::abs(direction);
+      }
+    }
+
+    auto visitedCells = std::unordered_set<const HandleCell*>{};
+    auto entryRadius = pickRadius(vm::point_at_distance(pickRay, tNear));
+    while (true)
+    {
+      const auto tExit = std::min({tNext.x(), tNext.y(), tNext.z(), tFar});
+      const auto exitRadius = pickRadius(vm::point_at_distance(pickRay, tExit));
+
+      // the pick radius along the ray within the current cell is largest at its ends
+      const auto tolerance = std::max(entryRadius, exitRadius) / (1.0 - growth);
+      const auto reach = long(std::ceil((tolerance + cellSize / 2.0) / cellSize));
+
+      for (auto x = key.x() - reach; x <= key.x() + reach; ++x)
+      {
+        for (auto y = key.y() - reach; y <= key.y() + reach; ++y)
+        {
+          for (auto z = key.z() - reach; z <= key.z() + reach; ++z)
+          {
+            if (const auto it = level.cells.find(vm::vec3l{x, y, z});
+                it != level.cells.end() && !visitedCells.contains(&it->second)
+                && isNearRay(it->second.bounds, tolerance))
+            {
+              visitedCells.insert(&it->second);
+              fun(it->second);
+            }
+          }
+        }
+      }
+
+      if (tExit >= tFar)
+      {
+        break;
+      }
+
+      const auto axis = tNext.x() <= tNext.y() && tNext.x() <= tNext.z() ? size_t(0)
+                        : tNext.y() <= tNext.z()                         ? size_t(1)
+                                                                         : size_t(2);
+      key[axis] += step[axis];
+      tNext[axis] += tDelta[axis];
+      entryRadius = exitRadius;
+    }
+  }
+
 public:
   /**
    * Applies the given picking test to all handles in this manager and adds all hits to
@@ -534,6 +938,11 @@ public:
   /**
    * Finds all brushes in the given range which are incident to the given handle.
    *
+   * If the handle is contained in this manager and all of its duplicates were added
+   * together with their brushes, the incident brushes are known, and the given range
+   * is only checked for containing them. Otherwise, every brush in the given range is
+   * tested for incidence.
+   *
    * @tparam R the type of the given range of brushes
    * @tparam O an output iterator to append the resulting brushes to
    * @param handle the handle
@@ -543,9 +952,21 @@ public:
   template <std::ranges::range R, typename O>
   void findIncidentBrushes(const Handle& handle, const R& brushNodes, O out) const
   {
-    std::ranges::copy_if(brushNodes, out, [&](const auto* brushNode) {
-      return isIncident(handle, *brushNode);
-    });
+    if (const auto it = m_handles.find(handle);
+        it != m_handles.end() && it->second.brushNodes.size() == it->second.count)
+    {
+      const auto& incidentBrushNodes = it->second.brushNodes;
+      std::ranges::copy_if(brushNodes, out, [&](const auto* brushNode) {
+        return std::ranges::find(incidentBrushNodes, brushNode)
+               != incidentBrushNodes.end();
+      });
+    }
+    else
+    {
+      std::ranges::copy_if(brushNodes, out, [&](const auto* brushNode) {
+        return isIncident(handle, *brushNode);
+      });
+    }
   }
 
 private:
@@ -557,6 +978,8 @@ private:
    * @return true if and only if the given brush is incident to the given handle
    */
   virtual bool isIncident(const Handle& handle, const BrushNode& brushNode) const = 0;
+
+  deleteCopyAndMove(VertexHandleManagerBaseT);
 };
 
 /**
@@ -27,6 +27,7 @@
 #include "mdl/Node.h"
 #include "mdl/Octree.h"
 
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -129,6 +130,14 @@ public: // node tree bulk updating
   void enableNodeTreeUpdates();
   void rebuildNodeTree();
 
+  /**
+   * Adds the given children to their parents, which must be this world or one of its
+   * descendants. Instead of inserting every added subtree into the node tree separately,
+   * all added nodes are inserted at once, which allows the node tree to be rebuilt bottom
+   * up if many nodes are added.
+   */
+  void addNodes(const std::map<Node*, std::vector<Node*>>& nodes);
+
 private:
   void invalidateAllIssues();
 
@@ -22,22 +22,19 @@
 #include "Notifier.h"
 #include "mdl/Map.h"
 #include "mdl/Node.h"
+#include "mdl/WorldNode.h"
 
 #include "kd/ranges/to.h"
-#include "kd/vector_utils.h"
 
 namespace tb::mdl
 {
 
 void addNodesAndNotify(const std::map<Node*, std::vector<Node*>>& nodes, Map& map)
 {
-  auto addedNodes = std::vector<Node*>{};
-  for (const auto& [parent, children] : nodes)
-  {
-    parent->addChildren(children);
-    addedNodes = kdl::vec_concat(std::move(addedNodes), children);
-  }
+  map.worldNode().addNodes(nodes);
 
+  const auto addedNodes =
+    nodes | std::views::values | std::views::join | kdl::ranges::to<std::vector>();
   map.nodesWereAddedNotifier(addedNodes);
 }
 
@@ -238,6 +238,31 @@ static std::vector<SurfaceControlPoints> collectAllSurfaceControlPoints(
   return result;
 }
 
+/**
+ * Returns the quadratic Bernstein weights for the parameters 0, 1/n, 2/n, ..., 1.
+ */
+static std::vector<std::array<double, 3u>> computeBernsteinWeights(const size_t n)
+{
+  auto result = std::vector<std::array<double, 3u>>{};
+  result.reserve(n + 1u);
+
+  for (size_t i = 0u; i <= n; ++i)
+  {
+    const auto t = static_cast<double>(i) / static_cast<double>(n);
+    result.push_back({1.0 - 2.0 * t + t * t, 2.0 * (t - t * t), t * t});
+  }
+  return result;
+}
+
+static BezierPatch::Point interpolate(
+  const std::array<double, 3u>& weights,
+  const BezierPatch::Point& p0,
+  const BezierPatch::Point& p1,
+  const BezierPatch::Point& p2)
+{
+  return weights[0] * p0 + weights[1] * p1 + weights[2] * p2;
+}
+
 template <typename O>
 void evaluateSurface(
   const SurfaceControlPoints& surfaceControlPoints,
@@ -323,26 +348,44 @@ std::vector<BezierPatch::Point> BezierPatch::evaluate(
   |    surface row index
   |
   value of v
+
+  The Bernstein weights of a grid point only depend on its position within the sampled
+  surface, so we compute them once for all rows and columns. For each grid row, we first
+  interpolate the control point columns of every surface at v, which leaves a quadratic
+  curve per surface. Then each grid point of the row is obtained by interpolating that
+  curve at u. This way, every grid point costs one curve interpolation instead of four.
   */
 
+  const auto weights = computeBernsteinWeights(quadsPerSurfaceSide);
+
+  auto rowCurves = std::vector<std::array<BezierPatch::Point, 3u>>(surfaceColumnCount());
   for (size_t gridRow = 0u; gridRow < gridPointRowCount; ++gridRow)
   {
     const size_t surfaceRow =
       (gridRow > 0u ? gridRow - 1u : gridRow) / quadsPerSurfaceSide;
-    const double v = static_cast<double>(gridRow - surfaceRow * quadsPerSurfaceSide)
-                     / static_cast<double>(quadsPerSurfaceSide);
+    const auto& wv = weights[gridRow - surfaceRow * quadsPerSurfaceSide];
+
+    for (size_t surfaceCol = 0u; surfaceCol < surfaceColumnCount(); ++surfaceCol)
+    {
+      const auto& surfaceControlPoints =
+        allSurfaceControlPoints[surfaceRow * surfaceColumnCount() + surfaceCol];
+      for (size_t i = 0u; i < 3u; ++i)
+      {
+        rowCurves[surfaceCol][i] = interpolate(
+          wv,
+          surfaceControlPoints[0][i],
+          surfaceControlPoints[1][i],
+          surfaceControlPoints[2][i]);
+      }
+    }
 
     for (size_t gridCol = 0u; gridCol < gridPointColumnCount; ++gridCol)
     {
       const size_t surfaceCol =
         (gridCol > 0u ? gridCol - 1u : gridCol) / quadsPerSurfaceSide;
-      const double u = static_cast<double>(gridCol - surfaceCol * quadsPerSurfaceSide)
-                       / static_cast<double>(quadsPerSurfaceSide);
-
-      const auto& surfaceControlPoints =
-        allSurfaceControlPoints[surfaceRow * surfaceColumnCount() + surfaceCol];
-      auto point = vm::evaluate_quadratic_bezier_surface(surfaceControlPoints, u, v);
-      grid.push_back(std::move(point));
+      const auto& wu = weights[gridCol - surfaceCol * quadsPerSurfaceSide];
+      const auto& curve = rowCurves[surfaceCol];
+      grid.push_back(interpolate(wu, curve[0], curve[1], curve[2]));
     }
   }
 
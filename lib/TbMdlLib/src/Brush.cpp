@@ -53,24 +53,11 @@ namespace tb::mdl
 
 kdl_reflect_impl(Brush);
 
-class Brush::CopyCallback : public BrushGeometry::CopyCallback
-{
-public:
-  void faceWasCopied(
-    const BrushFaceGeometry* original, BrushFaceGeometry* copy) const override
-  {
-    copy->setPayload(original->payload());
-  }
-};
-
 Brush::Brush() {}
 
 Brush::Brush(const Brush& other)
   : m_faces{other.m_faces}
-  , m_geometry{
-      other.m_geometry
-        ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback())
-        : nullptr}
+  , m_geometry{other.m_geometry}
 {
   if (m_geometry)
   {
@@ -157,7 +144,7 @@ Result<void> Brush::updateGeometryFromFaces(const vm::bbox3d& worldBounds)
   }
 
   m_faces = std::move(remainingFaces);
-  m_geometry = std::move(geometry);
+  m_geometry = std::shared_ptr<BrushGeometry>{std::move(geometry)};
 
   // too expensive for contract_post
   assert(checkFaceLinks());
@@ -1152,6 +1139,40 @@ Result<void> Brush::updateFacesFromGeometry(
   return updateGeometryFromFaces(worldBounds);
 }
 
+namespace
+{
+
+/**
+ * Repeatedly merges pairs of fragments whose union is convex until no such pair is left.
+ * Subtracting several brushes one after the other splits the minuend along the planes of
+ * every subtrahend, and many of the resulting fragments can be recombined afterwards.
+ */
+std::vector<BrushGeometry> mergeFragments(std::vector<BrushGeometry> fragments)
+{
+  for (size_t i = 0; i < fragments.size(); ++i)
+  {
+    for (size_t j = i + 1; j < fragments.size();)
+    {
+      if (auto merged = fragments[i].merge(fragments[j]))
+      {
+        fragments[i] = std::move(*merged);
+        fragments.erase(std::next(fragments.begin(), std::ptrdiff_t(j)));
+
+        // the merged fragment may now be mergeable with fragments we have already seen
+        j = i + 1;
+      }
+      else
+      {
+        ++j;
+      }
+    }
+  }
+
+  return fragments;
+}
+
+} // namespace
+
 std::vector<Result<Brush>> Brush::subtract(
   const MapFormat mapFormat,
   const vm::bbox3d& worldBounds,
@@ -1164,8 +1185,14 @@ std::vector<Result<Brush>> Brush::subtract(
   {
     auto nextResults = std::vector<BrushGeometry>{};
 
-    for (const BrushGeometry& fragment : result)
+    for (auto& fragment : result)
     {
+      if (!fragment.bounds().intersects(subtrahend->bounds()))
+      {
+        nextResults.push_back(std::move(fragment));
+        continue;
+      }
+
       auto subFragments = fragment.subtract(*subtrahend->m_geometry);
       nextResults = kdl::vec_concat(std::move(nextResults), std::move(subFragments));
     }
@@ -1173,6 +1200,11 @@ std::vector<Result<Brush>> Brush::subtract(
     result = std::move(nextResults);
   }
 
+  if (subtrahends.size() > 1)
+  {
+    result = mergeFragments(std::move(result));
+  }
+
   return result | std::views::transform([&](const auto& geometry) {
            return createBrush(
              mapFormat, worldBounds, defaultMaterialName, geometry, subtrahends);
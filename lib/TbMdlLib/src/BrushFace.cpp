@@ -25,6 +25,7 @@
 #include "mdl/ParallelUVCoordSystem.h"
 #include "mdl/ParaxialUVCoordSystem.h"
 #include "mdl/Polyhedron.h"
+#include "mdl/TagManager.h"
 #include "mdl/TagMatcher.h"
 #include "mdl/TagVisitor.h"
 #include "mdl/UVCoordSystem.h"
@@ -273,16 +274,17 @@ void BrushFace::copyUVCoordSystemFromFace(
     m_uvCoordSystem->uvCoords(refPoint, attributes, vm::vec2f{1, 1});
 
   m_uvCoordSystem->setNormal(
-    sourceFacePlane.normal, m_boundary.normal, m_attributes, wrapStyle);
+    sourceFacePlane.normal, m_boundary.normal, *m_attributes, wrapStyle);
 
   // Adjust the offset on this face so that the UV coordinates at the refPoint stay
   // the same
   if (!vm::is_zero(seam.direction, vm::Cd::almost_zero()))
   {
     const auto currentCoords =
-      m_uvCoordSystem->uvCoords(refPoint, m_attributes, vm::vec2f::one());
+      m_uvCoordSystem->uvCoords(refPoint, *m_attributes, vm::vec2f::one());
     const auto offsetChange = desriedCoords - currentCoords;
-    m_attributes.setOffset(correct(modOffset(m_attributes.offset() + offsetChange), 4));
+    m_attributes.mutate().setOffset(
+      correct(modOffset(m_attributes->offset() + offsetChange), 4));
   }
 }
 
@@ -389,28 +391,30 @@ bool BrushFace::coplanarWith(const vm::plane3d& plane) const
 
 const BrushFaceAttributes& BrushFace::attributes() const
 {
-  return m_attributes;
+  return *m_attributes;
 }
 
 void BrushFace::setAttributes(const BrushFaceAttributes& attributes)
 {
-  const auto oldRotation = m_attributes.rotation();
-  m_attributes = attributes;
-  m_uvCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+  const auto oldRotation = m_attributes->rotation();
+  m_attributes = kdl::cow_ptr{attributes};
+  m_uvCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes->rotation());
 }
 
 bool BrushFace::setAttributes(const BrushFace& other)
 {
+  auto& attributes = m_attributes.mutate();
+
   auto result = false;
-  result |= m_attributes.setMaterialName(other.attributes().materialName());
-  result |= m_attributes.setXOffset(other.attributes().xOffset());
-  result |= m_attributes.setYOffset(other.attributes().yOffset());
-  result |= m_attributes.setRotation(other.attributes().rotation());
-  result |= m_attributes.setXScale(other.attributes().xScale());
-  result |= m_attributes.setYScale(other.attributes().yScale());
-  result |= m_attributes.setSurfaceContents(other.attributes().surfaceContents());
-  result |= m_attributes.setSurfaceFlags(other.attributes().surfaceFlags());
-  result |= m_attributes.setSurfaceValue(other.attributes().surfaceValue());
+  result |= attributes.setMaterialName(other.attributes().materialName());
+  result |= attributes.setXOffset(other.attributes().xOffset());
+  result |= attributes.setYOffset(other.attributes().yOffset());
+  result |= attributes.setRotation(other.attributes().rotation());
+  result |= attributes.setXScale(other.attributes().xScale());
+  result |= attributes.setYScale(other.attributes().yScale());
+  result |= attributes.setSurfaceContents(other.attributes().surfaceContents());
+  result |= attributes.setSurfaceFlags(other.attributes().surfaceFlags());
+  result |= attributes.setSurfaceValue(other.attributes().surfaceValue());
   return result;
 }
 
@@ -455,29 +459,29 @@ SurfaceData resolveSurfaceData(
 
 int BrushFace::resolvedSurfaceContents() const
 {
-  return resolveSurfaceData(m_attributes, material()).surfaceContents;
+  return resolveSurfaceData(*m_attributes, material()).surfaceContents;
 }
 
 int BrushFace::resolvedSurfaceFlags() const
 {
-  return resolveSurfaceData(m_attributes, material()).surfaceFlags;
+  return resolveSurfaceData(*m_attributes, material()).surfaceFlags;
 }
 
 float BrushFace::resolvedSurfaceValue() const
 {
-  return resolveSurfaceData(m_attributes, material()).surfaceValue;
+  return resolveSurfaceData(*m_attributes, material()).surfaceValue;
 }
 
 std::optional<Color> BrushFace::resolvedColor() const
 {
-  return m_attributes.color();
+  return m_attributes->color();
 }
 
 void BrushFace::resetUVCoordSystemCache()
 {
   if (m_uvCoordSystem)
   {
-    m_uvCoordSystem->resetCache(m_points[0], m_points[1], m_points[2], m_attributes);
+    m_uvCoordSystem->resetCache(m_points[0], m_points[1], m_points[2], *m_attributes);
   }
 }
 
@@ -502,7 +506,7 @@ vm::vec2f BrushFace::textureSize() const
 
 vm::vec2f BrushFace::modOffset(const vm::vec2f& offset) const
 {
-  return m_attributes.modOffset(offset, textureSize());
+  return m_attributes->modOffset(offset, textureSize());
 }
 
 bool BrushFace::setMaterial(gl::Material* material)
@@ -539,32 +543,32 @@ void BrushFace::resetUVAxesToParaxial()
 void BrushFace::convertToParaxial()
 {
   auto [newUVCoordSystem, newAttributes] =
-    m_uvCoordSystem->toParaxial(m_points[0], m_points[1], m_points[2], m_attributes);
+    m_uvCoordSystem->toParaxial(m_points[0], m_points[1], m_points[2], *m_attributes);
 
-  m_attributes = newAttributes;
+  m_attributes = kdl::cow_ptr{std::move(newAttributes)};
   m_uvCoordSystem = std::move(newUVCoordSystem);
 }
 
 void BrushFace::convertToParallel()
 {
   auto [newUVCoordSystem, newAttributes] =
-    m_uvCoordSystem->toParallel(m_points[0], m_points[1], m_points[2], m_attributes);
+    m_uvCoordSystem->toParallel(m_points[0], m_points[1], m_points[2], *m_attributes);
 
-  m_attributes = newAttributes;
+  m_attributes = kdl::cow_ptr{std::move(newAttributes)};
   m_uvCoordSystem = std::move(newUVCoordSystem);
 }
 
 void BrushFace::translateUV(
   const vm::vec3d& up, const vm::vec3d& right, const vm::vec2f& offset)
 {
-  m_uvCoordSystem->translate(m_boundary.normal, up, right, offset, m_attributes);
+  m_uvCoordSystem->translate(m_boundary.normal, up, right, offset, m_attributes.mutate());
 }
 
 void BrushFace::rotateUV(const float angle)
 {
-  const auto oldRotation = m_attributes.rotation();
-  m_uvCoordSystem->rotate(m_boundary.normal, angle, m_attributes);
-  m_uvCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+  const auto oldRotation = m_attributes->rotation();
+  m_uvCoordSystem->rotate(m_boundary.normal, angle, m_attributes.mutate());
+  m_uvCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes->rotation());
 }
 
 void BrushFace::shearUV(const vm::vec2f& factors)
@@ -607,11 +611,11 @@ void BrushFace::flipUV(
 
   if (flipUAxis)
   {
-    m_attributes.setXScale(-m_attributes.xScale());
+    m_attributes.mutate().setXScale(-m_attributes->xScale());
   }
   else
   {
-    m_attributes.setYScale(-m_attributes.yScale());
+    m_attributes.mutate().setYScale(-m_attributes->yScale());
   }
 }
 
@@ -641,7 +645,7 @@ Result<void> BrushFace::transform(const vm::mat4x4d& transform, const bool lockA
              oldBoundary,
              m_boundary,
              transform,
-             m_attributes,
+             m_attributes.mutate(),
              textureSize(),
              lockAlignment,
              invariant);
@@ -676,18 +680,21 @@ Result<void> BrushFace::updatePointsFromVertices()
                // Get the UV coordinates at the refPoint using the old face's attribs
                // and UV coordinage system
                const auto desriedCoords =
-                 m_uvCoordSystem->uvCoords(refPoint, m_attributes, vm::vec2f{1, 1});
+                 m_uvCoordSystem->uvCoords(refPoint, *m_attributes, vm::vec2f{1, 1});
 
                m_uvCoordSystem->setNormal(
-                 oldPlane.normal, m_boundary.normal, m_attributes, WrapStyle::Projection);
+                 oldPlane.normal,
+                 m_boundary.normal,
+                 *m_attributes,
+                 WrapStyle::Projection);
 
                // Adjust the offset on this face so that the UV coordinates at the
                // refPoint stay the same
                const auto currentCoords =
-                 m_uvCoordSystem->uvCoords(refPoint, m_attributes, vm::vec2f{1, 1});
+                 m_uvCoordSystem->uvCoords(refPoint, *m_attributes, vm::vec2f{1, 1});
                const auto offsetChange = desriedCoords - currentCoords;
-               m_attributes.setOffset(
-                 correct(modOffset(m_attributes.offset() + offsetChange), 4));
+               m_attributes.mutate().setOffset(
+                 correct(modOffset(m_attributes->offset() + offsetChange), 4));
              }
            });
 }
@@ -716,7 +723,7 @@ vm::mat4x4d BrushFace::fromUVCoordSystemMatrix(
 
 float BrushFace::measureUVAngle(const vm::vec2f& center, const vm::vec2f& point) const
 {
-  return m_uvCoordSystem->measureAngle(m_attributes.rotation(), center, point);
+  return m_uvCoordSystem->measureAngle(m_attributes->rotation(), center, point);
 }
 
 size_t BrushFace::vertexCount() const
@@ -789,7 +796,7 @@ void BrushFace::deselect()
 
 vm::vec2f BrushFace::uvCoords(const vm::vec3d& point) const
 {
-  return m_uvCoordSystem->uvCoords(point, m_attributes, textureSize());
+  return m_uvCoordSystem->uvCoords(point, *m_attributes, textureSize());
 }
 
 std::optional<double> BrushFace::intersectWithRay(const vm::ray3d& ray) const
@@ -840,6 +847,11 @@ bool BrushFace::isMarked() const
   return m_markedToRenderFace;
 }
 
+void BrushFace::updateTags(TagManager& tagManager)
+{
+  tagManager.updateTags(*this);
+}
+
 void BrushFace::doAcceptTagVisitor(TagVisitor& visitor)
 {
   visitor.visit(*this);
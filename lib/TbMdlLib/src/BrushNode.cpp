@@ -139,8 +139,15 @@ void BrushNode::setFaceMaterial(const size_t faceIndex, gl::Material* material)
   invalidateVertexCache();
 }
 
-static bool containsPatch(const Brush& brush, const PatchGrid& grid)
+static bool containsPatch(const Brush& brush, const PatchNode& patchNode)
 {
+  // the patch lies within its physical bounds, so check them before tessellating it
+  if (!brush.bounds().intersects(patchNode.physicalBounds()))
+  {
+    return false;
+  }
+
+  const auto grid = patchNode.grid();
   if (!brush.bounds().contains(grid.bounds))
   {
     return false;
@@ -165,7 +172,7 @@ bool BrushNode::contains(const Node& node) const
     [&](const GroupNode& group) { return m_brush.contains(group.logicalBounds()); },
     [&](const EntityNode& entity) { return m_brush.contains(entity.logicalBounds()); },
     [&](const BrushNode& brush) { return m_brush.contains(brush.brush()); },
-    [&](const PatchNode& patch) { return containsPatch(m_brush, patch.grid()); }));
+    [&](const PatchNode& patch) { return containsPatch(m_brush, patch); }));
 }
 
 static bool faceIntersectsEdge(
@@ -180,8 +187,14 @@ static bool faceIntersectsEdge(
   return false;
 }
 
-static bool intersectsPatch(const Brush& brush, const PatchGrid& grid)
+static bool intersectsPatch(const Brush& brush, const PatchNode& patchNode)
 {
+  if (!brush.bounds().intersects(patchNode.physicalBounds()))
+  {
+    return false;
+  }
+
+  const auto grid = patchNode.grid();
   if (!brush.bounds().intersects(grid.bounds))
   {
     return false;
@@ -239,7 +252,7 @@ bool BrushNode::intersects(const Node& node) const
     [&](const GroupNode& group) { return m_brush.intersects(group.logicalBounds()); },
     [&](const EntityNode& entity) { return m_brush.intersects(entity.logicalBounds()); },
     [&](const BrushNode& brush) { return m_brush.intersects(brush.brush()); },
-    [&](const PatchNode& patch) { return intersectsPatch(m_brush, patch.grid()); }));
+    [&](const PatchNode& patch) { return intersectsPatch(m_brush, patch); }));
 }
 
 void BrushNode::clearSelectedFaces()
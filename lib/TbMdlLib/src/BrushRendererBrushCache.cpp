@@ -83,7 +83,8 @@ void BrushRendererBrushCache::validateVertexCache(const mdl::BrushNode& brushNod
       // Set the vertex payload to the index, relative to the brush's first vertex being
       // 0. This is used below when building the edge cache. NOTE: we'll overwrite the
       // payload as we visit the same vertex several times while visiting different faces,
-      // this is fine.
+      // this is fine. The geometry may be shared with copies of this brush, but they
+      // would write the same payloads.
       const auto currentIndex = m_cachedVertices.size();
       vertex->setPayload(static_cast<GLuint>(currentIndex));
 
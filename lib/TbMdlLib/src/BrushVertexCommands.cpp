@@ -30,7 +30,7 @@ namespace tb::mdl::detail
 {
 
 std::vector<BrushNode*> collectBrushNodes(
-  const std::vector<std::pair<Node*, NodeContents>>& nodes)
+  const std::vector<std::pair<Node*, CompactNodeContents>>& nodes)
 {
   return nodes | std::views::filter([](const auto& pair) {
            return dynamic_cast<BrushNode*>(pair.first) != nullptr;
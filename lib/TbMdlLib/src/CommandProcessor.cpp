@@ -29,6 +29,7 @@
 #include "kd/vector_utils.h"
 
 #include <algorithm>
+#include <cstddef>
 
 namespace tb::mdl
 {
@@ -77,6 +78,16 @@ public:
       m_commands, [](const auto& command) { return command->isModification(); });
   }
 
+  size_t doGetMemorySize() const override
+  {
+    auto result = UndoableCommand::doGetMemorySize();
+    for (const auto& command : m_commands)
+    {
+      result += command->memorySize();
+    }
+    return result;
+  }
+
 private:
   bool doPerformDo(Map& map) override
   {
@@ -188,6 +199,30 @@ void CommandProcessor::setIsCollationEnabled(const bool isCollationEnabled)
   m_isCollationEnabled = isCollationEnabled;
 }
 
+std::optional<size_t> CommandProcessor::undoMemoryLimit() const
+{
+  return m_undoMemoryLimit;
+}
+
+void CommandProcessor::setUndoMemoryLimit(const std::optional<size_t> undoMemoryLimit)
+{
+  m_undoMemoryLimit = undoMemoryLimit;
+  if (m_transactionStack.empty())
+  {
+    discardUndoCommandsOverLimit();
+  }
+}
+
+size_t CommandProcessor::undoMemorySize() const
+{
+  auto result = size_t(0);
+  for (const auto& command : m_undoStack)
+  {
+    result += command->memorySize();
+  }
+  return result;
+}
+
 bool CommandProcessor::canUndo() const
 {
   return m_transactionStack.empty() && !m_undoStack.empty();
@@ -432,14 +467,45 @@ bool CommandProcessor::pushToUndoStack(
     auto& lastCommand = m_undoStack.back();
     if (lastCommand->collateWith(*command))
     {
+      discardUndoCommandsOverLimit();
       return false;
     }
   }
 
   m_undoStack.push_back(std::move(command));
+  discardUndoCommandsOverLimit();
   return true;
 }
 
+void CommandProcessor::discardUndoCommandsOverLimit()
+{
+  contract_pre(m_transactionStack.empty());
+
+  if (!m_undoMemoryLimit)
+  {
+    return;
+  }
+
+  auto memorySize = undoMemorySize();
+  auto discardCount = size_t(0);
+  auto discardedMemorySize = size_t(0);
+
+  while (memorySize > *m_undoMemoryLimit && discardCount + 1 < m_undoStack.size())
+  {
+    const auto commandMemorySize = m_undoStack[discardCount]->memorySize();
+    memorySize -= commandMemorySize;
+    discardedMemorySize += commandMemorySize;
+    ++discardCount;
+  }
+
+  if (discardCount > 0)
+  {
+    m_undoStack.erase(
+      m_undoStack.begin(), m_undoStack.begin() + std::ptrdiff_t(discardCount));
+    undoCommandsDiscardedNotifier(discardCount, discardedMemorySize);
+  }
+}
+
 std::unique_ptr<UndoableCommand> CommandProcessor::popFromUndoStack()
 {
   contract_pre(m_transactionStack.empty());
@@ -0,0 +1,290 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/CompactNodeContents.h"
+
+#include "mdl/BezierPatch.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushGeometry.h"
+#include "mdl/BrushNode.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/Group.h"
+#include "mdl/Layer.h"
+#include "mdl/Node.h"
+#include "mdl/ParallelUVCoordSystem.h"
+
+#include "kd/contracts.h"
+#include "kd/overload.h"
+#include "kd/result.h"
+
+#include <algorithm>
+#include <string>
+#include <typeinfo>
+
+namespace tb::mdl
+{
+namespace
+{
+
+bool haveSameFacePoints(const Brush& lhs, const Brush& rhs)
+{
+  if (lhs.faceCount() != rhs.faceCount())
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < lhs.faceCount(); ++i)
+  {
+    if (lhs.face(i).points() != rhs.face(i).points())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool haveSameAttributes(const BrushFace& lhs, const BrushFace& rhs)
+{
+  // the UV coordinate systems are compared by their axes only, so also compare their
+  // types in case the brush was converted to another map format
+  return lhs.attributes() == rhs.attributes()
+         && typeid(lhs.uvCoordSystem()) == typeid(rhs.uvCoordSystem())
+         && lhs.uvCoordSystem() == rhs.uvCoordSystem();
+}
+
+void applyFaceChanges(
+  Brush& brush, std::vector<std::pair<size_t, BrushFace>> changedFaces)
+{
+  for (auto& [faceIndex, face] : changedFaces)
+  {
+    auto& brushFace = brush.face(faceIndex);
+    auto* geometry = brushFace.geometry();
+    brushFace = std::move(face);
+    brushFace.setGeometry(geometry);
+  }
+}
+
+size_t memorySize(const std::string& str)
+{
+  return str.capacity();
+}
+
+size_t memorySize(const BrushFace& face)
+{
+  // assume the larger of the two UV coordinate system implementations
+  return sizeof(BrushFace) + sizeof(ParallelUVCoordSystem)
+         + memorySize(face.attributes().materialName());
+}
+
+size_t memorySize(const std::vector<BrushFace>& faces)
+{
+  auto result = size_t(0);
+  for (const auto& face : faces)
+  {
+    result += memorySize(face);
+  }
+  return result;
+}
+
+size_t memorySize(const Brush& brush)
+{
+  return sizeof(Brush) + memorySize(brush.faces()) + sizeof(BrushGeometry)
+         + brush.vertexCount() * sizeof(BrushVertex)
+         + brush.edgeCount() * (sizeof(BrushEdge) + 2 * sizeof(BrushHalfEdge))
+         + brush.faceCount() * sizeof(BrushFaceGeometry);
+}
+
+size_t memorySize(const Entity& entity)
+{
+  auto result = sizeof(Entity);
+  for (const auto& property : entity.properties())
+  {
+    result +=
+      sizeof(EntityProperty) + memorySize(property.key()) + memorySize(property.value());
+  }
+  for (const auto& key : entity.protectedProperties())
+  {
+    result += sizeof(std::string) + memorySize(key);
+  }
+  return result;
+}
+
+size_t memorySize(const NodeContents& contents)
+{
+  return std::visit(
+    kdl::overload(
+      [](const Layer& layer) { return sizeof(Layer) + memorySize(layer.name()); },
+      [](const Group& group) { return sizeof(Group) + memorySize(group.name()); },
+      [](const Entity& entity) { return memorySize(entity); },
+      [](const Brush& brush) { return memorySize(brush); },
+      [](const BezierPatch& patch) {
+        return sizeof(BezierPatch)
+               + patch.controlPoints().size() * sizeof(BezierPatch::Point)
+               + memorySize(patch.materialName());
+      }),
+    contents.get());
+}
+
+} // namespace
+
+CompactNodeContents::CompactNodeContents(
+  std::variant<NodeContents, BrushFaces, BrushFaceChanges> contents)
+  : m_contents{std::move(contents)}
+{
+}
+
+CompactNodeContents::CompactNodeContents(NodeContents contents)
+  : m_contents{std::move(contents)}
+{
+}
+
+CompactNodeContents CompactNodeContents::compact(
+  NodeContents contents, const Node& node)
+{
+  const auto* brushNode = dynamic_cast<const BrushNode*>(&node);
+  auto* brush = std::get_if<Brush>(&contents.get());
+  if (!brushNode || !brush)
+  {
+    return CompactNodeContents{std::move(contents)};
+  }
+
+  const auto& currentBrush = brushNode->brush();
+  if (haveSameFacePoints(*brush, currentBrush))
+  {
+    auto changedFaces = std::vector<std::pair<size_t, BrushFace>>{};
+    for (size_t i = 0; i < brush->faceCount(); ++i)
+    {
+      auto& face = brush->face(i);
+      const auto& currentFace = currentBrush.face(i);
+      if (!haveSameAttributes(face, currentFace))
+      {
+        face.setGeometry(nullptr);
+        changedFaces.emplace_back(i, std::move(face));
+      }
+    }
+    return CompactNodeContents{BrushFaceChanges{std::move(changedFaces)}};
+  }
+
+  auto faces = std::move(brush->faces());
+  for (auto& face : faces)
+  {
+    face.setGeometry(nullptr);
+  }
+  return CompactNodeContents{BrushFaces{std::move(faces)}};
+}
+
+Result<NodeContents> CompactNodeContents::expand(
+  const Node& node, const vm::bbox3d& worldBounds) const
+{
+  return std::visit(
+    kdl::overload(
+      [](const NodeContents& contents) -> Result<NodeContents> { return contents; },
+      [&](const BrushFaces& brushFaces) -> Result<NodeContents> {
+        return Brush::create(worldBounds, brushFaces.faces)
+               | kdl::transform(
+                 [](auto brush) { return NodeContents{std::move(brush)}; });
+      },
+      [&](const BrushFaceChanges& brushFaceChanges) -> Result<NodeContents> {
+        const auto* brushNode = dynamic_cast<const BrushNode*>(&node);
+        contract_assert(brushNode != nullptr);
+
+        auto brush = brushNode->brush();
+        applyFaceChanges(brush, brushFaceChanges.changedFaces);
+        return NodeContents{std::move(brush)};
+      }),
+    m_contents);
+}
+
+void CompactNodeContents::rebase(
+  const CompactNodeContents& intermediateContents, const Node& node)
+{
+  // Only face changes refer to other contents
+  auto* brushFaceChanges = std::get_if<BrushFaceChanges>(&m_contents);
+  if (!brushFaceChanges)
+  {
+    return;
+  }
+
+  auto changedFaces = std::move(brushFaceChanges->changedFaces);
+  std::visit(
+    kdl::overload(
+      [&](const NodeContents& contents) {
+        auto brush = std::get<Brush>(contents.get());
+        applyFaceChanges(brush, std::move(changedFaces));
+        *this = compact(NodeContents{std::move(brush)}, node);
+      },
+      [&](const BrushFaces& brushFaces) {
+        auto faces = brushFaces.faces;
+        for (auto& [faceIndex, face] : changedFaces)
+        {
+          faces[faceIndex] = std::move(face);
+        }
+        m_contents = BrushFaces{std::move(faces)};
+      },
+      [&](const BrushFaceChanges& intermediateFaceChanges) {
+        const auto* brushNode = dynamic_cast<const BrushNode*>(&node);
+        contract_assert(brushNode != nullptr);
+
+        // Our changes take precedence over the intermediate changes to the same faces
+        for (const auto& [faceIndex, face] : intermediateFaceChanges.changedFaces)
+        {
+          if (std::ranges::none_of(changedFaces, [&](const auto& changedFace) {
+                return changedFace.first == faceIndex;
+              }))
+          {
+            changedFaces.emplace_back(faceIndex, face);
+          }
+        }
+
+        const auto& currentBrush = brushNode->brush();
+        std::erase_if(changedFaces, [&](const auto& changedFace) {
+          const auto& [faceIndex, face] = changedFace;
+          return haveSameAttributes(face, currentBrush.face(faceIndex));
+        });
+        m_contents = BrushFaceChanges{std::move(changedFaces)};
+      }),
+    intermediateContents.m_contents);
+}
+
+bool CompactNodeContents::isCompact() const
+{
+  return !std::holds_alternative<NodeContents>(m_contents);
+}
+
+size_t CompactNodeContents::memorySize() const
+{
+  return std::visit(
+    kdl::overload(
+      [](const NodeContents& contents) { return mdl::memorySize(contents); },
+      [](const BrushFaces& brushFaces) {
+        return sizeof(CompactNodeContents) + mdl::memorySize(brushFaces.faces);
+      },
+      [](const BrushFaceChanges& brushFaceChanges) {
+        auto result = sizeof(CompactNodeContents);
+        for (const auto& [faceIndex, face] : brushFaceChanges.changedFaces)
+        {
+          result += sizeof(faceIndex) + mdl::memorySize(face);
+        }
+        return result;
+      }),
+    m_contents);
+}
+
+} // namespace tb::mdl
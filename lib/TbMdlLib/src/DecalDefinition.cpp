@@ -64,17 +64,20 @@ DecalSpecification convertToDecal(
 kdl_reflect_impl(DecalSpecification);
 
 DecalDefinition::DecalDefinition()
-  : m_expression{el::LiteralExpression{el::Value::Undefined}}
+  : DecalDefinition{el::ExpressionNode{el::LiteralExpression{el::Value::Undefined}}}
 {
 }
 
 DecalDefinition::DecalDefinition(const FileLocation& location)
-  : m_expression{el::LiteralExpression{el::Value::Undefined}, location}
+  : DecalDefinition{
+      el::ExpressionNode{el::LiteralExpression{el::Value::Undefined}, location}}
 {
 }
 
 DecalDefinition::DecalDefinition(el::ExpressionNode expression)
   : m_expression{std::move(expression)}
+  , m_decalSpecificationCache{
+      std::make_shared<el::ExpressionCache<Result<DecalSpecification>>>(m_expression)}
 {
 }
 
@@ -85,16 +88,20 @@ void DecalDefinition::append(const DecalDefinition& other)
   auto cases =
     std::vector<el::ExpressionNode>{std::move(m_expression), other.m_expression};
   m_expression = el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location};
+  m_decalSpecificationCache =
+    std::make_shared<el::ExpressionCache<Result<DecalSpecification>>>(m_expression);
 }
 
 Result<DecalSpecification> DecalDefinition::decalSpecification(
   const el::VariableStore& variableStore) const
 {
-  return el::withEvaluationContext(
-    [&](auto& context) {
-      return convertToDecal(context, m_expression.evaluate(context));
-    },
-    variableStore);
+  return m_decalSpecificationCache->get(variableStore, [&]() {
+    return el::withEvaluationContext(
+      [&](auto& context) {
+        return convertToDecal(context, m_expression.evaluate(context));
+      },
+      variableStore);
+  });
 }
 
 Result<DecalSpecification> DecalDefinition::defaultDecalSpecification() const
@@ -29,6 +29,7 @@
 
 #include "kd/contracts.h"
 #include "kd/ranges/to.h"
+#include "kd/reflection_impl.h"
 
 #include <algorithm>
 #include <optional>
@@ -496,6 +497,25 @@ std::vector<EntityDefinitionClassInfo> resolveInheritance(
          | kdl::ranges::to<std::vector>();
 }
 
+kdl_reflect_impl(EntityDefinitionFileContents::Include);
+
+kdl_reflect_impl(EntityDefinitionFileContents);
+
+Result<std::vector<EntityDefinition>> createEntityDefinitions(
+  ParserStatus& status,
+  const std::vector<EntityDefinitionClassInfo>& classInfos,
+  const Color& defaultEntityColor)
+{
+  try
+  {
+    return createDefinitions(status, classInfos, defaultEntityColor);
+  }
+  catch (const ParserException& e)
+  {
+    return Error{e.what()};
+  }
+}
+
 EntityDefinitionParser::EntityDefinitionParser(const Color& defaultEntityColor)
   : m_defaultEntityColor{defaultEntityColor}
 {
@@ -517,4 +537,23 @@ Result<std::vector<EntityDefinition>> EntityDefinitionParser::parseDefinitions(
   }
 }
 
+Result<EntityDefinitionFileContents> EntityDefinitionParser::parseFileContents(
+  ParserStatus& status)
+{
+  try
+  {
+    return doParseFileContents(status);
+  }
+  catch (const ParserException& e)
+  {
+    return Error{e.what()};
+  }
+}
+
+EntityDefinitionFileContents EntityDefinitionParser::doParseFileContents(
+  ParserStatus& status)
+{
+  return {parseClassInfos(status), {}};
+}
+
 } // namespace tb::mdl
@@ -21,72 +21,21 @@
 
 #include "mdl/EntityDefinitionUtils.h"
 #include "mdl/EntityNodeBase.h"
-#include "mdl/NodeIndex.h"
 
+#include "kd/contracts.h"
 #include "kd/hash_utils.h"
 #include "kd/ranges/to.h"
 #include "kd/reflection_impl.h"
+#include "kd/task_manager.h"
 
+#include <algorithm>
+#include <functional>
 #include <ranges>
 
 namespace tb::mdl
 {
 namespace
 {
-const EntityLinkManager::LinkEndsForPropertyKey EmptyLinkEndsForPropertyKey;
-const EntityLinkManager::LinkEnds EmptyLinkEnds;
-
-const auto& getLinks(
-  const EntityLinkManager::LinksForEntityNode& links, const EntityNodeBase& node)
-{
-  const auto iLinkEndsForPropertyKey = links.find(&node);
-  return iLinkEndsForPropertyKey != links.end() ? iLinkEndsForPropertyKey->second
-                                                : EmptyLinkEndsForPropertyKey;
-}
-
-const auto& getLinks(
-  const EntityLinkManager::LinksForEntityNode& links,
-  const EntityNodeBase& node,
-  const std::string& propertyKey)
-{
-  const auto& linksForNode = getLinks(links, node);
-  if (const auto iLinkEnds = linksForNode.find(propertyKey);
-      iLinkEnds != linksForNode.end())
-  {
-    return iLinkEnds->second;
-  }
-  return EmptyLinkEnds;
-}
-
-auto hasMissingLinkEnd(
-  const EntityLinkManager::LinksForEntityNode& links,
-  const EntityNodeBase& node,
-  const std::string& propertyKey)
-{
-  if (const auto iLinkEndsForPropertyKey = links.find(&node);
-      iLinkEndsForPropertyKey != links.end())
-  {
-    const auto& linkEndsForPropertyKey = iLinkEndsForPropertyKey->second;
-    const auto iLinkEnds = linkEndsForPropertyKey.find(propertyKey);
-    return iLinkEnds != linkEndsForPropertyKey.end() && iLinkEnds->second.empty();
-  }
-  return false;
-}
-
-auto getPropertyKeysWithMissingLinkEnd(
-  const EntityLinkManager::LinksForEntityNode& links, const EntityNodeBase& node)
-{
-  if (const auto iLinkEndsForPropertyKey = links.find(&node);
-      iLinkEndsForPropertyKey != links.end())
-  {
-    const auto& linkEndsForPropertyKey = iLinkEndsForPropertyKey->second;
-    return linkEndsForPropertyKey
-           | std::views::filter([](const auto& entry) { return entry.second.empty(); })
-           | std::views::keys | kdl::ranges::to<std::vector>();
-  }
-
-  return std::vector<std::string>{};
-}
 
 auto getLinkSourcePropertyKeys(const EntityNodeBase& sourceNode)
 {
@@ -115,48 +64,83 @@ auto getPropertiesForKeys(const EntityNodeBase& entityNode, R keys)
          | std::views::join;
 }
 
-void removeLinkEnd(
-  EntityLinkManager::LinksForEntityNode& links,
-  const LinkEnd& linkEndToKeep,
-  const LinkEnd& linkEndToRemove)
+struct LinkProperties
+{
+  std::vector<std::pair<std::string, EntityProperty>> sourceProperties;
+  std::vector<std::pair<std::string, EntityProperty>> targetProperties;
+};
+
+auto getLinkProperties(const EntityNodeBase& entityNode)
+{
+  return LinkProperties{
+    getPropertiesForKeys(entityNode, getLinkSourcePropertyKeys(entityNode))
+      | kdl::ranges::to<std::vector>(),
+    getPropertiesForKeys(entityNode, getLinkTargetPropertyKeys(entityNode))
+      | kdl::ranges::to<std::vector>(),
+  };
+}
+
+bool contains(const auto& linkEnds, const auto& linkEnd)
+{
+  return std::ranges::find(linkEnds, linkEnd) != linkEnds.end();
+}
+
+/**
+ * Adds the given property unless the node already has a numbered property with the same
+ * key and value. This keeps the link ends in the value index unique.
+ */
+bool addLinkProperty(
+  auto& linkProperties, const auto propertyKey, const std::string& value)
 {
-  if (auto iLinkEndsForPropertyKey = links.find(linkEndToKeep.node);
-      iLinkEndsForPropertyKey != links.end())
+  if (std::ranges::any_of(linkProperties, [&](const auto& linkProperty) {
+        return linkProperty.propertyKey == propertyKey && linkProperty.value == value;
+      }))
   {
-    auto& linkEndsForPropertyKey = iLinkEndsForPropertyKey->second;
-    if (auto iLinkEnds = linkEndsForPropertyKey.find(linkEndToKeep.propertyKey);
-        iLinkEnds != linkEndsForPropertyKey.end())
-    {
-      auto& linkEnds = iLinkEnds->second;
-      linkEnds.erase(linkEndToRemove);
+    return false;
+  }
 
-      // Don't erase iLinkEnds from linkEndsForPropertyKey even if it becomes empty! The
-      // entry will still be used to find links with missing opposite ends during
-      // validation.
-    }
+  linkProperties.push_back({propertyKey, value});
+  return true;
+}
+
+auto* findAdjacency(auto& adjacencies, const auto propertyKey)
+{
+  const auto iAdjacency = std::ranges::find_if(adjacencies, [&](const auto& adjacency) {
+    return adjacency.propertyKey == propertyKey;
+  });
+  return iAdjacency != adjacencies.end() ? &*iAdjacency : nullptr;
+}
+
+auto& getAdjacency(auto& adjacencies, const auto propertyKey)
+{
+  if (auto* adjacency = findAdjacency(adjacencies, propertyKey))
+  {
+    return *adjacency;
   }
+  return adjacencies.emplace_back(propertyKey);
 }
 
-void removeLinks(
-  EntityLinkManager::LinksForEntityNode& links,
-  EntityLinkManager::LinksForEntityNode& oppositeLinks,
-  const EntityNodeBase& node)
+void removeLinkEnd(auto& adjacencies, const auto propertyKey, const auto& linkEnd)
 {
-  if (auto iLinkEndsForPropertyKey = links.find(&node);
-      iLinkEndsForPropertyKey != links.end())
+  // Don't erase the adjacency even if it becomes empty! It will still be used to find
+  // links with missing opposite ends during validation.
+  if (auto* adjacency = findAdjacency(adjacencies, propertyKey))
   {
-    auto& linkEndsForPropertyKey = iLinkEndsForPropertyKey->second;
-    std::ranges::for_each(
-      linkEndsForPropertyKey, [&](const auto& propertyKeyAndLinkEnds) {
-        const auto& [propertyKey, oppositeLinkEnds] = propertyKeyAndLinkEnds;
-
-        const auto linkEnd = LinkEnd{&node, propertyKey};
-        std::ranges::for_each(oppositeLinkEnds, [&](const auto& oppositeLinkEnd) {
-          removeLinkEnd(oppositeLinks, oppositeLinkEnd, linkEnd);
-        });
-      });
+    std::erase(adjacency->linkEnds, linkEnd);
+  }
+}
 
-    links.erase(iLinkEndsForPropertyKey);
+void removeFromValueIndex(auto& linkEndsByValue, const auto& value, const auto& linkEnd)
+{
+  if (const auto iLinkEnds = linkEndsByValue.find(value);
+      iLinkEnds != linkEndsByValue.end())
+  {
+    auto& linkEnds = iLinkEnds->second;
+    std::erase(linkEnds, linkEnd);
+    if (linkEnds.empty())
+    {
+      linkEndsByValue.erase(iLinkEnds);
+    }
   }
 }
 
@@ -164,33 +148,72 @@ void removeLinks(
 
 kdl_reflect_impl(LinkEnd);
 
-EntityLinkManager::EntityLinkManager(const NodeIndex& nodeIndex)
-  : m_nodeIndex{nodeIndex}
-{
-}
-
-const EntityLinkManager::LinkEndsForPropertyKey& EntityLinkManager::linksFrom(
+EntityLinkManager::LinkEndsForPropertyKey EntityLinkManager::linksFrom(
   const EntityNodeBase& sourceNode) const
 {
-  return getLinks(m_linkSources, sourceNode);
+  const auto* nodeLinks = findNodeLinks(sourceNode);
+  return nodeLinks ? expandLinks(nodeLinks->linksFrom) : LinkEndsForPropertyKey{};
 }
 
-const EntityLinkManager::LinkEnds& EntityLinkManager::linksFrom(
+EntityLinkManager::LinkEnds EntityLinkManager::linksFrom(
   const EntityNodeBase& sourceNode, const std::string& sourcePropertyKey) const
 {
-  return getLinks(m_linkSources, sourceNode, sourcePropertyKey);
+  const auto* nodeLinks = findNodeLinks(sourceNode);
+  const auto* propertyKeyId = findPropertyKeyId(sourcePropertyKey);
+  if (nodeLinks && propertyKeyId)
+  {
+    if (const auto* adjacency = findAdjacency(nodeLinks->linksFrom, *propertyKeyId))
+    {
+      return expandLinkEnds(adjacency->linkEnds);
+    }
+  }
+  return LinkEnds{};
 }
 
-const EntityLinkManager::LinkEndsForPropertyKey& EntityLinkManager::linksTo(
+EntityLinkManager::LinkEndsForPropertyKey EntityLinkManager::linksTo(
   const EntityNodeBase& targetNode) const
 {
-  return getLinks(m_linkTargets, targetNode);
+  const auto* nodeLinks = findNodeLinks(targetNode);
+  return nodeLinks ? expandLinks(nodeLinks->linksTo) : LinkEndsForPropertyKey{};
 }
 
-const EntityLinkManager::LinkEnds& EntityLinkManager::linksTo(
+EntityLinkManager::LinkEnds EntityLinkManager::linksTo(
   const EntityNodeBase& targetNode, const std::string& targetPropertyKey) const
 {
-  return getLinks(m_linkTargets, targetNode, targetPropertyKey);
+  const auto* nodeLinks = findNodeLinks(targetNode);
+  const auto* propertyKeyId = findPropertyKeyId(targetPropertyKey);
+  if (nodeLinks && propertyKeyId)
+  {
+    if (const auto* adjacency = findAdjacency(nodeLinks->linksTo, *propertyKeyId))
+    {
+      return expandLinkEnds(adjacency->linkEnds);
+    }
+  }
+  return LinkEnds{};
+}
+
+std::vector<const EntityNodeBase*> EntityLinkManager::linkTargetNodes(
+  const EntityNodeBase& sourceNode) const
+{
+  if (const auto* nodeLinks = findNodeLinks(sourceNode))
+  {
+    return nodeLinks->linksFrom | std::views::transform(&Adjacency::linkEnds)
+           | std::views::join | std::views::transform(&CompactLinkEnd::node)
+           | kdl::ranges::to<std::vector>();
+  }
+  return {};
+}
+
+std::vector<const EntityNodeBase*> EntityLinkManager::linkSourceNodes(
+  const EntityNodeBase& targetNode) const
+{
+  if (const auto* nodeLinks = findNodeLinks(targetNode))
+  {
+    return nodeLinks->linksTo | std::views::transform(&Adjacency::linkEnds)
+           | std::views::join | std::views::transform(&CompactLinkEnd::node)
+           | kdl::ranges::to<std::vector>();
+  }
+  return {};
 }
 
 bool EntityLinkManager::hasLink(
@@ -198,9 +221,18 @@ bool EntityLinkManager::hasLink(
   const EntityNodeBase& targetNode,
   const std::string& sourcePropertyKey) const
 {
-  return std::ranges::any_of(
-    linksFrom(sourceNode, sourcePropertyKey),
-    [&](const auto& linkEnd) { return linkEnd.node == &targetNode; });
+  const auto* nodeLinks = findNodeLinks(sourceNode);
+  const auto* propertyKeyId = findPropertyKeyId(sourcePropertyKey);
+  if (nodeLinks && propertyKeyId)
+  {
+    if (const auto* adjacency = findAdjacency(nodeLinks->linksFrom, *propertyKeyId))
+    {
+      return std::ranges::any_of(adjacency->linkEnds, [&](const auto& linkEnd) {
+        return linkEnd.node == &targetNode;
+      });
+    }
+  }
+  return false;
 }
 
 bool EntityLinkManager::hasLink(
@@ -209,118 +241,354 @@ bool EntityLinkManager::hasLink(
   const std::string& sourcePropertyKey,
   const std::string& targetPropertyKey) const
 {
-  return linksFrom(sourceNode, sourcePropertyKey)
-    .contains(LinkEnd{&targetNode, targetPropertyKey});
+  const auto* nodeLinks = findNodeLinks(sourceNode);
+  const auto* sourcePropertyKeyId = findPropertyKeyId(sourcePropertyKey);
+  const auto* targetPropertyKeyId = findPropertyKeyId(targetPropertyKey);
+  if (nodeLinks && sourcePropertyKeyId && targetPropertyKeyId)
+  {
+    if (const auto* adjacency = findAdjacency(nodeLinks->linksFrom, *sourcePropertyKeyId))
+    {
+      return contains(
+        adjacency->linkEnds, CompactLinkEnd{&targetNode, *targetPropertyKeyId});
+    }
+  }
+  return false;
 }
 
 bool EntityLinkManager::hasMissingTarget(
   const EntityNodeBase& sourceNode, const std::string& sourcePropertyKey) const
 {
-  return hasMissingLinkEnd(m_linkSources, sourceNode, sourcePropertyKey);
+  const auto* nodeLinks = findNodeLinks(sourceNode);
+  const auto* propertyKeyId = findPropertyKeyId(sourcePropertyKey);
+  if (nodeLinks && propertyKeyId)
+  {
+    const auto* adjacency = findAdjacency(nodeLinks->linksFrom, *propertyKeyId);
+    return adjacency && adjacency->linkEnds.empty();
+  }
+  return false;
 }
 
-std::vector<std::string> EntityLinkManager::getSourcePropertyKeysWithMissingTarget(
-  const EntityNodeBase& sourceNode) const
+bool EntityLinkManager::hasMissingSource(
+  const EntityNodeBase& targetNode, const std::string& targetPropertyKey) const
 {
-  return getPropertyKeysWithMissingLinkEnd(m_linkSources, sourceNode);
+  const auto* nodeLinks = findNodeLinks(targetNode);
+  const auto* propertyKeyId = findPropertyKeyId(targetPropertyKey);
+  if (nodeLinks && propertyKeyId)
+  {
+    const auto* adjacency = findAdjacency(nodeLinks->linksTo, *propertyKeyId);
+    return adjacency && adjacency->linkEnds.empty();
+  }
+  return false;
 }
 
-bool EntityLinkManager::hasMissingSource(
-  const EntityNodeBase& targetNode, const std::string& targetPropertyKey) const
+std::vector<std::string> EntityLinkManager::getSourcePropertyKeysWithMissingTarget(
+  const EntityNodeBase& sourceNode) const
 {
-  return hasMissingLinkEnd(m_linkTargets, targetNode, targetPropertyKey);
+  const auto* nodeLinks = findNodeLinks(sourceNode);
+  return nodeLinks ? getPropertyKeysWithMissingLinkEnd(nodeLinks->linksFrom)
+                   : std::vector<std::string>{};
 }
 
 std::vector<std::string> EntityLinkManager::getTargetPropertyKeysWithMissingSource(
   const EntityNodeBase& targetNode) const
 {
-  return getPropertyKeysWithMissingLinkEnd(m_linkTargets, targetNode);
+  const auto* nodeLinks = findNodeLinks(targetNode);
+  return nodeLinks ? getPropertyKeysWithMissingLinkEnd(nodeLinks->linksTo)
+                   : std::vector<std::string>{};
 }
 
 void EntityLinkManager::addEntityNode(EntityNodeBase& entityNode)
 {
-  addLinksFrom(entityNode);
-  addLinksTo(entityNode);
-}
-
-void EntityLinkManager::removeEntityNode(EntityNodeBase& entityNode)
-{
-  removeLinksFrom(entityNode);
-  removeLinksTo(entityNode);
-}
+  removeEntityNode(entityNode);
 
-void EntityLinkManager::clear()
-{
-  m_linkSources.clear();
-  m_linkTargets.clear();
-}
+  const auto [sourceProperties, targetProperties] = getLinkProperties(entityNode);
+  if (sourceProperties.empty() && targetProperties.empty())
+  {
+    return;
+  }
 
-void EntityLinkManager::addLinksFrom(EntityNodeBase& sourceNode)
-{
-  for (const auto& [sourcePropertyKey, sourceProperty] :
-       getPropertiesForKeys(sourceNode, getLinkSourcePropertyKeys(sourceNode)))
+  // We create an adjacency for every link property even if there are no opposite link
+  // ends yet. This way, we can detect missing link ends during validation.
+  auto& nodeLinks = m_nodeLinks[&entityNode];
+  for (const auto& [sourcePropertyKey, sourceProperty] : sourceProperties)
   {
-    const auto& sourcePropertyValue = sourceProperty.value();
+    const auto propertyKey = internPropertyKey(sourcePropertyKey);
+    const auto& value = sourceProperty.value();
+    getAdjacency(nodeLinks.linksFrom, propertyKey);
+
+    if (addLinkProperty(nodeLinks.sourceProperties, propertyKey, value))
+    {
+      const auto sourceLinkEnd = CompactLinkEnd{&entityNode, propertyKey};
+      m_linkSourcesByValue[value].push_back(sourceLinkEnd);
+
+      if (const auto iLinkTargets = m_linkTargetsByValue.find(value);
+          iLinkTargets != m_linkTargetsByValue.end())
+      {
+        for (const auto& targetLinkEnd : iLinkTargets->second)
+        {
+          addLink(sourceLinkEnd, targetLinkEnd);
+        }
+      }
+    }
+  }
 
-    // The node has some source property. We create an entry for the node and the property
-    // even if we don't know if there are any target nodes. This way, we can detect link
-    // sources with missing targets during validation.
-    auto& linkTargetsForKey = m_linkSources[&sourceNode][sourcePropertyKey];
+  for (const auto& [targetPropertyKey, targetProperty] : targetProperties)
+  {
+    const auto propertyKey = internPropertyKey(targetPropertyKey);
+    const auto& value = targetProperty.value();
+    getAdjacency(nodeLinks.linksTo, propertyKey);
 
-    for (const auto* targetNode : m_nodeIndex.findNodes<EntityNodeBase>(
-           NodeIndex::escapePattern(sourcePropertyValue)))
+    if (addLinkProperty(nodeLinks.targetProperties, propertyKey, value))
     {
-      for (const auto& targetPropertyKey : getLinkTargetPropertyKeys(*targetNode))
+      const auto targetLinkEnd = CompactLinkEnd{&entityNode, propertyKey};
+      m_linkTargetsByValue[value].push_back(targetLinkEnd);
+
+      if (const auto iLinkSources = m_linkSourcesByValue.find(value);
+          iLinkSources != m_linkSourcesByValue.end())
       {
-        const auto& targetEntity = targetNode->entity();
-        if (targetEntity.hasProperty(targetPropertyKey, sourcePropertyValue))
+        for (const auto& sourceLinkEnd : iLinkSources->second)
         {
-          linkTargetsForKey.emplace(LinkEnd{targetNode, targetPropertyKey});
-          m_linkTargets[targetNode][targetPropertyKey].emplace(
-            LinkEnd{&sourceNode, sourcePropertyKey});
+          addLink(sourceLinkEnd, targetLinkEnd);
         }
       }
     }
   }
 }
 
-void EntityLinkManager::addLinksTo(EntityNodeBase& targetNode)
+void EntityLinkManager::removeEntityNode(EntityNodeBase& entityNode)
 {
-  for (const auto& [targetPropertyKey, targetProperty] :
-       getPropertiesForKeys(targetNode, getLinkTargetPropertyKeys(targetNode)))
+  const auto iNodeLinks = m_nodeLinks.find(&entityNode);
+  if (iNodeLinks == m_nodeLinks.end())
+  {
+    return;
+  }
+
+  const auto& nodeLinks = iNodeLinks->second;
+  for (const auto& [propertyKey, targetLinkEnds] : nodeLinks.linksFrom)
+  {
+    const auto sourceLinkEnd = CompactLinkEnd{&entityNode, propertyKey};
+    for (const auto& targetLinkEnd : targetLinkEnds)
+    {
+      if (targetLinkEnd.node != &entityNode)
+      {
+        auto& targetLinks = m_nodeLinks.at(targetLinkEnd.node).linksTo;
+        removeLinkEnd(targetLinks, targetLinkEnd.propertyKey, sourceLinkEnd);
+      }
+    }
+  }
+
+  for (const auto& [propertyKey, sourceLinkEnds] : nodeLinks.linksTo)
+  {
+    const auto targetLinkEnd = CompactLinkEnd{&entityNode, propertyKey};
+    for (const auto& sourceLinkEnd : sourceLinkEnds)
+    {
+      if (sourceLinkEnd.node != &entityNode)
+      {
+        auto& sourceLinks = m_nodeLinks.at(sourceLinkEnd.node).linksFrom;
+        removeLinkEnd(sourceLinks, sourceLinkEnd.propertyKey, targetLinkEnd);
+      }
+    }
+  }
+
+  for (const auto& [propertyKey, value] : nodeLinks.sourceProperties)
+  {
+    removeFromValueIndex(
+      m_linkSourcesByValue, value, CompactLinkEnd{&entityNode, propertyKey});
+  }
+
+  for (const auto& [propertyKey, value] : nodeLinks.targetProperties)
   {
-    const auto& targetPropertyValue = targetProperty.value();
+    removeFromValueIndex(
+      m_linkTargetsByValue, value, CompactLinkEnd{&entityNode, propertyKey});
+  }
+
+  m_nodeLinks.erase(iNodeLinks);
+}
 
-    // The node has some target property. We create an entry for the node and the property
-    // even if we don't know if there are any source nodes. This way, we can detect link
-    // targets with missing sources during validation.
-    auto& linkSourcesForKey = m_linkTargets[&targetNode][targetPropertyKey];
+void EntityLinkManager::addEntityNodes(
+  const std::vector<EntityNodeBase*>& entityNodes, kdl::task_manager& taskManager)
+{
+  contract_pre(m_nodeLinks.empty());
+
+  auto linkPropertiesTasks =
+    entityNodes | std::views::transform([](const auto* entityNode) {
+      return std::function{[=]() { return getLinkProperties(*entityNode); }};
+    });
+  const auto linkProperties = taskManager.run_tasks_and_wait(linkPropertiesTasks);
+
+  // Register the link properties of all nodes and index them by their values. As in
+  // addEntityNode, we create an adjacency for every link property to detect missing link
+  // ends during validation.
+  for (size_t i = 0; i < entityNodes.size(); ++i)
+  {
+    const auto* entityNode = entityNodes[i];
+    const auto& [sourceProperties, targetProperties] = linkProperties[i];
+    if (sourceProperties.empty() && targetProperties.empty())
+    {
+      continue;
+    }
 
-    for (const auto* sourceNode : m_nodeIndex.findNodes<EntityNodeBase>(
-           NodeIndex::escapePattern(targetPropertyValue)))
+    auto& nodeLinks = m_nodeLinks[entityNode];
+    for (const auto& [sourcePropertyKey, sourceProperty] : sourceProperties)
+    {
+      const auto propertyKey = internPropertyKey(sourcePropertyKey);
+      const auto& value = sourceProperty.value();
+      getAdjacency(nodeLinks.linksFrom, propertyKey);
+      if (addLinkProperty(nodeLinks.sourceProperties, propertyKey, value))
+      {
+        m_linkSourcesByValue[value].push_back({entityNode, propertyKey});
+      }
+    }
+    for (const auto& [targetPropertyKey, targetProperty] : targetProperties)
     {
-      for (const auto& sourcePropertyKey : getLinkSourcePropertyKeys(*sourceNode))
+      const auto propertyKey = internPropertyKey(targetPropertyKey);
+      const auto& value = targetProperty.value();
+      getAdjacency(nodeLinks.linksTo, propertyKey);
+      if (addLinkProperty(nodeLinks.targetProperties, propertyKey, value))
+      {
+        m_linkTargetsByValue[value].push_back({entityNode, propertyKey});
+      }
+    }
+  }
+
+  // Resolve the links from every source node in parallel
+  const auto sourceNodes = m_nodeLinks
+                           | std::views::filter([](const auto& entry) {
+                               return !entry.second.sourceProperties.empty();
+                             })
+                           | std::views::keys | kdl::ranges::to<std::vector>();
+
+  auto resolveLinksTasks = std::vector<std::function<std::vector<Adjacency>()>>{};
+  resolveLinksTasks.reserve(sourceNodes.size());
+  for (const auto* sourceNode : sourceNodes)
+  {
+    resolveLinksTasks.emplace_back([&, sourceNode]() {
+      const auto& nodeLinks = m_nodeLinks.at(sourceNode);
+      auto linksFrom = nodeLinks.linksFrom;
+      for (const auto& [propertyKey, value] : nodeLinks.sourceProperties)
       {
-        const auto& sourceEntity = sourceNode->entity();
-        if (sourceEntity.hasNumberedProperty(sourcePropertyKey, targetPropertyValue))
+        if (const auto iLinkTargets = m_linkTargetsByValue.find(value);
+            iLinkTargets != m_linkTargetsByValue.end())
         {
-          linkSourcesForKey.emplace(LinkEnd{sourceNode, sourcePropertyKey});
-          m_linkSources[sourceNode][sourcePropertyKey].emplace(
-            LinkEnd{&targetNode, targetPropertyKey});
+          // Only numbered properties with the same key can yield duplicate links
+          auto& targetLinkEnds = findAdjacency(linksFrom, propertyKey)->linkEnds;
+          const auto checkDuplicates = !targetLinkEnds.empty();
+          for (const auto& targetLinkEnd : iLinkTargets->second)
+          {
+            if (!checkDuplicates || !contains(targetLinkEnds, targetLinkEnd))
+            {
+              targetLinkEnds.push_back(targetLinkEnd);
+            }
+          }
         }
       }
+      return linksFrom;
+    });
+  }
+  auto linksFrom = taskManager.run_tasks_and_wait(std::move(resolveLinksTasks));
+
+  for (size_t i = 0; i < sourceNodes.size(); ++i)
+  {
+    const auto* sourceNode = sourceNodes[i];
+    for (const auto& [propertyKey, targetLinkEnds] : linksFrom[i])
+    {
+      const auto sourceLinkEnd = CompactLinkEnd{sourceNode, propertyKey};
+      for (const auto& targetLinkEnd : targetLinkEnds)
+      {
+        auto& targetLinks = m_nodeLinks.at(targetLinkEnd.node).linksTo;
+        findAdjacency(targetLinks, targetLinkEnd.propertyKey)
+          ->linkEnds.push_back(sourceLinkEnd);
+      }
     }
+    m_nodeLinks.at(sourceNode).linksFrom = std::move(linksFrom[i]);
+  }
+}
+
+void EntityLinkManager::clear()
+{
+  m_propertyKeys.clear();
+  m_propertyKeyIds.clear();
+  m_nodeLinks.clear();
+  m_linkSourcesByValue.clear();
+  m_linkTargetsByValue.clear();
+}
+
+EntityLinkManager::PropertyKeyId EntityLinkManager::internPropertyKey(
+  const std::string& propertyKey)
+{
+  const auto [iPropertyKeyId, inserted] =
+    m_propertyKeyIds.try_emplace(propertyKey, PropertyKeyId(m_propertyKeys.size()));
+  if (inserted)
+  {
+    m_propertyKeys.push_back(propertyKey);
+  }
+  return iPropertyKeyId->second;
+}
+
+const EntityLinkManager::PropertyKeyId* EntityLinkManager::findPropertyKeyId(
+  const std::string& propertyKey) const
+{
+  const auto iPropertyKeyId = m_propertyKeyIds.find(propertyKey);
+  return iPropertyKeyId != m_propertyKeyIds.end() ? &iPropertyKeyId->second : nullptr;
+}
+
+const EntityLinkManager::NodeLinks* EntityLinkManager::findNodeLinks(
+  const EntityNodeBase& node) const
+{
+  const auto iNodeLinks = m_nodeLinks.find(&node);
+  return iNodeLinks != m_nodeLinks.end() ? &iNodeLinks->second : nullptr;
+}
+
+std::vector<std::string> EntityLinkManager::getPropertyKeysWithMissingLinkEnd(
+  const std::vector<Adjacency>& adjacencies) const
+{
+  return adjacencies
+         | std::views::filter(
+           [](const auto& adjacency) { return adjacency.linkEnds.empty(); })
+         | std::views::transform(
+           [&](const auto& adjacency) { return m_propertyKeys[adjacency.propertyKey]; })
+         | kdl::ranges::to<std::vector>();
+}
+
+EntityLinkManager::LinkEndsForPropertyKey EntityLinkManager::expandLinks(
+  const std::vector<Adjacency>& adjacencies) const
+{
+  auto result = LinkEndsForPropertyKey{};
+  for (const auto& [propertyKey, linkEnds] : adjacencies)
+  {
+    result.emplace(m_propertyKeys[propertyKey], expandLinkEnds(linkEnds));
   }
+  return result;
 }
 
-void EntityLinkManager::removeLinksFrom(const EntityNodeBase& sourceNode)
+EntityLinkManager::LinkEnds EntityLinkManager::expandLinkEnds(
+  const std::vector<CompactLinkEnd>& linkEnds) const
 {
-  removeLinks(m_linkSources, m_linkTargets, sourceNode);
+  return linkEnds | std::views::transform([&](const auto& linkEnd) {
+           return LinkEnd{linkEnd.node, m_propertyKeys[linkEnd.propertyKey]};
+         })
+         | kdl::ranges::to<LinkEnds>();
 }
 
-void EntityLinkManager::removeLinksTo(const EntityNodeBase& targetNode)
+void EntityLinkManager::addLink(
+  const CompactLinkEnd& sourceLinkEnd, const CompactLinkEnd& targetLinkEnd)
 {
-  removeLinks(m_linkTargets, m_linkSources, targetNode);
+  auto& targetLinkEnds =
+    findAdjacency(m_nodeLinks.at(sourceLinkEnd.node).linksFrom, sourceLinkEnd.propertyKey)
+      ->linkEnds;
+  auto& sourceLinkEnds =
+    findAdjacency(m_nodeLinks.at(targetLinkEnd.node).linksTo, targetLinkEnd.propertyKey)
+      ->linkEnds;
+
+  // Both arrays contain the link or neither does, so search the shorter one
+  const auto exists = targetLinkEnds.size() < sourceLinkEnds.size()
+                        ? contains(targetLinkEnds, targetLinkEnd)
+                        : contains(sourceLinkEnds, sourceLinkEnd);
+  if (!exists)
+  {
+    targetLinkEnds.push_back(targetLinkEnd);
+    sourceLinkEnds.push_back(sourceLinkEnd);
+  }
 }
 
 } // namespace tb::mdl
@@ -40,10 +40,12 @@ namespace tb::mdl
 EntityModelManager::EntityModelManager(
   const GameInfo& gameInfo,
   const fs::FileSystem& gameFileSystem,
-  CreateEntityModelDataResource createResource,
+  Quake3ShaderCache& shaderCache,
+  CreateFileResource<EntityModelData> createResource,
   Logger& logger)
   : m_gameInfo{gameInfo}
   , m_gameFileSystem{gameFileSystem}
+  , m_shaderCache{shaderCache}
   , m_createResource{std::move(createResource)}
   , m_logger{logger}
 {
@@ -67,14 +69,16 @@ void EntityModelManager::clear()
 
 void EntityModelManager::reloadShaders(kdl::task_manager& taskManager)
 {
-  m_shaders.clear();
-
-  m_shaders =
+  m_shaders = std::make_shared<const std::vector<Quake3Shader>>(
     loadShaders(
-      m_gameFileSystem, m_gameInfo.gameConfig.materialConfig, taskManager, m_logger)
+      m_gameFileSystem,
+      m_gameInfo.gameConfig.materialConfig,
+      m_shaderCache,
+      taskManager,
+      m_logger)
     | kdl::if_error(
       [&](const auto& e) { m_logger.error() << "Failed to reload shaders: " << e.msg; })
-    | kdl::value_or(std::vector<Quake3Shader>{});
+    | kdl::value_or(std::vector<Quake3Shader>{}));
 }
 
 gl::MaterialRenderer* EntityModelManager::renderer(const ModelSpecification& spec) const
@@ -180,24 +184,33 @@ Result<EntityModel> EntityModelManager::loadModel(
     return gl::createResourceSync(std::move(resourceLoader));
   };
 
-  const auto loadMaterial = [&](const auto& materialPath) {
+  // The model is loaded on a worker thread, so the material loader must not capture any
+  // locals by reference.
+  const auto shaders = m_shaders ? m_shaders
+                                 : std::make_shared<const std::vector<Quake3Shader>>();
+  const auto loadMaterial = [this, &materialConfig, createResource, shaders](
+                              const auto& materialPath) {
     return mdl::loadMaterial(
              m_gameFileSystem,
              materialConfig,
              materialPath,
              createResource,
-             m_shaders,
+             *shaders,
              std::nullopt)
            | kdl::or_else(makeReadMaterialErrorHandler(m_gameFileSystem, m_logger))
            | kdl::value();
   };
 
+  const auto createModelResource = [&](auto resourceLoader) {
+    return m_createResource(modelPath, std::move(resourceLoader));
+  };
+
   return mdl::loadEntityModelAsync(
     m_gameFileSystem,
     materialConfig,
     modelPath,
     loadMaterial,
-    m_createResource,
+    createModelResource,
     m_logger);
 }
 
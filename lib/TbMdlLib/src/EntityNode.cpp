@@ -64,6 +64,11 @@ void EntityNode::setModel(const EntityModel* model)
   nodePhysicalBoundsDidChange();
 }
 
+void EntityNode::modelDataDidLoad()
+{
+  nodePhysicalBoundsDidChange();
+}
+
 const vm::bbox3d& EntityNode::doGetLogicalBounds() const
 {
   validateBounds();
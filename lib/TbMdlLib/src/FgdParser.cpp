@@ -278,6 +278,29 @@ std::vector<EntityDefinitionClassInfo> FgdParser::parseClassInfos(ParserStatus&
   return classInfos;
 }
 
+EntityDefinitionFileContents FgdParser::doParseFileContents(ParserStatus& status)
+{
+  auto contents = EntityDefinitionFileContents{};
+  auto token = m_tokenizer.peekToken(FgdToken::Eof | FgdToken::Word);
+  while (!token.hasType(FgdToken::Eof))
+  {
+    if (kdl::ci::str_is_equal(token.data(), "@include"))
+    {
+      contents.includes.push_back({contents.classInfos.size(), parseIncludePath()});
+    }
+    else
+    {
+      if (auto classInfo = parseClassInfo(status))
+      {
+        contents.classInfos.push_back(std::move(*classInfo));
+      }
+      status.progress(m_tokenizer.progress());
+    }
+    token = m_tokenizer.peekToken(FgdToken::Eof | FgdToken::Word);
+  }
+  return contents;
+}
+
 void FgdParser::parseClassInfoOrInclude(
   ParserStatus& status, std::vector<EntityDefinitionClassInfo>& classInfos)
 {
@@ -1116,13 +1139,18 @@ std::string FgdParser::parseString()
   }
 }
 
-std::vector<EntityDefinitionClassInfo> FgdParser::parseInclude(ParserStatus& status)
+std::filesystem::path FgdParser::parseIncludePath()
 {
   auto token = m_tokenizer.nextToken(FgdToken::Word);
   contract_assert(kdl::ci::str_is_equal(token.data(), "@include"));
 
   token = m_tokenizer.nextToken(FgdToken::String);
-  return handleInclude(status, token.data());
+  return token.data();
+}
+
+std::vector<EntityDefinitionClassInfo> FgdParser::parseInclude(ParserStatus& status)
+{
+  return handleInclude(status, parseIncludePath());
 }
 
 std::vector<EntityDefinitionClassInfo> FgdParser::handleInclude(
@@ -0,0 +1,51 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/GameAssetContext.h"
+
+#include "mdl/EntityModel.h"
+
+namespace tb::mdl
+{
+
+GameAssetContext::GameAssetContext() = default;
+
+GameAssetContext::~GameAssetContext() = default;
+
+Quake3ShaderCache& GameAssetContext::shaderCache()
+{
+  return m_shaderCache;
+}
+
+EntityDefinitionFileCache& GameAssetContext::entityDefinitionFileCache()
+{
+  return m_entityDefinitionFileCache;
+}
+
+SharedResourceCache<gl::Texture>& GameAssetContext::textureResourceCache()
+{
+  return m_textureResourceCache;
+}
+
+SharedResourceCache<EntityModelData>& GameAssetContext::entityModelDataResourceCache()
+{
+  return m_entityModelDataResourceCache;
+}
+
+} // namespace tb::mdl
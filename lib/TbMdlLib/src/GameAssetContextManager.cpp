@@ -0,0 +1,47 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/GameAssetContextManager.h"
+
+#include "mdl/GameAssetContext.h"
+
+namespace tb::mdl
+{
+
+GameAssetContextManager::GameAssetContextManager() = default;
+
+GameAssetContextManager::~GameAssetContextManager() = default;
+
+std::shared_ptr<GameAssetContext> GameAssetContextManager::acquire(
+  const std::string& gameName)
+{
+  std::erase_if(m_contexts, [](const auto& entry) { return entry.second.expired(); });
+
+  auto& context = m_contexts[gameName];
+  if (auto existingContext = context.lock())
+  {
+    return existingContext;
+  }
+
+  auto newContext = std::make_shared<GameAssetContext>();
+  context = newContext;
+  return newContext;
+}
+
+} // namespace tb::mdl
@@ -111,6 +111,26 @@ bool GroupNode::hasPendingChanges() const
 void GroupNode::setHasPendingChanges(const bool hasPendingChanges)
 {
   m_hasPendingChanges = hasPendingChanges;
+  m_pendingContentChanges = std::nullopt;
+}
+
+const std::optional<std::vector<const Node*>>& GroupNode::pendingContentChanges() const
+{
+  return m_pendingContentChanges;
+}
+
+void GroupNode::addPendingContentChanges(const std::vector<const Node*>& nodes)
+{
+  if (!m_hasPendingChanges)
+  {
+    m_hasPendingChanges = true;
+    m_pendingContentChanges = std::vector<const Node*>{};
+  }
+
+  if (m_pendingContentChanges)
+  {
+    m_pendingContentChanges = kdl::vec_concat(std::move(*m_pendingContentChanges), nodes);
+  }
 }
 
 void GroupNode::setEditState(const EditState editState)
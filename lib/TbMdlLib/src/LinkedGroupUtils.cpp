@@ -35,8 +35,10 @@
 #include "kd/task_manager.h"
 
 #include <algorithm>
+#include <optional>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace tb::mdl
 {
@@ -202,6 +204,38 @@ FaceSelectionResult faceSelectionWithLinkedGroupConstraints(
 
 namespace
 {
+Result<std::variant<Layer, Group, Entity, Brush, BezierPatch>> transformContents(
+  const Node& node, const vm::bbox3d& worldBounds, const vm::mat4x4d& transformation)
+{
+  using TransformResult = Result<std::variant<Layer, Group, Entity, Brush, BezierPatch>>;
+
+  return node.accept(kdl::overload(
+    [](const WorldNode&) -> TransformResult { contract_assert(false); },
+    [](const LayerNode&) -> TransformResult { contract_assert(false); },
+    [&](const GroupNode& groupNode) -> TransformResult {
+      auto group = groupNode.group();
+      group.transform(transformation);
+      return std::move(group);
+    },
+    [&](const EntityNode& entityNode) -> TransformResult {
+      const auto updateAngleProperty =
+        entityNode.entityPropertyConfig().updateAnglePropertyAfterTransform;
+      auto entity = entityNode.entity();
+      entity.transform(transformation, updateAngleProperty);
+      return std::move(entity);
+    },
+    [&](const BrushNode& brushNode) -> TransformResult {
+      auto brush = brushNode.brush();
+      return brush.transform(worldBounds, transformation, true)
+             | kdl::and_then([&]() -> TransformResult { return std::move(brush); });
+    },
+    [&](const PatchNode& patchNode) -> TransformResult {
+      auto patch = patchNode.patch();
+      patch.transform(transformation);
+      return std::move(patch);
+    }));
+}
+
 Result<std::unique_ptr<Node>> cloneAndTransformRecursive(
   const Node* nodeToClone,
   std::unordered_map<const Node*, NodeContents>& origNodeToTransformedContents,
@@ -277,35 +311,12 @@ Result<std::vector<std::unique_ptr<Node>>> cloneAndTransformChildren(
   // `nodesToClone`
   auto tasks =
     nodesToClone | std::views::transform([&](const auto& nodeToTransform) {
-      return std::function{[&]() {
-        return nodeToTransform->accept(kdl::overload(
-          [](const WorldNode&) -> TransformResult { contract_assert(false); },
-          [](const LayerNode&) -> TransformResult { contract_assert(false); },
-          [&](const GroupNode& groupNode) -> TransformResult {
-            auto group = groupNode.group();
-            group.transform(transformation);
-            return std::make_pair(nodeToTransform, NodeContents{std::move(group)});
-          },
-          [&](const EntityNode& entityNode) -> TransformResult {
-            const auto updateAngleProperty =
-              entityNode.entityPropertyConfig().updateAnglePropertyAfterTransform;
-            auto entity = entityNode.entity();
-            entity.transform(transformation, updateAngleProperty);
-            return std::make_pair(nodeToTransform, NodeContents{std::move(entity)});
-          },
-          [&](const BrushNode& brushNode) -> TransformResult {
-            auto brush = brushNode.brush();
-            return brush.transform(worldBounds, transformation, true)
-                   | kdl::and_then([&]() -> TransformResult {
-                       return std::make_pair(
-                         nodeToTransform, NodeContents{std::move(brush)});
-                     });
-          },
-          [&](const PatchNode& patchNode) -> TransformResult {
-            auto patch = patchNode.patch();
-            patch.transform(transformation);
-            return std::make_pair(nodeToTransform, NodeContents{std::move(patch)});
-          }));
+      return std::function{[&]() -> TransformResult {
+        return transformContents(*nodeToTransform, worldBounds, transformation)
+               | kdl::transform([&](auto contents) {
+                   return std::pair<const Node*, NodeContents>{
+                     nodeToTransform, NodeContents{std::move(contents)}};
+                 });
       }};
     });
 
@@ -398,19 +409,15 @@ void preserveGroupNames(
       [](const PatchNode&) {}));
 }
 
-void preserveEntityProperties(
-  EntityNode& clonedEntityNode, const EntityNode& correspondingEntityNode)
+void preserveEntityProperties(Entity& clonedEntity, const Entity& correspondingEntity)
 {
   if (
-    clonedEntityNode.entity().protectedProperties().empty()
-    && correspondingEntityNode.entity().protectedProperties().empty())
+    clonedEntity.protectedProperties().empty()
+    && correspondingEntity.protectedProperties().empty())
   {
     return;
   }
 
-  auto clonedEntity = clonedEntityNode.entity();
-  const auto& correspondingEntity = correspondingEntityNode.entity();
-
   const auto allProtectedProperties = kdl::vec_sort_and_remove_duplicates(kdl::vec_concat(
     clonedEntity.protectedProperties(), correspondingEntity.protectedProperties()));
 
@@ -425,7 +432,20 @@ void preserveEntityProperties(
       clonedEntity.addOrUpdateProperty(propertyKey, *propertyValue);
     }
   }
+}
+
+void preserveEntityProperties(
+  EntityNode& clonedEntityNode, const EntityNode& correspondingEntityNode)
+{
+  if (
+    clonedEntityNode.entity().protectedProperties().empty()
+    && correspondingEntityNode.entity().protectedProperties().empty())
+  {
+    return;
+  }
 
+  auto clonedEntity = clonedEntityNode.entity();
+  preserveEntityProperties(clonedEntity, correspondingEntityNode.entity());
   clonedEntityNode.setEntity(std::move(clonedEntity));
 }
 
@@ -457,6 +477,24 @@ void preserveEntityProperties(
       [](const BrushNode&) {},
       [](const PatchNode&) {}));
 }
+
+Result<std::pair<Node*, std::vector<std::unique_ptr<Node>>>> replaceLinkedGroupChildren(
+  const GroupNode& sourceGroupNode,
+  GroupNode& targetGroupNode,
+  const vm::bbox3d& worldBounds,
+  const vm::mat4x4d& transformation,
+  kdl::task_manager& taskManager)
+{
+  return cloneAndTransformChildren(
+           sourceGroupNode, worldBounds, transformation, taskManager)
+         | kdl::transform([&](auto newChildren) {
+             const auto linkIdToNodeMap = makeLinkIdToNodeMap(targetGroupNode.children());
+             preserveGroupNames(newChildren, linkIdToNodeMap);
+             preserveEntityProperties(newChildren, linkIdToNodeMap);
+             return std::pair{
+               static_cast<Node*>(&targetGroupNode), std::move(newChildren)};
+           });
+}
 } // namespace
 
 Result<UpdateLinkedGroupsResult> updateLinkedGroups(
@@ -477,16 +515,8 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
   return targetGroupNodesToUpdate | std::views::transform([&](auto* targetGroupNode) {
            const auto transformation =
              targetGroupNode->group().transformation() * *invertedSourceTransformation;
-           return cloneAndTransformChildren(
-                    sourceGroupNode, worldBounds, transformation, taskManager)
-                  | kdl::transform([&](auto newChildren) {
-                      const auto linkIdToNodeMap =
-                        makeLinkIdToNodeMap(targetGroupNode->children());
-                      preserveGroupNames(newChildren, linkIdToNodeMap);
-                      preserveEntityProperties(newChildren, linkIdToNodeMap);
-                      return std::pair{
-                        static_cast<Node*>(targetGroupNode), std::move(newChildren)};
-                    });
+           return replaceLinkedGroupChildren(
+             sourceGroupNode, *targetGroupNode, worldBounds, transformation, taskManager);
          })
          | kdl::fold;
 }
@@ -690,8 +720,197 @@ void resetLinkIds(GroupNode& rootNode)
     [](PatchNode& patchNode) { patchNode.setLinkId(generateUuid()); }));
 }
 
+/**
+ * Returns pairs of corresponding nodes in the given source and target group nodes, not
+ * including the group nodes themselves. Returns an error if the structure of the groups
+ * differs or if any corresponding nodes have different link IDs.
+ */
+Result<std::vector<std::pair<const Node*, Node*>>> collectCorrespondingNodes(
+  const GroupNode& sourceGroupNode, GroupNode& targetGroupNode)
+{
+  auto result = std::vector<std::pair<const Node*, Node*>>{};
+  auto linkIdsMatch = true;
+
+  return visitChildrenPerPosition(
+           sourceGroupNode,
+           targetGroupNode,
+           kdl::overload(
+             [](const WorldNode&, WorldNode&) {},
+             [](const LayerNode&, LayerNode&) {},
+             [&](const auto& sourceNode, auto& targetNode) {
+               linkIdsMatch = linkIdsMatch && sourceNode.linkId() == targetNode.linkId();
+               result.emplace_back(&sourceNode, &targetNode);
+             }),
+           GroupRecursionMode::Deep,
+           0)
+         | kdl::and_then(
+           [&]() -> Result<std::vector<std::pair<const Node*, Node*>>> {
+             if (!linkIdsMatch)
+             {
+               return Error{"Inconsistent linked group structure"};
+             }
+             return std::move(result);
+           });
+}
+
+bool exceedsWorldBounds(const NodeContents& contents, const vm::bbox3d& worldBounds)
+{
+  return std::visit(
+    kdl::overload(
+      [](const Layer&) { return false; },
+      [](const Group&) { return false; },
+      [&](const Entity& entity) {
+        return !worldBounds.contains(EntityNode{entity}.logicalBounds());
+      },
+      [&](const Brush& brush) { return !worldBounds.contains(brush.bounds()); },
+      [&](const BezierPatch& patch) { return !worldBounds.contains(patch.bounds()); }),
+    contents.get());
+}
+
+/**
+ * Transforms the contents of the given source node and returns them if they differ from
+ * the contents of the given target node.
+ */
+Result<std::optional<NodeContents>> updateLinkedNodeContents(
+  const Node& sourceNode,
+  const Node& targetNode,
+  const vm::bbox3d& worldBounds,
+  const vm::mat4x4d& transformation)
+{
+  return transformContents(sourceNode, worldBounds, transformation)
+         | kdl::transform([&](auto contents) -> std::optional<NodeContents> {
+             const auto contentsChanged = targetNode.accept(kdl::overload(
+               [](const WorldNode&) -> bool { contract_assert(false); },
+               [](const LayerNode&) -> bool { contract_assert(false); },
+               [&](const GroupNode& targetGroupNode) {
+                 auto& group = std::get<Group>(contents);
+                 group.setName(targetGroupNode.group().name());
+                 return group != targetGroupNode.group();
+               },
+               [&](const EntityNode& targetEntityNode) {
+                 auto& entity = std::get<Entity>(contents);
+                 preserveEntityProperties(entity, targetEntityNode.entity());
+                 return entity != targetEntityNode.entity();
+               },
+               [&](const BrushNode& targetBrushNode) {
+                 return std::get<Brush>(contents) != targetBrushNode.brush();
+               },
+               [&](const PatchNode& targetPatchNode) {
+                 return std::get<BezierPatch>(contents) != targetPatchNode.patch();
+               }));
+
+             return contentsChanged ? std::optional{NodeContents{std::move(contents)}}
+                                    : std::nullopt;
+           });
+}
+
+Result<LinkedGroupUpdates> updateLinkedGroupIncrementally(
+  const GroupNode& sourceGroupNode,
+  GroupNode& targetGroupNode,
+  const vm::bbox3d& worldBounds,
+  const vm::mat4x4d& transformation,
+  kdl::task_manager& taskManager,
+  const std::unordered_set<const Node*>* changedNodes)
+{
+  auto correspondingNodesResult =
+    collectCorrespondingNodes(sourceGroupNode, targetGroupNode);
+  if (!correspondingNodesResult)
+  {
+    // The structure of the groups differs, so the target group's children are replaced
+    return replaceLinkedGroupChildren(
+             sourceGroupNode, targetGroupNode, worldBounds, transformation, taskManager)
+           | kdl::transform([](auto childrenToReplace) {
+               auto result = LinkedGroupUpdates{};
+               result.childrenToReplace.push_back(std::move(childrenToReplace));
+               return result;
+             });
+  }
+
+  auto correspondingNodes = std::move(correspondingNodesResult).value();
+  if (changedNodes)
+  {
+    // Only the linked duplicates of the changed nodes can differ from their sources
+    std::erase_if(correspondingNodes, [&](const auto& pair) {
+      return !changedNodes->contains(pair.first);
+    });
+  }
+
+  using UpdateResult = Result<std::optional<NodeContents>>;
+
+  auto tasks = correspondingNodes | std::views::transform([&](const auto& pair) {
+                 return std::function{[&]() -> UpdateResult {
+                   return updateLinkedNodeContents(
+                     *pair.first, *pair.second, worldBounds, transformation);
+                 }};
+               });
+
+  return taskManager.run_tasks_and_wait(tasks) | kdl::fold
+         | kdl::or_else(
+           [](const auto&) -> Result<std::vector<std::optional<NodeContents>>> {
+             return Error{"Failed to transform a linked node"};
+           })
+         | kdl::and_then(
+           [&](auto updatedContents) -> Result<LinkedGroupUpdates> {
+             auto result = LinkedGroupUpdates{};
+             for (size_t i = 0; i < updatedContents.size(); ++i)
+             {
+               if (auto& contents = updatedContents[i])
+               {
+                 if (exceedsWorldBounds(*contents, worldBounds))
+                 {
+                   return Error{"Updating a linked node would exceed world bounds"};
+                 }
+                 result.contentsToSwap.emplace_back(
+                   correspondingNodes[i].second, std::move(*contents));
+               }
+             }
+             return result;
+           });
+}
+
 } // namespace
 
+Result<LinkedGroupUpdates> updateLinkedGroupsIncrementally(
+  const GroupNode& sourceGroupNode,
+  const std::vector<GroupNode*>& targetGroupNodes,
+  const vm::bbox3d& worldBounds,
+  kdl::task_manager& taskManager,
+  const std::unordered_set<const Node*>* changedNodes)
+{
+  const auto& sourceGroup = sourceGroupNode.group();
+  const auto invertedSourceTransformation = vm::invert(sourceGroup.transformation());
+  if (!invertedSourceTransformation)
+  {
+    return Error{"Group transformation is not invertible"};
+  }
+
+  const auto targetGroupNodesToUpdate =
+    kdl::vec_erase(targetGroupNodes, &sourceGroupNode);
+  return targetGroupNodesToUpdate | std::views::transform([&](auto* targetGroupNode) {
+           const auto transformation =
+             targetGroupNode->group().transformation() * *invertedSourceTransformation;
+           return updateLinkedGroupIncrementally(
+             sourceGroupNode,
+             *targetGroupNode,
+             worldBounds,
+             transformation,
+             taskManager,
+             changedNodes);
+         })
+         | kdl::fold | kdl::transform([](auto updatesPerGroup) {
+             auto result = LinkedGroupUpdates{};
+             for (auto& updates : updatesPerGroup)
+             {
+               result.childrenToReplace = kdl::vec_concat(
+                 std::move(result.childrenToReplace),
+                 std::move(updates.childrenToReplace));
+               result.contentsToSwap = kdl::vec_concat(
+                 std::move(result.contentsToSwap), std::move(updates.contentsToSwap));
+             }
+             return result;
+           });
+}
+
 std::vector<Error> initializeLinkIds(const std::vector<Node*>& nodes)
 {
   const auto allGroupNodes =
@@ -19,12 +19,31 @@
 
 #include "mdl/LoadEntityDefinitions.h"
 
+#include "Logger.h"
+#include "SimpleParserStatus.h"
+#include "fs/DiskFileSystem.h"
 #include "fs/DiskIO.h"
+#include "fs/File.h"
+#include "fs/Reader.h"
 #include "mdl/DefParser.h"
 #include "mdl/EntParser.h"
+#include "mdl/EntityDefinitionFileCache.h"
 #include "mdl/FgdParser.h"
 
+#include "kd/path_hash.h"
 #include "kd/path_utils.h"
+#include "kd/result.h"
+#include "kd/result_fold.h"
+#include "kd/task_manager.h"
+#include "kd/vector_utils.h"
+
+#include <fmt/format.h>
+#include <fmt/std.h>
+
+#include <functional>
+#include <optional>
+#include <ranges>
+#include <unordered_map>
 
 namespace tb::mdl
 {
@@ -42,6 +61,176 @@ Result<std::vector<EntityDefinition>> loadEntityDefinitions(
          });
 }
 
+Result<EntityDefinitionFileContents> parseFileContents(
+  const std::filesystem::path& path,
+  const std::string_view str,
+  const Color& defaultColor,
+  ParserStatus& status)
+{
+  const auto extension = kdl::path_to_lower(path.extension());
+  if (extension == ".fgd")
+  {
+    return FgdParser{str, defaultColor}.parseFileContents(status);
+  }
+  if (extension == ".def")
+  {
+    return DefParser{str, defaultColor}.parseFileContents(status);
+  }
+  if (extension == ".ent")
+  {
+    return EntParser{str, defaultColor}.parseFileContents(status);
+  }
+
+  return Error{fmt::format("Unknown entity definition format: {}", path)};
+}
+
+struct LoadedFile
+{
+  /** Set if the file was parsed and should be cached. */
+  std::optional<EntityDefinitionFileCache::Key> cacheKey;
+  EntityDefinitionFileContents contents;
+};
+
+/**
+ * Returns nullopt if the file cannot be opened, and an error if it cannot be parsed.
+ */
+Result<std::optional<LoadedFile>> loadFile(
+  const fs::DiskFileSystem& fs,
+  const std::filesystem::path& path,
+  const Color& defaultColor,
+  const EntityDefinitionFileCache& cache,
+  Logger& logger)
+{
+  const auto file = fs.openFile(path);
+  if (file.is_error())
+  {
+    return std::nullopt;
+  }
+
+  auto reader = file.value()->reader().buffer();
+  const auto str = reader.stringView();
+
+  auto cacheKey = EntityDefinitionFileCache::makeKey(fs.root() / path, str);
+  if (const auto* cachedContents = cache.find(cacheKey))
+  {
+    return LoadedFile{std::nullopt, *cachedContents};
+  }
+
+  auto status = SimpleParserStatus{logger, path.string()};
+  return parseFileContents(path, str, defaultColor, status)
+         | kdl::transform([&](auto contents) {
+             return std::optional{LoadedFile{std::move(cacheKey), std::move(contents)}};
+           });
+}
+
+using LoadedFiles =
+  std::unordered_map<std::filesystem::path, std::optional<LoadedFile>, kdl::path_hash>;
+
+std::filesystem::path resolveIncludePath(
+  const std::filesystem::path& path, const EntityDefinitionFileContents::Include& include)
+{
+  return (path.parent_path() / include.path).lexically_normal();
+}
+
+/**
+ * Loads the given files and all files they include. The files are loaded level by level,
+ * and the files of each level are read and parsed in parallel.
+ */
+Result<void> loadFiles(
+  const fs::DiskFileSystem& fs,
+  const std::vector<std::filesystem::path>& pathsToLoad,
+  const Color& defaultColor,
+  const EntityDefinitionFileCache& cache,
+  kdl::task_manager& taskManager,
+  Logger& logger,
+  LoadedFiles& loadedFiles)
+{
+  if (pathsToLoad.empty())
+  {
+    return kdl::void_success;
+  }
+
+  auto tasks = pathsToLoad | std::views::transform([&](const auto& path) {
+                 return std::function{
+                   [&]() { return loadFile(fs, path, defaultColor, cache, logger); }};
+               });
+
+  return taskManager.run_tasks_and_wait(tasks) | kdl::fold
+         | kdl::and_then([&](auto files) {
+             auto nextPathsToLoad = std::vector<std::filesystem::path>{};
+             for (size_t i = 0; i < pathsToLoad.size(); ++i)
+             {
+               if (files[i])
+               {
+                 for (const auto& include : files[i]->contents.includes)
+                 {
+                   auto includedPath = resolveIncludePath(pathsToLoad[i], include);
+                   if (
+                     !loadedFiles.contains(includedPath)
+                     && !kdl::vec_contains(pathsToLoad, includedPath)
+                     && !kdl::vec_contains(nextPathsToLoad, includedPath))
+                   {
+                     nextPathsToLoad.push_back(std::move(includedPath));
+                   }
+                 }
+               }
+               loadedFiles.emplace(pathsToLoad[i], std::move(files[i]));
+             }
+
+             return loadFiles(
+               fs,
+               nextPathsToLoad,
+               defaultColor,
+               cache,
+               taskManager,
+               logger,
+               loadedFiles);
+           });
+}
+
+void collectClassInfos(
+  const std::filesystem::path& path,
+  const LoadedFiles& loadedFiles,
+  std::vector<std::filesystem::path>& includeStack,
+  ParserStatus& status,
+  std::vector<EntityDefinitionClassInfo>& classInfos)
+{
+  const auto& contents = loadedFiles.at(path)->contents;
+  const auto appendClassInfos = [&](const size_t first, const size_t last) {
+    classInfos.insert(
+      classInfos.end(),
+      std::next(contents.classInfos.begin(), std::ptrdiff_t(first)),
+      std::next(contents.classInfos.begin(), std::ptrdiff_t(last)));
+  };
+
+  includeStack.push_back(path);
+
+  auto position = size_t(0);
+  for (const auto& include : contents.includes)
+  {
+    appendClassInfos(position, include.position);
+    position = include.position;
+
+    const auto includedPath = resolveIncludePath(path, include);
+    if (!loadedFiles.at(includedPath))
+    {
+      status.error(fmt::format("Failed to open included file: {}", includedPath));
+    }
+    else if (kdl::vec_contains(includeStack, includedPath))
+    {
+      status.error(fmt::format(
+        "Skipping recursively included file: {} ({})", include.path, includedPath));
+    }
+    else
+    {
+      collectClassInfos(includedPath, loadedFiles, includeStack, status, classInfos);
+    }
+  }
+  appendClassInfos(position, contents.classInfos.size());
+
+  includeStack.pop_back();
+}
+
 } // namespace
 
 Result<std::vector<EntityDefinition>> loadEntityDefinitions(
@@ -64,4 +253,41 @@ Result<std::vector<EntityDefinition>> loadEntityDefinitions(
   return Error{fmt::format("Unknown entity definition format: {}", path)};
 }
 
+Result<std::vector<EntityDefinition>> loadEntityDefinitions(
+  const std::filesystem::path& path,
+  const Color& defaultColor,
+  EntityDefinitionFileCache& cache,
+  kdl::task_manager& taskManager,
+  Logger& logger)
+{
+  // included files are resolved relative to the directory of the including file
+  const auto fs = fs::DiskFileSystem{path.parent_path()};
+  const auto filename = path.filename();
+
+  auto loadedFiles = LoadedFiles{};
+  return loadFiles(fs, {filename}, defaultColor, cache, taskManager, logger, loadedFiles)
+         | kdl::and_then([&]() -> Result<std::vector<EntityDefinition>> {
+             if (!loadedFiles.at(filename))
+             {
+               return Error{fmt::format("Could not open {}", path)};
+             }
+
+             for (auto& [loadedPath, loadedFile] : loadedFiles)
+             {
+               if (loadedFile && loadedFile->cacheKey)
+               {
+                 // the tasks may read the cache concurrently, so it's updated here
+                 cache.insert(*loadedFile->cacheKey, loadedFile->contents);
+               }
+             }
+
+             auto status = SimpleParserStatus{logger};
+             auto classInfos = std::vector<EntityDefinitionClassInfo>{};
+             auto includeStack = std::vector<std::filesystem::path>{};
+             collectClassInfos(filename, loadedFiles, includeStack, status, classInfos);
+
+             return createEntityDefinitions(status, classInfos, defaultColor);
+           });
+}
+
 } // namespace tb::mdl
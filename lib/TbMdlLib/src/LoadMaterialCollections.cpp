@@ -193,25 +193,25 @@ Result<gl::Material> loadShaderMaterial(
   const Quake3Shader& shader,
   const fs::FileSystem& fs,
   const MaterialConfig& materialConfig,
-  const gl::CreateTextureResource& createResource)
+  const CreateFileResource<gl::Texture>& createResource)
 {
-  return findShaderTexture(shader, fs, materialConfig) | kdl::transform([&](auto path_) {
-           return [&, path = std::move(path_)]() {
-             return fs.openFile(path) | kdl::and_then([&](auto file) {
-                      auto reader = file->reader().buffer();
-                      return loadFreeImageTexture(reader).transform([](auto texture) {
-                        texture.setMask(gl::TextureMask::Off);
-                        return texture;
-                      });
-                    });
-           };
-         })
-         | kdl::transform([&](auto textureLoader) {
+  return findShaderTexture(shader, fs, materialConfig)
+         | kdl::transform([&](const auto& texturePath) {
              const auto prefixLength = kdl::path_length(materialConfig.root);
              auto shaderName =
                getMaterialNameFromPathSuffix(shader.shaderPath, prefixLength);
 
-             auto textureResource = createResource(std::move(textureLoader));
+             auto textureLoader = [&, path = texturePath]() {
+               return fs.openFile(path) | kdl::and_then([&](auto file) {
+                        auto reader = file->reader().buffer();
+                        return loadFreeImageTexture(reader).transform([](auto texture) {
+                          texture.setMask(gl::TextureMask::Off);
+                          return texture;
+                        });
+                      });
+             };
+
+             auto textureResource = createResource(texturePath, std::move(textureLoader));
              auto material =
                gl::Material{std::move(shaderName), std::move(textureResource)};
              material.setSurfaceParms(shader.surfaceParms);
@@ -282,7 +282,7 @@ Result<gl::Material> loadTextureMaterial(
   const std::filesystem::path& texturePath,
   const fs::FileSystem& fs,
   const MaterialConfig& materialConfig,
-  const gl::CreateTextureResource& createResource,
+  const CreateFileResource<gl::Texture>& createResource,
   const std::optional<Palette>& palette)
 {
   const auto prefixLength = kdl::path_length(materialConfig.root);
@@ -293,7 +293,7 @@ Result<gl::Material> loadTextureMaterial(
 
   auto textureLoader =
     makeTextureResourceLoader(texturePath, name, materialConfig.extensions, fs, palette);
-  auto textureResource = createResource(std::move(textureLoader));
+  auto textureResource = createResource(texturePath, std::move(textureLoader));
   return gl::Material{std::move(name), std::move(textureResource)};
 }
 
@@ -360,14 +360,11 @@ std::vector<gl::MaterialCollection> groupMaterialsIntoCollections(
          | kdl::ranges::to<std::vector>();
 }
 
-} // namespace
-
-
 Result<gl::Material> loadMaterial(
   const fs::FileSystem& fs,
   const MaterialConfig& materialConfig,
   const std::filesystem::path& materialPath,
-  const gl::CreateTextureResource& createResource,
+  const CreateFileResource<gl::Texture>& createResource,
   const std::vector<Quake3Shader>& shaders,
   const std::optional<Palette>& palette)
 {
@@ -390,14 +387,38 @@ Result<gl::Material> loadMaterial(
            });
 }
 
-Result<std::vector<gl::MaterialCollection>> loadMaterialCollections(
+CreateFileResource<gl::Texture> ignorePath(
+  const gl::CreateTextureResource& createResource)
+{
+  return [&](const auto&, auto resourceLoader) {
+    return createResource(std::move(resourceLoader));
+  };
+}
+
+} // namespace
+
+Result<gl::Material> loadMaterial(
   const fs::FileSystem& fs,
   const MaterialConfig& materialConfig,
+  const std::filesystem::path& materialPath,
   const gl::CreateTextureResource& createResource,
-  kdl::task_manager& taskManager,
-  Logger& logger)
+  const std::vector<Quake3Shader>& shaders,
+  const std::optional<Palette>& palette)
 {
-  return loadShaders(fs, materialConfig, taskManager, logger)
+  return loadMaterial(
+    fs, materialConfig, materialPath, ignorePath(createResource), shaders, palette);
+}
+
+namespace
+{
+
+Result<std::vector<gl::MaterialCollection>> loadMaterialCollections(
+  const fs::FileSystem& fs,
+  const MaterialConfig& materialConfig,
+  const CreateFileResource<gl::Texture>& createResource,
+  Result<std::vector<Quake3Shader>> shaders)
+{
+  return std::move(shaders)
          | kdl::transform([&](auto shaders) {
              return shaders | std::views::filter([&](const auto& shader) {
                       return kdl::path_has_prefix(shader.shaderPath, materialConfig.root);
@@ -426,4 +447,50 @@ Result<std::vector<gl::MaterialCollection>> loadMaterialCollections(
            });
 }
 
+} // namespace
+
+Result<std::vector<gl::MaterialCollection>> loadMaterialCollections(
+  const fs::FileSystem& fs,
+  const MaterialConfig& materialConfig,
+  const gl::CreateTextureResource& createResource,
+  kdl::task_manager& taskManager,
+  Logger& logger)
+{
+  return loadMaterialCollections(
+    fs,
+    materialConfig,
+    ignorePath(createResource),
+    loadShaders(fs, materialConfig, taskManager, logger));
+}
+
+Result<std::vector<gl::MaterialCollection>> loadMaterialCollections(
+  const fs::FileSystem& fs,
+  const MaterialConfig& materialConfig,
+  const gl::CreateTextureResource& createResource,
+  Quake3ShaderCache& shaderCache,
+  kdl::task_manager& taskManager,
+  Logger& logger)
+{
+  return loadMaterialCollections(
+    fs,
+    materialConfig,
+    ignorePath(createResource),
+    loadShaders(fs, materialConfig, shaderCache, taskManager, logger));
+}
+
+Result<std::vector<gl::MaterialCollection>> loadMaterialCollections(
+  const fs::FileSystem& fs,
+  const MaterialConfig& materialConfig,
+  const CreateFileResource<gl::Texture>& createResource,
+  Quake3ShaderCache& shaderCache,
+  kdl::task_manager& taskManager,
+  Logger& logger)
+{
+  return loadMaterialCollections(
+    fs,
+    materialConfig,
+    createResource,
+    loadShaders(fs, materialConfig, shaderCache, taskManager, logger));
+}
+
 } // namespace tb::mdl
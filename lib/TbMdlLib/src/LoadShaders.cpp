@@ -27,6 +27,7 @@
 #include "fs/TraversalMode.h"
 #include "mdl/GameConfig.h"
 #include "mdl/Quake3Shader.h"
+#include "mdl/Quake3ShaderCache.h"
 #include "mdl/Quake3ShaderParser.h"
 
 #include "kd/result.h"
@@ -36,6 +37,7 @@
 
 #include <fmt/format.h>
 
+#include <optional>
 #include <vector>
 
 namespace tb::mdl
@@ -44,26 +46,49 @@ namespace tb::mdl
 namespace
 {
 
-Result<std::vector<Quake3Shader>> loadShader(
-  const fs::FileSystem& fs, const std::filesystem::path& path, Logger& logger)
+struct LoadedShaders
 {
-  return fs.openFile(path) | kdl::and_then([&](auto file) {
+  /** Set if the shaders were parsed and should be cached. */
+  std::optional<Quake3ShaderCache::Key> cacheKey;
+  std::vector<Quake3Shader> shaders;
+};
+
+Result<LoadedShaders> loadShader(
+  const fs::FileSystem& fs,
+  const std::filesystem::path& path,
+  const Quake3ShaderCache* cache,
+  Logger& logger)
+{
+  return fs.openFile(path) | kdl::and_then([&](auto file) -> Result<LoadedShaders> {
            auto bufferedReader = file->reader().buffer();
-           auto parser = Quake3ShaderParser{bufferedReader.stringView()};
+           const auto contents = bufferedReader.stringView();
+
+           auto cacheKey = std::optional<Quake3ShaderCache::Key>{};
+           if (cache)
+           {
+             cacheKey = Quake3ShaderCache::makeKey(path, contents);
+             if (const auto* cachedShaders = cache->find(*cacheKey))
+             {
+               return LoadedShaders{std::nullopt, *cachedShaders};
+             }
+           }
+
+           auto parser = Quake3ShaderParser{contents};
            auto status = SimpleParserStatus{logger, path.string()};
-           return parser.parse(status);
+           return parser.parse(status) | kdl::transform([&](auto shaders) {
+                    return LoadedShaders{std::move(cacheKey), std::move(shaders)};
+                  });
          })
          | kdl::transform_error([&](const auto& e) {
              logger.warn() << "Skipping malformed shader file " << path << ": " << e.msg;
-             return std::vector<Quake3Shader>{};
+             return LoadedShaders{};
            });
 }
 
-} // namespace
-
 Result<std::vector<Quake3Shader>> loadShaders(
   const fs::FileSystem& fs,
   const MaterialConfig& materialConfig,
+  Quake3ShaderCache* cache,
   kdl::task_manager& taskManager,
   Logger& logger)
 {
@@ -79,11 +104,25 @@ Result<std::vector<Quake3Shader>> loadShaders(
          | kdl::and_then([&](auto paths) {
              auto tasks =
                paths | std::views::transform([&](const auto& path) {
-                 return std::function{[&]() { return loadShader(fs, path, logger); }};
+                 return std::function{
+                   [&]() { return loadShader(fs, path, cache, logger); }};
                });
              return taskManager.run_tasks_and_wait(tasks) | kdl::fold;
            })
-         | kdl::transform([&](auto nestedShaders) {
+         | kdl::transform([&](auto loadedShaders) {
+             auto nestedShaders = std::vector<std::vector<Quake3Shader>>{};
+             nestedShaders.reserve(loadedShaders.size());
+
+             for (auto& [cacheKey, shaders] : loadedShaders)
+             {
+               if (cache && cacheKey)
+               {
+                 // the tasks may read the cache concurrently, so it's updated here
+                 cache->insert(std::move(*cacheKey), shaders);
+               }
+               nestedShaders.push_back(std::move(shaders));
+             }
+
              return nestedShaders | std::views::join | kdl::ranges::to<std::vector>();
            })
          | kdl::transform([](auto shaders) {
@@ -99,4 +138,25 @@ Result<std::vector<Quake3Shader>> loadShaders(
            });
 }
 
+} // namespace
+
+Result<std::vector<Quake3Shader>> loadShaders(
+  const fs::FileSystem& fs,
+  const MaterialConfig& materialConfig,
+  kdl::task_manager& taskManager,
+  Logger& logger)
+{
+  return loadShaders(fs, materialConfig, nullptr, taskManager, logger);
+}
+
+Result<std::vector<Quake3Shader>> loadShaders(
+  const fs::FileSystem& fs,
+  const MaterialConfig& materialConfig,
+  Quake3ShaderCache& cache,
+  kdl::task_manager& taskManager,
+  Logger& logger)
+{
+  return loadShaders(fs, materialConfig, &cache, taskManager, logger);
+}
+
 } // namespace tb::mdl
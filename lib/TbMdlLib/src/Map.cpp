@@ -42,6 +42,7 @@
 #include "mdl/EntityModelManager.h"
 #include "mdl/EntityNode.h"
 #include "mdl/EnvironmentConfig.h"
+#include "mdl/GameAssetContext.h"
 #include "mdl/GameFileSystem.h"
 #include "mdl/GameInfo.h"
 #include "mdl/Grid.h"
@@ -66,12 +67,14 @@
 #include "mdl/Map_Nodes.h"
 #include "mdl/Map_Selection.h"
 #include "mdl/Map_World.h"
+#include "mdl/MaterialIndex.h"
 #include "mdl/MissingClassnameValidator.h"
 #include "mdl/MissingDefinitionValidator.h"
 #include "mdl/MissingModValidator.h"
 #include "mdl/MixedBrushContentsValidator.h"
 #include "mdl/ModelUtils.h"
 #include "mdl/Node.h"
+#include "mdl/NodeChangeBatcher.h"
 #include "mdl/NodeIndex.h"
 #include "mdl/NodeQueries.h"
 #include "mdl/NodeReader.h"
@@ -88,6 +91,7 @@
 #include "mdl/SoftMapBoundsValidator.h"
 #include "mdl/TagManager.h"
 #include "mdl/Transaction.h"
+#include "mdl/TransactionScope.h"
 #include "mdl/UndoableCommand.h"
 #include "mdl/UpdateLinkedGroupsCommand.h"
 #include "mdl/UpdateLinkedGroupsHelper.h"
@@ -108,9 +112,11 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <functional>
 #include <memory>
 #include <ranges>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 
@@ -151,6 +157,20 @@ auto makeCreateResource(gl::ResourceManager& resourceManager)
   };
 }
 
+/**
+ * Returns the search paths that determine which files the game file system of the given
+ * map contains, not counting the wad files.
+ */
+std::vector<std::filesystem::path> gameSearchPaths(const Map& map)
+{
+  auto searchPaths = std::vector<std::filesystem::path>{map.gamePath()};
+  for (const auto& mod : enabledMods(map))
+  {
+    searchPaths.emplace_back(mod);
+  }
+  return searchPaths;
+}
+
 Result<std::unique_ptr<WorldNode>> loadWorldNode(
   const MapFormat mapFormat,
   const GameConfig& config,
@@ -284,7 +304,39 @@ auto findEntityDefinitionFile(
   return fs::Disk::resolvePath(searchPaths, spec.path);
 }
 
-auto makeInitializeNodeTagsVisitor(TagManager& tagManager)
+/**
+ * Initializes the tags of the given brush nodes in parallel. Every task only modifies the
+ * tags of its own brushes and their faces.
+ */
+void initializeBrushNodeTags(
+  const std::vector<BrushNode*>& brushNodes,
+  TagManager& tagManager,
+  kdl::task_manager& taskManager)
+{
+  constexpr auto BrushNodesPerTask = size_t(256);
+
+  auto tasks = std::vector<std::function<size_t()>>{};
+  for (size_t first = 0; first < brushNodes.size(); first += BrushNodesPerTask)
+  {
+    tasks.emplace_back([&, first]() {
+      const auto last = std::min(first + BrushNodesPerTask, brushNodes.size());
+      for (auto i = first; i < last; ++i)
+      {
+        brushNodes[i]->initializeTags(tagManager);
+      }
+      return last - first;
+    });
+  }
+
+  taskManager.run_tasks_and_wait(std::move(tasks));
+}
+
+/**
+ * Initializes the tags of all visited nodes except for brush nodes, which are collected
+ * so that their tags can be initialized in parallel.
+ */
+auto makeInitializeNodeTagsVisitor(
+  TagManager& tagManager, std::vector<BrushNode*>& brushNodes)
 {
   return kdl::overload(
     [&](auto&& thisLambda, WorldNode& worldNode) {
@@ -303,7 +355,7 @@ auto makeInitializeNodeTagsVisitor(TagManager& tagManager)
       entityNode.initializeTags(tagManager);
       entityNode.visitChildren(thisLambda);
     },
-    [&](BrushNode& brushNode) { brushNode.initializeTags(tagManager); },
+    [&](BrushNode& brushNode) { brushNodes.push_back(&brushNode); },
     [&](PatchNode& patchNode) { patchNode.initializeTags(tagManager); });
 }
 
@@ -469,9 +521,20 @@ bool updateLinkedGroups(Map& map)
           collectGroupsWithPendingChanges(map.worldNode());
         !allChangedLinkedGroups.empty())
     {
+      auto changedLinkedNodes = ChangedLinkedNodes{};
+      for (const auto* groupNode : allChangedLinkedGroups)
+      {
+        if (const auto& changedNodes = groupNode->pendingContentChanges())
+        {
+          changedLinkedNodes.emplace(
+            groupNode, *changedNodes | kdl::ranges::to<std::unordered_set>());
+        }
+      }
+
       setHasPendingChanges(allChangedLinkedGroups, false);
 
-      auto command = std::make_unique<UpdateLinkedGroupsCommand>(allChangedLinkedGroups);
+      auto command = std::make_unique<UpdateLinkedGroupsCommand>(
+        allChangedLinkedGroups, std::move(changedLinkedNodes));
       return map.executeAndStore(std::move(command));
     }
   }
@@ -504,6 +567,7 @@ Map::Map(
   const vm::bbox3d& worldBounds,
   kdl::task_manager& taskManager,
   gl::ResourceManager& resourceManager,
+  std::shared_ptr<GameAssetContext> assetContext,
   Logger& logger)
   : Map{
       environmentConfig,
@@ -514,6 +578,7 @@ Map::Map(
       DefaultDocumentName,
       taskManager,
       resourceManager,
+      std::move(assetContext),
       logger}
 {
   setWorldDefaultProperties(
@@ -532,12 +597,14 @@ Map::Map(
   std::filesystem::path path,
   kdl::task_manager& taskManager,
   gl::ResourceManager& resourceManager,
+  std::shared_ptr<GameAssetContext> assetContext,
   Logger& logger)
   : m_environmentConfig{environmentConfig}
   , m_gameInfo{gameInfo}
   , m_gamePath{gamePath}
   , m_gameFileSystem{createGameFileSystem(
       m_environmentConfig, m_gameInfo, m_gamePath, logger)}
+  , m_assetContext{std::move(assetContext)}
   , m_taskManager{taskManager}
   , m_resourceManager{resourceManager}
   , m_logger{logger}
@@ -545,7 +612,15 @@ Map::Map(
   , m_entityModelManager{std::make_unique<EntityModelManager>(
       m_gameInfo,
       *m_gameFileSystem,
-      makeCreateResource<EntityModelDataResource>(m_resourceManager),
+      m_assetContext->shaderCache(),
+      [this](const auto& modelPath, auto resourceLoader) {
+        return m_assetContext->entityModelDataResourceCache().getOrCreate(
+          *m_gameFileSystem,
+          gameSearchPaths(*this),
+          modelPath,
+          std::move(resourceLoader),
+          makeCreateResource<EntityModelDataResource>(m_resourceManager));
+      },
       logger)}
   , m_materialManager{std::make_unique<gl::MaterialManager>(logger)}
   , m_tagManager{std::make_unique<TagManager>()}
@@ -554,13 +629,15 @@ Map::Map(
   , m_worldNode{std::move(worldNode)}
   , m_worldBounds{worldBounds}
   , m_nodeIndex{std::make_unique<NodeIndex>()}
-  , m_entityLinkManager{std::make_unique<EntityLinkManager>(*m_nodeIndex)}
+  , m_materialIndex{std::make_unique<MaterialIndex>()}
+  , m_entityLinkManager{std::make_unique<EntityLinkManager>()}
   , m_vertexHandles{std::make_unique<VertexHandleManager>()}
   , m_edgeHandles{std::make_unique<EdgeHandleManager>()}
   , m_faceHandles{std::make_unique<FaceHandleManager>()}
   , m_currentMaterialName{BrushFaceAttributes::NoMaterialName}
   , m_repeatStack{std::make_unique<RepeatStack>()}
   , m_commandProcessor{std::make_unique<CommandProcessor>(*this)}
+  , m_nodeChangeBatcher{std::make_unique<NodeChangeBatcher>(nodeChangesNotifier)}
   , m_path{std::move(path)}
   , m_selection{*this}
 {
@@ -589,6 +666,7 @@ Result<std::unique_ptr<Map>> Map::createMap(
   const vm::bbox3d& worldBounds,
   kdl::task_manager& taskManager,
   gl::ResourceManager& resourceManager,
+  std::shared_ptr<GameAssetContext> assetContext,
   Logger& logger)
 {
   logger.info() << "Creating new document";
@@ -603,6 +681,7 @@ Result<std::unique_ptr<Map>> Map::createMap(
                worldBounds,
                taskManager,
                resourceManager,
+               std::move(assetContext),
                logger);
            });
 }
@@ -616,6 +695,7 @@ Result<std::unique_ptr<Map>> Map::loadMap(
   std::filesystem::path path,
   kdl::task_manager& taskManager,
   gl::ResourceManager& resourceManager,
+  std::shared_ptr<GameAssetContext> assetContext,
   Logger& logger)
 {
   if (!path.is_absolute())
@@ -637,6 +717,7 @@ Result<std::unique_ptr<Map>> Map::loadMap(
                std::move(path),
                taskManager,
                resourceManager,
+               std::move(assetContext),
                logger);
            });
 }
@@ -805,6 +886,11 @@ const CommandProcessor& Map::commandProcessor() const
   return *m_commandProcessor;
 }
 
+const MaterialIndex& Map::materialIndex() const
+{
+  return *m_materialIndex;
+}
+
 const EntityLinkManager& Map::entityLinkManager() const
 {
   return *m_entityLinkManager;
@@ -847,6 +933,7 @@ Result<std::unique_ptr<Map>> Map::reload()
     m_path,
     taskManager(),
     m_resourceManager,
+    m_assetContext,
     logger());
 }
 
@@ -1007,6 +1094,7 @@ void Map::registerSmartTags()
 {
   m_tagManager->clearSmartTags();
   m_tagManager->registerSmartTags(gameInfo().gameConfig.smartTags);
+  m_tagManager->precomputeMaterialTags(m_materialManager->materials());
 }
 
 const std::vector<SmartTag>& Map::smartTags() const
@@ -1036,12 +1124,16 @@ const SmartTag& Map::smartTag(const size_t index) const
 
 void Map::initializeAllNodeTags()
 {
-  m_worldNode->accept(makeInitializeNodeTagsVisitor(*m_tagManager));
+  auto brushNodes = std::vector<BrushNode*>{};
+  m_worldNode->accept(makeInitializeNodeTagsVisitor(*m_tagManager, brushNodes));
+  initializeBrushNodeTags(brushNodes, *m_tagManager, m_taskManager);
 }
 
 void Map::initializeNodeTags(const std::vector<Node*>& nodes)
 {
-  Node::visitAll(nodes, makeInitializeNodeTagsVisitor(*m_tagManager));
+  auto brushNodes = std::vector<BrushNode*>{};
+  Node::visitAll(nodes, makeInitializeNodeTagsVisitor(*m_tagManager, brushNodes));
+  initializeBrushNodeTags(brushNodes, *m_tagManager, m_taskManager);
 }
 
 void Map::clearNodeTags(const std::vector<Node*>& nodes)
@@ -1068,6 +1160,7 @@ void Map::updateFaceTags(const std::vector<BrushFaceHandle>& faceHandles)
 
 void Map::updateAllFaceTags()
 {
+  auto brushNodes = std::vector<BrushNode*>{};
   m_worldNode->accept(kdl::overload(
     [](auto&& thisLambda, WorldNode& worldNode) { worldNode.visitChildren(thisLambda); },
     [](auto&& thisLambda, LayerNode& layerNode) { layerNode.visitChildren(thisLambda); },
@@ -1075,8 +1168,10 @@ void Map::updateAllFaceTags()
     [](auto&& thisLambda, EntityNode& entityNode) {
       entityNode.visitChildren(thisLambda);
     },
-    [&](BrushNode& brushNode) { brushNode.initializeTags(*m_tagManager); },
+    [&](BrushNode& brushNode) { brushNodes.push_back(&brushNode); },
     [](PatchNode&) {}));
+
+  initializeBrushNodeTags(brushNodes, *m_tagManager, m_taskManager);
 }
 
 void Map::updateFaceTagsAfterResourcesWhereProcessed(
@@ -1112,6 +1207,31 @@ void Map::updateFaceTagsAfterResourcesWhereProcessed(
     [](PatchNode&) {}));
 }
 
+void Map::updateEntityBoundsAfterResourcesWereProcessed(
+  const std::vector<gl::ResourceId>& resourceIds)
+{
+  // Entity models are loaded asynchronously, and until then, point entities are shown
+  // with their definition bounds. Once a model is loaded, the entity bounds and the
+  // spacial index must be updated.
+
+  const auto resourceIdSet =
+    std::unordered_set<gl::ResourceId>{resourceIds.begin(), resourceIds.end()};
+
+  worldNode().accept(kdl::overload(
+    [](auto&& thisLambda, WorldNode& worldNode) { worldNode.visitChildren(thisLambda); },
+    [](auto&& thisLambda, LayerNode& layerNode) { layerNode.visitChildren(thisLambda); },
+    [](auto&& thisLambda, GroupNode& groupNode) { groupNode.visitChildren(thisLambda); },
+    [&](EntityNode& entityNode) {
+      if (const auto* model = entityNode.entity().model();
+          model && model->data() && resourceIdSet.contains(model->dataResource().id()))
+      {
+        entityNode.modelDataDidLoad();
+      }
+    },
+    [](BrushNode&) {},
+    [](PatchNode&) {}));
+}
+
 void Map::registerValidators()
 {
   m_worldNode->registerValidator(std::make_unique<MissingClassnameValidator>());
@@ -1175,9 +1295,13 @@ void Map::loadEntityDefinitions()
     const auto path =
       findEntityDefinitionFile(gameConfig, *spec, externalSearchPaths(*this));
     const auto& defaultColor = gameConfig.entityConfig.defaultColor;
-    auto status = SimpleParserStatus{logger()};
 
-    mdl::loadEntityDefinitions(path, defaultColor, status)
+    mdl::loadEntityDefinitions(
+      path,
+      defaultColor,
+      m_assetContext->entityDefinitionFileCache(),
+      taskManager(),
+      logger())
       | kdl::transform([&](auto entityDefinitions) {
           logger().info() << fmt::format(
             "Loaded entity definition file {}", path.filename());
@@ -1237,11 +1361,23 @@ void Map::loadMaterials()
   }
 
   m_materialManager->clear();
+  m_tagManager->precomputeMaterialTags({});
+
+  const auto searchPaths = gameSearchPaths(*this);
+  const auto createResource = [&](const auto& texturePath, auto resourceLoader) {
+    return m_assetContext->textureResourceCache().getOrCreate(
+      *m_gameFileSystem,
+      searchPaths,
+      texturePath,
+      std::move(resourceLoader),
+      makeCreateResource<gl::TextureResource>(m_resourceManager));
+  };
 
   loadMaterialCollections(
     *m_gameFileSystem,
     gameInfo().gameConfig.materialConfig,
-    makeCreateResource<gl::TextureResource>(m_resourceManager),
+    CreateFileResource<gl::Texture>{createResource},
+    m_assetContext->shaderCache(),
     taskManager(),
     m_logger)
     | kdl::transform([&](auto materialCollections) {
@@ -1250,12 +1386,15 @@ void Map::loadMaterials()
     | kdl::transform_error([&](auto e) {
         m_logger.error() << "Could not reload material collections: " + e.msg;
       });
+
+  m_tagManager->precomputeMaterialTags(m_materialManager->materials());
 }
 
 void Map::clearMaterials()
 {
   unsetMaterials();
   materialManager().clear();
+  m_tagManager->precomputeMaterialTags({});
 }
 
 void Map::setMaterials()
@@ -1368,14 +1507,12 @@ void Map::initializeNodeIndex()
 
 void Map::addToNodeIndex(const std::vector<Node*>& nodes, const bool recurse)
 {
-  for (auto* node : nodes)
-  {
-    m_nodeIndex->addNode(*node);
+  const auto nodesToAdd = recurse ? collectNodesAndDescendants(nodes) : nodes;
+  m_nodeIndex->addNodes(nodesToAdd);
 
-    if (recurse)
-    {
-      addToNodeIndex(node->children(), true);
-    }
+  for (auto* node : nodesToAdd)
+  {
+    m_materialIndex->addNode(*node);
   }
 }
 
@@ -1384,6 +1521,7 @@ void Map::removeFromNodeIndex(const std::vector<Node*>& nodes, const bool recurs
   for (auto* node : nodes)
   {
     m_nodeIndex->removeNode(*node);
+    m_materialIndex->removeNode(*node);
 
     if (recurse)
     {
@@ -1394,7 +1532,16 @@ void Map::removeFromNodeIndex(const std::vector<Node*>& nodes, const bool recurs
 
 void Map::initializeEntityLinks()
 {
-  addEntityLinks({&worldNode()}, true);
+  auto entityNodes = std::vector<EntityNodeBase*>{&worldNode()};
+  worldNode().accept(kdl::overload(
+    [](auto&& thisLambda, WorldNode& worldNode) { worldNode.visitChildren(thisLambda); },
+    [](auto&& thisLambda, LayerNode& layerNode) { layerNode.visitChildren(thisLambda); },
+    [](auto&& thisLambda, GroupNode& groupNode) { groupNode.visitChildren(thisLambda); },
+    [&](EntityNode& entityNode) { entityNodes.push_back(&entityNode); },
+    [](BrushNode&) {},
+    [](PatchNode&) {}));
+
+  m_entityLinkManager->addEntityNodes(entityNodes, taskManager());
 }
 
 void Map::clearEntityLinks()
@@ -1463,8 +1610,10 @@ const std::string* Map::redoCommandName() const
 
 void Map::undoCommand()
 {
+  m_nodeChangeBatcher->startTransaction(TransactionScope::Oneshot);
   m_commandProcessor->undo();
   updateLinkedGroups(*this);
+  m_nodeChangeBatcher->endTransaction();
 
   // Undo/redo in the repeat system is not supported for now, so just clear the repeat
   // stack
@@ -1473,8 +1622,10 @@ void Map::undoCommand()
 
 void Map::redoCommand()
 {
+  m_nodeChangeBatcher->startTransaction(TransactionScope::Oneshot);
   m_commandProcessor->redo();
   updateLinkedGroups(*this);
+  m_nodeChangeBatcher->endTransaction();
 
   // Undo/redo in the repeat system is not supported for now, so just clear the repeat
   // stack
@@ -1491,6 +1642,16 @@ void Map::setIsCommandCollationEnabled(const bool isCommandCollationEnabled)
   m_commandProcessor->setIsCollationEnabled(isCommandCollationEnabled);
 }
 
+std::optional<size_t> Map::undoMemoryLimit() const
+{
+  return m_commandProcessor->undoMemoryLimit();
+}
+
+void Map::setUndoMemoryLimit(const std::optional<size_t> undoMemoryLimit)
+{
+  m_commandProcessor->setUndoMemoryLimit(undoMemoryLimit);
+}
+
 void Map::pushRepeatableCommand(RepeatableCommand command)
 {
   m_repeatStack->push(std::move(command));
@@ -1516,6 +1677,7 @@ void Map::startTransaction(std::string name, const TransactionScope scope)
   logger().debug() << "Starting transaction '" + name + "'";
   m_commandProcessor->startTransaction(std::move(name), scope);
   m_repeatStack->startTransaction();
+  m_nodeChangeBatcher->startTransaction(scope);
 }
 
 void Map::rollbackTransaction()
@@ -1537,6 +1699,7 @@ bool Map::commitTransaction()
 
   m_commandProcessor->commitTransaction();
   m_repeatStack->commitTransaction();
+  m_nodeChangeBatcher->endTransaction();
   return true;
 }
 
@@ -1547,6 +1710,7 @@ void Map::cancelTransaction()
   m_repeatStack->rollbackTransaction();
   m_commandProcessor->commitTransaction();
   m_repeatStack->commitTransaction();
+  m_nodeChangeBatcher->endTransaction();
 }
 
 bool Map::isCurrentDocumentStateObservable() const
@@ -1578,6 +1742,19 @@ void Map::connectObservers()
   m_notifierConnection += nodesWillChangeNotifier.connect(this, &Map::nodesWillChange);
   m_notifierConnection += nodesDidChangeNotifier.connect(this, &Map::nodesDidChange);
 
+  // connected after the handlers above so that the batched notifications are delivered
+  // after the node index, the tags and the entity links were updated
+  m_notifierConnection += nodesWereAddedNotifier.connect(
+    m_nodeChangeBatcher.get(), &NodeChangeBatcher::nodesWereAdded);
+  m_notifierConnection += nodesWereRemovedNotifier.connect(
+    m_nodeChangeBatcher.get(), &NodeChangeBatcher::nodesWereRemoved);
+  m_notifierConnection += nodesDidChangeNotifier.connect(
+    m_nodeChangeBatcher.get(), &NodeChangeBatcher::nodesDidChange);
+  m_notifierConnection += nodeVisibilityDidChangeNotifier.connect(
+    m_nodeChangeBatcher.get(), &NodeChangeBatcher::nodeVisibilityDidChange);
+  m_notifierConnection += nodeLockingDidChangeNotifier.connect(
+    m_nodeChangeBatcher.get(), &NodeChangeBatcher::nodeLockingDidChange);
+
   m_notifierConnection +=
     selectionDidChangeNotifier.connect(this, &Map::selectionDidChange);
   m_notifierConnection +=
@@ -1601,6 +1778,9 @@ void Map::connectObservers()
 
   m_notifierConnection += m_resourceManager.resourcesWereProcessedNotifier.connect(
     this, &Map::resourcesWereProcessed);
+
+  m_notifierConnection += m_commandProcessor->undoCommandsDiscardedNotifier.connect(
+    this, &Map::undoCommandsDiscarded);
 }
 
 namespace
@@ -1717,6 +1897,7 @@ void Map::brushFacesDidChange(const std::vector<BrushFaceHandle>& brushFaces)
 void Map::resourcesWereProcessed(const std::vector<gl::ResourceId>& resourceIds)
 {
   updateFaceTagsAfterResourcesWhereProcessed(resourceIds);
+  updateEntityBoundsAfterResourcesWereProcessed(resourceIds);
 }
 
 void Map::selectionWillChange()
@@ -1776,4 +1957,12 @@ void Map::modsDidChange()
   updateAllFaceTags();
 }
 
+void Map::undoCommandsDiscarded(const size_t count, const size_t memorySize)
+{
+  logger().info() << fmt::format(
+    "Discarded {} undo steps ({:.1f} MiB) to stay within the undo memory limit",
+    count,
+    double(memorySize) / (1024.0 * 1024.0));
+}
+
 } // namespace tb::mdl
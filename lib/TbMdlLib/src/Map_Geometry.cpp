@@ -56,6 +56,8 @@
 #include "kd/string_format.h"
 #include "kd/task_manager.h"
 
+#include <chrono>
+#include <functional>
 #include <ranges>
 
 namespace tb::mdl
@@ -282,8 +284,9 @@ TransformVerticesResult transformVertices(
     kdl::str_plural(vertexPositions.size(), "Move Brush Vertex", "Move Brush Vertices");
   auto transaction = Transaction{map, commandName};
 
-  const auto changedLinkedGroups = collectContainingGroups(
-    *newNodes | std::views::keys | kdl::ranges::to<std::vector>());
+  const auto changedNodes =
+    *newNodes | std::views::keys | kdl::ranges::to<std::vector>();
+  const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
   auto command = std::make_unique<BrushVertexCommand>(
     std::move(commandName),
@@ -297,7 +300,7 @@ TransformVerticesResult transformVertices(
     return TransformVerticesResult{false, false};
   }
 
-  setHasPendingChanges(changedLinkedGroups, true);
+  addPendingContentChanges(changedLinkedGroups, changedNodes);
 
   if (!transaction.commit())
   {
@@ -358,8 +361,9 @@ bool transformEdges(
       kdl::str_plural(edgePositions.size(), "Move Brush Edge", "Move Brush Edges");
     auto transaction = Transaction{map, commandName};
 
-    const auto changedLinkedGroups = collectContainingGroups(
-      *newNodes | std::views::keys | kdl::ranges::to<std::vector>());
+    const auto changedNodes =
+      *newNodes | std::views::keys | kdl::ranges::to<std::vector>();
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = map.executeAndStore(std::make_unique<BrushEdgeCommand>(
       commandName,
@@ -373,7 +377,7 @@ bool transformEdges(
       return false;
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    addPendingContentChanges(changedLinkedGroups, changedNodes);
     return transaction.commit();
   }
 
@@ -431,8 +435,9 @@ bool transformFaces(
       kdl::str_plural(facePositions.size(), "Move Brush Face", "Move Brush Faces");
     auto transaction = Transaction{map, commandName};
 
-    auto changedLinkedGroups = collectContainingGroups(
-      *newNodes | std::views::keys | kdl::ranges::to<std::vector>());
+    const auto changedNodes =
+      *newNodes | std::views::keys | kdl::ranges::to<std::vector>();
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = map.executeAndStore(std::make_unique<BrushFaceCommand>(
       commandName,
@@ -446,7 +451,7 @@ bool transformFaces(
       return false;
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    addPendingContentChanges(changedLinkedGroups, changedNodes);
     return transaction.commit();
   }
 
@@ -480,8 +485,9 @@ bool addVertex(Map& map, const vm::vec3d& vertexPosition)
     const auto commandName = "Add Brush Vertex";
     auto transaction = Transaction{map, commandName};
 
-    const auto changedLinkedGroups = collectContainingGroups(
-      *newNodes | std::views::keys | kdl::ranges::to<std::vector>());
+    const auto changedNodes =
+      *newNodes | std::views::keys | kdl::ranges::to<std::vector>();
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = map.executeAndStore(std::make_unique<BrushVertexCommand>(
       commandName,
@@ -495,7 +501,7 @@ bool addVertex(Map& map, const vm::vec3d& vertexPosition)
       return false;
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    addPendingContentChanges(changedLinkedGroups, changedNodes);
     return transaction.commit();
   }
 
@@ -539,8 +545,9 @@ bool removeVertices(
   {
     auto transaction = Transaction{map, commandName};
 
-    auto changedLinkedGroups = collectContainingGroups(
-      *newNodes | std::views::keys | kdl::ranges::to<std::vector>());
+    const auto changedNodes =
+      *newNodes | std::views::keys | kdl::ranges::to<std::vector>();
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = map.executeAndStore(std::make_unique<BrushVertexCommand>(
       commandName,
@@ -554,7 +561,7 @@ bool removeVertices(
       return false;
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    addPendingContentChanges(changedLinkedGroups, changedNodes);
     return transaction.commit();
   }
 
@@ -704,36 +711,61 @@ bool csgConvexMerge(Map& map)
 
 bool csgSubtract(Map& map)
 {
+  using Clock = std::chrono::high_resolution_clock;
+
   const auto subtrahendNodes = std::vector<BrushNode*>{map.selection().brushes};
   if (subtrahendNodes.empty())
   {
     return false;
   }
 
+  const auto startTime = Clock::now();
+
   auto transaction = Transaction{map, "CSG Subtract"};
   // Select touching, but don't delete the subtrahends yet
   selectTouchingNodes(map, false);
 
   const auto minuendNodes = std::vector<BrushNode*>{map.selection().brushes};
+  const auto selectTime = Clock::now();
+
+  // Every minuend is only clipped by the subtrahends that overlap it, and the minuends
+  // are processed in parallel.
+  const auto mapFormat = map.worldNode().mapFormat();
+  const auto worldBounds = map.worldBounds();
+  const auto materialName = map.currentMaterialName();
+
   const auto subtrahends = subtrahendNodes
                            | std::views::transform([](const auto* subtrahendNode) {
                                return &subtrahendNode->brush();
                              })
                            | kdl::ranges::to<std::vector>();
 
+  auto tasks = minuendNodes | std::views::transform([&](auto* minuendNode) {
+                 return std::function{[&, minuendNode]() {
+                   const auto& minuend = minuendNode->brush();
+                   const auto overlappingSubtrahends =
+                     subtrahends | std::views::filter([&](const auto* subtrahend) {
+                       return minuend.bounds().intersects(subtrahend->bounds());
+                     })
+                     | kdl::ranges::to<std::vector>();
+
+                   return std::pair{
+                     minuendNode,
+                     minuend.subtract(
+                       mapFormat, worldBounds, materialName, overlappingSubtrahends)};
+                 }};
+               });
+
+  auto subtractionResults = map.taskManager().run_tasks_and_wait(std::move(tasks));
+  const auto subtractTime = Clock::now();
+
   auto toAdd = std::map<Node*, std::vector<Node*>>{};
   auto toRemove =
     std::vector<Node*>{std::begin(subtrahendNodes), std::end(subtrahendNodes)};
 
-  return minuendNodes | std::views::transform([&](auto* minuendNode) {
-           const auto& minuend = minuendNode->brush();
-           auto currentSubtractionResults = minuend.subtract(
-             map.worldNode().mapFormat(),
-             map.worldBounds(),
-             map.currentMaterialName(),
-             subtrahends);
-
-           return currentSubtractionResults
+  return subtractionResults | std::views::transform([&](auto& entry) {
+           auto* minuendNode = entry.first;
+           return entry.second
                   | std::views::filter([](const auto r) { return r | kdl::is_success(); })
                   | kdl::views::as_rvalue | kdl::fold
                   | kdl::transform([&](auto currentBrushes) {
@@ -758,6 +790,24 @@ bool csgSubtract(Map& map)
              removeNodes(map, toRemove);
              selectNodes(map, added);
 
+             const auto endTime = Clock::now();
+             map.logger().debug() << fmt::format(
+               "Subtracted {} {} from {} {}: selected minuends in {}ms, subtracted in "
+               "{}ms, updated map in {}ms",
+               subtrahendNodes.size(),
+               kdl::str_plural(subtrahendNodes.size(), "brush", "brushes"),
+               minuendNodes.size(),
+               kdl::str_plural(minuendNodes.size(), "brush", "brushes"),
+               std::chrono::duration_cast<std::chrono::milliseconds>(
+                 selectTime - startTime)
+                 .count(),
+               std::chrono::duration_cast<std::chrono::milliseconds>(
+                 subtractTime - selectTime)
+                 .count(),
+               std::chrono::duration_cast<std::chrono::milliseconds>(
+                 endTime - subtractTime)
+                 .count());
+
              return transaction.commit();
            })
          | kdl::transform_error([&](const auto& e) {
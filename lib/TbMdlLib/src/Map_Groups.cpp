@@ -46,6 +46,8 @@
 
 #include <algorithm>
 #include <ranges>
+#include <unordered_map>
+#include <vector>
 
 namespace tb::mdl
 {
@@ -636,4 +638,34 @@ void setHasPendingChanges(
   }
 }
 
+void addPendingContentChanges(
+  const std::vector<GroupNode*>& groupNodes, const std::vector<Node*>& changedNodes)
+{
+  auto changedNodesPerGroup = std::unordered_map<GroupNode*, std::vector<const Node*>>{};
+  for (auto* groupNode : groupNodes)
+  {
+    changedNodesPerGroup[groupNode];
+  }
+
+  for (const auto* changedNode : changedNodes)
+  {
+    for (auto* ancestor = changedNode->parent(); ancestor; ancestor = ancestor->parent())
+    {
+      if (auto* groupNode = dynamic_cast<GroupNode*>(ancestor))
+      {
+        if (const auto it = changedNodesPerGroup.find(groupNode);
+            it != changedNodesPerGroup.end())
+        {
+          it->second.push_back(changedNode);
+        }
+      }
+    }
+  }
+
+  for (auto& [groupNode, nodes] : changedNodesPerGroup)
+  {
+    groupNode->addPendingContentChanges(nodes);
+  }
+}
+
 } // namespace tb::mdl
@@ -473,6 +473,9 @@ bool updateNodeContents(
     return false;
   }
 
+  const auto changedNodes =
+    nodesToSwap | std::views::elements<0> | kdl::ranges::to<std::vector>();
+
   auto transaction = Transaction{map};
   if (!map.executeAndStore(
         std::make_unique<SwapNodeContentsCommand>(commandName, std::move(nodesToSwap))))
@@ -481,7 +484,7 @@ bool updateNodeContents(
     return false;
   }
 
-  setHasPendingChanges(changedLinkedGroups, true);
+  addPendingContentChanges(changedLinkedGroups, changedNodes);
   return transaction.commit();
 }
 
@@ -22,6 +22,7 @@
 #include "Logger.h"
 #include "mdl/BrushBuilder.h"
 #include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
 #include "mdl/EditorContext.h"
 #include "mdl/EntityNode.h"
 #include "mdl/GroupNode.h"
@@ -30,6 +31,7 @@
 #include "mdl/Map.h"
 #include "mdl/Map_Groups.h"
 #include "mdl/Map_Nodes.h"
+#include "mdl/MaterialIndex.h"
 #include "mdl/ModelUtils.h"
 #include "mdl/Node.h"
 #include "mdl/PatchNode.h"
@@ -40,7 +42,6 @@
 #include "kd/contracts.h"
 #include "kd/ranges/to.h"
 #include "kd/result_fold.h"
-#include "kd/string_compare.h"
 
 #include <algorithm>
 #include <ranges>
@@ -255,18 +256,54 @@ void selectNodesWithFilePosition(Map& map, const std::vector<size_t>& positions)
   transaction.commit();
 }
 
+namespace
+{
+
+/**
+ * Returns the node that would be selected in place of the given brush node. This is the
+ * closed group that contains the brush node if it is selectable, otherwise the brush node
+ * itself if it is selectable, or null.
+ */
+Node* findSelectableNodeForBrushNode(
+  BrushNode& brushNode, const EditorContext& editorContext)
+{
+  for (auto* groupNode = brushNode.containingGroup(); groupNode;
+       groupNode = groupNode->containingGroup())
+  {
+    if (editorContext.selectable(*groupNode))
+    {
+      return groupNode;
+    }
+  }
+
+  return editorContext.selectable(brushNode) ? &brushNode : nullptr;
+}
+
+std::vector<BrushFaceHandle> findSelectableBrushFacesWithMaterial(
+  const Map& map, const std::string_view materialName)
+{
+  return map.materialIndex().findBrushFaces(materialName)
+         | std::views::filter([&](const auto& h) {
+             return map.editorContext().selectable(*h.node(), h.face());
+           })
+         | kdl::ranges::to<std::vector>();
+}
+
+} // namespace
+
 void selectBrushesWithMaterial(Map& map, const std::string_view materialName)
 {
-  const auto brushes =
-    collectSelectableNodes(std::vector<Node*>{&map.worldNode()}, map.editorContext())
-    | std::views::filter([&](const auto& node) {
-        return std::ranges::any_of(
-          collectSelectableBrushFaces({node}, map.editorContext()), [&](const auto& h) {
-            return kdl::ci::str_is_equal(
-              h.face().attributes().materialName(), materialName);
-          });
-      })
-    | kdl::ranges::to<std::vector>();
+  auto brushes = std::vector<Node*>{};
+  auto visited = std::unordered_set<Node*>{};
+
+  for (const auto& handle : findSelectableBrushFacesWithMaterial(map, materialName))
+  {
+    if (auto* node = findSelectableNodeForBrushNode(*handle.node(), map.editorContext());
+        node && visited.insert(node).second)
+    {
+      brushes.push_back(node);
+    }
+  }
 
   auto transaction = Transaction{map, "Select Brushes with Material"};
   deselectAll(map);
@@ -378,12 +415,7 @@ void selectBrushFaces(Map& map, const std::vector<BrushFaceHandle>& handles)
 
 void selectBrushFacesWithMaterial(Map& map, const std::string_view materialName)
 {
-  const auto faces =
-    collectSelectableBrushFaces(std::vector<Node*>{&map.worldNode()}, map.editorContext())
-    | std::views::filter([&](const auto& h) {
-        return kdl::ci::str_is_equal(h.face().attributes().materialName(), materialName);
-      })
-    | kdl::ranges::to<std::vector>();
+  const auto faces = findSelectableBrushFacesWithMaterial(map, materialName);
 
   auto transaction = Transaction{map, "Select Faces with Material"};
   deselectAll(map);
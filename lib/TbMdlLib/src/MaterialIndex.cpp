@@ -0,0 +1,163 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/MaterialIndex.h"
+
+#include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EntityNode.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/PatchNode.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/contracts.h"
+#include "kd/overload.h"
+#include "kd/string_compare.h"
+#include "kd/string_format.h"
+
+#include <algorithm>
+
+namespace tb::mdl
+{
+
+void MaterialIndex::addNode(Node& node)
+{
+  node.accept(kdl::overload(
+    [](WorldNode&) {},
+    [](LayerNode&) {},
+    [](GroupNode&) {},
+    [](EntityNode&) {},
+    [&](BrushNode& brushNode) { addBrushNode(brushNode); },
+    [](PatchNode&) {}));
+}
+
+void MaterialIndex::removeNode(Node& node)
+{
+  node.accept(kdl::overload(
+    [](WorldNode&) {},
+    [](LayerNode&) {},
+    [](GroupNode&) {},
+    [](EntityNode&) {},
+    [&](BrushNode& brushNode) { removeBrushNode(brushNode); },
+    [](PatchNode&) {}));
+}
+
+void MaterialIndex::clear()
+{
+  m_index.clear();
+}
+
+std::vector<BrushNode*> MaterialIndex::findBrushNodes(
+  const std::string_view materialName) const
+{
+  auto result = std::vector<BrushNode*>{};
+  if (const auto* entry = findEntry(materialName))
+  {
+    result.reserve(entry->brushNodes.size());
+    for (const auto& [brushNode, faceCount] : entry->brushNodes)
+    {
+      result.push_back(brushNode);
+    }
+  }
+  return result;
+}
+
+std::vector<BrushFaceHandle> MaterialIndex::findBrushFaces(
+  const std::string_view materialName) const
+{
+  auto result = std::vector<BrushFaceHandle>{};
+  if (const auto* entry = findEntry(materialName))
+  {
+    result.reserve(entry->faceCount);
+    for (const auto& [brushNode, faceCount] : entry->brushNodes)
+    {
+      const auto& brush = brushNode->brush();
+      for (size_t i = 0; i < brush.faceCount(); ++i)
+      {
+        if (kdl::ci::str_is_equal(
+              brush.face(i).attributes().materialName(), materialName))
+        {
+          result.emplace_back(brushNode, i);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+size_t MaterialIndex::usageCount(const std::string_view materialName) const
+{
+  const auto* entry = findEntry(materialName);
+  return entry ? entry->faceCount : 0;
+}
+
+std::vector<std::string> MaterialIndex::materialNames() const
+{
+  auto result = std::vector<std::string>{};
+  result.reserve(m_index.size());
+  for (const auto& [materialName, entry] : m_index)
+  {
+    result.push_back(materialName);
+  }
+  std::ranges::sort(result);
+  return result;
+}
+
+void MaterialIndex::addBrushNode(BrushNode& brushNode)
+{
+  for (const auto& face : brushNode.brush().faces())
+  {
+    auto& entry = m_index[kdl::str_to_lower(face.attributes().materialName())];
+    ++entry.brushNodes[&brushNode];
+    ++entry.faceCount;
+  }
+}
+
+void MaterialIndex::removeBrushNode(BrushNode& brushNode)
+{
+  for (const auto& face : brushNode.brush().faces())
+  {
+    const auto iEntry = m_index.find(kdl::str_to_lower(face.attributes().materialName()));
+    contract_assert(iEntry != m_index.end());
+
+    auto& entry = iEntry->second;
+    const auto iBrushNode = entry.brushNodes.find(&brushNode);
+    contract_assert(iBrushNode != entry.brushNodes.end());
+
+    if (--iBrushNode->second == 0)
+    {
+      entry.brushNodes.erase(iBrushNode);
+    }
+    if (--entry.faceCount == 0)
+    {
+      m_index.erase(iEntry);
+    }
+  }
+}
+
+const MaterialIndex::Entry* MaterialIndex::findEntry(
+  const std::string_view materialName) const
+{
+  const auto iEntry = m_index.find(kdl::str_to_lower(materialName));
+  return iEntry != m_index.end() ? &iEntry->second : nullptr;
+}
+
+} // namespace tb::mdl
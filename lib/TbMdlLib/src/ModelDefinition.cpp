@@ -142,17 +142,20 @@ std::optional<vm::vec3d> convertToScale(
 } // namespace
 
 ModelDefinition::ModelDefinition()
-  : m_expression{el::LiteralExpression{el::Value::Undefined}}
+  : ModelDefinition{el::ExpressionNode{el::LiteralExpression{el::Value::Undefined}}}
 {
 }
 
 ModelDefinition::ModelDefinition(const FileLocation& location)
-  : m_expression{el::LiteralExpression{el::Value::Undefined}, location}
+  : ModelDefinition{
+      el::ExpressionNode{el::LiteralExpression{el::Value::Undefined}, location}}
 {
 }
 
 ModelDefinition::ModelDefinition(el::ExpressionNode expression)
   : m_expression{std::move(expression)}
+  , m_modelSpecificationCache{
+      std::make_shared<el::ExpressionCache<Result<ModelSpecification>>>(m_expression)}
 {
 }
 
@@ -162,16 +165,20 @@ void ModelDefinition::append(ModelDefinition other)
 
   auto cases = std::vector{std::move(m_expression), std::move(other.m_expression)};
   m_expression = el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location};
+  m_modelSpecificationCache =
+    std::make_shared<el::ExpressionCache<Result<ModelSpecification>>>(m_expression);
 }
 
 Result<ModelSpecification> ModelDefinition::modelSpecification(
   const el::VariableStore& variableStore) const
 {
-  return el::withEvaluationContext(
-    [&](auto& context) {
-      return convertToModel(context, m_expression.evaluate(context));
-    },
-    variableStore);
+  return m_modelSpecificationCache->get(variableStore, [&]() {
+    return el::withEvaluationContext(
+      [&](auto& context) {
+        return convertToModel(context, m_expression.evaluate(context));
+      },
+      variableStore);
+  });
 }
 
 Result<ModelSpecification> ModelDefinition::defaultModelSpecification() const
@@ -0,0 +1,166 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/NodeChangeBatcher.h"
+
+#include "mdl/Node.h"
+#include "mdl/TransactionScope.h"
+
+#include "kd/contracts.h"
+#include "kd/vector_utils.h"
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+
+namespace tb::mdl
+{
+namespace
+{
+
+void append(std::vector<Node*>& nodes, const std::vector<Node*>& toAppend)
+{
+  nodes.insert(nodes.end(), toAppend.begin(), toAppend.end());
+}
+
+void eraseRemovedNodes(
+  std::vector<Node*>& nodes, const std::unordered_set<const Node*>& removedNodes)
+{
+  std::erase_if(nodes, [&](const auto* node) {
+    for (const auto* n = node; n != nullptr; n = n->parent())
+    {
+      if (removedNodes.contains(n))
+      {
+        return true;
+      }
+    }
+    return false;
+  });
+}
+
+void eraseNodes(std::vector<Node*>& nodes, const std::unordered_set<const Node*>& toErase)
+{
+  std::erase_if(nodes, [&](const auto* node) { return toErase.contains(node); });
+}
+
+} // namespace
+
+NodeChangeBatcher::NodeChangeBatcher(Notifier<const NodeChanges&>& nodeChangesNotifier)
+  : m_nodeChangesNotifier{nodeChangesNotifier}
+{
+}
+
+bool NodeChangeBatcher::isBatching() const
+{
+  return kdl::vec_contains(m_openTransactions, TransactionScope::Oneshot);
+}
+
+void NodeChangeBatcher::startTransaction(const TransactionScope scope)
+{
+  m_openTransactions.push_back(scope);
+}
+
+void NodeChangeBatcher::endTransaction()
+{
+  contract_pre(!m_openTransactions.empty());
+
+  m_openTransactions.pop_back();
+  if (!isBatching())
+  {
+    flush();
+  }
+}
+
+void NodeChangeBatcher::nodesWereAdded(const std::vector<Node*>& nodes)
+{
+  notify({.addedNodes = nodes});
+}
+
+void NodeChangeBatcher::nodesWereRemoved(const std::vector<Node*>& nodes)
+{
+  if (m_pendingChanges.empty())
+  {
+    return;
+  }
+
+  const auto removedNodes = std::unordered_set<const Node*>{nodes.begin(), nodes.end()};
+  eraseRemovedNodes(m_pendingChanges.addedNodes, removedNodes);
+  eraseRemovedNodes(m_pendingChanges.changedNodes, removedNodes);
+  eraseRemovedNodes(m_pendingChanges.visibilityChangedNodes, removedNodes);
+  eraseRemovedNodes(m_pendingChanges.lockingChangedNodes, removedNodes);
+}
+
+void NodeChangeBatcher::nodesDidChange(const std::vector<Node*>& nodes)
+{
+  notify({.changedNodes = nodes});
+}
+
+void NodeChangeBatcher::nodeVisibilityDidChange(const std::vector<Node*>& nodes)
+{
+  notify({.visibilityChangedNodes = nodes});
+}
+
+void NodeChangeBatcher::nodeLockingDidChange(const std::vector<Node*>& nodes)
+{
+  notify({.lockingChangedNodes = nodes});
+}
+
+void NodeChangeBatcher::notify(NodeChanges nodeChanges)
+{
+  if (isBatching())
+  {
+    append(m_pendingChanges.addedNodes, nodeChanges.addedNodes);
+    append(m_pendingChanges.changedNodes, nodeChanges.changedNodes);
+    append(m_pendingChanges.visibilityChangedNodes, nodeChanges.visibilityChangedNodes);
+    append(m_pendingChanges.lockingChangedNodes, nodeChanges.lockingChangedNodes);
+  }
+  else if (!nodeChanges.empty())
+  {
+    m_nodeChangesNotifier(nodeChanges);
+  }
+}
+
+void NodeChangeBatcher::flush()
+{
+  if (m_pendingChanges.empty())
+  {
+    return;
+  }
+
+  auto nodeChanges = std::exchange(m_pendingChanges, NodeChanges{});
+  nodeChanges.addedNodes =
+    kdl::vec_sort_and_remove_duplicates(std::move(nodeChanges.addedNodes));
+  nodeChanges.changedNodes =
+    kdl::vec_sort_and_remove_duplicates(std::move(nodeChanges.changedNodes));
+  nodeChanges.visibilityChangedNodes =
+    kdl::vec_sort_and_remove_duplicates(std::move(nodeChanges.visibilityChangedNodes));
+  nodeChanges.lockingChangedNodes =
+    kdl::vec_sort_and_remove_duplicates(std::move(nodeChanges.lockingChangedNodes));
+
+  // the entire state of an added node is new, so its other changes are redundant
+  const auto addedNodes = std::unordered_set<const Node*>{
+    nodeChanges.addedNodes.begin(), nodeChanges.addedNodes.end()};
+  eraseNodes(nodeChanges.changedNodes, addedNodes);
+  eraseNodes(nodeChanges.visibilityChangedNodes, addedNodes);
+  eraseNodes(nodeChanges.lockingChangedNodes, addedNodes);
+
+  m_nodeChangesNotifier(nodeChanges);
+}
+
+} // namespace tb::mdl
@@ -20,6 +20,12 @@
 #include "mdl/NodeContents.h"
 
 #include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EntityNode.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/PatchNode.h"
+#include "mdl/WorldNode.h"
 
 #include "kd/overload.h"
 
@@ -55,4 +61,30 @@ std::variant<Layer, Group, Entity, Brush, BezierPatch>& NodeContents::get()
   return m_contents;
 }
 
+NodeContents swapNodeContents(Node& node, NodeContents contents)
+{
+  auto& newContents = contents.get();
+  return node.accept(kdl::overload(
+    [&](WorldNode& worldNode) {
+      return NodeContents{worldNode.setEntity(std::get<Entity>(std::move(newContents)))};
+    },
+    [&](LayerNode& layerNode) {
+      return NodeContents{layerNode.setLayer(std::get<Layer>(std::move(newContents)))};
+    },
+    [&](GroupNode& groupNode) {
+      return NodeContents{groupNode.setGroup(std::get<Group>(std::move(newContents)))};
+    },
+    [&](EntityNode& entityNode) {
+      return NodeContents{
+        entityNode.setEntity(std::get<Entity>(std::move(newContents)))};
+    },
+    [&](BrushNode& brushNode) {
+      return NodeContents{brushNode.setBrush(std::get<Brush>(std::move(newContents)))};
+    },
+    [&](PatchNode& patchNode) {
+      return NodeContents{
+        patchNode.setPatch(std::get<BezierPatch>(std::move(newContents)))};
+    }));
+}
+
 } // namespace tb::mdl
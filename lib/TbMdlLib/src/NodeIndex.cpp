@@ -34,7 +34,14 @@
 #include "mdl/WorldNode.h"
 
 #include "kd/compact_trie.h"
-#include "kd/vector_utils.h"
+#include "kd/overload.h"
+#include "kd/ranges/to.h"
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <utility>
 
 namespace tb::mdl
 {
@@ -72,10 +79,103 @@ void withPatchNode(PatchNode& patchNode, const F& f)
   f(patchNode.patch().materialName());
 }
 
+/**
+ * Calls the given function with every string of the given node that should be indexed
+ * and the corresponding index entry.
+ */
+template <typename F>
+void withIndexedStrings(Node& node, const F& f)
+{
+  const auto withEntry = [&](Node& n, const NodeKind kind) {
+    const auto entry = NodeIndexEntry{&n, kind};
+    return [&, entry](const std::string_view str) { f(str, entry); };
+  };
+
+  node.accept(kdl::overload(
+    [&](WorldNode& worldNode) {
+      withEntityNode(worldNode, withEntry(worldNode, NodeKind::World));
+    },
+    [](LayerNode&) {},
+    [&](GroupNode& groupNode) {
+      withGroupNode(groupNode, withEntry(groupNode, NodeKind::Group));
+    },
+    [&](EntityNode& entityNode) {
+      withEntityNode(entityNode, withEntry(entityNode, NodeKind::Entity));
+    },
+    [&](BrushNode& brushNode) {
+      withBrushNode(brushNode, withEntry(brushNode, NodeKind::Brush));
+    },
+    [&](PatchNode& patchNode) {
+      withPatchNode(patchNode, withEntry(patchNode, NodeKind::Patch));
+    }));
+}
+
+auto reversed(const std::string_view str)
+{
+  return std::string{str.rbegin(), str.rend()};
+}
+
+bool isWildcard(const char c)
+{
+  return c == '*' || c == '?' || c == '%';
+}
+
+/**
+ * If the given pattern does not contain any wildcards, returns the string it matches.
+ * Returns an empty optional if the pattern contains wildcards or an invalid escape
+ * sequence, which is left to the trie to report.
+ */
+std::optional<std::string> getLiteral(const std::string_view pattern)
+{
+  auto result = std::string{};
+  result.reserve(pattern.size());
+
+  for (size_t i = 0; i < pattern.size(); ++i)
+  {
+    const auto c = pattern[i];
+    if (c == '\\' && i + 1 < pattern.size())
+    {
+      const auto escaped = pattern[++i];
+      if (!isWildcard(escaped) && escaped != '\\')
+      {
+        return std::nullopt;
+      }
+      result.push_back(escaped);
+    }
+    else if (isWildcard(c))
+    {
+      return std::nullopt;
+    }
+    else
+    {
+      result.push_back(c);
+    }
+  }
+
+  return result;
+}
+
+/**
+ * If the given pattern consists of a single leading `*` followed by a non-empty literal
+ * string, returns that literal string.
+ */
+std::optional<std::string> getLiteralSuffix(const std::string_view pattern)
+{
+  if (pattern.size() > 1 && pattern.front() == '*')
+  {
+    if (auto suffix = getLiteral(pattern.substr(1)); suffix && !suffix->empty())
+    {
+      return suffix;
+    }
+  }
+  return std::nullopt;
+}
+
 } // namespace
 
 NodeIndex::NodeIndex()
   : m_index{std::make_unique<NodeStringIndex>()}
+  , m_reverseIndex{std::make_unique<NodeStringIndex>()}
 {
 }
 
@@ -88,44 +188,96 @@ std::string NodeIndex::escapePattern(std::string_view str)
 
 void NodeIndex::addNode(Node& node)
 {
-  const auto addToIndex = [&](const std::string_view key) {
-    m_index->insert(key, &node);
-  };
-
-  node.accept(kdl::overload(
-    [&](WorldNode& worldNode) { withEntityNode(worldNode, addToIndex); },
-    [](LayerNode&) {},
-    [&](GroupNode& groupNode) { withGroupNode(groupNode, addToIndex); },
-    [&](EntityNode& entityNode) { withEntityNode(entityNode, addToIndex); },
-    [&](BrushNode& brushNode) { withBrushNode(brushNode, addToIndex); },
-    [&](PatchNode& patchNode) { withPatchNode(patchNode, addToIndex); }));
+  withIndexedStrings(node, [&](const std::string_view str, const auto& entry) {
+    insert(str, entry);
+  });
 }
 
 void NodeIndex::removeNode(Node& node)
 {
-  const auto removeFromIndex = [&](const std::string_view key) {
-    m_index->remove(key, &node);
-  };
+  withIndexedStrings(node, [&](const std::string_view str, const auto& entry) {
+    remove(str, entry);
+  });
+}
 
-  node.accept(kdl::overload(
-    [&](WorldNode& worldNode) { withEntityNode(worldNode, removeFromIndex); },
-    [](LayerNode&) {},
-    [&](GroupNode& groupNode) { withGroupNode(groupNode, removeFromIndex); },
-    [&](EntityNode& entityNode) { withEntityNode(entityNode, removeFromIndex); },
-    [&](BrushNode& brushNode) { withBrushNode(brushNode, removeFromIndex); },
-    [&](PatchNode& patchNode) { withPatchNode(patchNode, removeFromIndex); }));
+void NodeIndex::addNodes(const std::vector<Node*>& nodes)
+{
+  auto strings = std::vector<std::pair<std::string_view, NodeIndexEntry>>{};
+  for (auto* node : nodes)
+  {
+    withIndexedStrings(*node, [&](const std::string_view str, const auto& entry) {
+      strings.emplace_back(str, entry);
+    });
+  }
+
+  // Inserting the strings in sorted order appends new nodes at the end of the sorted
+  // child lists in the trie instead of shifting them around.
+  std::ranges::sort(strings, {}, [](const auto& pair) { return pair.first; });
+
+  for (const auto& [str, entry] : strings)
+  {
+    m_index->insert(str, entry);
+  }
+
+  auto reversedStrings =
+    strings | std::views::transform([](const auto& pair) {
+      return std::pair{reversed(pair.first), pair.second};
+    })
+    | kdl::ranges::to<std::vector>();
+  std::ranges::sort(reversedStrings, {}, [](const auto& pair) { return pair.first; });
+
+  for (const auto& [str, entry] : reversedStrings)
+  {
+    m_reverseIndex->insert(str, entry);
+  }
 }
 
 void NodeIndex::clear()
 {
   m_index = std::make_unique<NodeStringIndex>();
+  m_reverseIndex = std::make_unique<NodeStringIndex>();
 }
 
-std::vector<Node*> NodeIndex::doFindNodes(const std::string_view pattern) const
+void NodeIndex::insert(const std::string_view key, const NodeIndexEntry& entry)
 {
-  auto result = std::vector<Node*>{};
-  m_index->find_matches(pattern, std::back_inserter(result));
-  return kdl::vec_sort_and_remove_duplicates(std::move(result));
+  m_index->insert(key, entry);
+  m_reverseIndex->insert(reversed(key), entry);
+}
+
+void NodeIndex::remove(const std::string_view key, const NodeIndexEntry& entry)
+{
+  m_index->remove(key, entry);
+  m_reverseIndex->remove(reversed(key), entry);
+}
+
+std::vector<NodeIndexEntry> NodeIndex::doFindNodes(const std::string_view pattern) const
+{
+  auto result = std::vector<NodeIndexEntry>{};
+
+  if (const auto literal = getLiteral(pattern))
+  {
+    m_index->find_values(*literal, std::back_inserter(result));
+  }
+  else if (const auto suffix = getLiteralSuffix(pattern))
+  {
+    m_reverseIndex->find_matches(
+      escapePattern(reversed(*suffix)) + "*", std::back_inserter(result));
+  }
+  else
+  {
+    m_index->find_matches(pattern, std::back_inserter(result));
+  }
+
+  std::ranges::sort(result, {}, &NodeIndexEntry::node);
+  const auto [first, last] = std::ranges::unique(result, {}, &NodeIndexEntry::node);
+  result.erase(first, last);
+  return result;
 }
 
 } // namespace tb::mdl
+
+std::size_t std::hash<tb::mdl::NodeIndexEntry>::operator()(
+  const tb::mdl::NodeIndexEntry& entry) const noexcept
+{
+  return std::hash<tb::mdl::Node*>{}(entry.node);
+}
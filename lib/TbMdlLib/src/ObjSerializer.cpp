@@ -22,68 +22,132 @@
 #include "gl/Material.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
+#include "mdl/EntityNode.h"
 #include "mdl/ExportOptions.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LayerNode.h"
 #include "mdl/PatchNode.h"
 #include "mdl/Polyhedron.h"
+#include "mdl/WorldNode.h"
 
 #include "kd/contracts.h"
 #include "kd/overload.h"
+#include "kd/task_manager.h"
 
 #include <fmt/format.h>
 
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <ranges>
 #include <utility>
 
 namespace tb::mdl
 {
 
-std::ostream& operator<<(std::ostream& str, const ObjSerializer::IndexedVertex& vertex)
+namespace
 {
-  str << " " << (vertex.vertex + 1u) << "/" << (vertex.uvCoords + 1u) << "/"
-      << (vertex.normal + 1u);
-  return str;
+
+using Buffer = fmt::memory_buffer;
+
+// the buffer is written to the stream whenever it grows beyond this size
+constexpr auto MaxBufferSize = size_t(1) << 20;
+
+void flush(std::ostream& str, Buffer& buffer)
+{
+  str.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  buffer.clear();
 }
 
-std::ostream& operator<<(std::ostream& str, const ObjSerializer::BrushObject& object)
+void flushIfFull(std::ostream& str, Buffer& buffer)
 {
-  str << "o entity" << object.entityNo << "_brush" << object.brushNo << "\n";
+  if (buffer.size() >= MaxBufferSize)
+  {
+    flush(str, buffer);
+  }
+}
+
+void format(Buffer& buffer, const ObjSerializer::IndexedVertex& vertex)
+{
+  fmt::format_to(
+    std::back_inserter(buffer),
+    " {}/{}/{}",
+    vertex.vertex + 1u,
+    vertex.uvCoords + 1u,
+    vertex.normal + 1u);
+}
+
+void format(Buffer& buffer, const ObjSerializer::BrushObject& object)
+{
+  fmt::format_to(
+    std::back_inserter(buffer), "o entity{}_brush{}\n", object.entityNo, object.brushNo);
   for (const auto& face : object.faces)
   {
-    str << "usemtl " << face.materialName << "\n";
-    str << "f";
+    fmt::format_to(std::back_inserter(buffer), "usemtl {}\nf", face.materialName);
     for (const auto& vertex : face.verts)
     {
-      str << " " << vertex;
+      buffer.push_back(' ');
+      format(buffer, vertex);
     }
-    str << "\n";
+    buffer.push_back('\n');
   }
-  return str;
 }
 
-std::ostream& operator<<(std::ostream& str, const ObjSerializer::PatchObject& object)
+void format(Buffer& buffer, const ObjSerializer::PatchObject& object)
 {
-  str << "o entity" << object.entityNo << "_patch" << object.patchNo << "\n";
-  str << "usemtl " << object.materialName << "\n";
+  fmt::format_to(
+    std::back_inserter(buffer),
+    "o entity{}_patch{}\nusemtl {}\n",
+    object.entityNo,
+    object.patchNo,
+    object.materialName);
   for (const auto& quad : object.quads)
   {
-    str << "f";
+    buffer.push_back('f');
     for (const auto& vertex : quad.verts)
     {
-      str << " " << vertex;
+      buffer.push_back(' ');
+      format(buffer, vertex);
     }
-    str << "\n";
+    buffer.push_back('\n');
   }
+}
+
+void format(Buffer& buffer, const ObjSerializer::Object& object)
+{
+  std::visit([&](const auto& x) { format(buffer, x); }, object);
+}
+
+template <typename T>
+std::ostream& write(std::ostream& str, const T& value)
+{
+  auto buffer = Buffer{};
+  format(buffer, value);
+  flush(str, buffer);
   return str;
 }
 
+} // namespace
+
+std::ostream& operator<<(std::ostream& str, const ObjSerializer::IndexedVertex& vertex)
+{
+  return write(str, vertex);
+}
+
+std::ostream& operator<<(std::ostream& str, const ObjSerializer::BrushObject& object)
+{
+  return write(str, object);
+}
+
+std::ostream& operator<<(std::ostream& str, const ObjSerializer::PatchObject& object)
+{
+  return write(str, object);
+}
+
 std::ostream& operator<<(std::ostream& str, const ObjSerializer::Object& object)
 {
-  std::visit(
-    kdl::overload(
-      [&](const ObjSerializer::BrushObject& brushObject) { str << brushObject; },
-      [&](const ObjSerializer::PatchObject& patchObject) { str << patchObject; }),
-    object);
-  return str;
+  return write(str, object);
 }
 
 ObjSerializer::ObjSerializer(
@@ -101,8 +165,51 @@ ObjSerializer::ObjSerializer(
 }
 
 void ObjSerializer::doBeginFile(
-  const std::vector<const Node*>& /* rootNodes */, kdl::task_manager&)
+  const std::vector<const Node*>& rootNodes, kdl::task_manager& taskManager)
 {
+  contract_pre(m_brushGeometry.empty());
+
+  // collect brushes
+  auto brushNodes = std::vector<const BrushNode*>{};
+
+  Node::visitAll(
+    rootNodes,
+    kdl::overload(
+      [](auto&& thisLambda, const WorldNode& worldNode) {
+        worldNode.visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const LayerNode& layerNode) {
+        layerNode.visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const GroupNode& groupNode) {
+        groupNode.visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const EntityNode& entityNode) {
+        entityNode.visitChildren(thisLambda);
+      },
+      [&](const BrushNode& brushNode) { brushNodes.push_back(&brushNode); },
+      [](const PatchNode&) {}));
+
+  // compute the brush geometry in parallel, the indices are assigned in order later
+  using Entry = std::pair<const BrushNode*, std::vector<BrushFaceGeometry>>;
+  auto tasks = brushNodes | std::views::transform([](const auto* brushNode) {
+                 return std::function{[=]() {
+                   const auto& faces = brushNode->brush().faces();
+                   auto geometry = std::vector<BrushFaceGeometry>{};
+                   geometry.reserve(faces.size());
+                   for (const auto& face : faces)
+                   {
+                     geometry.push_back(computeBrushFaceGeometry(face));
+                   }
+                   return Entry{brushNode, std::move(geometry)};
+                 }};
+               });
+
+  m_brushGeometry.reserve(brushNodes.size());
+  for (auto& entry : taskManager.run_tasks_and_wait(std::move(tasks)))
+  {
+    m_brushGeometry.insert(std::move(entry));
+  }
 }
 
 static void writeMtlFile(
@@ -153,41 +260,42 @@ static void writeMtlFile(
   }
 }
 
-static void writeVertices(std::ostream& str, const std::vector<vm::vec3d>& vertices)
+static void writeVertices(
+  std::ostream& str, Buffer& buffer, const std::vector<vm::vec3d>& vertices)
 {
-  str << "# vertices\n";
+  fmt::format_to(std::back_inserter(buffer), "# vertices\n");
   for (const auto& elem : vertices)
   {
     // no idea why I have to switch Y and Z
     fmt::format_to(
-      std::ostreambuf_iterator<char>(str), "v {} {} {}\n", elem.x(), elem.z(), -elem.y());
+      std::back_inserter(buffer), "v {} {} {}\n", elem.x(), elem.z(), -elem.y());
+    flushIfFull(str, buffer);
   }
 }
 
-static void writeUVCoords(std::ostream& str, const std::vector<vm::vec2f>& uvCoords)
+static void writeUVCoords(
+  std::ostream& str, Buffer& buffer, const std::vector<vm::vec2f>& uvCoords)
 {
-  str << "# texture coordinates\n";
+  fmt::format_to(std::back_inserter(buffer), "# texture coordinates\n");
   for (const auto& elem : uvCoords)
   {
     // multiplying Y by -1 needed to get the UV's to appear correct in Blender and UE4
     // (see: https://github.com/TrenchBroom/TrenchBroom/issues/2851 )
-    fmt::format_to(
-      std::ostreambuf_iterator<char>(str), "vt {} {}\n", elem.x(), -elem.y());
+    fmt::format_to(std::back_inserter(buffer), "vt {} {}\n", elem.x(), -elem.y());
+    flushIfFull(str, buffer);
   }
 }
 
-static void writeNormals(std::ostream& str, const std::vector<vm::vec3d>& normals)
+static void writeNormals(
+  std::ostream& str, Buffer& buffer, const std::vector<vm::vec3d>& normals)
 {
-  str << "# normals\n";
+  fmt::format_to(std::back_inserter(buffer), "# normals\n");
   for (const auto& elem : normals)
   {
     // no idea why I have to switch Y and Z
     fmt::format_to(
-      std::ostreambuf_iterator<char>(str),
-      "vn {} {} {}\n",
-      elem.x(),
-      elem.z(),
-      -elem.y());
+      std::back_inserter(buffer), "vn {} {} {}\n", elem.x(), elem.z(), -elem.y());
+    flushIfFull(str, buffer);
   }
 }
 
@@ -199,20 +307,24 @@ static void writeObjFile(
   const std::vector<vm::vec3d>& normals,
   const std::vector<ObjSerializer::Object>& objects)
 {
+  auto buffer = Buffer{};
 
-  str << "mtllib " << mtlFilename << "\n";
-  writeVertices(str, vertices);
-  str << "\n";
-  writeUVCoords(str, uvCoords);
-  str << "\n";
-  writeNormals(str, normals);
-  str << "\n";
+  fmt::format_to(std::back_inserter(buffer), "mtllib {}\n", mtlFilename);
+  writeVertices(str, buffer, vertices);
+  buffer.push_back('\n');
+  writeUVCoords(str, buffer, uvCoords);
+  buffer.push_back('\n');
+  writeNormals(str, buffer, normals);
+  buffer.push_back('\n');
 
   for (const auto& object : objects)
   {
-    str << object;
-    str << "\n";
+    format(buffer, object);
+    buffer.push_back('\n');
+    flushIfFull(str, buffer);
   }
+
+  flush(str, buffer);
 }
 
 void ObjSerializer::doEndFile()
@@ -239,9 +351,23 @@ void ObjSerializer::doBrush(const BrushNode& brushNode)
   // Vertex positions inserted from now on should get new indices
   m_vertices.clearIndices();
 
-  for (const auto& face : brushNode.brush().faces())
+  const auto& faces = brushNode.brush().faces();
+  if (const auto it = m_brushGeometry.find(&brushNode); it != m_brushGeometry.end())
   {
-    doBrushFace(face);
+    contract_assert(it->second.size() == faces.size());
+
+    for (size_t i = 0; i < faces.size(); ++i)
+    {
+      addBrushFace(faces[i], it->second[i]);
+    }
+    m_brushGeometry.erase(it);
+  }
+  else
+  {
+    for (const auto& face : faces)
+    {
+      doBrushFace(face);
+    }
   }
 
   m_objects.emplace_back(std::move(*m_currentBrush));
@@ -250,19 +376,37 @@ void ObjSerializer::doBrush(const BrushNode& brushNode)
 
 void ObjSerializer::doBrushFace(const BrushFace& face)
 {
-  const auto& normal = face.boundary().normal;
-  const auto normalIndex = m_normals.index(normal);
+  addBrushFace(face, computeBrushFaceGeometry(face));
+}
 
-  auto indexedVertices = std::vector<IndexedVertex>{};
-  indexedVertices.reserve(face.vertexCount());
+ObjSerializer::BrushFaceGeometry ObjSerializer::computeBrushFaceGeometry(
+  const BrushFace& face)
+{
+  auto geometry = BrushFaceGeometry{face.boundary().normal, {}, {}};
+  geometry.positions.reserve(face.vertexCount());
+  geometry.uvCoords.reserve(face.vertexCount());
 
   for (const auto* vertex : face.vertices())
   {
     const auto& position = vertex->position();
-    const auto uvCoords = face.uvCoords(position);
+    geometry.positions.push_back(position);
+    geometry.uvCoords.push_back(face.uvCoords(position));
+  }
+
+  return geometry;
+}
+
+void ObjSerializer::addBrushFace(const BrushFace& face, const BrushFaceGeometry& geometry)
+{
+  const auto normalIndex = m_normals.index(geometry.normal);
+
+  auto indexedVertices = std::vector<IndexedVertex>{};
+  indexedVertices.reserve(geometry.positions.size());
 
-    const auto vertexIndex = m_vertices.index(position);
-    const auto uvCoordsIndex = m_uvCoords.index(uvCoords);
+  for (size_t i = 0; i < geometry.positions.size(); ++i)
+  {
+    const auto vertexIndex = m_vertices.index(geometry.positions[i]);
+    const auto uvCoordsIndex = m_uvCoords.index(geometry.uvCoords[i]);
 
     indexedVertices.push_back(IndexedVertex{vertexIndex, uvCoordsIndex, normalIndex});
   }
@@ -280,7 +424,7 @@ void ObjSerializer::doPatch(const PatchNode& patchNode)
   auto patchObject =
     PatchObject{entityNo(), brushNo(), {}, patch.materialName(), patch.material()};
 
-  const auto& patchGrid = patchNode.grid();
+  const auto patchGrid = patchNode.grid();
   patchObject.quads.reserve(patchGrid.quadRowCount() * patchGrid.quadColumnCount());
 
   // Vertex positions inserted from now on should get new indices
@@ -46,7 +46,13 @@
 namespace tb::mdl
 {
 
-constexpr static size_t DefaultSubdivisionsPerSurface = 3u;
+namespace
+{
+
+constexpr auto MaxPositionError = 0.1;
+constexpr auto MaxUVError = 1.0 / 1024.0;
+
+} // namespace
 
 kdl_reflect_impl(PatchGrid::Point);
 
@@ -299,11 +305,71 @@ PatchGrid makePatchGrid(const BezierPatch& patch, const size_t subdivisionsPerSu
     gridPointRowCount, gridPointColumnCount, std::move(points), boundsBuilder.bounds()};
 }
 
+size_t computeSubdivisionsPerSurface(
+  const BezierPatch& patch, const size_t maxSubdivisionsPerSurface)
+{
+  /*
+   * The distance between a quadratic Bezier surface and its tessellation into a grid with
+   * 2^n quads per side is bounded by (du + dv) / (4 * 4^n), where du and dv are the
+   * largest second differences p0 - 2p1 + p2 of the control points along the rows and
+   * columns of the surfaces, respectively. The same bound applies to the UV coordinates.
+   */
+  auto du = vm::vec2d{0, 0};
+  auto dv = vm::vec2d{0, 0};
+
+  const auto secondDifference =
+    [](const auto& p0, const auto& p1, const auto& p2) -> vm::vec2d {
+    const auto d = p0 - 2.0 * p1 + p2;
+    return {vm::length(vm::slice<3>(d, 0)), vm::length(vm::slice<2>(d, 3))};
+  };
+
+  for (size_t row = 0u; row < patch.pointRowCount(); ++row)
+  {
+    for (size_t col = 0u; col + 2u < patch.pointColumnCount(); col += 2u)
+    {
+      du = vm::max(
+        du,
+        secondDifference(
+          patch.controlPoint(row, col),
+          patch.controlPoint(row, col + 1u),
+          patch.controlPoint(row, col + 2u)));
+    }
+  }
+
+  for (size_t row = 0u; row + 2u < patch.pointRowCount(); row += 2u)
+  {
+    for (size_t col = 0u; col < patch.pointColumnCount(); ++col)
+    {
+      dv = vm::max(
+        dv,
+        secondDifference(
+          patch.controlPoint(row, col),
+          patch.controlPoint(row + 1u, col),
+          patch.controlPoint(row + 2u, col)));
+    }
+  }
+
+  auto error = (du + dv) / 4.0;
+  for (size_t subdivisionsPerSurface = 0u;
+       subdivisionsPerSurface < maxSubdivisionsPerSurface;
+       ++subdivisionsPerSurface)
+  {
+    if (error.x() <= MaxPositionError && error.y() <= MaxUVError)
+    {
+      return subdivisionsPerSurface;
+    }
+    error = error / 4.0;
+  }
+
+  return maxSubdivisionsPerSurface;
+}
+
 const HitType::Type PatchNode::PatchHitType = HitType::freeType();
 
 PatchNode::PatchNode(BezierPatch patch)
   : m_patch{std::move(patch)}
-  , m_grid{makePatchGrid(m_patch, DefaultSubdivisionsPerSurface)}
+  , m_renderSubdivisionsPerSurface{
+      computeSubdivisionsPerSurface(m_patch, DefaultSubdivisionsPerSurface)}
 {
 }
 
@@ -348,7 +414,8 @@ BezierPatch PatchNode::setPatch(BezierPatch patch)
   const auto boundsChange = NotifyPhysicalBoundsChange{*this};
 
   auto previousPatch = std::exchange(m_patch, std::move(patch));
-  m_grid = makePatchGrid(m_patch, DefaultSubdivisionsPerSurface);
+  m_renderSubdivisionsPerSurface =
+    computeSubdivisionsPerSurface(m_patch, DefaultSubdivisionsPerSurface);
   return previousPatch;
 }
 
@@ -357,9 +424,21 @@ void PatchNode::setMaterial(gl::Material* material)
   m_patch.setMaterial(material);
 }
 
-const PatchGrid& PatchNode::grid() const
+PatchGrid PatchNode::grid() const
 {
-  return m_grid;
+  return grid(DefaultSubdivisionsPerSurface);
+}
+
+PatchGrid PatchNode::grid(const size_t subdivisionsPerSurface) const
+{
+  contract_pre(subdivisionsPerSurface <= DefaultSubdivisionsPerSurface);
+
+  return makePatchGrid(m_patch, subdivisionsPerSurface);
+}
+
+PatchGrid PatchNode::renderGrid() const
+{
+  return grid(m_renderSubdivisionsPerSurface);
 }
 
 const std::string& PatchNode::doGetName() const
@@ -375,7 +454,8 @@ const vm::bbox3d& PatchNode::doGetLogicalBounds() const
 
 const vm::bbox3d& PatchNode::doGetPhysicalBounds() const
 {
-  return m_grid.bounds;
+  // the patch lies within the convex hull of its control points
+  return m_patch.bounds();
 }
 
 double PatchNode::doGetProjectedArea(const vm::axis::type axis) const
@@ -430,7 +510,7 @@ bool PatchNode::doSelectable() const
 void PatchNode::doPick(
   const EditorContext& editorContext, const vm::ray3d& pickRay, PickResult& pickResult)
 {
-  if (!editorContext.visible(*this))
+  if (!editorContext.visible(*this) || !vm::intersect_ray_bbox(pickRay, physicalBounds()))
   {
     return;
   }
@@ -444,14 +524,15 @@ void PatchNode::doPick(
     return false;
   };
 
-  for (size_t row = 0u; row < m_grid.pointRowCount - 1u; ++row)
+  const auto pickGrid = grid();
+  for (size_t row = 0u; row < pickGrid.pointRowCount - 1u; ++row)
   {
-    for (size_t col = 0u; col < m_grid.pointColumnCount - 1u; ++col)
+    for (size_t col = 0u; col < pickGrid.pointColumnCount - 1u; ++col)
     {
-      const auto v0 = m_grid.point(row, col).position;
-      const auto v1 = m_grid.point(row, col + 1u).position;
-      const auto v2 = m_grid.point(row + 1u, col + 1u).position;
-      const auto v3 = m_grid.point(row + 1u, col).position;
+      const auto v0 = pickGrid.point(row, col).position;
+      const auto v1 = pickGrid.point(row, col + 1u).position;
+      const auto v2 = pickGrid.point(row + 1u, col + 1u).position;
+      const auto v3 = pickGrid.point(row + 1u, col).position;
 
       if (pickTriangle(v0, v1, v2) || pickTriangle(v2, v3, v0))
       {
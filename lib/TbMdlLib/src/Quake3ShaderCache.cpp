@@ -0,0 +1,64 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Quake3ShaderCache.h"
+
+#include <functional>
+
+namespace tb::mdl
+{
+
+Quake3ShaderCache::Key Quake3ShaderCache::makeKey(
+  std::filesystem::path path, const std::string_view contents)
+{
+  return Key{
+    std::move(path),
+    contents.size(),
+    std::hash<std::string_view>{}(contents),
+  };
+}
+
+const std::vector<Quake3Shader>* Quake3ShaderCache::find(const Key& key) const
+{
+  if (const auto it = m_entries.find(key.path);
+      it != m_entries.end() && it->second.key == key)
+  {
+    return &it->second.shaders;
+  }
+  return nullptr;
+}
+
+void Quake3ShaderCache::insert(Key key, std::vector<Quake3Shader> shaders)
+{
+  auto path = key.path;
+  m_entries.insert_or_assign(
+    std::move(path), Entry{std::move(key), std::move(shaders)});
+}
+
+size_t Quake3ShaderCache::size() const
+{
+  return m_entries.size();
+}
+
+void Quake3ShaderCache::clear()
+{
+  m_entries.clear();
+}
+
+} // namespace tb::mdl
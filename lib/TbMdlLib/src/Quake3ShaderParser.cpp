@@ -57,6 +57,50 @@ Quake3ShaderTokenizer::Quake3ShaderTokenizer(const std::string_view str)
 {
 }
 
+void Quake3ShaderTokenizer::discardRemainderOfEntry()
+{
+  // This must skip exactly the tokens that emitToken would return for the remainder of
+  // the entry.
+  while (!eof())
+  {
+    switch (curChar())
+    {
+    case '}':
+      return;
+    case '\r':
+    case '\n':
+      discardWhile(Whitespace());
+      return;
+    case ' ':
+    case '\t':
+      advance();
+      break;
+    case '/':
+      if (lookAhead() == '/')
+      {
+        advance(2);
+        discardUntil("\n\r");
+        break;
+      }
+      if (lookAhead() == '*')
+      {
+        advance(2);
+        while (curChar() != '*' || lookAhead() != '/')
+        {
+          errorIfEof();
+          advance();
+        }
+        advance(2);
+        break;
+      }
+      switchFallthrough();
+    default:
+      discardUntil(Whitespace());
+      break;
+    }
+  }
+}
+
 Tokenizer<unsigned int>::Token Quake3ShaderTokenizer::emitToken()
 {
   while (!eof())
@@ -338,16 +382,7 @@ void Quake3ShaderParser::parseStageEntry(Quake3ShaderStage& stage, ParserStatus&
 
 void Quake3ShaderParser::skipRemainderOfEntry()
 {
-  auto token = m_tokenizer.peekToken();
-  while (!token.hasType(Quake3ShaderToken::Eol | Quake3ShaderToken::CBrace))
-  {
-    m_tokenizer.nextToken();
-    token = m_tokenizer.peekToken();
-  }
-  if (token.hasType(Quake3ShaderToken::Eol))
-  {
-    m_tokenizer.skipToken();
-  }
+  m_tokenizer.discardRemainderOfEntry();
 }
 
 } // namespace tb::mdl
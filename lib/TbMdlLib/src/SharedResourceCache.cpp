@@ -0,0 +1,65 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/SharedResourceCache.h"
+
+#include "fs/FileSystem.h"
+#include "fs/FileSystemMetadata.h"
+
+#include "kd/result.h"
+
+#include <system_error>
+
+namespace tb::mdl
+{
+namespace
+{
+
+std::optional<std::filesystem::path> findDiskPath(
+  const fs::FileSystem& fs, const std::filesystem::path& path)
+{
+  if (const auto* imageFilePath =
+        fs.metadata(path, fs::FileSystemMetadataKeys::ImageFilePath))
+  {
+    return std::get<std::filesystem::path>(*imageFilePath);
+  }
+
+  return fs.makeAbsolute(path)
+         | kdl::transform([](auto absPath) { return std::optional{std::move(absPath)}; })
+         | kdl::value_or(std::optional<std::filesystem::path>{});
+}
+
+} // namespace
+
+std::optional<DiskFile> findDiskFile(
+  const fs::FileSystem& fs, const std::filesystem::path& path)
+{
+  if (auto diskPath = findDiskPath(fs, path))
+  {
+    auto error = std::error_code{};
+    if (const auto modificationTime = std::filesystem::last_write_time(*diskPath, error);
+        !error)
+    {
+      return DiskFile{std::move(*diskPath), modificationTime};
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace tb::mdl
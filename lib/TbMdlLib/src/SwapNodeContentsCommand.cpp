@@ -28,8 +28,10 @@
 #include "mdl/NodeQueries.h"
 
 #include "kd/ranges/to.h"
+#include "kd/result_fold.h"
 
 #include <ranges>
+#include <unordered_map>
 
 namespace tb::mdl
 {
@@ -70,9 +72,30 @@ auto notifySpecialWorldProperties(
   return std::tuple{false, false, false};
 }
 
-void doSwapNodeContents(
-  std::vector<std::pair<Node*, NodeContents>>& nodesToSwap, Map& map)
+Result<std::vector<std::pair<Node*, NodeContents>>> expandNodeContents(
+  const std::vector<std::pair<Node*, CompactNodeContents>>& nodes,
+  const vm::bbox3d& worldBounds)
 {
+  return nodes | std::views::transform([&](const auto& pair) {
+           const auto& [node, contents] = pair;
+           return contents.expand(*node, worldBounds)
+                  | kdl::transform([&](auto expandedContents) {
+                      return std::pair{node, std::move(expandedContents)};
+                    });
+         })
+         | kdl::fold;
+}
+
+bool doSwapNodeContents(
+  std::vector<std::pair<Node*, CompactNodeContents>>& compactNodesToSwap, Map& map)
+{
+  auto expandResult = expandNodeContents(compactNodesToSwap, map.worldBounds());
+  if (!expandResult)
+  {
+    return false;
+  }
+
+  auto nodesToSwap = std::move(expandResult).value();
   const auto nodes = nodesToSwap
                      | std::views::transform([](const auto& pair) { return pair.first; })
                      | kdl::ranges::to<std::vector>();
@@ -93,32 +116,18 @@ void doSwapNodeContents(
   auto notifyMods = NotifyBeforeAndAfter{
     notifyModsChange, map.modsWillChangeNotifier, map.modsDidChangeNotifier};
 
-  for (auto& pair : nodesToSwap)
+  for (auto& [node, contents] : nodesToSwap)
   {
-    auto* node = pair.first;
-    auto& contents = pair.second.get();
-
-    pair.second = node->accept(kdl::overload(
-      [&](WorldNode& worldNode) {
-        return NodeContents{worldNode.setEntity(std::get<Entity>(std::move(contents)))};
-      },
-      [&](LayerNode& layerNode) {
-        return NodeContents(layerNode.setLayer(std::get<Layer>(std::move(contents))));
-      },
-      [&](GroupNode& groupNode) {
-        return NodeContents{groupNode.setGroup(std::get<Group>(std::move(contents)))};
-      },
-      [&](EntityNode& entityNode) {
-        return NodeContents{entityNode.setEntity(std::get<Entity>(std::move(contents)))};
-      },
-      [&](BrushNode& brushNode) {
-        return NodeContents{brushNode.setBrush(std::get<Brush>(std::move(contents)))};
-      },
-      [&](PatchNode& patchNode) {
-        return NodeContents{
-          patchNode.setPatch(std::get<BezierPatch>(std::move(contents)))};
-      }));
+    contents = swapNodeContents(*node, std::move(contents));
   }
+
+  compactNodesToSwap.clear();
+  for (auto& [node, contents] : nodesToSwap)
+  {
+    compactNodesToSwap.emplace_back(
+      node, CompactNodeContents::compact(std::move(contents), *node));
+  }
+  return true;
 }
 
 } // namespace
@@ -126,22 +135,24 @@ void doSwapNodeContents(
 SwapNodeContentsCommand::SwapNodeContentsCommand(
   std::string name, std::vector<std::pair<Node*, NodeContents>> nodes)
   : UpdateLinkedGroupsCommandBase{std::move(name), true}
-  , m_nodes{std::move(nodes)}
 {
+  m_nodes.reserve(nodes.size());
+  for (auto& [node, contents] : nodes)
+  {
+    m_nodes.emplace_back(node, CompactNodeContents{std::move(contents)});
+  }
 }
 
 SwapNodeContentsCommand::~SwapNodeContentsCommand() = default;
 
 bool SwapNodeContentsCommand::doPerformDo(Map& map)
 {
-  doSwapNodeContents(m_nodes, map);
-  return true;
+  return doSwapNodeContents(m_nodes, map);
 }
 
 bool SwapNodeContentsCommand::doPerformUndo(Map& map)
 {
-  doSwapNodeContents(m_nodes, map);
-  return true;
+  return doSwapNodeContents(m_nodes, map);
 }
 
 bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
@@ -158,10 +169,37 @@ bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
     std::ranges::sort(myNodes);
     std::ranges::sort(theirNodes);
 
-    return myNodes == theirNodes;
+    if (myNodes != theirNodes)
+    {
+      return false;
+    }
+
+    // Our contents refer to the node contents restored by the other command, but after
+    // collation, they must be restored from the current node contents
+    const auto theirContents =
+      other->m_nodes | std::views::transform([](const auto& pair) {
+        return std::pair{pair.first, &pair.second};
+      })
+      | kdl::ranges::to<std::unordered_map<Node*, const CompactNodeContents*>>();
+
+    for (auto& [node, contents] : m_nodes)
+    {
+      contents.rebase(*theirContents.at(node), *node);
+    }
+    return true;
   }
 
   return false;
 }
 
+size_t SwapNodeContentsCommand::doGetMemorySize() const
+{
+  auto result = UpdateLinkedGroupsCommandBase::doGetMemorySize();
+  for (const auto& [node, contents] : m_nodes)
+  {
+    result += sizeof(node) + contents.memorySize();
+  }
+  return result;
+}
+
 } // namespace tb::mdl
@@ -234,6 +234,21 @@ void TagMatcher::enable(TagMatcherCallback&, Map&) const {}
 
 void TagMatcher::disable(TagMatcherCallback&, Map&) const {}
 
+TagMatcherFaceDependency TagMatcher::faceDependency() const
+{
+  return TagMatcherFaceDependency::Face;
+}
+
+bool TagMatcher::matchesFaceMaterial(std::string_view, const gl::Material*) const
+{
+  return false;
+}
+
+int TagMatcher::faceFlags() const
+{
+  return 0;
+}
+
 bool TagMatcher::canEnable() const
 {
   return false;
@@ -280,6 +295,11 @@ bool SmartTag::matches(const Taggable& taggable) const
   return m_matcher->matches(taggable);
 }
 
+const TagMatcher& SmartTag::matcher() const
+{
+  return *m_matcher;
+}
+
 void SmartTag::update(Taggable& taggable) const
 {
   if (matches(taggable))
@@ -19,6 +19,9 @@
 
 #include "mdl/TagManager.h"
 
+#include "Macros.h"
+#include "gl/Material.h"
+#include "mdl/BrushFace.h"
 #include "mdl/Tag.h"
 #include "mdl/TagType.h"
 
@@ -27,11 +30,47 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <bit>
 #include <stdexcept>
 #include <string>
 
 namespace tb::mdl
 {
+namespace
+{
+
+void addFlagTags(
+  std::array<TagType::Type, sizeof(int) * 8>& flagTags,
+  const int flags,
+  const TagType::Type tagType)
+{
+  for (size_t i = 0; i < flagTags.size(); ++i)
+  {
+    if ((static_cast<unsigned int>(flags) & (1u << i)) != 0)
+    {
+      flagTags[i] |= tagType;
+    }
+  }
+}
+
+TagType::Type matchFlagTags(
+  const std::array<TagType::Type, sizeof(int) * 8>& flagTags, const int flags)
+{
+  auto result = TagType::NoType;
+  for (auto bits = static_cast<unsigned int>(flags); bits != 0; bits &= bits - 1)
+  {
+    result |= flagTags[size_t(std::countr_zero(bits))];
+  }
+  return result;
+}
+
+bool hasFlagTags(const std::array<TagType::Type, sizeof(int) * 8>& flagTags)
+{
+  return std::ranges::any_of(
+    flagTags, [](const auto tagTypes) { return tagTypes != TagType::NoType; });
+}
+
+} // namespace
 
 bool TagManager::TagCmp::operator()(const SmartTag& lhs, const SmartTag& rhs) const
 {
@@ -105,11 +144,14 @@ void TagManager::registerSmartTags(const std::vector<SmartTag>& tags)
 
     it->setIndex(nextIndex);
   }
+
+  compileFaceMatchers();
 }
 
 void TagManager::clearSmartTags()
 {
   m_smartTags.clear();
+  compileFaceMatchers();
 }
 
 void TagManager::updateTags(Taggable& taggable) const
@@ -120,6 +162,81 @@ void TagManager::updateTags(Taggable& taggable) const
   }
 }
 
+void TagManager::updateTags(BrushFace& face) const
+{
+  const auto tagMask = matchTags(face);
+  if ((face.tagMask() & m_smartTagMask) == tagMask)
+  {
+    return;
+  }
+
+  for (const auto& tag : m_smartTags)
+  {
+    if ((tagMask & tag.type()) != 0)
+    {
+      face.addTag(tag);
+    }
+    else
+    {
+      face.removeTag(tag);
+    }
+  }
+}
+
+TagType::Type TagManager::matchTags(const BrushFace& face) const
+{
+  auto result = TagType::NoType;
+
+  if (!m_materialTags.empty())
+  {
+    const auto* material = face.material();
+    if (const auto it = m_materialTagMasks.find(material);
+        it != m_materialTagMasks.end())
+    {
+      result |= it->second;
+    }
+    else
+    {
+      result |= matchMaterialTags(face.attributes().materialName(), material);
+    }
+  }
+
+  if (hasFlagTags(m_contentFlagTags))
+  {
+    result |= matchFlagTags(m_contentFlagTags, face.resolvedSurfaceContents());
+  }
+
+  if (hasFlagTags(m_surfaceFlagTags))
+  {
+    result |= matchFlagTags(m_surfaceFlagTags, face.resolvedSurfaceFlags());
+  }
+
+  for (const auto index : m_faceTags)
+  {
+    const auto& tag = smartTags()[index];
+    if (tag.matches(face))
+    {
+      result |= tag.type();
+    }
+  }
+
+  return result;
+}
+
+void TagManager::precomputeMaterialTags(
+  const std::vector<const gl::Material*>& materials)
+{
+  m_materialTagMasks.clear();
+  if (!m_materialTags.empty())
+  {
+    m_materialTagMasks.reserve(materials.size());
+    for (const auto* material : materials)
+    {
+      m_materialTagMasks[material] = matchMaterialTags(material->name(), material);
+    }
+  }
+}
+
 size_t TagManager::freeTagIndex()
 {
   static const size_t Bits = (sizeof(TagType::Type) * 8);
@@ -129,4 +246,56 @@ size_t TagManager::freeTagIndex()
   return index;
 }
 
+void TagManager::compileFaceMatchers()
+{
+  m_smartTagMask = TagType::NoType;
+  m_materialTags.clear();
+  m_faceTags.clear();
+  m_contentFlagTags = {};
+  m_surfaceFlagTags = {};
+  m_materialTagMasks.clear();
+
+  const auto& tags = smartTags();
+  for (size_t i = 0; i < tags.size(); ++i)
+  {
+    const auto& tag = tags[i];
+    const auto& matcher = tag.matcher();
+    m_smartTagMask |= tag.type();
+
+    switch (matcher.faceDependency())
+    {
+    case TagMatcherFaceDependency::None:
+      break;
+    case TagMatcherFaceDependency::Material:
+      m_materialTags.push_back(i);
+      break;
+    case TagMatcherFaceDependency::ContentFlags:
+      addFlagTags(m_contentFlagTags, matcher.faceFlags(), tag.type());
+      break;
+    case TagMatcherFaceDependency::SurfaceFlags:
+      addFlagTags(m_surfaceFlagTags, matcher.faceFlags(), tag.type());
+      break;
+    case TagMatcherFaceDependency::Face:
+      m_faceTags.push_back(i);
+      break;
+      switchDefault();
+    }
+  }
+}
+
+TagType::Type TagManager::matchMaterialTags(
+  const std::string_view materialName, const gl::Material* material) const
+{
+  auto result = TagType::NoType;
+  for (const auto index : m_materialTags)
+  {
+    const auto& tag = smartTags()[index];
+    if (tag.matcher().matchesFaceMaterial(materialName, material))
+    {
+      result |= tag.type();
+    }
+  }
+  return result;
+}
+
 } // namespace tb::mdl
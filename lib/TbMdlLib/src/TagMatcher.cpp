@@ -179,6 +179,17 @@ bool MaterialNameTagMatcher::matches(const Taggable& taggable) const
   return visitor.matches();
 }
 
+TagMatcherFaceDependency MaterialNameTagMatcher::faceDependency() const
+{
+  return TagMatcherFaceDependency::Material;
+}
+
+bool MaterialNameTagMatcher::matchesFaceMaterial(
+  const std::string_view materialName, const gl::Material*) const
+{
+  return matchesMaterialName(materialName);
+}
+
 void MaterialNameTagMatcher::appendToStream(std::ostream& str) const
 {
   kdl::struct_stream{str} << "MaterialNameTagMatcher"
@@ -230,6 +241,17 @@ bool SurfaceParmTagMatcher::matches(const Taggable& taggable) const
   return visitor.matches();
 }
 
+TagMatcherFaceDependency SurfaceParmTagMatcher::faceDependency() const
+{
+  return TagMatcherFaceDependency::Material;
+}
+
+bool SurfaceParmTagMatcher::matchesFaceMaterial(
+  const std::string_view, const gl::Material* material) const
+{
+  return matchesMaterial(material);
+}
+
 void SurfaceParmTagMatcher::appendToStream(std::ostream& str) const
 {
   kdl::struct_stream{str} << "SurfaceParmTagMatcher"
@@ -286,6 +308,11 @@ bool FlagsTagMatcher::matches(const Taggable& taggable) const
   return visitor.matches();
 }
 
+int FlagsTagMatcher::faceFlags() const
+{
+  return m_flags;
+}
+
 void FlagsTagMatcher::enable(TagMatcherCallback& callback, Map& map) const
 {
   constexpr auto bits = sizeof(decltype(m_flags)) * 8;
@@ -380,6 +407,11 @@ std::unique_ptr<TagMatcher> ContentFlagsTagMatcher::clone() const
   return std::make_unique<ContentFlagsTagMatcher>(m_flags);
 }
 
+TagMatcherFaceDependency ContentFlagsTagMatcher::faceDependency() const
+{
+  return TagMatcherFaceDependency::ContentFlags;
+}
+
 SurfaceFlagsTagMatcher::SurfaceFlagsTagMatcher(const int i_flags)
   : FlagsTagMatcher{
       i_flags,
@@ -401,6 +433,11 @@ std::unique_ptr<TagMatcher> SurfaceFlagsTagMatcher::clone() const
   return std::make_unique<SurfaceFlagsTagMatcher>(m_flags);
 }
 
+TagMatcherFaceDependency SurfaceFlagsTagMatcher::faceDependency() const
+{
+  return TagMatcherFaceDependency::SurfaceFlags;
+}
+
 EntityClassNameTagMatcher::EntityClassNameTagMatcher(
   std::string pattern, std::string material)
   : m_pattern{std::move(pattern)}
@@ -430,6 +467,11 @@ bool EntityClassNameTagMatcher::matches(const Taggable& taggable) const
   return visitor.matches();
 }
 
+TagMatcherFaceDependency EntityClassNameTagMatcher::faceDependency() const
+{
+  return TagMatcherFaceDependency::None;
+}
+
 void EntityClassNameTagMatcher::enable(TagMatcherCallback& callback, Map& map) const
 {
   if (!map.selection().hasOnlyBrushes())
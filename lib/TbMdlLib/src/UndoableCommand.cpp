@@ -43,6 +43,8 @@ bool UndoableCommand::isModification() const
 
 bool UndoableCommand::performDo(Map& map)
 {
+  m_memorySize = std::nullopt;
+
   const auto result = Command::performDo(map);
   if (result)
   {
@@ -54,6 +56,8 @@ bool UndoableCommand::performDo(Map& map)
 bool UndoableCommand::performUndo(Map& map)
 {
   m_state = CommandState::Undoing;
+  m_memorySize = std::nullopt;
+
   const auto result = doPerformUndo(map);
   if (result)
   {
@@ -74,16 +78,31 @@ bool UndoableCommand::collateWith(UndoableCommand& command)
   if (doCollateWith(command))
   {
     m_modificationCount += command.m_modificationCount;
+    m_memorySize = std::nullopt;
     return true;
   }
   return false;
 }
 
+size_t UndoableCommand::memorySize() const
+{
+  if (!m_memorySize)
+  {
+    m_memorySize = doGetMemorySize();
+  }
+  return *m_memorySize;
+}
+
 bool UndoableCommand::doCollateWith(UndoableCommand&)
 {
   return false;
 }
 
+size_t UndoableCommand::doGetMemorySize() const
+{
+  return sizeof(UndoableCommand) + m_name.capacity();
+}
+
 void UndoableCommand::setModificationCount(Map& map) const
 {
   if (m_modificationCount)
@@ -23,9 +23,12 @@ namespace tb::mdl
 {
 
 UpdateLinkedGroupsCommand::UpdateLinkedGroupsCommand(
-  std::vector<GroupNode*> changedLinkedGroups)
+  std::vector<GroupNode*> changedLinkedGroups, ChangedLinkedNodes changedLinkedNodes)
   : UpdateLinkedGroupsCommandBase{
-      "Update Linked Groups", true, std::move(changedLinkedGroups)}
+      "Update Linked Groups",
+      true,
+      std::move(changedLinkedGroups),
+      std::move(changedLinkedNodes)}
 {
 }
 
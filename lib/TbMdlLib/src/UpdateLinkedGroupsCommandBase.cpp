@@ -34,9 +34,11 @@ namespace tb::mdl
 UpdateLinkedGroupsCommandBase::UpdateLinkedGroupsCommandBase(
   std::string name,
   const bool updateModificationCount,
-  std::vector<GroupNode*> changedLinkedGroups)
+  std::vector<GroupNode*> changedLinkedGroups,
+  ChangedLinkedNodes changedLinkedNodes)
   : UndoableCommand{std::move(name), updateModificationCount}
-  , m_updateLinkedGroupsHelper{std::move(changedLinkedGroups)}
+  , m_updateLinkedGroupsHelper{
+      std::move(changedLinkedGroups), std::move(changedLinkedNodes)}
 {
 }
 
@@ -23,9 +23,9 @@
 #include "mdl/LinkedGroupUtils.h"
 #include "mdl/Map.h"
 #include "mdl/ModelUtils.h"
+#include "mdl/NodeContents.h"
 
 #include "kd/overload.h"
-#include "kd/ranges/as_rvalue_view.h"
 #include "kd/ranges/to.h"
 #include "kd/result.h"
 #include "kd/result_fold.h"
@@ -35,6 +35,7 @@
 #include <cassert>
 #include <map>
 #include <ranges>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace tb::mdl
@@ -92,6 +93,26 @@ auto doReplaceChildren(
   return result;
 }
 
+auto doSwapNodeContents(std::vector<std::pair<Node*, NodeContents>> nodes, Map& map)
+{
+  if (nodes.empty())
+  {
+    return nodes;
+  }
+
+  const auto nodesToNotify =
+    nodes | std::views::keys | kdl::ranges::to<std::vector>();
+  auto notifyNodes = NotifyBeforeAndAfter{
+    map.nodesWillChangeNotifier, map.nodesDidChangeNotifier, nodesToNotify};
+
+  for (auto& [node, contents] : nodes)
+  {
+    contents = swapNodeContents(*node, std::move(contents));
+  }
+
+  return nodes;
+}
+
 } // namespace
 
 bool checkLinkedGroupsToUpdate(const std::vector<GroupNode*>& changedLinkedGroups)
@@ -105,8 +126,9 @@ bool checkLinkedGroupsToUpdate(const std::vector<GroupNode*>& changedLinkedGroup
 }
 
 UpdateLinkedGroupsHelper::UpdateLinkedGroupsHelper(
-  ChangedLinkedGroups changedLinkedGroups)
+  ChangedLinkedGroups changedLinkedGroups, ChangedLinkedNodes changedLinkedNodes)
   : m_state{kdl::vec_sort(std::move(changedLinkedGroups), compareByAncestry)}
+  , m_changedLinkedNodes{std::move(changedLinkedNodes)}
 {
 }
 
@@ -115,42 +137,73 @@ UpdateLinkedGroupsHelper::~UpdateLinkedGroupsHelper() = default;
 Result<void> UpdateLinkedGroupsHelper::applyLinkedGroupUpdates(Map& map)
 {
   return computeLinkedGroupUpdates(map)
-         | kdl::transform([&]() { doApplyOrUndoLinkedGroupUpdates(map); });
+         | kdl::transform([&]() { doApplyLinkedGroupUpdates(map); });
 }
 
 void UpdateLinkedGroupsHelper::undoLinkedGroupUpdates(Map& map)
 {
-  doApplyOrUndoLinkedGroupUpdates(map);
+  doUndoLinkedGroupUpdates(map);
 }
 
 void UpdateLinkedGroupsHelper::collateWith(UpdateLinkedGroupsHelper& other)
 {
   // Both helpers have already applied their changes at this point, so in both helpers,
-  // m_linkedGroups contains pairs p where
-  // - p.first is the group node to update
-  // - p.second is a vector containing the group node's original children
+  // m_state contains
+  // - pairs p where p.first is a group node whose children were replaced and p.second is
+  //   a vector containing the group node's original children
+  // - pairs q where q.first is a node whose contents were replaced and q.second is the
+  //   node's original contents
   //
-  // Let p_o be an update from the other helper. If p_o is an update for a linked group
-  // node that was updated by this helper, then there is a pair p_t in this helper such
-  // that p_t.first == p_o.first. In this case, we want to keep the old children of the
-  // linked group node stored in this helper and discard those in the other helper. If
-  // p_o is not an update for a linked group node that was updated by this helper, then
-  // we will add p_o to our updates and remove it from the other helper's updates to
-  // prevent the replaced node to be deleted with the other helper.
+  // Let p_o be a children update from the other helper. If p_o is an update for a linked
+  // group node whose children were replaced by this helper, then there is a pair p_t in
+  // this helper such that p_t.first == p_o.first. In this case, we want to keep the old
+  // children of the linked group node stored in this helper and discard those in the
+  // other helper. If p_o is not an update for a linked group node that was updated by
+  // this helper, then we will add p_o to our updates and remove it from the other
+  // helper's updates to prevent the replaced node to be deleted with the other helper.
+  //
+  // Let q_o be a contents update from the other helper. If this helper has replaced the
+  // children of an ancestor of q_o.first, or if this helper has already replaced the
+  // contents of q_o.first, then q_o is discarded because undoing this helper's changes
+  // already restores the original state of q_o.first. Otherwise, we add q_o to our
+  // updates.
+  //
+  // The contents updates are collated first so that only the children updates of this
+  // helper are considered when checking for replaced ancestors.
 
   auto& myLinkedGroupUpdates = std::get<LinkedGroupUpdates>(m_state);
   auto& theirLinkedGroupUpdates = std::get<LinkedGroupUpdates>(other.m_state);
 
-  for (auto& [theirGroupNodeToUpdate_, theirOldChildren] : theirLinkedGroupUpdates)
+  const auto mySwappedNodes =
+    myLinkedGroupUpdates.contentsToSwap | std::views::keys
+    | kdl::ranges::to<std::unordered_set<Node*>>();
+
+  for (auto& [theirNodeToUpdate, theirOldContents] :
+       theirLinkedGroupUpdates.contentsToSwap)
+  {
+    const auto isReplaced =
+      mySwappedNodes.contains(theirNodeToUpdate)
+      || std::ranges::any_of(myLinkedGroupUpdates.childrenToReplace, [&](const auto& p) {
+           return theirNodeToUpdate->isDescendantOf(*p.first);
+         });
+    if (!isReplaced)
+    {
+      myLinkedGroupUpdates.contentsToSwap.emplace_back(
+        theirNodeToUpdate, std::move(theirOldContents));
+    }
+  }
+
+  for (auto& [theirGroupNodeToUpdate_, theirOldChildren] :
+       theirLinkedGroupUpdates.childrenToReplace)
   {
     const auto myIt = std::ranges::find_if(
-      myLinkedGroupUpdates,
+      myLinkedGroupUpdates.childrenToReplace,
       [theirGroupNodeToUpdate = theirGroupNodeToUpdate_](const auto& p) {
         return p.first == theirGroupNodeToUpdate;
       });
-    if (myIt == std::end(myLinkedGroupUpdates))
+    if (myIt == std::end(myLinkedGroupUpdates.childrenToReplace))
     {
-      myLinkedGroupUpdates.emplace_back(
+      myLinkedGroupUpdates.childrenToReplace.emplace_back(
         theirGroupNodeToUpdate_, std::move(theirOldChildren));
     }
   }
@@ -161,18 +214,21 @@ Result<void> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(Map& map)
   return std::visit(
     kdl::overload(
       [&](const ChangedLinkedGroups& changedLinkedGroups) {
-        return computeLinkedGroupUpdates(changedLinkedGroups, map)
+        return computeLinkedGroupUpdates(changedLinkedGroups, m_changedLinkedNodes, map)
                | kdl::transform([&](auto&& linkedGroupUpdates) {
                    m_state =
                      std::forward<decltype(linkedGroupUpdates)>(linkedGroupUpdates);
+                   m_changedLinkedNodes.clear();
                  });
       },
       [](const LinkedGroupUpdates&) -> Result<void> { return kdl::void_success; }),
     m_state);
 }
 
-Result<UpdateLinkedGroupsHelper::LinkedGroupUpdates> UpdateLinkedGroupsHelper::
-  computeLinkedGroupUpdates(const ChangedLinkedGroups& changedLinkedGroups, Map& map)
+Result<LinkedGroupUpdates> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(
+  const ChangedLinkedGroups& changedLinkedGroups,
+  const ChangedLinkedNodes& changedLinkedNodes,
+  Map& map)
 {
   if (!checkLinkedGroupsToUpdate(changedLinkedGroups))
   {
@@ -184,23 +240,93 @@ Result<UpdateLinkedGroupsHelper::LinkedGroupUpdates> UpdateLinkedGroupsHelper::
            const auto groupNodesToUpdate = kdl::vec_erase(
              collectGroupsWithLinkId({&map.worldNode()}, groupNode->linkId()), groupNode);
 
-           return updateLinkedGroups(
-             *groupNode, groupNodesToUpdate, worldBounds, map.taskManager());
+           const auto changedNodesIt = changedLinkedNodes.find(groupNode);
+           const auto* changedNodes = changedNodesIt != changedLinkedNodes.end()
+                                        ? &changedNodesIt->second
+                                        : nullptr;
+
+           return updateLinkedGroupsIncrementally(
+             *groupNode,
+             groupNodesToUpdate,
+             worldBounds,
+             map.taskManager(),
+             changedNodes);
          })
-         | kdl::fold
-         | kdl::and_then([&](auto nestedUpdateLists) -> Result<LinkedGroupUpdates> {
-             return nestedUpdateLists | std::views::join | kdl::views::as_rvalue
-                    | kdl::ranges::to<std::vector>();
+         | kdl::fold | kdl::transform([](auto updatesPerGroup) {
+             // A node can be updated by more than one of the changed groups if the groups
+             // are nested. Since the groups are ordered so that descendants come before
+             // their ancestors, the last update of a node is the one to keep.
+             auto result = LinkedGroupUpdates{};
+             auto contentsIndices = std::unordered_map<Node*, size_t>{};
+             for (auto& updates : updatesPerGroup)
+             {
+               result.childrenToReplace = kdl::vec_concat(
+                 std::move(result.childrenToReplace),
+                 std::move(updates.childrenToReplace));
+
+               for (auto& [node, contents] : updates.contentsToSwap)
+               {
+                 if (const auto it = contentsIndices.find(node);
+                     it != contentsIndices.end())
+                 {
+                   result.contentsToSwap[it->second].second = std::move(contents);
+                 }
+                 else
+                 {
+                   contentsIndices.emplace(node, result.contentsToSwap.size());
+                   result.contentsToSwap.emplace_back(node, std::move(contents));
+                 }
+               }
+             }
+
+             // If the children of a group are replaced, then the new children already
+             // contain the updated nested groups, so replacing the children of a nested
+             // group as well is redundant and would remove its children twice.
+             const auto replacedParents =
+               result.childrenToReplace | std::views::keys
+               | kdl::ranges::to<std::vector<Node*>>();
+             std::erase_if(result.childrenToReplace, [&](const auto& p) {
+               return p.first->isDescendantOf(replacedParents);
+             });
+
+             return result;
            });
 }
 
-void UpdateLinkedGroupsHelper::doApplyOrUndoLinkedGroupUpdates(Map& map)
+void UpdateLinkedGroupsHelper::doApplyLinkedGroupUpdates(Map& map)
+{
+  // Swap the contents first because the swapped nodes may be removed when their
+  // ancestors' children are replaced
+  std::visit(
+    kdl::overload(
+      [](const ChangedLinkedGroups&) {},
+      [&](LinkedGroupUpdates&& linkedGroupUpdates) {
+        auto contentsToSwap =
+          doSwapNodeContents(std::move(linkedGroupUpdates.contentsToSwap), map);
+        auto childrenToReplace =
+          doReplaceChildren(std::move(linkedGroupUpdates.childrenToReplace), map);
+        m_state = LinkedGroupUpdates{
+          std::move(childrenToReplace),
+          std::move(contentsToSwap),
+        };
+      }),
+    std::move(m_state));
+}
+
+void UpdateLinkedGroupsHelper::doUndoLinkedGroupUpdates(Map& map)
 {
   std::visit(
     kdl::overload(
       [](const ChangedLinkedGroups&) {},
       [&](LinkedGroupUpdates&& linkedGroupUpdates) {
-        m_state = doReplaceChildren(std::move(linkedGroupUpdates), map);
+        auto childrenToReplace =
+          doReplaceChildren(std::move(linkedGroupUpdates.childrenToReplace), map);
+        auto contentsToSwap =
+          doSwapNodeContents(std::move(linkedGroupUpdates.contentsToSwap), map);
+        m_state = LinkedGroupUpdates{
+          std::move(childrenToReplace),
+          std::move(contentsToSwap),
+        };
       }),
     std::move(m_state));
 }
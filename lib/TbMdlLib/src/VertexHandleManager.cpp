@@ -31,6 +31,22 @@
 namespace tb::mdl
 {
 
+vm::bbox3d handleBounds(const vm::vec3d& handle)
+{
+  return vm::bbox3d{handle, handle};
+}
+
+vm::bbox3d handleBounds(const vm::segment3d& handle)
+{
+  return vm::bbox3d{
+    vm::min(handle.start(), handle.end()), vm::max(handle.start(), handle.end())};
+}
+
+vm::bbox3d handleBounds(const vm::polygon3d& handle)
+{
+  return vm::bbox3d::merge_all(handle.vertices().begin(), handle.vertices().end());
+}
+
 VertexHandleManagerBase::~VertexHandleManagerBase() = default;
 
 const HitType::Type VertexHandleManager::HandleHitType = HitType::freeType();
@@ -41,15 +57,14 @@ void VertexHandleManager::pick(
   const double handleRadius,
   PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const auto& position) {
     if (const auto distance = camera.pickPointHandle(pickRay, position, handleRadius))
     {
       const auto hitPoint = vm::point_at_distance(pickRay, *distance);
       const auto error = vm::squared_distance(pickRay, position).distance;
       pickResult.addHit(Hit(HandleHitType, *distance, hitPoint, position, error));
     }
-  }
+  });
 }
 
 void VertexHandleManager::addHandles(const BrushNode& brushNode)
@@ -57,7 +72,7 @@ void VertexHandleManager::addHandles(const BrushNode& brushNode)
   const auto& brush = brushNode.brush();
   for (const auto* vertex : brush.vertices())
   {
-    add(vertex->position());
+    add(vertex->position(), brushNode);
   }
 }
 
@@ -66,7 +81,7 @@ void VertexHandleManager::removeHandles(const BrushNode& brushNode)
   const auto& brush = brushNode.brush();
   for (const auto* vertex : brush.vertices())
   {
-    assertResult(remove(vertex->position()));
+    assertResult(remove(vertex->position(), brushNode));
   }
 }
 
@@ -91,8 +106,7 @@ void EdgeHandleManager::pickGridHandle(
   const Grid& grid,
   PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const auto& position) {
     if (
       const auto edgeDist = camera.pickLineSegmentHandle(pickRay, position, handleRadius))
     {
@@ -110,7 +124,7 @@ void EdgeHandleManager::pickGridHandle(
         }
       }
     }
-  }
+  });
 }
 
 void EdgeHandleManager::pickCenterHandle(
@@ -119,8 +133,7 @@ void EdgeHandleManager::pickCenterHandle(
   const double handleRadius,
   PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const auto& position) {
     const auto pointHandle = position.center();
 
     if (const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius))
@@ -128,7 +141,7 @@ void EdgeHandleManager::pickCenterHandle(
       const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
       pickResult.addHit(Hit{HandleHitType, *pointDist, hitPoint, position});
     }
-  }
+  });
 }
 
 void EdgeHandleManager::addHandles(const BrushNode& brushNode)
@@ -136,7 +149,9 @@ void EdgeHandleManager::addHandles(const BrushNode& brushNode)
   const auto& brush = brushNode.brush();
   for (const auto* edge : brush.edges())
   {
-    add(vm::segment3d{edge->firstVertex()->position(), edge->secondVertex()->position()});
+    add(
+      vm::segment3d{edge->firstVertex()->position(), edge->secondVertex()->position()},
+      brushNode);
   }
 }
 
@@ -146,7 +161,8 @@ void EdgeHandleManager::removeHandles(const BrushNode& brushNode)
   for (const auto* edge : brush.edges())
   {
     assertResult(remove(
-      vm::segment3d{edge->firstVertex()->position(), edge->secondVertex()->position()}));
+      vm::segment3d{edge->firstVertex()->position(), edge->secondVertex()->position()},
+      brushNode));
   }
 }
 
@@ -170,8 +186,7 @@ void FaceHandleManager::pickGridHandle(
   const Grid& grid,
   PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const auto& position) {
     if (
       const auto plane =
         vm::from_points(position.vertices().begin(), position.vertices().end()))
@@ -193,7 +208,7 @@ void FaceHandleManager::pickGridHandle(
         }
       }
     }
-  }
+  });
 }
 
 void FaceHandleManager::pickCenterHandle(
@@ -202,8 +217,7 @@ void FaceHandleManager::pickCenterHandle(
   const double handleRadius,
   PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const auto& position) {
     const auto pointHandle = position.center();
 
     if (const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius))
@@ -211,7 +225,7 @@ void FaceHandleManager::pickCenterHandle(
       const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
       pickResult.addHit(Hit{HandleHitType, *pointDist, hitPoint, position});
     }
-  }
+  });
 }
 
 void FaceHandleManager::addHandles(const BrushNode& brushNode)
@@ -219,7 +233,7 @@ void FaceHandleManager::addHandles(const BrushNode& brushNode)
   const auto& brush = brushNode.brush();
   for (const auto& face : brush.faces())
   {
-    add(face.polygon());
+    add(face.polygon(), brushNode);
   }
 }
 
@@ -228,7 +242,7 @@ void FaceHandleManager::removeHandles(const BrushNode& brushNode)
   const auto& brush = brushNode.brush();
   for (const auto& face : brush.faces())
   {
-    assertResult(remove(face.polygon()));
+    assertResult(remove(face.polygon(), brushNode));
   }
 }
 
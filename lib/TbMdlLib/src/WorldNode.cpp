@@ -38,10 +38,42 @@
 #include "vm/bbox_io.h" // IWYU pragma: keep
 
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace tb::mdl
 {
+namespace
+{
+
+using NodeTreeEntries = std::vector<std::pair<vm::bbox3d, Node*>>;
+
+/**
+ * Collects the given node and those of its descendants that belong into the node tree,
+ * along with their bounds.
+ */
+void collectNodeTreeEntries(Node& node, NodeTreeEntries& entries)
+{
+  // NOTE: `node` may be the root of a subtree that is being connected to this World. In
+  // some cases, (e.g. if `node` is a Group), `node` will not be added to the spatial
+  // index, but some of its descendants may be.
+  node.accept(kdl::overload(
+    [&](auto&& thisLambda, WorldNode& worldNode) { worldNode.visitChildren(thisLambda); },
+    [&](auto&& thisLambda, LayerNode& layerNode) { layerNode.visitChildren(thisLambda); },
+    [&](auto&& thisLambda, GroupNode& groupNode) { groupNode.visitChildren(thisLambda); },
+    [&](auto&& thisLambda, EntityNode& entityNode) {
+      entries.emplace_back(entityNode.physicalBounds(), &entityNode);
+      entityNode.visitChildren(thisLambda);
+    },
+    [&](BrushNode& brushNode) {
+      entries.emplace_back(brushNode.physicalBounds(), &brushNode);
+    },
+    [&](PatchNode& patchNode) {
+      entries.emplace_back(patchNode.physicalBounds(), &patchNode);
+    }));
+}
+
+} // namespace
 
 WorldNode::WorldNode(
   EntityPropertyConfig entityPropertyConfig, Entity entity, const MapFormat mapFormat)
@@ -206,38 +238,34 @@ void WorldNode::enableNodeTreeUpdates()
 
 void WorldNode::rebuildNodeTree()
 {
-  auto nodes = std::vector<Node*>{};
-  const auto addNode = [&](auto& node) {
-    if (node.shouldAddToSpacialIndex())
-    {
-      nodes.push_back(&node);
-    }
-  };
-
-  accept(kdl::overload(
-    [&](auto&& thisLambda, WorldNode& worldNode) {
-      addNode(worldNode);
-      worldNode.visitChildren(thisLambda);
-    },
-    [&](auto&& thisLambda, LayerNode& layerNode) {
-      addNode(layerNode);
-      layerNode.visitChildren(thisLambda);
-    },
-    [&](auto&& thisLambda, GroupNode& groupNode) {
-      addNode(groupNode);
-      groupNode.visitChildren(thisLambda);
-    },
-    [&](auto&& thisLambda, EntityNode& entityNode) {
-      addNode(entityNode);
-      entityNode.visitChildren(thisLambda);
-    },
-    [&](BrushNode& brushNode) { addNode(brushNode); },
-    [&](PatchNode& patchNode) { addNode(patchNode); }));
+  auto entries = NodeTreeEntries{};
+  collectNodeTreeEntries(*this, entries);
 
   m_nodeTree->clear();
-  for (auto* node : nodes)
+  contract_assert(m_nodeTree->bulk_insert(entries));
+}
+
+void WorldNode::addNodes(const std::map<Node*, std::vector<Node*>>& nodes)
+{
+  const auto updateNodeTree = std::exchange(m_updateNodeTree, false);
+  for (const auto& [parent, children] : nodes)
   {
-    contract_assert(m_nodeTree->insert(node->physicalBounds(), node));
+    parent->addChildren(children);
+  }
+  m_updateNodeTree = updateNodeTree;
+
+  if (m_updateNodeTree)
+  {
+    auto entries = NodeTreeEntries{};
+    for (const auto& [parent, children] : nodes)
+    {
+      for (auto* child : children)
+      {
+        collectNodeTreeEntries(*child, entries);
+      }
+    }
+
+    contract_assert(m_nodeTree->bulk_insert(entries));
   }
 }
 
@@ -333,29 +361,11 @@ bool WorldNode::doShouldAddToSpacialIndex() const
 
 void WorldNode::doDescendantWasAdded(Node& node, const size_t /* depth */)
 {
-  // NOTE: `node` is just the root of a subtree that is being connected to this World.
-  // In some cases, (e.g. if `node` is a Group), `node` will not be added to the spatial
-  // index, but some of its descendants may be. We need to recursively search the `node`
-  // being connected and add it or any descendants that need to be added.
   if (m_updateNodeTree)
   {
-    node.accept(kdl::overload(
-      [&](
-        auto&& thisLambda, WorldNode& worldNode) { worldNode.visitChildren(thisLambda); },
-      [&](
-        auto&& thisLambda, LayerNode& layerNode) { layerNode.visitChildren(thisLambda); },
-      [&](
-        auto&& thisLambda, GroupNode& groupNode) { groupNode.visitChildren(thisLambda); },
-      [&](auto&& thisLambda, EntityNode& entityNode) {
-        contract_assert(m_nodeTree->insert(entityNode.physicalBounds(), &entityNode));
-        entityNode.visitChildren(thisLambda);
-      },
-      [&](BrushNode& brushNode) {
-        contract_assert(m_nodeTree->insert(brushNode.physicalBounds(), &brushNode));
-      },
-      [&](PatchNode& patchNode) {
-        contract_assert(m_nodeTree->insert(patchNode.physicalBounds(), &patchNode));
-      }));
+    auto entries = NodeTreeEntries{};
+    collectNodeTreeEntries(node, entries);
+    contract_assert(m_nodeTree->bulk_insert(entries));
   }
 
   const auto updatePersistentId = [&](auto& persistentNode) {
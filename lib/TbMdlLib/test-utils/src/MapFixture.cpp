@@ -24,6 +24,7 @@
 #include "gl/ResourceManager.h"
 #include "gl/TestGl.h"
 #include "gl/TestUtils.h"
+#include "mdl/GameAssetContext.h"
 #include "mdl/Map.h"
 #include "mdl/TestUtils.h"
 
@@ -56,6 +57,7 @@ Map& MapFixture::create(MapFixtureConfig config)
       vm::bbox3d{8129.0},
       *m_taskManager,
       *m_resourceManager,
+      std::make_shared<GameAssetContext>(),
       *m_logger)
     | kdl::transform([&](auto map) {
         m_map = std::move(map);
@@ -86,6 +88,7 @@ Map& MapFixture::load(const std::filesystem::path& path, MapFixtureConfig config
       absPath,
       *m_taskManager,
       *m_resourceManager,
+      std::make_shared<GameAssetContext>(),
       *m_logger)
     | kdl::transform([&](auto map) {
         m_map = std::move(map);
@@ -36,6 +36,7 @@
 #include "kd/vector_utils.h"
 
 #include "vm/approx.h"
+#include "vm/mat_ext.h"
 #include "vm/polygon.h"
 #include "vm/segment.h"
 #include "vm/vec.h"
@@ -342,6 +343,38 @@ TEST_CASE("Brush")
     }
   }
 
+  SECTION("copy")
+  {
+    const auto worldBounds = vm::bbox3d{4096.0};
+
+    const auto brushBuilder = BrushBuilder{MapFormat::Valve, worldBounds};
+    const auto brush = brushBuilder.createCube(64.0, "material") | kdl::value();
+
+    auto copy = brush;
+    REQUIRE(copy == brush);
+
+    SECTION("Copies share the brush geometry")
+    {
+      for (size_t i = 0; i < brush.faceCount(); ++i)
+      {
+        CHECK(copy.face(i).geometry() == brush.face(i).geometry());
+      }
+    }
+
+    SECTION("Changing a copy does not change the original")
+    {
+      REQUIRE(copy.transform(
+        worldBounds, vm::translation_matrix(vm::vec3d{16, 0, 0}), false));
+
+      CHECK(brush.bounds() == vm::bbox3d{32.0});
+      CHECK(copy.bounds() == vm::bbox3d{{-16, -32, -32}, {48, 32, 32}});
+      for (size_t i = 0; i < brush.faceCount(); ++i)
+      {
+        CHECK(copy.face(i).geometry() != brush.face(i).geometry());
+      }
+    }
+  }
+
   SECTION("cloneFaceAttributesFrom")
   {
     const auto worldBounds = vm::bbox3d{4096.0};
@@ -2466,6 +2499,32 @@ TEST_CASE("Brush")
         | kdl::value();
       CHECK(fragments.empty());
     }
+
+    SECTION("Subtract multiple brushes merges fragments")
+    {
+      const auto worldBounds = vm::bbox3d{4096.0};
+
+      auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+      const auto minuend =
+        builder.createCuboid(vm::bbox3d{{0, 0, 0}, {64, 64, 64}}, "material")
+        | kdl::value();
+
+      // together, the subtrahends remove the upper half of the minuend, but the first
+      // subtrahend splits the lower half into two fragments
+      const auto subtrahend1 =
+        builder.createCuboid(vm::bbox3d{{0, 0, 32}, {32, 64, 64}}, "material")
+        | kdl::value();
+      const auto subtrahend2 =
+        builder.createCuboid(vm::bbox3d{{32, 0, 32}, {64, 64, 64}}, "material")
+        | kdl::value();
+
+      const auto fragments =
+        minuend.subtract(
+          MapFormat::Standard, worldBounds, "material", {&subtrahend1, &subtrahend2})
+        | kdl::fold | kdl::value();
+      REQUIRE(fragments.size() == 1u);
+      CHECK(fragments.front().bounds() == vm::bbox3d{{0, 0, 0}, {64, 64, 32}});
+    }
   }
 }
 
@@ -498,6 +498,27 @@ TEST_CASE("BrushFace")
       p0, p1, p2, attribs, std::make_unique<ParaxialUVCoordSystem>(p0, p1, p2, attribs)));
   }
 
+  SECTION("copy")
+  {
+    const auto worldBounds = vm::bbox3d{4096.0};
+
+    const auto brushBuilder = BrushBuilder{MapFormat::Valve, worldBounds};
+    const auto brush = brushBuilder.createCube(64.0, "material") | kdl::value();
+    const auto& face = brush.face(0);
+
+    auto copy = face;
+    CHECK(&copy.attributes() == &face.attributes());
+
+    SECTION("Changing the attributes of a copy does not change the original")
+    {
+      copy.rotateUV(15.0f);
+
+      CHECK(&copy.attributes() != &face.attributes());
+      CHECK(face.attributes().rotation() == 0.0f);
+      CHECK(copy.attributes().rotation() != 0.0f);
+    }
+  }
+
   SECTION("materialUsageCount")
   {
     const auto p0 = vm::vec3d{0, 0, 4};
@@ -243,7 +243,8 @@ TEST_CASE("BrushNode")
         auto thinBrushNode = BrushNode{
           builder.createCuboid(vm::bbox3d{{1, -64, -64}, {2, 64, 64}}, "some_material")
           | kdl::value()};
-        for (const auto& point : patchNode.grid().points)
+        const auto grid = patchNode.grid();
+        for (const auto& point : grid.points)
         {
           REQUIRE_FALSE(thinBrushNode.brush().containsPoint(point.position));
         }
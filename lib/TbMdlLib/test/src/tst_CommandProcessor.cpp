@@ -33,6 +33,7 @@
 #include <memory>
 #include <ostream>
 #include <thread>
+#include <tuple>
 #include <variant>
 
 #include <catch2/catch_test_macros.hpp>
@@ -251,6 +252,21 @@ public:
   bool doPerformUndo(Map&) override { return true; }
 };
 
+class SizedCommand : public NullCommand
+{
+private:
+  size_t m_memorySize;
+
+public:
+  SizedCommand(std::string name, const size_t memorySize)
+    : NullCommand{std::move(name)}
+    , m_memorySize{memorySize}
+  {
+  }
+
+  size_t doGetMemorySize() const override { return m_memorySize; }
+};
+
 } // namespace
 
 TEST_CASE("CommandProcessor")
@@ -922,6 +938,69 @@ TEST_CASE("CommandProcessor")
     CHECK(*commandProcessor.redoCommandName() == commandName2);
   }
 
+  SECTION("undoMemoryLimit")
+  {
+    commandProcessor.setIsCollationEnabled(false);
+
+    auto discarded = std::vector<std::tuple<size_t, size_t>>{};
+    notifierConnection += commandProcessor.undoCommandsDiscardedNotifier.connect(
+      [&](const auto count, const auto memorySize) {
+        discarded.emplace_back(count, memorySize);
+      });
+
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd1", 100));
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd2", 200));
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd3", 300));
+    CHECK(commandProcessor.undoMemorySize() == 600);
+
+    SECTION("Oldest commands are discarded when the limit is set")
+    {
+      commandProcessor.setUndoMemoryLimit(500);
+
+      CHECK(discarded == std::vector<std::tuple<size_t, size_t>>{{1, 100}});
+      CHECK(commandProcessor.undoMemorySize() == 500);
+
+      CHECK(commandProcessor.undo());
+      CHECK(commandProcessor.undo());
+      CHECK_FALSE(commandProcessor.canUndo());
+    }
+
+    SECTION("Oldest commands are discarded when a command is stored")
+    {
+      commandProcessor.setUndoMemoryLimit(600);
+      CHECK(discarded.empty());
+
+      commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd4", 250));
+
+      CHECK(discarded == std::vector<std::tuple<size_t, size_t>>{{2, 300}});
+      CHECK(commandProcessor.undoMemorySize() == 550);
+      CHECK(*commandProcessor.undoCommandName() == "cmd4");
+    }
+
+    SECTION("The most recent command is always kept")
+    {
+      commandProcessor.setUndoMemoryLimit(100);
+
+      CHECK(discarded == std::vector<std::tuple<size_t, size_t>>{{2, 300}});
+      CHECK(commandProcessor.undoMemorySize() == 300);
+      CHECK(*commandProcessor.undoCommandName() == "cmd3");
+    }
+
+    SECTION("Transactions are discarded as a whole")
+    {
+      commandProcessor.setUndoMemoryLimit(1000);
+
+      commandProcessor.startTransaction("transaction", TransactionScope::Oneshot);
+      commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd4", 300));
+      commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd5", 300));
+      commandProcessor.commitTransaction();
+
+      REQUIRE(discarded.size() == 1);
+      CHECK(std::get<0>(discarded.front()) == 2);
+      CHECK(*commandProcessor.undoCommandName() == "transaction");
+    }
+  }
+
   SECTION("collateTransactions")
   {
     auto transaction1_command1 =
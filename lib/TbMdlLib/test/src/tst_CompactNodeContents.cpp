@@ -0,0 +1,116 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/CatchConfig.h"
+#include "mdl/CompactNodeContents.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/NodeContents.h"
+#include "mdl/UVCoordSystem.h"
+
+#include "kd/result.h"
+
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include <variant>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+
+TEST_CASE("CompactNodeContents")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Valve, worldBounds};
+
+  const auto originalBrush = builder.createCube(64.0, "material") | kdl::value();
+  auto brushNode = BrushNode{originalBrush};
+
+  const auto expandBrush = [&](const CompactNodeContents& contents) {
+    auto expanded = contents.expand(brushNode, worldBounds) | kdl::value();
+    return std::get<Brush>(std::move(expanded.get()));
+  };
+
+  SECTION("Non-brush contents are not compacted")
+  {
+    const auto entity = Entity{{{"classname", "info_player_start"}}};
+    auto entityNode = EntityNode{Entity{{{"classname", "light"}}}};
+
+    auto contents = CompactNodeContents::compact(NodeContents{entity}, entityNode);
+    CHECK_FALSE(contents.isCompact());
+
+    auto expanded = contents.expand(entityNode, worldBounds) | kdl::value();
+    CHECK(std::get<Entity>(expanded.get()) == entity);
+  }
+
+  SECTION("Brushes with changed face attributes are stored as face changes")
+  {
+    auto changedBrush = originalBrush;
+    auto attributes = changedBrush.face(0).attributes();
+    attributes.setXOffset(16.0f);
+    attributes.setRotation(45.0f);
+    changedBrush.face(0).setAttributes(attributes);
+    brushNode.setBrush(changedBrush);
+
+    auto contents = CompactNodeContents::compact(NodeContents{originalBrush}, brushNode);
+    CHECK(contents.isCompact());
+    CHECK(
+      contents.memorySize()
+      < CompactNodeContents{NodeContents{originalBrush}}.memorySize());
+
+    const auto expandedBrush = expandBrush(contents);
+    CHECK(expandedBrush == originalBrush);
+    CHECK(
+      expandedBrush.face(0).uvCoordSystem() == originalBrush.face(0).uvCoordSystem());
+    CHECK(expandedBrush.vertexPositions() == originalBrush.vertexPositions());
+  }
+
+  SECTION("Brushes with changed geometry are stored as faces")
+  {
+    auto changedBrush = originalBrush;
+    REQUIRE(changedBrush.transform(
+      worldBounds, vm::translation_matrix(vm::vec3d{16, 0, 0}), false));
+    brushNode.setBrush(changedBrush);
+
+    auto contents = CompactNodeContents::compact(NodeContents{originalBrush}, brushNode);
+    CHECK(contents.isCompact());
+    CHECK(
+      contents.memorySize()
+      < CompactNodeContents{NodeContents{originalBrush}}.memorySize());
+
+    const auto expandedBrush = expandBrush(contents);
+    CHECK(expandedBrush == originalBrush);
+    CHECK(expandedBrush.vertexPositions() == originalBrush.vertexPositions());
+
+    SECTION("Failing to expand leaves the contents unchanged")
+    {
+      REQUIRE(contents.expand(brushNode, vm::bbox3d{8.0}).is_error());
+      CHECK(expandBrush(contents) == originalBrush);
+    }
+  }
+}
+
+} // namespace tb::mdl
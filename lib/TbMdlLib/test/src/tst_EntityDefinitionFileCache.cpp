@@ -0,0 +1,187 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Logger.h"
+#include "fs/DiskIO.h"
+#include "fs/File.h"
+#include "fs/Reader.h"
+#include "mdl/CatchConfig.h"
+#include "mdl/EntityDefinition.h"
+#include "mdl/EntityDefinitionFileCache.h"
+#include "mdl/LoadEntityDefinitions.h"
+
+#include "kd/result.h"
+#include "kd/task_manager.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+namespace
+{
+
+auto makeKey(const std::filesystem::path& path)
+{
+  const auto file = fs::Disk::openFile(path) | kdl::value();
+  const auto bufferedReader = file->reader().buffer();
+  return EntityDefinitionFileCache::makeKey(path, bufferedReader.stringView());
+}
+
+bool containsDefinition(
+  const std::vector<EntityDefinition>& definitions, const std::string& name)
+{
+  return std::ranges::any_of(
+    definitions, [&](const auto& definition) { return definition.name == name; });
+}
+
+} // namespace
+
+TEST_CASE("EntityDefinitionFileCache")
+{
+  auto cache = EntityDefinitionFileCache{};
+
+  const auto contents = EntityDefinitionFileContents{
+    {{.type = EntityDefinitionClassType::PointClass, .name = "some_class"}},
+    {{0, "include.fgd"}},
+  };
+
+  cache.insert(EntityDefinitionFileCache::makeKey("defs/test.fgd", "contents"), contents);
+  REQUIRE(cache.size() == 1);
+
+  SECTION("find")
+  {
+    CHECK(
+      cache.find(EntityDefinitionFileCache::makeKey("defs/test.fgd", "contents"))
+      != nullptr);
+    CHECK(
+      *cache.find(EntityDefinitionFileCache::makeKey("defs/test.fgd", "contents"))
+      == contents);
+
+    CHECK(
+      cache.find(EntityDefinitionFileCache::makeKey("defs/test.fgd", "changed contents"))
+      == nullptr);
+    CHECK(
+      cache.find(EntityDefinitionFileCache::makeKey("defs/other.fgd", "contents"))
+      == nullptr);
+  }
+
+  SECTION("insert replaces the contents cached for the same path")
+  {
+    const auto otherContents = EntityDefinitionFileContents{
+      {{.type = EntityDefinitionClassType::BrushClass, .name = "other_class"}},
+      {},
+    };
+
+    cache.insert(
+      EntityDefinitionFileCache::makeKey("defs/test.fgd", "changed contents"),
+      otherContents);
+
+    CHECK(cache.size() == 1);
+    CHECK(
+      cache.find(EntityDefinitionFileCache::makeKey("defs/test.fgd", "contents"))
+      == nullptr);
+    CHECK(
+      *cache.find(EntityDefinitionFileCache::makeKey("defs/test.fgd", "changed contents"))
+      == otherContents);
+  }
+}
+
+TEST_CASE("loadEntityDefinitions with EntityDefinitionFileCache")
+{
+  auto logger = NullLogger{};
+  auto taskManager = kdl::task_manager{};
+  const auto defaultColor = Color{RgbaF{1.0f, 1.0f, 1.0f, 1.0f}};
+
+  auto cache = EntityDefinitionFileCache{};
+
+  SECTION("Nested includes")
+  {
+    const auto fixturePath =
+      std::filesystem::current_path() / "fixture/test/mdl/FgdParser/parseNestedInclude";
+    const auto path = fixturePath / "host.fgd";
+
+    const auto definitions =
+      loadEntityDefinitions(path, defaultColor, cache, taskManager, logger)
+      | kdl::value();
+
+    CHECK(definitions.size() == 3u);
+    CHECK(containsDefinition(definitions, "worldspawn"));
+    CHECK(containsDefinition(definitions, "info_player_start"));
+    CHECK(containsDefinition(definitions, "info_player_coop"));
+
+    CHECK(cache.size() == 3u);
+    CHECK(cache.find(makeKey(path)) != nullptr);
+    CHECK(cache.find(makeKey(fixturePath / "nested/include.fgd")) != nullptr);
+    CHECK(cache.find(makeKey(fixturePath / "nested/nested.fgd")) != nullptr);
+
+    SECTION("Unchanged files are not parsed again")
+    {
+      const auto key = makeKey(fixturePath / "nested/nested.fgd");
+      cache.insert(
+        key,
+        EntityDefinitionFileContents{
+          {{
+            .type = EntityDefinitionClassType::PointClass,
+            .name = "cached_class",
+            .superClasses = {"PlayerClass"},
+          }},
+          {},
+        });
+
+      const auto cachedDefinitions =
+        loadEntityDefinitions(path, defaultColor, cache, taskManager, logger)
+        | kdl::value();
+
+      CHECK(cachedDefinitions.size() == 3u);
+      CHECK(containsDefinition(cachedDefinitions, "info_player_start"));
+      CHECK(containsDefinition(cachedDefinitions, "cached_class"));
+      CHECK(!containsDefinition(cachedDefinitions, "info_player_coop"));
+    }
+  }
+
+  SECTION("Recursive includes")
+  {
+    const auto path = std::filesystem::current_path()
+                      / "fixture/test/mdl/FgdParser/parseRecursiveInclude/host.fgd";
+
+    const auto definitions =
+      loadEntityDefinitions(path, defaultColor, cache, taskManager, logger)
+      | kdl::value();
+
+    CHECK(definitions.size() == 1u);
+    CHECK(containsDefinition(definitions, "worldspawn"));
+    CHECK(cache.size() == 1u);
+  }
+
+  SECTION("Missing file")
+  {
+    const auto path =
+      std::filesystem::current_path() / "fixture/test/mdl/FgdParser/missing.fgd";
+
+    CHECK(loadEntityDefinitions(path, defaultColor, cache, taskManager, logger)
+            .is_error());
+    CHECK(cache.size() == 0u);
+  }
+}
+
+} // namespace tb::mdl
@@ -22,7 +22,9 @@
 #include "mdl/EntityDefinition.h"
 #include "mdl/EntityLinkManager.h"
 #include "mdl/EntityNode.h"
-#include "mdl/NodeIndex.h"
+#include "mdl/TestUtils.h"
+
+#include "kd/task_manager.h"
 
 #include <vector>
 
@@ -45,8 +47,7 @@ TEST_CASE("EntityLinkManager")
   const auto TargetProp = "targetname"s;
   const auto AltTargetProp = "alt_targetname"s;
 
-  auto i = NodeIndex{};
-  auto m = EntityLinkManager{i};
+  auto m = EntityLinkManager{};
 
   const auto sourceDefinition = EntityDefinition{
     "source_definition",
@@ -87,22 +88,13 @@ TEST_CASE("EntityLinkManager")
     }}};
     targetNode.setDefinition(&targetDefinition);
 
-    i.addNode(targetNode);
-    i.addNode(sourceNode);
 
     m.addEntityNode(sourceNode);
-    CHECK(
-      m.linksFrom(sourceNode)
-      == LinkEndsForKey{
-        {SourceProp, {{&targetNode, TargetProp}}},
-      });
+    CHECK(m.linksFrom(sourceNode) == LinkEndsForKey{{SourceProp, {}}});
     CHECK(m.linksTo(sourceNode) == LinkEndsForKey{});
     CHECK(m.linksFrom(targetNode) == LinkEndsForKey{});
-    CHECK(
-      m.linksTo(targetNode)
-      == LinkEndsForKey{
-        {TargetProp, {{&sourceNode, SourceProp}}},
-      });
+    CHECK(m.linksTo(targetNode) == LinkEndsForKey{});
+    CHECK(m.hasMissingTarget(sourceNode, SourceProp));
 
     m.addEntityNode(targetNode);
     CHECK(
@@ -213,8 +205,6 @@ TEST_CASE("EntityLinkManager")
     }}};
     targetNode.setDefinition(&targetDefinition);
 
-    i.addNode(targetNode);
-    i.addNode(sourceNode);
 
     m.addEntityNode(sourceNode);
     m.addEntityNode(targetNode);
@@ -241,8 +231,6 @@ TEST_CASE("EntityLinkManager")
       {TargetProp, "some_name"},
     }}};
 
-    i.addNode(n1);
-    i.addNode(n2);
 
     m.addEntityNode(n1);
     m.addEntityNode(n2);
@@ -264,8 +252,6 @@ TEST_CASE("EntityLinkManager")
 
     n2.setDefinition(&targetDefinition);
 
-    i.addNode(n1);
-    i.addNode(n2);
 
     m.addEntityNode(n1);
     m.addEntityNode(n2);
@@ -287,8 +273,6 @@ TEST_CASE("EntityLinkManager")
 
     n1.setDefinition(&sourceDefinition);
 
-    i.addNode(n1);
-    i.addNode(n2);
 
     m.addEntityNode(n1);
     m.addEntityNode(n2);
@@ -317,9 +301,6 @@ TEST_CASE("EntityLinkManager")
     n2.setDefinition(&targetDefinition);
     n3.setDefinition(&targetDefinition);
 
-    i.addNode(n1);
-    i.addNode(n2);
-    i.addNode(n3);
 
     m.addEntityNode(n1);
     m.addEntityNode(n2);
@@ -350,9 +331,6 @@ TEST_CASE("EntityLinkManager")
     n2.setDefinition(&targetDefinition);
     n3.setDefinition(&targetDefinition);
 
-    i.addNode(n1);
-    i.addNode(n2);
-    i.addNode(n3);
 
     m.addEntityNode(n1);
     m.addEntityNode(n2);
@@ -380,7 +358,6 @@ TEST_CASE("EntityLinkManager")
 
     n.setDefinition(&sourceTargetDefinition);
 
-    i.addNode(n);
 
     m.addEntityNode(n);
     CHECK(m.linksFrom(n) == LinkEndsForKey{{SourceProp, {{&n, TargetProp}}}});
@@ -410,8 +387,6 @@ TEST_CASE("EntityLinkManager")
     n1.setDefinition(&sourceTargetDefinition);
     n2.setDefinition(&sourceTargetDefinition);
 
-    i.addNode(n1);
-    i.addNode(n2);
 
     m.addEntityNode(n1);
     m.addEntityNode(n2);
@@ -471,9 +446,6 @@ TEST_CASE("EntityLinkManager")
     n2.setDefinition(&sourceTargetDefinition);
     n3.setDefinition(&targetDefinition);
 
-    i.addNode(n1);
-    i.addNode(n2);
-    i.addNode(n3);
 
     m.addEntityNode(n1);
     m.addEntityNode(n2);
@@ -641,12 +613,10 @@ TEST_CASE("EntityLinkManager")
     sourceNode.setDefinition(&sourceDefinition);
     targetNode.setDefinition(&targetDefinition);
 
-    i.addNode(targetNode);
-    i.addNode(sourceNode);
     REQUIRE(!m.hasLink(sourceNode, targetNode, SourceProp));
 
     m.addEntityNode(sourceNode);
-    CHECK(m.hasLink(sourceNode, targetNode, SourceProp));
+    CHECK(!m.hasLink(sourceNode, targetNode, SourceProp));
 
     m.addEntityNode(targetNode);
     CHECK(m.hasLink(sourceNode, targetNode, SourceProp));
@@ -655,7 +625,7 @@ TEST_CASE("EntityLinkManager")
     CHECK(!m.hasLink(sourceNode, targetNode, SourceProp));
   }
 
-  SECTION("Order of indexing and adding nodes")
+  SECTION("Order of adding nodes")
   {
     auto n1 = EntityNode{Entity{{
       {SourceProp, "some_name"},
@@ -670,34 +640,105 @@ TEST_CASE("EntityLinkManager")
     n1.setDefinition(&sourceTargetDefinition);
     n2.setDefinition(&sourceTargetDefinition);
 
-    SECTION("Index everything, then add")
-    {
-      i.addNode(n1);
-      i.addNode(n2);
+    const auto [first, second] = GENERATE_REF(
+      std::pair<EntityNode*, EntityNode*>{&n1, &n2},
+      std::pair<EntityNode*, EntityNode*>{&n2, &n1});
 
-      m.addEntityNode(n1);
-      CHECK(m.hasLink(n1, n2, SourceProp));
-      CHECK(m.hasLink(n2, n1, SourceProp));
+    m.addEntityNode(*first);
+    CHECK(!m.hasLink(n1, n2, SourceProp));
+    CHECK(!m.hasLink(n2, n1, SourceProp));
 
-      m.addEntityNode(n2);
-      CHECK(m.hasLink(n1, n2, SourceProp));
-      CHECK(m.hasLink(n2, n1, SourceProp));
-    }
+    m.addEntityNode(*second);
+    CHECK(m.hasLink(n1, n2, SourceProp));
+    CHECK(m.hasLink(n2, n1, SourceProp));
+  }
 
-    SECTION("Index and add nodes individually")
-    {
-      i.addNode(n1);
-      m.addEntityNode(n1);
+  SECTION("Adding a node twice")
+  {
+    auto sourceNode = EntityNode{Entity{{
+      {SourceProp + "1", "some_name"},
+      {SourceProp + "2", "some_name"},
+    }}};
 
-      CHECK(!m.hasLink(n1, n2, SourceProp));
-      CHECK(!m.hasLink(n2, n1, SourceProp));
+    auto targetNode = EntityNode{Entity{{
+      {TargetProp, "some_name"},
+    }}};
+
+    sourceNode.setDefinition(&sourceDefinition);
+    targetNode.setDefinition(&targetDefinition);
 
-      i.addNode(n2);
-      m.addEntityNode(n2);
+    m.addEntityNode(sourceNode);
+    m.addEntityNode(targetNode);
+    m.addEntityNode(sourceNode);
 
-      CHECK(m.hasLink(n1, n2, SourceProp));
-      CHECK(m.hasLink(n2, n1, SourceProp));
+    CHECK(
+      m.linksFrom(sourceNode)
+      == LinkEndsForKey{
+        {SourceProp, {{&targetNode, TargetProp}}},
+      });
+    CHECK(
+      m.linksTo(targetNode)
+      == LinkEndsForKey{
+        {TargetProp, {{&sourceNode, SourceProp}}},
+      });
+
+    m.removeEntityNode(sourceNode);
+    CHECK(m.linksTo(targetNode) == LinkEndsForKey{{TargetProp, {}}});
+  }
+
+  SECTION("Adding entities in bulk")
+  {
+    auto n1 = EntityNode{Entity{{
+      {SourceProp, "n2"},
+      {SourceProp + "2", "n3"},
+    }}};
+
+    auto n2 = EntityNode{Entity{{
+      {TargetProp, "n2"},
+      {SourceProp, "n3"},
+    }}};
+
+    auto n3 = EntityNode{Entity{{
+      {TargetProp, "n3"},
+      {TargetProp + "1", "n3"},
+      {AltTargetProp, "n2"},
+    }}};
+
+    auto n4 = EntityNode{Entity{{
+      {SourceProp, "n4"},
+      {TargetProp, "n4"},
+    }}};
+
+    auto n5 = EntityNode{Entity{{
+      {SourceProp, "missing"},
+      {TargetProp + "2", "n3"},
+    }}};
+
+    n1.setDefinition(&sourceDefinition);
+    n2.setDefinition(&sourceTargetDefinition);
+    n3.setDefinition(&targetDefinition);
+    n4.setDefinition(&sourceTargetDefinition);
+    n5.setDefinition(&sourceTargetDefinition);
+
+    const auto nodes = std::vector<EntityNodeBase*>{&n1, &n2, &n3, &n4, &n5};
+    auto expected = EntityLinkManager{};
+    for (auto* node : nodes)
+    {
+      expected.addEntityNode(*node);
     }
+
+    auto taskManager = createTestTaskManager();
+    m.addEntityNodes(nodes, *taskManager);
+
+    for (const auto* node : nodes)
+    {
+      CHECK(m.linksFrom(*node) == expected.linksFrom(*node));
+      CHECK(m.linksTo(*node) == expected.linksTo(*node));
+    }
+
+    CHECK(m.hasLink(n1, n3, SourceProp, AltTargetProp));
+    CHECK(m.hasLink(n4, n4, SourceProp));
+    CHECK(m.hasMissingTarget(n5, SourceProp));
   }
 }
 
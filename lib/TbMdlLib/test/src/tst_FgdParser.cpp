@@ -1252,6 +1252,31 @@ model({"path"
       defs.value(), [](const auto& def) { return def.name == "worldspawn"; }));
   }
 
+  SECTION("parseFileContents")
+  {
+    const auto file = R"(
+@PointClass = first []
+@include "include.fgd"
+@PointClass = second []
+@include "nested/other.fgd"
+)";
+
+    auto parser = FgdParser{file, RgbaF{1.0f, 1.0f, 1.0f, 1.0f}};
+    auto status = TestParserStatus{};
+
+    const auto contents = parser.parseFileContents(status);
+    REQUIRE(contents);
+    REQUIRE(contents.value().classInfos.size() == 2u);
+    CHECK(contents.value().classInfos[0].name == "first");
+    CHECK(contents.value().classInfos[1].name == "second");
+    CHECK(
+      contents.value().includes
+      == std::vector<EntityDefinitionFileContents::Include>{
+        {1, "include.fgd"},
+        {2, "nested/other.fgd"},
+      });
+  }
+
   SECTION("parseStringContinuations")
   {
     const auto file = R"(
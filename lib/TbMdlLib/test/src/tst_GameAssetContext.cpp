@@ -0,0 +1,201 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Logger.h"
+#include "fs/DiskFileSystem.h"
+#include "fs/TestEnvironment.h"
+#include "gl/Material.h"
+#include "gl/MaterialManager.h"
+#include "gl/ResourceManager.h"
+#include "gl/TestGl.h"
+#include "gl/TestUtils.h"
+#include "gl/Texture.h"
+#include "gl/TextureResource.h"
+#include "mdl/CatchConfig.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/EnvironmentConfig.h"
+#include "mdl/GameAssetContext.h"
+#include "mdl/GameAssetContextManager.h"
+#include "mdl/GameConfigFixture.h"
+#include "mdl/Map.h"
+#include "mdl/Map_Entities.h"
+#include "mdl/MapFormat.h"
+#include "mdl/SharedResourceCache.h"
+#include "mdl/TestUtils.h"
+
+#include "kd/result.h"
+#include "kd/task_manager.h"
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+using namespace std::chrono_literals;
+
+namespace
+{
+
+void processResources(gl::ResourceManager& resourceManager)
+{
+  auto gl = gl::TestGl{};
+  gl::processResourcesSync(resourceManager, gl::ProcessContext{gl, [](auto, auto) {}});
+}
+
+} // namespace
+
+TEST_CASE("GameAssetContextManager")
+{
+  auto manager = GameAssetContextManager{};
+
+  auto quakeContext = manager.acquire("Quake");
+  REQUIRE(quakeContext != nullptr);
+
+  CHECK(manager.acquire("Quake") == quakeContext);
+  CHECK(manager.acquire("Quake 2") != quakeContext);
+
+  SECTION("A context is released when it is no longer used")
+  {
+    quakeContext->shaderCache().insert(Quake3ShaderCache::makeKey("shader", ""), {});
+    quakeContext.reset();
+
+    CHECK(manager.acquire("Quake")->shaderCache().size() == 0);
+  }
+}
+
+TEST_CASE("SharedResourceCache")
+{
+  auto env = fs::TestEnvironment{};
+  env.createDirectory("textures");
+  env.createFile("textures/texture.wal", "contents");
+
+  const auto fs = fs::DiskFileSystem{env.dir()};
+  const auto searchPaths = std::vector<std::filesystem::path>{"baseq2"};
+
+  auto resourceManager = gl::ResourceManager{};
+  const auto createResource = [&](auto resourceLoader) {
+    auto resource = std::make_shared<gl::TextureResource>(std::move(resourceLoader));
+    resourceManager.addResource(resource);
+    return resource;
+  };
+  const auto loadTexture = []() { return Result<gl::Texture>{gl::Texture{16, 16}}; };
+
+  auto cache = SharedResourceCache<gl::Texture>{};
+
+  auto resource = cache.getOrCreate(
+    fs, searchPaths, "textures/texture.wal", loadTexture, createResource);
+  REQUIRE(resource != nullptr);
+  REQUIRE(cache.size() == 1);
+
+  SECTION("Resources that are not ready are not shared")
+  {
+    CHECK(
+      cache.getOrCreate(
+        fs, searchPaths, "textures/texture.wal", loadTexture, createResource)
+      != resource);
+  }
+
+  SECTION("Resources that are ready are shared")
+  {
+    processResources(resourceManager);
+
+    CHECK(
+      cache.getOrCreate(
+        fs, searchPaths, "textures/texture.wal", loadTexture, createResource)
+      == resource);
+    CHECK(
+      cache.getOrCreate(
+        fs, {"baseq2", "mod"}, "textures/texture.wal", loadTexture, createResource)
+      != resource);
+  }
+
+  SECTION("Resources for modified files are not shared")
+  {
+    processResources(resourceManager);
+
+    const auto path = env.dir() / "textures/texture.wal";
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + 1h);
+
+    CHECK(
+      cache.getOrCreate(
+        fs, searchPaths, "textures/texture.wal", loadTexture, createResource)
+      != resource);
+  }
+
+  SECTION("Resources for files that are not on disk are not cached")
+  {
+    cache.getOrCreate(
+      fs, searchPaths, "textures/missing.wal", loadTexture, createResource);
+    CHECK(cache.size() == 1);
+  }
+}
+
+TEST_CASE("GameAssetContext")
+{
+  auto taskManager = createTestTaskManager();
+  auto resourceManager = gl::ResourceManager{};
+  auto logger = NullLogger{};
+
+  const auto environmentConfig = EnvironmentConfig{};
+
+  const auto createMap = [&](auto assetContext) {
+    auto map = Map::createMap(
+                 environmentConfig,
+                 DefaultGameInfo,
+                 DefaultGameInfo.gamePathPreference.defaultValue,
+                 MapFormat::Standard,
+                 vm::bbox3d{8192.0},
+                 *taskManager,
+                 resourceManager,
+                 std::move(assetContext),
+                 logger)
+               | kdl::value();
+    setEntityProperty(*map, EntityPropertyKeys::Wad, "fixture/test/mdl/Map/cr8_czg.wad");
+    processResources(resourceManager);
+    return map;
+  };
+
+  const auto textureResource = [](const Map& map) {
+    const auto* material = map.materialManager().material("coffin1");
+    REQUIRE(material != nullptr);
+    return &material->textureResource();
+  };
+
+  auto assetContext = std::make_shared<GameAssetContext>();
+  const auto map1 = createMap(assetContext);
+
+  SECTION("Maps using the same context share their textures")
+  {
+    const auto map2 = createMap(assetContext);
+    CHECK(textureResource(*map2) == textureResource(*map1));
+  }
+
+  SECTION("Maps using different contexts do not share their textures")
+  {
+    const auto map2 = createMap(std::make_shared<GameAssetContext>());
+    CHECK(textureResource(*map2) != textureResource(*map1));
+  }
+}
+
+} // namespace tb::mdl
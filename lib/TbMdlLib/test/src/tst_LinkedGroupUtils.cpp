@@ -43,6 +43,7 @@
 #include <algorithm>
 #include <numeric>
 #include <ranges>
+#include <unordered_set>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
@@ -718,6 +719,135 @@ TEST_CASE("updateLinkedGroups")
   }
 }
 
+TEST_CASE("updateLinkedGroupsIncrementally")
+{
+  auto taskManager = kdl::task_manager{};
+
+  const auto worldBounds = vm::bbox3d{8192.0};
+
+  auto groupNode = GroupNode{Group{"name"}};
+  auto* entityNode = new EntityNode{Entity{{{"some_key", "some_value"}}}};
+  auto* otherEntityNode = new EntityNode{Entity{}};
+  groupNode.addChildren({entityNode, otherEntityNode});
+
+  auto groupNodeClone = std::unique_ptr<GroupNode>{
+    static_cast<GroupNode*>(groupNode.cloneRecursively(worldBounds))};
+  transformNode(
+    *groupNodeClone, vm::translation_matrix(vm::vec3d{0, 2, 0}), worldBounds);
+
+  auto* entityNodeClone = static_cast<EntityNode*>(groupNodeClone->children().front());
+  REQUIRE(entityNodeClone->entity().origin() == vm::vec3d{0, 2, 0});
+
+  SECTION("Nothing has changed")
+  {
+    updateLinkedGroupsIncrementally(
+      groupNode, {groupNodeClone.get()}, worldBounds, taskManager)
+      | kdl::transform([&](const LinkedGroupUpdates& r) {
+          CHECK(r.childrenToReplace.empty());
+          CHECK(r.contentsToSwap.empty());
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Only changed nodes are updated")
+  {
+    transformNode(*entityNode, vm::translation_matrix(vm::vec3d{0, 0, 3}), worldBounds);
+
+    updateLinkedGroupsIncrementally(
+      groupNode, {groupNodeClone.get()}, worldBounds, taskManager)
+      | kdl::transform([&](const LinkedGroupUpdates& r) {
+          CHECK(r.childrenToReplace.empty());
+          REQUIRE(r.contentsToSwap.size() == 1u);
+
+          const auto& [nodeToUpdate, newContents] = r.contentsToSwap.front();
+          CHECK(nodeToUpdate == entityNodeClone);
+          CHECK(std::get<Entity>(newContents.get()).origin() == vm::vec3d{0, 2, 3});
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Only the linked duplicates of the given changed nodes are compared")
+  {
+    transformNode(*entityNode, vm::translation_matrix(vm::vec3d{0, 0, 3}), worldBounds);
+    transformNode(
+      *otherEntityNode, vm::translation_matrix(vm::vec3d{0, 0, 5}), worldBounds);
+
+    const auto changedNodes = std::unordered_set<const Node*>{otherEntityNode};
+    updateLinkedGroupsIncrementally(
+      groupNode, {groupNodeClone.get()}, worldBounds, taskManager, &changedNodes)
+      | kdl::transform([&](const LinkedGroupUpdates& r) {
+          CHECK(r.childrenToReplace.empty());
+          REQUIRE(r.contentsToSwap.size() == 1u);
+
+          const auto& [nodeToUpdate, newContents] = r.contentsToSwap.front();
+          CHECK(nodeToUpdate == groupNodeClone->children().back());
+          CHECK(std::get<Entity>(newContents.get()).origin() == vm::vec3d{0, 2, 5});
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Protected entity properties are preserved")
+  {
+    {
+      auto entity = entityNodeClone->entity();
+      entity.setProtectedProperties({"some_key"});
+      entity.addOrUpdateProperty("some_key", "protected_value");
+      entityNodeClone->setEntity(std::move(entity));
+    }
+
+    {
+      auto entity = entityNode->entity();
+      entity.addOrUpdateProperty("some_key", "other_value");
+      entity.addOrUpdateProperty("another_key", "another_value");
+      entityNode->setEntity(std::move(entity));
+    }
+
+    updateLinkedGroupsIncrementally(
+      groupNode, {groupNodeClone.get()}, worldBounds, taskManager)
+      | kdl::transform([&](const LinkedGroupUpdates& r) {
+          CHECK(r.childrenToReplace.empty());
+          REQUIRE(r.contentsToSwap.size() == 1u);
+
+          const auto& [nodeToUpdate, newContents] = r.contentsToSwap.front();
+          CHECK(nodeToUpdate == entityNodeClone);
+
+          const auto& newEntity = std::get<Entity>(newContents.get());
+          CHECK(*newEntity.property("some_key") == "protected_value");
+          CHECK(*newEntity.property("another_key") == "another_value");
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Structural changes replace the children of the target group")
+  {
+    groupNode.addChild(new EntityNode{Entity{}});
+
+    updateLinkedGroupsIncrementally(
+      groupNode, {groupNodeClone.get()}, worldBounds, taskManager)
+      | kdl::transform([&](const LinkedGroupUpdates& r) {
+          CHECK(r.contentsToSwap.empty());
+          REQUIRE(r.childrenToReplace.size() == 1u);
+
+          const auto& [groupNodeToUpdate, newChildren] = r.childrenToReplace.front();
+          CHECK(groupNodeToUpdate == groupNodeClone.get());
+          CHECK(newChildren.size() == 3u);
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Linked node exceeds world bounds after update")
+  {
+    transformNode(
+      *entityNode, vm::translation_matrix(vm::vec3d{8192 - 4, 0, 0}), worldBounds);
+
+    updateLinkedGroupsIncrementally(
+      groupNode, {groupNodeClone.get()}, worldBounds, taskManager)
+      | kdl::transform([](auto) { FAIL(); }) | kdl::transform_error([](auto e) {
+          CHECK(e == Error{"Updating a linked node would exceed world bounds"});
+        });
+  }
+}
+
 TEST_CASE("initializeLinkIds")
 {
   auto brushBuilder = BrushBuilder{MapFormat::Quake3, vm::bbox3d{8192.0}};
@@ -33,6 +33,7 @@
 #include "mdl/Entity.h"
 #include "mdl/EntityDefinitionManager.h"
 #include "mdl/EntityNode.h"
+#include "mdl/GameAssetContext.h"
 #include "mdl/GameInfo.h"
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
@@ -47,6 +48,7 @@
 #include "mdl/Map_Selection.h"
 #include "mdl/Matchers.h"
 #include "mdl/PasteType.h"
+#include "mdl/TagManager.h"
 #include "mdl/TagMatcher.h"
 #include "mdl/TestFactory.h"
 #include "mdl/TestUtils.h"
@@ -113,6 +115,7 @@ TEST_CASE("Map")
         vm::bbox3d{8192.0},
         *taskManager,
         resourceManager,
+        std::make_shared<GameAssetContext>(),
         logger)
         | kdl::transform([](auto map) {
             CHECK(
@@ -145,6 +148,7 @@ TEST_CASE("Map")
         vm::bbox3d{8192.0},
         *taskManager,
         resourceManager,
+        std::make_shared<GameAssetContext>(),
         logger)
         | kdl::transform([](auto map) {
             const auto* defaultLayerNode = map->worldNode().defaultLayer();
@@ -181,6 +185,7 @@ TEST_CASE("Map")
         vm::bbox3d{8192.0},
         *taskManager,
         resourceManager,
+        std::make_shared<GameAssetContext>(),
         logger)
         | kdl::transform([](auto map) {
             const auto* valveVersionProperty =
@@ -208,6 +213,7 @@ TEST_CASE("Map")
         vm::bbox3d{8192.0},
         *taskManager,
         resourceManager,
+        std::make_shared<GameAssetContext>(),
         logger)
         | kdl::transform([](auto map) {
             const auto* materialConfigProperty =
@@ -234,6 +240,7 @@ TEST_CASE("Map")
         vm::bbox3d{8192.0},
         *taskManager,
         resourceManager,
+        std::make_shared<GameAssetContext>(),
         logger)
         | kdl::transform([](auto map) {
             const auto* defaultLayerNode = map->worldNode().defaultLayer();
@@ -267,6 +274,7 @@ TEST_CASE("Map")
         vm::bbox3d{8192.0},
         *taskManager,
         resourceManager,
+        std::make_shared<GameAssetContext>(),
         logger)
         | kdl::transform([](auto map) {
             REQUIRE(map->entityDefinitionManager().definitions().size() == 1);
@@ -302,6 +310,7 @@ TEST_CASE("Map")
         path,
         *taskManager,
         resourceManager,
+        std::make_shared<GameAssetContext>(),
         logger)
         | kdl::transform([&](auto map) {
             CHECK(map->worldBounds() == worldBounds);
@@ -331,6 +340,7 @@ TEST_CASE("Map")
           makeAbsolute("fixture/test/mdl/Map/valveFormatMapWithoutFormatTag.map"),
           *taskManager,
           resourceManager,
+          std::make_shared<GameAssetContext>(),
           logger)
           | kdl::transform([&](auto map) {
               CHECK(map->worldNode().mapFormat() == mdl::MapFormat::Valve);
@@ -350,6 +360,7 @@ TEST_CASE("Map")
           makeAbsolute("fixture/test/mdl/Map/standardFormatMapWithoutFormatTag.map"),
           *taskManager,
           resourceManager,
+          std::make_shared<GameAssetContext>(),
           logger)
           | kdl::transform([&](auto map) {
               CHECK(map->worldNode().mapFormat() == mdl::MapFormat::Standard);
@@ -369,6 +380,7 @@ TEST_CASE("Map")
           makeAbsolute("fixture/test/mdl/Map/emptyMapWithoutFormatTag.map"),
           *taskManager,
           resourceManager,
+          std::make_shared<GameAssetContext>(),
           logger)
           | kdl::transform([&](auto map) {
               // an empty map detects as Valve because Valve is listed first in the game
@@ -391,6 +403,7 @@ TEST_CASE("Map")
           makeAbsolute("fixture/test/mdl/Map/mixedFormats.map"),
           *taskManager,
           resourceManager,
+          std::make_shared<GameAssetContext>(),
           logger));
       }
     }
@@ -417,6 +430,7 @@ TEST_CASE("Map")
         makeAbsolute("fixture/test/mdl/Map/valveFormatMapWithoutFormatTag.map"),
         *taskManager,
         resourceManager,
+        std::make_shared<GameAssetContext>(),
         logger)
         | kdl::transform([&](auto map) {
             REQUIRE(map->entityDefinitionManager().definitions().size() == 1);
@@ -450,6 +464,7 @@ TEST_CASE("Map")
       path,
       *taskManager,
       resourceManager,
+      std::make_shared<GameAssetContext>(),
       logger)
       | kdl::and_then([&](auto map) {
           REQUIRE(map->worldBounds() == worldBounds);
@@ -1291,6 +1306,48 @@ TEST_CASE("Map")
       }
     }
 
+    SECTION("Brush face tags agree with smart tag matchers")
+    {
+      auto* brushNodeA = createBrushNode(map, materialA->name());
+      auto* brushNodeB = createBrushNode(map, materialB->name());
+      auto* brushNodeC = createBrushNode(map, "missing_material");
+      addNodes(map, {{parentForNodes(map), {brushNodeA, brushNodeB, brushNodeC}}});
+
+      selectBrushFaces(map, {{brushNodeA, 0u}, {brushNodeC, 1u}});
+      setBrushFaceAttributes(
+        map, {.surfaceFlags = SetFlagBits{3}, .surfaceContents = SetFlagBits{1}});
+      deselectAll(map);
+
+      const auto brushNodes = std::vector<BrushNode*>{brushNodeA, brushNodeB, brushNodeC};
+
+      SECTION("Without precomputed material tags")
+      {
+        map.tagManager().precomputeMaterialTags({});
+      }
+
+      SECTION("With precomputed material tags")
+      {
+        map.tagManager().precomputeMaterialTags(materialManager.materials());
+      }
+
+      for (auto* brushNode : brushNodes)
+      {
+        brushNode->initializeTags(map.tagManager());
+      }
+
+      for (const auto* brushNode : brushNodes)
+      {
+        for (const auto& face : brushNode->brush().faces())
+        {
+          for (const auto& tag : map.smartTags())
+          {
+            CAPTURE(face.attributes().materialName(), tag.name());
+            CHECK(face.hasTag(tag) == tag.matches(face));
+          }
+        }
+      }
+    }
+
     SECTION("Material name tag")
     {
       SECTION("matches")
@@ -2041,6 +2098,7 @@ TEST_CASE("Map")
         vm::bbox3d{8192.0},
         *taskManager,
         resourceManager,
+        std::make_shared<GameAssetContext>(),
         logger)
         | kdl::transform([](auto map) {
             CHECK(
@@ -17,12 +17,14 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "gl/ResourceManager.h"
 #include "mdl/BrushBuilder.h"
 #include "mdl/BrushNode.h"
 #include "mdl/CatchConfig.h"
 #include "mdl/Entity.h"
 #include "mdl/EntityDefinition.h"
 #include "mdl/EntityDefinitionManager.h"
+#include "mdl/EntityModel.h"
 #include "mdl/EntityNode.h"
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
@@ -1430,4 +1432,33 @@ TEST_CASE("Map_Entities")
   }
 }
 
+TEST_CASE("Map_Entities.modelBounds")
+{
+  auto modelResource =
+    std::make_shared<EntityModelDataResource>([]() -> Result<EntityModelData> {
+      auto modelData = EntityModelData{PitchType::Normal, Orientation::Oriented};
+      modelData.addFrame("frame", vm::bbox3f{{-32, -32, 0}, {32, 32, 128}});
+      return modelData;
+    });
+  const auto model = EntityModel{"model", modelResource};
+
+  auto fixture = MapFixture{};
+  auto& map = fixture.create();
+
+  auto* entityNode = new EntityNode{Entity{}};
+  addNodes(map, {{parentForNodes(map), {entityNode}}});
+
+  // the model data is not loaded yet, so the bounds only depend on the definition
+  entityNode->setModel(&model);
+  REQUIRE(entityNode->physicalBounds() == entityNode->logicalBounds());
+
+  modelResource->loadSync();
+  map.resourceManager().resourcesWereProcessedNotifier(
+    std::vector<gl::ResourceId>{modelResource->id()});
+
+  CHECK(entityNode->physicalBounds().max.z() == 128.0);
+
+  entityNode->setModel(nullptr);
+}
+
 } // namespace tb::mdl
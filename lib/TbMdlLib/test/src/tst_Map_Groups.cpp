@@ -44,6 +44,7 @@
 #include "mdl/WorldNode.h"
 
 #include <functional>
+#include <optional>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
@@ -1144,6 +1145,38 @@ TEST_CASE("Map_Groups")
     CHECK(!groupNode1->hasPendingChanges());
     CHECK(groupNode2->hasPendingChanges());
   }
+
+  SECTION("addPendingContentChanges")
+  {
+    auto groupNode1 = std::make_unique<GroupNode>(Group{"1"});
+    auto* groupNode2 = new GroupNode{Group{"2"}};
+    auto* entityNode1 = new EntityNode{Entity{}};
+    auto* entityNode2 = new EntityNode{Entity{}};
+
+    groupNode2->addChild(entityNode2);
+    groupNode1->addChildren({entityNode1, groupNode2});
+
+    addPendingContentChanges({groupNode1.get()}, {entityNode1, entityNode2});
+    CHECK(groupNode1->hasPendingChanges());
+    CHECK(!groupNode2->hasPendingChanges());
+    CHECK(
+      groupNode1->pendingContentChanges()
+      == std::vector<const Node*>{entityNode1, entityNode2});
+
+    addPendingContentChanges({groupNode2}, {entityNode1, entityNode2});
+    CHECK(groupNode2->pendingContentChanges() == std::vector<const Node*>{entityNode2});
+
+    setHasPendingChanges({groupNode1.get()}, true);
+    CHECK(groupNode1->hasPendingChanges());
+    CHECK(groupNode1->pendingContentChanges() == std::nullopt);
+
+    addPendingContentChanges({groupNode1.get()}, {entityNode1});
+    CHECK(groupNode1->pendingContentChanges() == std::nullopt);
+
+    setHasPendingChanges({groupNode1.get(), groupNode2}, false);
+    CHECK(!groupNode1->hasPendingChanges());
+    CHECK(groupNode2->pendingContentChanges() == std::nullopt);
+  }
 }
 
 } // namespace tb::mdl
@@ -0,0 +1,138 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/CatchConfig.h"
+#include "mdl/GroupNode.h"
+#include "mdl/Map.h"
+#include "mdl/MapFixture.h"
+#include "mdl/Map_Brushes.h"
+#include "mdl/Map_Groups.h"
+#include "mdl/Map_Nodes.h"
+#include "mdl/Map_Selection.h"
+#include "mdl/MaterialIndex.h"
+#include "mdl/TestFactory.h"
+#include "mdl/UpdateBrushFaceAttributes.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+namespace tb::mdl
+{
+using namespace Catch::Matchers;
+
+TEST_CASE("Map_MaterialIndex")
+{
+  auto fixture = MapFixture{};
+  auto& map = fixture.create();
+
+  const auto& materialIndex = map.materialIndex();
+
+  SECTION("adding nodes updates the index")
+  {
+    auto* brushNode1 = createBrushNode(map, "material1");
+    auto* brushNode2 = createBrushNode(map, "material2");
+    auto* groupNode = new GroupNode{Group{"group"}};
+    auto* groupedBrushNode = createBrushNode(map, "material1");
+    groupNode->addChild(groupedBrushNode);
+
+    addNodes(map, {{parentForNodes(map), {brushNode1, brushNode2, groupNode}}});
+
+    CHECK_THAT(
+      materialIndex.findBrushNodes("material1"),
+      UnorderedEquals(std::vector<BrushNode*>{brushNode1, groupedBrushNode}));
+    CHECK_THAT(
+      materialIndex.findBrushNodes("material2"),
+      UnorderedEquals(std::vector<BrushNode*>{brushNode2}));
+    CHECK(materialIndex.findBrushNodes("material3").empty());
+
+    CHECK(materialIndex.usageCount("material1") == 12u);
+    CHECK(materialIndex.usageCount("material2") == 6u);
+    CHECK(materialIndex.usageCount("material3") == 0u);
+
+    CHECK(
+      materialIndex.materialNames()
+      == std::vector<std::string>{"material1", "material2"});
+  }
+
+  SECTION("material names are case insensitive")
+  {
+    auto* brushNode1 = createBrushNode(map, "material1");
+    auto* brushNode2 = createBrushNode(map, "MATERIAL1");
+
+    addNodes(map, {{parentForNodes(map), {brushNode1, brushNode2}}});
+
+    const auto name = GENERATE("material1", "MATERIAL1", "Material1");
+    CAPTURE(name);
+
+    CHECK_THAT(
+      materialIndex.findBrushNodes(name),
+      UnorderedEquals(std::vector<BrushNode*>{brushNode1, brushNode2}));
+    CHECK(materialIndex.findBrushFaces(name).size() == 12u);
+    CHECK(materialIndex.usageCount(name) == 12u);
+  }
+
+  SECTION("removing nodes updates the index")
+  {
+    auto* brushNode1 = createBrushNode(map, "material1");
+    auto* brushNode2 = createBrushNode(map, "material2");
+
+    addNodes(map, {{parentForNodes(map), {brushNode1, brushNode2}}});
+    removeNodes(map, {brushNode2});
+
+    CHECK(
+      materialIndex.findBrushNodes("material1") == std::vector<BrushNode*>{brushNode1});
+    CHECK(materialIndex.findBrushNodes("material2").empty());
+    CHECK(materialIndex.usageCount("material2") == 0u);
+    CHECK(materialIndex.materialNames() == std::vector<std::string>{"material1"});
+
+    map.undoCommand();
+
+    CHECK(
+      materialIndex.findBrushNodes("material2") == std::vector<BrushNode*>{brushNode2});
+    CHECK(materialIndex.usageCount("material2") == 6u);
+  }
+
+  SECTION("changing face attributes updates the index")
+  {
+    auto* brushNode = createBrushNode(map, "material1");
+    addNodes(map, {{parentForNodes(map), {brushNode}}});
+
+    const auto firstFace = BrushFaceHandle{brushNode, 0};
+    selectBrushFaces(map, {firstFace});
+    setBrushFaceAttributes(map, {.materialName = "material2"});
+
+    CHECK(materialIndex.usageCount("material1") == 5u);
+    CHECK(materialIndex.usageCount("material2") == 1u);
+    CHECK(materialIndex.findBrushFaces("material2") == std::vector{firstFace});
+    CHECK(
+      materialIndex.findBrushNodes("material1") == std::vector<BrushNode*>{brushNode});
+
+    map.undoCommand();
+
+    CHECK(materialIndex.usageCount("material1") == 6u);
+    CHECK(materialIndex.usageCount("material2") == 0u);
+    CHECK(materialIndex.findBrushFaces("material2").empty());
+  }
+}
+
+} // namespace tb::mdl
@@ -586,7 +586,7 @@ TEST_CASE("ModelUtils.computePhysicalBounds")
     == vm::bbox3d{vm::vec3d{32, -32, -32}, vm::vec3d{96, 32, 32}});
   CHECK(
     computePhysicalBounds({patchNode})
-    == vm::bbox3d{vm::vec3d{0, 0, 0}, vm::vec3d{2, 2, 1}});
+    == vm::bbox3d{vm::vec3d{0, 0, 0}, vm::vec3d{2, 2, 2}});
   CHECK(
     computePhysicalBounds({entityNode, brushNode})
     == vm::bbox3d{vm::vec3d{-8, -32, -32}, vm::vec3d{96, 32, 32}});
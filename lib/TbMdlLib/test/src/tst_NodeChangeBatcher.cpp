@@ -0,0 +1,192 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Notifier.h"
+#include "NotifierConnection.h"
+#include "mdl/CatchConfig.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/Group.h"
+#include "mdl/GroupNode.h"
+#include "mdl/Map.h"
+#include "mdl/MapFixture.h"
+#include "mdl/Map_Entities.h"
+#include "mdl/Map_Nodes.h"
+#include "mdl/Map_Selection.h"
+#include "mdl/NodeChangeBatcher.h"
+#include "mdl/NodeChanges.h"
+#include "mdl/Transaction.h"
+#include "mdl/TransactionScope.h"
+
+#include "kd/vector_utils.h"
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+namespace tb::mdl
+{
+using namespace Catch::Matchers;
+
+TEST_CASE("NodeChangeBatcher")
+{
+  auto notifier = Notifier<const NodeChanges&>{};
+  auto batcher = NodeChangeBatcher{notifier};
+
+  auto notifications = std::vector<NodeChanges>{};
+  auto notifierConnection = NotifierConnection{};
+  notifierConnection += notifier.connect(
+    [&](const auto& nodeChanges) { notifications.push_back(nodeChanges); });
+
+  auto groupNode = GroupNode{Group{"group"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  groupNode.addChild(entityNode);
+  auto otherEntityNode = EntityNode{Entity{}};
+
+  SECTION("Notifications are delivered immediately outside of a transaction")
+  {
+    REQUIRE(!batcher.isBatching());
+
+    batcher.nodesWereAdded({&groupNode});
+    batcher.nodesDidChange({entityNode});
+
+    CHECK(
+      notifications
+      == std::vector<NodeChanges>{
+        {.addedNodes = {&groupNode}},
+        {.changedNodes = {entityNode}},
+      });
+  }
+
+  SECTION("Notifications are delivered immediately in a long running transaction")
+  {
+    batcher.startTransaction(TransactionScope::LongRunning);
+    REQUIRE(!batcher.isBatching());
+
+    batcher.nodeVisibilityDidChange({&groupNode});
+    batcher.nodeLockingDidChange({&groupNode});
+    batcher.endTransaction();
+
+    CHECK(
+      notifications
+      == std::vector<NodeChanges>{
+        {.visibilityChangedNodes = {&groupNode}},
+        {.lockingChangedNodes = {&groupNode}},
+      });
+  }
+
+  SECTION("Notifications are collected in a oneshot transaction")
+  {
+    batcher.startTransaction(TransactionScope::Oneshot);
+    REQUIRE(batcher.isBatching());
+
+    batcher.nodesDidChange({entityNode});
+    batcher.nodesDidChange({entityNode, &otherEntityNode});
+    batcher.nodeVisibilityDidChange({&groupNode});
+
+    // a nested long running transaction cannot be observed either
+    batcher.startTransaction(TransactionScope::LongRunning);
+    CHECK(batcher.isBatching());
+
+    batcher.nodeLockingDidChange({&otherEntityNode});
+    batcher.endTransaction();
+
+    CHECK(notifications.empty());
+
+    batcher.endTransaction();
+
+    REQUIRE(notifications.size() == 1);
+    CHECK_THAT(
+      notifications.front().changedNodes,
+      UnorderedEquals(std::vector<Node*>{entityNode, &otherEntityNode}));
+    CHECK(notifications.front().visibilityChangedNodes == std::vector<Node*>{&groupNode});
+    CHECK(
+      notifications.front().lockingChangedNodes == std::vector<Node*>{&otherEntityNode});
+  }
+
+  SECTION("Changes of added nodes are not delivered separately")
+  {
+    batcher.startTransaction(TransactionScope::Oneshot);
+    batcher.nodesWereAdded({&groupNode});
+    batcher.nodesDidChange({&groupNode, &otherEntityNode});
+    batcher.nodeVisibilityDidChange({&groupNode});
+    batcher.endTransaction();
+
+    CHECK(
+      notifications
+      == std::vector<NodeChanges>{{
+        .addedNodes = {&groupNode},
+        .changedNodes = {&otherEntityNode},
+      }});
+  }
+
+  SECTION("Removed nodes and their descendants are dropped")
+  {
+    batcher.startTransaction(TransactionScope::Oneshot);
+    batcher.nodesWereAdded({&otherEntityNode});
+    batcher.nodesDidChange({entityNode});
+    batcher.nodeLockingDidChange({&groupNode});
+    batcher.nodesWereRemoved({&groupNode, &otherEntityNode});
+    batcher.endTransaction();
+
+    CHECK(notifications.empty());
+  }
+}
+
+TEST_CASE("Map.nodeChangesNotifier")
+{
+  auto fixture = MapFixture{};
+  auto& map = fixture.create();
+
+  auto notifications = std::vector<NodeChanges>{};
+  auto notifierConnection = NotifierConnection{};
+  notifierConnection += map.nodeChangesNotifier.connect(
+    [&](const auto& nodeChanges) { notifications.push_back(nodeChanges); });
+
+  auto* entityNode = new EntityNode{Entity{}};
+
+  auto transaction = Transaction{map};
+  addNodes(map, {{parentForNodes(map), {entityNode}}});
+  selectNodes(map, {entityNode});
+  setEntityProperty(map, "some_key", "some_value");
+  setEntityProperty(map, "some_key", "other_value");
+
+  CHECK(notifications.empty());
+
+  transaction.commit();
+
+  REQUIRE(notifications.size() == 1);
+  CHECK(notifications.front().addedNodes == std::vector<Node*>{entityNode});
+  CHECK(!kdl::vec_contains(notifications.front().changedNodes, entityNode));
+
+  SECTION("Undo delivers a single batch")
+  {
+    setEntityProperty(map, "some_key", "yet_another_value");
+    setEntityProperty(map, "other_key", "some_value");
+
+    notifications.clear();
+    map.undoCommand();
+
+    REQUIRE(notifications.size() == 1);
+    CHECK(kdl::vec_contains(notifications.front().changedNodes, entityNode));
+  }
+}
+
+} // namespace tb::mdl
@@ -219,6 +219,128 @@ TEST_CASE("NodeIndex")
     }
   }
 
+  SECTION("Pattern queries")
+  {
+    auto worldNode = WorldNode{
+      {},
+      {
+        {"message", "some_value"},
+      },
+      MapFormat::Quake3};
+    auto entityNode1 = EntityNode{Entity{{
+      {"target", "door_1"},
+    }}};
+    auto entityNode2 = EntityNode{Entity{{
+      {"targetname", "door_1"},
+      {"message", "*_value"},
+    }}};
+    auto groupNode = GroupNode{Group{"some_door_1"}};
+
+    i.addNode(worldNode);
+    i.addNode(entityNode1);
+    i.addNode(entityNode2);
+    i.addNode(groupNode);
+
+    SECTION("exact matches")
+    {
+      CHECK_THAT(
+        i.findNodes("door_1"),
+        UnorderedEquals(std::vector<Node*>{&entityNode1, &entityNode2}));
+      CHECK_THAT(
+        i.findNodes("message"),
+        UnorderedEquals(std::vector<Node*>{&worldNode, &entityNode2}));
+      CHECK_THAT(
+        i.findNodes(NodeIndex::escapePattern("*_value")),
+        UnorderedEquals(std::vector<Node*>{&entityNode2}));
+      CHECK_THAT(i.findNodes("door"), UnorderedEquals(std::vector<Node*>{}));
+    }
+
+    SECTION("suffix matches")
+    {
+      CHECK_THAT(
+        i.findNodes("*door_1"),
+        UnorderedEquals(std::vector<Node*>{&entityNode1, &entityNode2, &groupNode}));
+      CHECK_THAT(
+        i.findNodes("*_value"),
+        UnorderedEquals(std::vector<Node*>{&worldNode, &entityNode2}));
+      // the world node has a "classname" key
+      CHECK_THAT(
+        i.findNodes("*name"),
+        UnorderedEquals(std::vector<Node*>{&worldNode, &entityNode2}));
+      CHECK_THAT(i.findNodes("*door"), UnorderedEquals(std::vector<Node*>{}));
+    }
+
+    SECTION("other patterns")
+    {
+      CHECK_THAT(
+        i.findNodes("*door*"),
+        UnorderedEquals(std::vector<Node*>{&entityNode1, &entityNode2, &groupNode}));
+      CHECK_THAT(
+        i.findNodes("door_%"),
+        UnorderedEquals(std::vector<Node*>{&entityNode1, &entityNode2}));
+      CHECK_THAT(
+        i.findNodes("*"),
+        UnorderedEquals(
+          std::vector<Node*>{&worldNode, &entityNode1, &entityNode2, &groupNode}));
+    }
+
+    SECTION("typed queries")
+    {
+      CHECK_THAT(
+        i.findNodes<EntityNodeBase>("message"),
+        UnorderedEquals(std::vector<EntityNodeBase*>{&worldNode, &entityNode2}));
+      CHECK_THAT(
+        i.findNodes<WorldNode>("*_value"),
+        UnorderedEquals(std::vector<WorldNode*>{&worldNode}));
+      CHECK_THAT(
+        i.findNodes<GroupNode>("*door_1"),
+        UnorderedEquals(std::vector<GroupNode*>{&groupNode}));
+    }
+
+    SECTION("removing nodes")
+    {
+      i.removeNode(entityNode2);
+
+      CHECK_THAT(
+        i.findNodes("door_1"), UnorderedEquals(std::vector<Node*>{&entityNode1}));
+      CHECK_THAT(
+        i.findNodes("*door_1"),
+        UnorderedEquals(std::vector<Node*>{&entityNode1, &groupNode}));
+      CHECK_THAT(
+        i.findNodes("door*"), UnorderedEquals(std::vector<Node*>{&entityNode1}));
+    }
+  }
+
+  SECTION("addNodes")
+  {
+    auto entityNode1 = EntityNode{Entity{{
+      {"some_key", "a_value"},
+    }}};
+    auto entityNode2 = EntityNode{Entity{{
+      {"some_key", "another_value"},
+    }}};
+    auto groupNode = GroupNode{Group{"some_group"}};
+
+    i.addNodes({&entityNode1, &entityNode2, &groupNode});
+
+    CHECK_THAT(
+      i.findNodes("some_key"),
+      UnorderedEquals(std::vector<Node*>{&entityNode1, &entityNode2}));
+    CHECK_THAT(
+      i.findNodes("*_value"),
+      UnorderedEquals(std::vector<Node*>{&entityNode1, &entityNode2}));
+    CHECK_THAT(
+      i.findNodes("some*"),
+      UnorderedEquals(std::vector<Node*>{&entityNode1, &entityNode2, &groupNode}));
+
+    i.removeNode(entityNode1);
+
+    CHECK_THAT(
+      i.findNodes("some_key"), UnorderedEquals(std::vector<Node*>{&entityNode2}));
+    CHECK_THAT(
+      i.findNodes("*_value"), UnorderedEquals(std::vector<Node*>{&entityNode2}));
+  }
+
   SECTION("clear")
   {
     auto entityNode = EntityNode{Entity{{
@@ -20,6 +20,10 @@
 #include "mdl/CatchConfig.h"
 #include "mdl/Octree.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 
 namespace tb::mdl
@@ -553,6 +557,147 @@ TEST_CASE("octree.insert_duplicate")
   CHECK_FALSE(tree.empty());
 }
 
+TEST_CASE("octree.bulk_insert")
+{
+  auto tree = octree<double, int>{32.0};
+
+  SECTION("inserting into root node")
+  {
+    CHECK(tree.bulk_insert({
+      {{{-2, 0, 0}, {5, 3, 6}}, 1},
+      {{{-32, -32, -32}, {32, 32, 32}}, 2},
+      {{{-33, -32, -32}, {32, 32, 32}}, 3},
+    }));
+    CHECK(tree == octree<double, int>{32.0, leaf_node{{-2, -2, -2, 2}, {1, 2, 3}}});
+  }
+
+  SECTION("inserting into root node and its quadrants does not expand root node")
+  {
+    CHECK(tree.bulk_insert({
+      {{{-2, 0, 0}, {5, 3, 6}}, 1},
+      {{{2, 2, 2}, {3, 3, 3}}, 2},
+    }));
+
+    auto incrementalTree = octree<double, int>{32.0};
+    REQUIRE(incrementalTree.insert({{-2, 0, 0}, {5, 3, 6}}, 1));
+    REQUIRE(incrementalTree.insert({{2, 2, 2}, {3, 3, 3}}, 2));
+    CHECK(tree == incrementalTree);
+  }
+
+  SECTION("inserting into quadrants skips unnecessary inner nodes")
+  {
+    CHECK(tree.bulk_insert({
+      {{{2, 2, 2}, {3, 3, 3}}, 1},
+      {{{3, 3, 3}, {4, 4, 4}}, 2},
+    }));
+    CHECK(
+      tree
+      == octree<double, int>{
+        32.0,
+        inner_node{
+          {-2, -2, -2, 2},
+          {},
+          kdl::vec_from(
+            node{leaf_node{{-2, -2, -2, 1}, {}}},
+            node{leaf_node{{0, -2, -2, 1}, {}}},
+            node{leaf_node{{-2, 0, -2, 1}, {}}},
+            node{leaf_node{{0, 0, -2, 1}, {}}},
+            node{leaf_node{{-2, -2, 0, 1}, {}}},
+            node{leaf_node{{0, -2, 0, 1}, {}}},
+            node{leaf_node{{-2, 0, 0, 1}, {}}},
+            node{leaf_node{{0, 0, 0, 0}, {1, 2}}})}});
+  }
+
+  SECTION("inserting duplicates")
+  {
+    REQUIRE(tree.insert({{0, 0, 0}, {2, 1, 1}}, 1));
+
+    CHECK_FALSE(tree.bulk_insert({
+      {{{0, 0, 0}, {2, 1, 1}}, 1},
+      {{{0, 0, 0}, {2, 1, 1}}, 2},
+      {{{0, 0, 0}, {2, 1, 1}}, 2},
+    }));
+    CHECK(tree.contains(1));
+    CHECK(tree.contains(2));
+  }
+
+  SECTION("bulk inserted trees behave like incrementally built trees")
+  {
+    // deterministic pseudo random boxes of varying sizes around the origin
+    auto seed = 1u;
+    const auto next = [&](const int range) {
+      seed = seed * 1103515245u + 12345u;
+      return int((seed >> 16) % unsigned(range)) - range / 2;
+    };
+
+    auto boundsAndData = std::vector<std::pair<vm::bbox3d, int>>{};
+    for (int i = 0; i < 500; ++i)
+    {
+      const auto min =
+        vm::vec3d{double(next(2048)), double(next(2048)), double(next(2048))};
+      const auto size = double(1 + next(512) + 256);
+      boundsAndData.emplace_back(vm::bbox3d{min, min + vm::vec3d{size, size, size}}, i);
+    }
+
+    const auto queries = std::vector<vm::bbox3d>{
+      {{-64, -64, -64}, {64, 64, 64}},
+      {{100, 200, 300}, {400, 500, 600}},
+      {{-1024, -1024, -1024}, {0, 0, 0}},
+      {{-2048, -2048, -2048}, {2048, 2048, 2048}},
+    };
+
+    const auto findIntersectors = [](const auto& tree_, const auto& bbox) {
+      auto result = tree_.find_intersectors(bbox);
+      std::ranges::sort(result);
+      return result;
+    };
+
+    auto incrementalTree = octree<double, int>{32.0};
+    for (const auto& [bounds, data] : boundsAndData)
+    {
+      REQUIRE(incrementalTree.insert(bounds, data));
+    }
+
+    SECTION("into an empty tree")
+    {
+      REQUIRE(tree.bulk_insert(boundsAndData));
+    }
+
+    SECTION("into a small tree")
+    {
+      const auto half = boundsAndData.size() / 2;
+      for (size_t i = 0; i < half; ++i)
+      {
+        REQUIRE(tree.insert(boundsAndData[i].first, boundsAndData[i].second));
+      }
+      REQUIRE(tree.bulk_insert(
+        {std::next(boundsAndData.begin(), long(half)), boundsAndData.end()}));
+    }
+
+    SECTION("into a large tree")
+    {
+      const auto count = boundsAndData.size() - 10;
+      for (size_t i = 0; i < count; ++i)
+      {
+        REQUIRE(tree.insert(boundsAndData[i].first, boundsAndData[i].second));
+      }
+      REQUIRE(tree.bulk_insert(
+        {std::next(boundsAndData.begin(), long(count)), boundsAndData.end()}));
+    }
+
+    for (const auto& query : queries)
+    {
+      CHECK(findIntersectors(tree, query) == findIntersectors(incrementalTree, query));
+    }
+
+    for (const auto& [bounds, data] : boundsAndData)
+    {
+      CHECK(tree.remove(data));
+    }
+    CHECK(tree.empty());
+  }
+}
+
 TEST_CASE("octree.contains")
 {
   auto tree = octree<double, int>{32.0};
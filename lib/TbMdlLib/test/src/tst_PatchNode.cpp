@@ -139,6 +139,13 @@ TEST_CASE("PatchNode.makePatchGrid")
     GP{{0.0, 1.0, 0.0}, {0.0, 0.5 }, {0.0, 0.0, 1.0}}, GP{{1.0, 1.0, 0.0}, {0.5, 0.5 }, {0.0, 0.0, 1.0}}, GP{{2.0, 1.0, 0.0}, {1.0, 0.5 }, {0.0, 0.0, 1.0}},
     GP{{0.0, 0.5, 0.0}, {0.0, 0.75}, {0.0, 0.0, 1.0}}, GP{{1.0, 0.5, 0.0}, {0.5, 0.75}, {0.0, 0.0, 1.0}}, GP{{2.0, 0.5, 0.0}, {1.0, 0.75}, {0.0, 0.0, 1.0}},
     GP{{0.0, 0.0, 0.0}, {0.0, 1.0 }, {0.0, 0.0, 1.0}}, GP{{1.0, 0.0, 0.0}, {0.5, 1.0 }, {0.0, 0.0, 1.0}}, GP{{2.0, 0.0, 0.0}, {1.0, 1.0 }, {0.0, 0.0, 1.0}}}},
+  {3, 5, 1, // flat surface on XY plane with 5 columns
+    {CP{0.0, 2.0, 0.0, 0.0, 0.0}, CP{0.5, 2.0, 0.0, 0.25, 0.0}, CP{1.0, 2.0, 0.0, 0.5, 0.0}, CP{1.5, 2.0, 0.0, 0.75, 0.0}, CP{2.0, 2.0, 0.0, 1.0, 0.0},
+    CP{0.0, 1.0, 0.0, 0.0, 0.5}, CP{0.5, 1.0, 0.0, 0.25, 0.5}, CP{1.0, 1.0, 0.0, 0.5, 0.5}, CP{1.5, 1.0, 0.0, 0.75, 0.5}, CP{2.0, 1.0, 0.0, 1.0, 0.5},
+    CP{0.0, 0.0, 0.0, 0.0, 1.0}, CP{0.5, 0.0, 0.0, 0.25, 1.0}, CP{1.0, 0.0, 0.0, 0.5, 1.0}, CP{1.5, 0.0, 0.0, 0.75, 1.0}, CP{2.0, 0.0, 0.0, 1.0, 1.0}, },
+    {GP{{0.0, 2.0, 0.0}, {0.0, 0.0}, {0.0, 0.0, 1.0}}, GP{{0.5, 2.0, 0.0}, {0.25, 0.0}, {0.0, 0.0, 1.0}}, GP{{1.0, 2.0, 0.0}, {0.5, 0.0}, {0.0, 0.0, 1.0}}, GP{{1.5, 2.0, 0.0}, {0.75, 0.0}, {0.0, 0.0, 1.0}}, GP{{2.0, 2.0, 0.0}, {1.0, 0.0}, {0.0, 0.0, 1.0}},
+    GP{{0.0, 1.0, 0.0}, {0.0, 0.5}, {0.0, 0.0, 1.0}}, GP{{0.5, 1.0, 0.0}, {0.25, 0.5}, {0.0, 0.0, 1.0}}, GP{{1.0, 1.0, 0.0}, {0.5, 0.5}, {0.0, 0.0, 1.0}}, GP{{1.5, 1.0, 0.0}, {0.75, 0.5}, {0.0, 0.0, 1.0}}, GP{{2.0, 1.0, 0.0}, {1.0, 0.5}, {0.0, 0.0, 1.0}},
+    GP{{0.0, 0.0, 0.0}, {0.0, 1.0}, {0.0, 0.0, 1.0}}, GP{{0.5, 0.0, 0.0}, {0.25, 1.0}, {0.0, 0.0, 1.0}}, GP{{1.0, 0.0, 0.0}, {0.5, 1.0}, {0.0, 0.0, 1.0}}, GP{{1.5, 0.0, 0.0}, {0.75, 1.0}, {0.0, 0.0, 1.0}}, GP{{2.0, 0.0, 0.0}, {1.0, 1.0}, {0.0, 0.0, 1.0}}}},
   {9, 3, 1, // cylinder
     {CP{-1.0,  0.0,  1.0, 0.0, 0.0  }, CP{-1.0,  0.0,  0.0, 0.5, 0.0  }, CP{-1.0,  0.0, -1.0, 1.0, 0.0  },
     CP{-1.0,  1.0,  1.0, 0.0, 0.125}, CP{-1.0,  1.0,  0.0, 0.5, 0.125}, CP{-1.0,  1.0, -1.0, 1.0, 0.125},
@@ -169,6 +176,102 @@ TEST_CASE("PatchNode.makePatchGrid")
                 })));
 }
 
+TEST_CASE("PatchNode.computeSubdivisionsPerSurface")
+{
+  using CP = BezierPatch::Point;
+  using T = std::tuple<std::vector<CP>, size_t, size_t>;
+
+  // clang-format off
+  const auto 
+  [controlPoints, maxSd, expectedSd] = GENERATE(values<T>({
+  { // flat surface on XY plane
+    {CP{0.0, 2.0, 0.0, 0.0, 0.0}, CP{1.0, 2.0, 0.0, 0.5, 0.0}, CP{2.0, 2.0, 0.0, 1.0, 0.0},
+    CP{0.0, 1.0, 0.0, 0.0, 0.5}, CP{1.0, 1.0, 0.0, 0.5, 0.5}, CP{2.0, 1.0, 0.0, 1.0, 0.5},
+    CP{0.0, 0.0, 0.0, 0.0, 1.0}, CP{1.0, 0.0, 0.0, 0.5, 1.0}, CP{2.0, 0.0, 0.0, 1.0, 1.0}, },
+    3, 0},
+  { // low hill surface bulging towards +Z
+    {CP{0.0, 2.0, 0.0, 0.0, 0.0}, CP{1.0, 2.0, 0.0, 0.5, 0.0}, CP{2.0, 2.0, 0.0, 1.0, 0.0},
+    CP{0.0, 1.0, 0.0, 0.0, 0.5}, CP{1.0, 1.0, 0.5, 0.5, 0.5}, CP{2.0, 1.0, 0.0, 1.0, 0.5},
+    CP{0.0, 0.0, 0.0, 0.0, 1.0}, CP{1.0, 0.0, 0.0, 0.5, 1.0}, CP{2.0, 0.0, 0.0, 1.0, 1.0}, },
+    3, 2},
+  { // high hill surface bulging towards +Z
+    {CP{0.0, 2.0, 0.0, 0.0, 0.0}, CP{1.0, 2.0, 0.0, 0.5, 0.0}, CP{2.0, 2.0, 0.0, 1.0, 0.0},
+    CP{0.0, 1.0, 0.0, 0.0, 0.5}, CP{1.0, 1.0, 4.0, 0.5, 0.5}, CP{2.0, 1.0, 0.0, 1.0, 0.5},
+    CP{0.0, 0.0, 0.0, 0.0, 1.0}, CP{1.0, 0.0, 0.0, 0.5, 1.0}, CP{2.0, 0.0, 0.0, 1.0, 1.0}, },
+    3, 3},
+  { // flat surface with distorted UV coordinates
+    {CP{0.0, 2.0, 0.0, 0.0, 0.0}, CP{1.0, 2.0, 0.0, 0.5, 0.0}, CP{2.0, 2.0, 0.0, 1.0, 0.0},
+    CP{0.0, 1.0, 0.0, 0.0, 0.5}, CP{1.0, 1.0, 0.0, 0.6, 0.5}, CP{2.0, 1.0, 0.0, 1.0, 0.5},
+    CP{0.0, 0.0, 0.0, 0.0, 1.0}, CP{1.0, 0.0, 0.0, 0.5, 1.0}, CP{2.0, 0.0, 0.0, 1.0, 1.0}, },
+    3, 3},
+  { // flat surface with distorted UV coordinates
+    {CP{0.0, 2.0, 0.0, 0.0, 0.0}, CP{1.0, 2.0, 0.0, 0.5, 0.0}, CP{2.0, 2.0, 0.0, 1.0, 0.0},
+    CP{0.0, 1.0, 0.0, 0.0, 0.5}, CP{1.0, 1.0, 0.0, 0.6, 0.5}, CP{2.0, 1.0, 0.0, 1.0, 0.5},
+    CP{0.0, 0.0, 0.0, 0.0, 1.0}, CP{1.0, 0.0, 0.0, 0.5, 1.0}, CP{2.0, 0.0, 0.0, 1.0, 1.0}, },
+    5, 4},
+  }));
+  // clang-format on
+
+  CAPTURE(controlPoints, maxSd);
+  CHECK(
+    computeSubdivisionsPerSurface(BezierPatch{3, 3, controlPoints, "material"}, maxSd)
+    == expectedSd);
+}
+
+TEST_CASE("PatchNode.grid")
+{
+  using CP = BezierPatch::Point;
+
+  // clang-format off
+  const auto flatPatch = BezierPatch{3, 3, {
+    CP{0.0, 2.0, 0.0, 0.0, 0.0}, CP{1.0, 2.0, 0.0, 0.5, 0.0}, CP{2.0, 2.0, 0.0, 1.0, 0.0},
+    CP{0.0, 1.0, 0.0, 0.0, 0.5}, CP{1.0, 1.0, 0.0, 0.5, 0.5}, CP{2.0, 1.0, 0.0, 1.0, 0.5},
+    CP{0.0, 0.0, 0.0, 0.0, 1.0}, CP{1.0, 0.0, 0.0, 0.5, 1.0}, CP{2.0, 0.0, 0.0, 1.0, 1.0},
+  }, "material"};
+
+  const auto hillPatch = BezierPatch{3, 3, {
+    CP{0.0, 2.0, 0.0, 0.0, 0.0}, CP{1.0, 2.0, 0.0, 0.5, 0.0}, CP{2.0, 2.0, 0.0, 1.0, 0.0},
+    CP{0.0, 1.0, 0.0, 0.0, 0.5}, CP{1.0, 1.0, 4.0, 0.5, 0.5}, CP{2.0, 1.0, 0.0, 1.0, 0.5},
+    CP{0.0, 0.0, 0.0, 0.0, 1.0}, CP{1.0, 0.0, 0.0, 0.5, 1.0}, CP{2.0, 0.0, 0.0, 1.0, 1.0},
+  }, "material"};
+  // clang-format on
+
+  auto patchNode = PatchNode{flatPatch};
+
+  SECTION("Grids match the tessellation with the given subdivisions")
+  {
+    for (size_t sd = 0u; sd <= PatchNode::DefaultSubdivisionsPerSurface; ++sd)
+    {
+      CAPTURE(sd);
+      CHECK(patchNode.grid(sd) == makePatchGrid(flatPatch, sd));
+    }
+
+    CHECK(patchNode.grid() == makePatchGrid(flatPatch, 3u));
+  }
+
+  SECTION("Render grid is the coarsest sufficient grid")
+  {
+    CHECK(patchNode.renderGrid() == makePatchGrid(flatPatch, 0u));
+  }
+
+  SECTION("Setting the patch updates all grids")
+  {
+    patchNode.setPatch(hillPatch);
+
+    CHECK(patchNode.grid(1u) == makePatchGrid(hillPatch, 1u));
+    CHECK(patchNode.grid() == makePatchGrid(hillPatch, 3u));
+    CHECK(patchNode.renderGrid() == makePatchGrid(hillPatch, 3u));
+  }
+
+  SECTION("Physical bounds contain the grid")
+  {
+    patchNode.setPatch(hillPatch);
+
+    CHECK(patchNode.physicalBounds() == hillPatch.bounds());
+    CHECK(patchNode.physicalBounds().contains(patchNode.grid().bounds));
+  }
+}
+
 TEST_CASE("PatchNode.pickFlatPatch")
 {
   using P = BezierPatch::Point;
@@ -23,14 +23,17 @@
 #include "mdl/Polyhedron_IO.h" // IWYU pragma: keep
 #include "mdl/Polyhedron_Instantiation.h"
 
+#include "vm/plane.h"
 #include "vm/vec.h"
 #include "vm/vec_io.h"
 
 #include <algorithm>
 #include <iterator>
+#include <random>
 #include <set>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
 namespace tb::mdl
@@ -95,6 +98,40 @@ bool findAndRemove(
   return false;
 }
 
+/**
+ * Computes the vertices of the convex hull of the given points by testing every plane
+ * through three of the points. Only works for points in general position.
+ */
+std::vector<vm::vec3d> bruteForceHullVertices(const std::vector<vm::vec3d>& points)
+{
+  auto result = std::set<vm::vec3d>{};
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    for (size_t j = i + 1; j < points.size(); ++j)
+    {
+      for (size_t k = j + 1; k < points.size(); ++k)
+      {
+        if (const auto plane = vm::from_points(points[i], points[j], points[k]))
+        {
+          const auto countAbove = std::ranges::count_if(points, [&](const auto& point) {
+            return plane->point_status(point) == vm::plane_status::above;
+          });
+          const auto countBelow = std::ranges::count_if(points, [&](const auto& point) {
+            return plane->point_status(point) == vm::plane_status::below;
+          });
+          if (countAbove == 0 || countBelow == 0)
+          {
+            result.insert(points[i]);
+            result.insert(points[j]);
+            result.insert(points[k]);
+          }
+        }
+      }
+    }
+  }
+  return {result.begin(), result.end()};
+}
+
 } // namespace
 
 TEST_CASE("Polyhedron")
@@ -919,6 +956,63 @@ TEST_CASE("Polyhedron")
     CHECK(result.size() == 0u);
   }
 
+  SECTION("merge")
+  {
+    const auto cuboid = Polyhedron3d{vm::bbox3d{{0, 0, 0}, {32, 32, 32}}};
+
+    SECTION("Adjacent cuboids with a common face")
+    {
+      const auto other = Polyhedron3d{vm::bbox3d{{32, 0, 0}, {64, 32, 32}}};
+      const auto expected = Polyhedron3d{vm::bbox3d{{0, 0, 0}, {64, 32, 32}}};
+
+      CHECK(cuboid.merge(other) == expected);
+      CHECK(other.merge(cuboid) == expected);
+    }
+
+    SECTION("Adjacent cuboids with a partially common face")
+    {
+      const auto other = Polyhedron3d{vm::bbox3d{{32, 0, 0}, {64, 16, 32}}};
+      CHECK(cuboid.merge(other) == std::nullopt);
+    }
+
+    SECTION("Cuboid and wedge with a common face")
+    {
+      const auto wedge = Polyhedron3d{
+        {32, 0, 0},
+        {32, 32, 0},
+        {32, 0, 32},
+        {32, 32, 32},
+        {64, 0, 0},
+        {64, 32, 0},
+      };
+
+      CHECK(
+        cuboid.merge(wedge)
+        == Polyhedron3d{
+          {0, 0, 0},
+          {0, 32, 0},
+          {0, 0, 32},
+          {0, 32, 32},
+          {32, 0, 32},
+          {32, 32, 32},
+          {64, 0, 0},
+          {64, 32, 0},
+        });
+    }
+
+    SECTION("Cuboids touching at an edge")
+    {
+      const auto other = Polyhedron3d{vm::bbox3d{{32, 32, 0}, {64, 64, 32}}};
+      CHECK(cuboid.merge(other) == std::nullopt);
+    }
+
+    SECTION("Disjoint cuboids")
+    {
+      const auto other = Polyhedron3d{vm::bbox3d{{64, 0, 0}, {96, 32, 32}}};
+      CHECK(cuboid.merge(other) == std::nullopt);
+    }
+  }
+
   SECTION("intersection_empty_polyhedron")
   {
     const auto empty = Polyhedron3d{};
@@ -1388,6 +1482,42 @@ TEST_CASE("Polyhedron")
   }
 }
 
+TEST_CASE("Polyhedron (Random points)")
+{
+  // the points are in general position with overwhelming probability
+  auto rng = std::mt19937{GENERATE(1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u)};
+  const auto pointCount = GENERATE(4, 8, 16, 40);
+  auto coordinate = std::uniform_real_distribution<double>{-512.0, 512.0};
+
+  auto points = std::vector<vm::vec3d>{};
+  for (int i = 0; i < pointCount; ++i)
+  {
+    points.emplace_back(coordinate(rng), coordinate(rng), coordinate(rng));
+  }
+
+  CAPTURE(points);
+
+  const auto p = Polyhedron3d{points};
+  const auto expectedVertices = bruteForceHullVertices(points);
+
+  CHECK(p.polyhedron());
+  CHECK(p.closed());
+  CHECK(p.vertexCount() == expectedVertices.size());
+  CHECK(p.hasAllVertices(expectedVertices, 0.0));
+  CHECK(std::ranges::all_of(
+    points, [&](const auto& point) { return p.contains(point, 0.001); }));
+
+  auto incremental = Polyhedron3d{};
+  incremental.addPointsIncrementally(points);
+
+  CHECK(p == incremental);
+  CHECK(std::ranges::all_of(p.faces(), [&](const auto* face) {
+    const auto* incrementalFace =
+      incremental.findFaceByPositions(face->vertexPositions());
+    return incrementalFace && incrementalFace->origin() == face->origin();
+  }));
+}
+
 TEST_CASE("Polyhedron (Regression)", "[regression]")
 {
   SECTION("convexHullWithFailingPoints")
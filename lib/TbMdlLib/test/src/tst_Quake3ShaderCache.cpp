@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Logger.h"
+#include "fs/DiskFileSystem.h"
+#include "fs/File.h"
+#include "fs/Reader.h"
+#include "mdl/CatchConfig.h"
+#include "mdl/GameConfig.h"
+#include "mdl/LoadShaders.h"
+#include "mdl/Quake3Shader.h"
+#include "mdl/Quake3ShaderCache.h"
+
+#include "kd/result.h"
+#include "kd/task_manager.h"
+
+#include <filesystem>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+
+TEST_CASE("Quake3ShaderCache")
+{
+  auto cache = Quake3ShaderCache{};
+
+  const auto shaders = std::vector<Quake3Shader>{
+    {.shaderPath = "textures/test/some_shader"},
+  };
+
+  cache.insert(Quake3ShaderCache::makeKey("scripts/test.shader", "contents"), shaders);
+  REQUIRE(cache.size() == 1);
+
+  SECTION("find")
+  {
+    CHECK(
+      cache.find(Quake3ShaderCache::makeKey("scripts/test.shader", "contents"))
+      != nullptr);
+    CHECK(
+      *cache.find(Quake3ShaderCache::makeKey("scripts/test.shader", "contents"))
+      == shaders);
+
+    CHECK(
+      cache.find(Quake3ShaderCache::makeKey("scripts/test.shader", "changed contents"))
+      == nullptr);
+    CHECK(
+      cache.find(Quake3ShaderCache::makeKey("scripts/other.shader", "contents"))
+      == nullptr);
+  }
+
+  SECTION("insert replaces the shaders cached for the same path")
+  {
+    const auto otherShaders = std::vector<Quake3Shader>{
+      {.shaderPath = "textures/test/other_shader"},
+    };
+
+    cache.insert(
+      Quake3ShaderCache::makeKey("scripts/test.shader", "changed contents"),
+      otherShaders);
+
+    CHECK(cache.size() == 1);
+    CHECK(
+      cache.find(Quake3ShaderCache::makeKey("scripts/test.shader", "contents"))
+      == nullptr);
+    CHECK(
+      *cache.find(Quake3ShaderCache::makeKey("scripts/test.shader", "changed contents"))
+      == otherShaders);
+  }
+}
+
+TEST_CASE("loadShaders with Quake3ShaderCache")
+{
+  auto logger = NullLogger{};
+  auto taskManager = kdl::task_manager{};
+
+  const auto fs = fs::DiskFileSystem{
+    std::filesystem::current_path()
+    / "fixture/test/mdl/LoadMaterialCollections/shaders/malformed_shader"};
+
+  const auto materialConfig = MaterialConfig{
+    "textures",
+    {".tga", ".png", ".jpg", ".jpeg"},
+    "",
+    std::nullopt,
+    "scripts",
+    {},
+  };
+
+  auto cache = Quake3ShaderCache{};
+  const auto shaders =
+    loadShaders(fs, materialConfig, cache, taskManager, logger) | kdl::value();
+
+  REQUIRE(shaders.size() == 1);
+  CHECK(shaders.front().shaderPath == "textures/test/some_shader");
+
+  // malformed scripts are not cached
+  CHECK(cache.size() == 1);
+
+  SECTION("Unchanged scripts are not parsed again")
+  {
+    const auto file = fs.openFile("scripts/test.shader") | kdl::value();
+    const auto bufferedReader = file->reader().buffer();
+    const auto key =
+      Quake3ShaderCache::makeKey("scripts/test.shader", bufferedReader.stringView());
+    REQUIRE(cache.find(key) != nullptr);
+
+    const auto cachedShaders = std::vector<Quake3Shader>{
+      {.shaderPath = "textures/test/cached_shader"},
+    };
+    cache.insert(key, cachedShaders);
+
+    CHECK(
+      (loadShaders(fs, materialConfig, cache, taskManager, logger) | kdl::value())
+      == cachedShaders);
+  }
+}
+
+} // namespace tb::mdl
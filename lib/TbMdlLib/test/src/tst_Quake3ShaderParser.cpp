@@ -434,6 +434,38 @@ waterBubble
     CHECK_NOTHROW(parser.parse(status));
   }
 
+  SECTION("Skip ignored entries")
+  {
+    const auto data = R"(
+textures/test/skipped_entries
+{
+    q3map_globaltexture /* a comment
+    spanning lines */ $whiteimage
+    deformVertexes wave 100 sin 3 0 0.2 0.5 // comment
+    {
+        tcMod scroll 0.1 0 }
+    {
+        map textures/test/layer.tga
+        rgbGen identity }
+    surfaceparm trans
+}
+)";
+    auto parser = Quake3ShaderParser{data};
+    CHECK(
+      parser.parse(status)
+      == std::vector<Quake3Shader>{{
+        "textures/test/skipped_entries", // shaderPath
+        "",                              // editorImage
+        "",                              // lightImage
+        Quake3Shader::Culling::Front,    // culling
+        {"trans"},                       // surfaceParms
+        {
+          {"", {"", ""}},
+          {"textures/test/layer.tga", {"", ""}},
+        }, // stages
+      }});
+  }
+
   SECTION("Parse blend func parameters")
   {
     // https://github.com/id-Software/Quake-III-Arena/blob/master/code/renderer/tr_shader.c#L176
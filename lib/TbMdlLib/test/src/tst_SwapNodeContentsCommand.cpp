@@ -0,0 +1,118 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/CatchConfig.h"
+#include "mdl/Map.h"
+#include "mdl/MapFixture.h"
+#include "mdl/Map_Nodes.h"
+#include "mdl/NodeContents.h"
+#include "mdl/SwapNodeContentsCommand.h"
+#include "mdl/TestFactory.h"
+
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+namespace
+{
+
+auto setXOffset(Brush brush, const size_t faceIndex, const float xOffset)
+{
+  auto attributes = brush.face(faceIndex).attributes();
+  attributes.setXOffset(xOffset);
+  brush.face(faceIndex).setAttributes(attributes);
+  return brush;
+}
+
+auto setMaterialName(Brush brush, const size_t faceIndex, const std::string& materialName)
+{
+  auto attributes = brush.face(faceIndex).attributes();
+  attributes.setMaterialName(materialName);
+  brush.face(faceIndex).setAttributes(attributes);
+  return brush;
+}
+
+} // namespace
+
+TEST_CASE("SwapNodeContentsCommand")
+{
+  auto fixture = MapFixture{};
+  auto& map = fixture.create();
+
+  auto* brushNode = createBrushNode(map);
+  addNodes(map, {{parentForNodes(map), {brushNode}}});
+
+  const auto originalBrush = brushNode->brush();
+
+  SECTION("Collated changes to different faces are undone together")
+  {
+    const auto firstBrush = setXOffset(originalBrush, 0, 16.0f);
+    const auto secondBrush = setMaterialName(firstBrush, 1, "other_material");
+
+    auto firstCommand =
+      SwapNodeContentsCommand{"first", {{brushNode, NodeContents{firstBrush}}}};
+    auto secondCommand =
+      SwapNodeContentsCommand{"second", {{brushNode, NodeContents{secondBrush}}}};
+
+    REQUIRE(firstCommand.performDo(map));
+    REQUIRE(secondCommand.performDo(map));
+    REQUIRE(brushNode->brush() == secondBrush);
+
+    REQUIRE(firstCommand.collateWith(secondCommand));
+
+    CHECK(firstCommand.performUndo(map));
+    CHECK(brushNode->brush() == originalBrush);
+
+    CHECK(firstCommand.performDo(map));
+    CHECK(brushNode->brush() == secondBrush);
+  }
+
+  SECTION("Collated face and geometry changes are undone together")
+  {
+    const auto firstBrush = setMaterialName(originalBrush, 0, "other_material");
+
+    auto secondBrush = firstBrush;
+    REQUIRE(secondBrush.transform(
+      map.worldBounds(), vm::translation_matrix(vm::vec3d{16, 0, 0}), false));
+
+    auto firstCommand =
+      SwapNodeContentsCommand{"first", {{brushNode, NodeContents{firstBrush}}}};
+    auto secondCommand =
+      SwapNodeContentsCommand{"second", {{brushNode, NodeContents{secondBrush}}}};
+
+    REQUIRE(firstCommand.performDo(map));
+    REQUIRE(secondCommand.performDo(map));
+    REQUIRE(firstCommand.collateWith(secondCommand));
+
+    CHECK(firstCommand.performUndo(map));
+    CHECK(brushNode->brush() == originalBrush);
+    CHECK(brushNode->brush().vertexPositions() == originalBrush.vertexPositions());
+
+    CHECK(firstCommand.performDo(map));
+    CHECK(brushNode->brush() == secondBrush);
+  }
+}
+
+} // namespace tb::mdl
@@ -17,6 +17,8 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
 #include "mdl/CatchConfig.h"
 #include "mdl/Entity.h"
@@ -26,6 +28,7 @@
 #include "mdl/LayerNode.h"
 #include "mdl/Map.h"
 #include "mdl/MapFixture.h"
+#include "mdl/MaterialIndex.h"
 #include "mdl/Map_Nodes.h"
 #include "mdl/Map_Selection.h"
 #include "mdl/TestFactory.h"
@@ -140,6 +143,10 @@ TEST_CASE("UpdateLinkedGroupsHelper")
     auto* linkedNode =
       static_cast<GroupNode*>(groupNode->cloneRecursively(map.worldBounds()));
 
+    // change the structure of the linked group so that the children of groupNode are
+    // replaced
+    linkedNode->addChild(new EntityNode{Entity{}});
+
     addNodes(map, {{parentForNodes(map), {groupNode, linkedNode}}});
 
     SECTION("Helper takes ownership of replaced child nodes")
@@ -226,15 +233,15 @@ TEST_CASE("UpdateLinkedGroupsHelper")
         +-groupNode
           +-brushNode (translated 0 16 0)
         +-linkedGroupNode (translated 32 0 0)
-          +-newLinkedBrushNode (translated 32 16 0)
+          +-linkedBrushNode (translated 32 16 0)
       */
 
-      // changes were propagated
+      // changes were propagated, but the linked brush node was not replaced
       REQUIRE(linkedGroupNode->childCount() == 1u);
-      CHECK(linkedBrushNode->parent() == nullptr);
-      auto* newLinkedBrushNode = linkedGroupNode->children().front();
+      CHECK_THAT(
+        linkedGroupNode->children(), Equals(std::vector<Node*>{linkedBrushNode}));
       CHECK(
-        newLinkedBrushNode->physicalBounds()
+        linkedBrushNode->physicalBounds()
         == originalBrushBounds.translate(vm::vec3d(32.0, 16.0, 0.0)));
 
       // undo change propagation
@@ -258,6 +265,57 @@ TEST_CASE("UpdateLinkedGroupsHelper")
         == originalBrushBounds.translate(vm::vec3d(32.0, 0.0, 0.0)));
     }
 
+    SECTION("Unchanged linked nodes are left untouched")
+    {
+      auto* groupNode = new GroupNode{Group{"test"}};
+      setLinkId(*groupNode, "asdf");
+
+      auto* brushNode = createBrushNode(map);
+      auto* unchangedBrushNode = createBrushNode(map);
+      groupNode->addChild(brushNode);
+      groupNode->addChild(unchangedBrushNode);
+
+      auto* linkedGroupNode =
+        static_cast<GroupNode*>(groupNode->cloneRecursively(map.worldBounds()));
+
+      REQUIRE(linkedGroupNode->children().size() == 2u);
+      auto* linkedBrushNode =
+        dynamic_cast<BrushNode*>(linkedGroupNode->children().front());
+      auto* linkedUnchangedBrushNode =
+        dynamic_cast<BrushNode*>(linkedGroupNode->children().back());
+      REQUIRE(linkedBrushNode != nullptr);
+      REQUIRE(linkedUnchangedBrushNode != nullptr);
+
+      addNodes(map, {{parentForNodes(map), {groupNode, linkedGroupNode}}});
+
+      const auto originalBrushBounds = brushNode->physicalBounds();
+      const auto* originalUnchangedGeometry =
+        linkedUnchangedBrushNode->brush().face(0).geometry();
+
+      transformNode(
+        *brushNode, vm::translation_matrix(vm::vec3d(0.0, 16.0, 0.0)), map.worldBounds());
+
+      auto helper = UpdateLinkedGroupsHelper{{groupNode}};
+      REQUIRE(helper.applyLinkedGroupUpdates(map));
+
+      CHECK_THAT(
+        linkedGroupNode->children(),
+        Equals(std::vector<Node*>{linkedBrushNode, linkedUnchangedBrushNode}));
+      CHECK(
+        linkedBrushNode->physicalBounds()
+        == originalBrushBounds.translate(vm::vec3d(0.0, 16.0, 0.0)));
+      CHECK(
+        linkedUnchangedBrushNode->brush().face(0).geometry()
+        == originalUnchangedGeometry);
+
+      helper.undoLinkedGroupUpdates(map);
+
+      CHECK(linkedBrushNode->physicalBounds() == originalBrushBounds);
+      CHECK(
+        linkedUnchangedBrushNode->brush().face(0).geometry()
+        == originalUnchangedGeometry);
+    }
+
     SECTION("Nested linked groups")
     {
       auto* outerGroupNode = new GroupNode{Group{"outerGroupNode"}};
@@ -537,6 +595,67 @@ TEST_CASE("UpdateLinkedGroupsHelper")
         newNestedLinkedBrushNode->physicalBounds()
         == originalBrushBounds.translate(vm::vec3d(32.0, 16.0, 8.0)));
     }
+
+    SECTION("Nested linked groups with changed structure")
+    {
+      auto* outerGroupNode = new GroupNode{Group{"outerGroupNode"}};
+      setLinkId(*outerGroupNode, "outerGroupNode");
+
+      auto* innerGroupNode = new GroupNode{Group{"innerGroupNode"}};
+      setLinkId(*innerGroupNode, "innerGroupNode");
+
+      auto* brushNode = createBrushNode(map);
+      innerGroupNode->addChild(brushNode);
+      outerGroupNode->addChild(innerGroupNode);
+
+      auto* linkedOuterGroupNode =
+        static_cast<GroupNode*>(outerGroupNode->cloneRecursively(map.worldBounds()));
+      auto* nestedLinkedInnerGroupNode =
+        static_cast<GroupNode*>(linkedOuterGroupNode->children().front());
+      auto* nestedLinkedBrushNode = nestedLinkedInnerGroupNode->children().front();
+
+      addNodes(map, {{parentForNodes(map), {outerGroupNode, linkedOuterGroupNode}}});
+
+      /*
+      world
+      +-defaultLayer
+        +-outerGroupNode--------+
+          +-innerGroupNode------|-------+
+            +-brushNode         |       |
+        +-linkedOuterGroupNode--+       |
+          +-nestedLinkedInnerGroupNode--+
+            +-nestedLinkedBrushNode
+      */
+
+      // change the structure of the inner group so that the children of both
+      // nestedLinkedInnerGroupNode and linkedOuterGroupNode are replaced
+      innerGroupNode->addChild(createBrushNode(map));
+
+      const auto materialName = brushNode->brush().face(0).attributes().materialName();
+      const auto originalUsageCount = map.materialIndex().usageCount(materialName);
+
+      auto helper = UpdateLinkedGroupsHelper{{innerGroupNode, outerGroupNode}};
+      REQUIRE(helper.applyLinkedGroupUpdates(map));
+
+      REQUIRE(linkedOuterGroupNode->childCount() == 1u);
+      auto* newNestedLinkedInnerGroupNode =
+        dynamic_cast<GroupNode*>(linkedOuterGroupNode->children().front());
+      REQUIRE(newNestedLinkedInnerGroupNode != nullptr);
+      CHECK(newNestedLinkedInnerGroupNode->childCount() == 2u);
+      CHECK(
+        map.materialIndex().usageCount(materialName)
+        == originalUsageCount + brushNode->brush().faceCount());
+
+      helper.undoLinkedGroupUpdates(map);
+
+      CHECK_THAT(
+        linkedOuterGroupNode->children(),
+        Equals(std::vector<Node*>{nestedLinkedInnerGroupNode}));
+      CHECK_THAT(
+        nestedLinkedInnerGroupNode->children(),
+        Equals(std::vector<Node*>{nestedLinkedBrushNode}));
+      CHECK(map.materialIndex().usageCount(materialName) == originalUsageCount);
+    }
   }
 }
 
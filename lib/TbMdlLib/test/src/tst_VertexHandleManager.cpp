@@ -0,0 +1,264 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gl/PerspectiveCamera.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/CatchConfig.h"
+#include "mdl/Grid.h"
+#include "mdl/PickResult.h"
+#include "mdl/VertexHandleManager.h"
+
+#include "kd/result.h"
+
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+namespace tb::mdl
+{
+using namespace Catch::Matchers;
+
+TEST_CASE("VertexHandleManager")
+{
+  const auto builder = BrushBuilder{MapFormat::Quake3, vm::bbox3d{4096.0}};
+
+  // two cuboids sharing the face at x == 64
+  auto brushNode1 = std::make_unique<BrushNode>(
+    builder.createCuboid(vm::bbox3d{{0, 0, 0}, {64, 64, 64}}, "material")
+    | kdl::value());
+  auto brushNode2 = std::make_unique<BrushNode>(
+    builder.createCuboid(vm::bbox3d{{64, 0, 0}, {128, 64, 64}}, "material")
+    | kdl::value());
+  const auto brushNodes = std::vector<BrushNode*>{brushNode1.get(), brushNode2.get()};
+
+  auto manager = VertexHandleManager{};
+  manager.addHandles(brushNodes);
+
+  REQUIRE(manager.totalHandleCount() == 12);
+
+  SECTION("findIncidentBrushes")
+  {
+    CHECK_THAT(
+      manager.findIncidentBrushes(vm::vec3d{64, 0, 0}, brushNodes),
+      UnorderedEquals(std::vector<BrushNode*>{brushNode1.get(), brushNode2.get()}));
+    CHECK(
+      manager.findIncidentBrushes(vm::vec3d{0, 0, 0}, brushNodes)
+      == std::vector<BrushNode*>{brushNode1.get()});
+    CHECK(
+      manager.findIncidentBrushes(vm::vec3d{128, 64, 64}, brushNodes)
+      == std::vector<BrushNode*>{brushNode2.get()});
+    CHECK(manager.findIncidentBrushes(vm::vec3d{32, 32, 32}, brushNodes).empty());
+
+    // only the given brushes are considered
+    CHECK(
+      manager.findIncidentBrushes(
+        vm::vec3d{64, 0, 0}, std::vector<BrushNode*>{brushNode2.get()})
+      == std::vector<BrushNode*>{brushNode2.get()});
+
+    manager.removeHandles(*brushNode1);
+    CHECK(manager.totalHandleCount() == 8);
+    CHECK(
+      manager.findIncidentBrushes(vm::vec3d{64, 0, 0}, brushNodes)
+      == std::vector<BrushNode*>{brushNode2.get()});
+    CHECK(!manager.contains(vm::vec3d{0, 0, 0}));
+  }
+
+  SECTION("remove handles shared by several brushes")
+  {
+    manager.select(vm::vec3d{64, 0, 0});
+    REQUIRE(manager.selectedHandleCount() == 1);
+
+    manager.removeHandles(*brushNode2);
+    CHECK(manager.totalHandleCount() == 8);
+    CHECK(manager.selected(vm::vec3d{64, 0, 0}));
+    CHECK(manager.selectedHandleCount() == 1);
+
+    manager.removeHandles(*brushNode1);
+    CHECK(manager.totalHandleCount() == 0);
+    CHECK(manager.selectedHandleCount() == 0);
+  }
+
+  SECTION("select close handles")
+  {
+    // selecting a handle that is not managed selects the handles close to it
+    manager.select(std::vector<vm::vec3d>{
+      vm::vec3d{64.0000001, 0, 0},
+      vm::vec3d{-0.0000001, 64, 64},
+      vm::vec3d{32, 32, 32},
+    });
+    CHECK(manager.selectedHandleCount() == 2);
+    CHECK(manager.selected(vm::vec3d{64, 0, 0}));
+    CHECK(manager.selected(vm::vec3d{0, 64, 64}));
+
+    manager.deselect(vm::vec3d{63.9999999, 0, 0});
+    CHECK(manager.selectedHandleCount() == 1);
+    CHECK(!manager.selected(vm::vec3d{64, 0, 0}));
+
+    manager.deselectAll();
+    CHECK(manager.selectedHandleCount() == 0);
+  }
+
+  SECTION("pick")
+  {
+    const auto camera = gl::PerspectiveCamera{
+      90.0f,
+      1.0f,
+      8000.0f,
+      gl::Camera::Viewport{0, 0, 1920, 1080},
+      vm::vec3f{64, -256, 0},
+      vm::vec3f{0, 1, 0},
+      vm::vec3f{0, 0, 1}};
+
+    SECTION("hits a handle")
+    {
+      auto pickResult = PickResult{};
+      manager.pick(vm::ray3d{{64, -256, 0}, {0, 1, 0}}, camera, 3.0, pickResult);
+
+      REQUIRE(pickResult.size() == 2);
+      CHECK(pickResult.all()[0].target<vm::vec3d>() == vm::vec3d{64, 0, 0});
+      CHECK(pickResult.all()[1].target<vm::vec3d>() == vm::vec3d{64, 64, 0});
+    }
+
+    SECTION("misses all handles")
+    {
+      auto pickResult = PickResult{};
+      manager.pick(vm::ray3d{{32, -256, 32}, {0, 1, 0}}, camera, 3.0, pickResult);
+      CHECK(pickResult.empty());
+    }
+
+    SECTION("hits a handle after it was added")
+    {
+      manager.removeHandles(brushNodes);
+      REQUIRE(manager.totalHandleCount() == 0);
+
+      manager.add(vm::vec3d{1000, 1000, 1000});
+
+      auto pickResult = PickResult{};
+      manager.pick(
+        vm::ray3d{{64, -256, 0}, vm::normalize(vm::vec3d{936, 1256, 1000})},
+        camera,
+        3.0,
+        pickResult);
+      CHECK(pickResult.size() == 1);
+    }
+
+    SECTION("finds the same hits as testing every handle")
+    {
+      manager.removeHandles(brushNodes);
+      REQUIRE(manager.totalHandleCount() == 0);
+
+      for (int x = -8; x <= 8; ++x)
+      {
+        for (int y = -8; y <= 8; ++y)
+        {
+          for (int z = -8; z <= 8; ++z)
+          {
+            manager.add(vm::vec3d{40.0 * x, 40.0 * y, 40.0 * z});
+          }
+        }
+      }
+
+      const auto handleRadius = GENERATE(3.0, 30.0);
+      const auto target = GENERATE(
+        vm::vec3d{80, 320, 0},
+        vm::vec3d{120, 40, -80},
+        vm::vec3d{-200, 280, 160},
+        vm::vec3d{320, 120, 320});
+
+      const auto origin = vm::vec3d{64, -256, 0};
+      const auto pickRay = vm::ray3d{origin, vm::normalize(target - origin)};
+
+      auto pickResult = PickResult{};
+      manager.pick(pickRay, camera, handleRadius, pickResult);
+
+      auto expectedHits = std::vector<vm::vec3d>{};
+      for (const auto& handle : manager.allHandles())
+      {
+        if (camera.pickPointHandle(pickRay, handle, handleRadius))
+        {
+          expectedHits.push_back(handle);
+        }
+      }
+      REQUIRE(!expectedHits.empty());
+
+      auto hits = std::vector<vm::vec3d>{};
+      for (const auto& hit : pickResult.all())
+      {
+        hits.push_back(hit.target<vm::vec3d>());
+      }
+      CHECK_THAT(hits, UnorderedEquals(expectedHits));
+    }
+  }
+}
+
+TEST_CASE("EdgeHandleManager")
+{
+  const auto camera = gl::PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8000.0f,
+    gl::Camera::Viewport{0, 0, 1920, 1080},
+    vm::vec3f{64, -256, 0},
+    vm::vec3f{0, 1, 0},
+    vm::vec3f{0, 0, 1}};
+
+  auto manager = EdgeHandleManager{};
+
+  // edges that are larger than the cells of the spatial index
+  const auto longEdge = vm::segment3d{{-1000, 500, 0}, {1000, 500, 0}};
+  const auto shortEdge = vm::segment3d{{0, 0, 0}, {0, 0, 16}};
+  manager.add(longEdge);
+  manager.add(shortEdge);
+
+  SECTION("pickCenterHandle")
+  {
+    auto pickResult = PickResult{};
+    manager.pickCenterHandle(
+      vm::ray3d{{64, -256, 0}, vm::normalize(vm::vec3d{-64, 756, 0})},
+      camera,
+      3.0,
+      pickResult);
+
+    REQUIRE(pickResult.size() == 1);
+    CHECK(pickResult.all()[0].target<vm::segment3d>() == longEdge);
+  }
+
+  SECTION("pickGridHandle")
+  {
+    const auto grid = Grid{4};
+
+    auto pickResult = PickResult{};
+    manager.pickGridHandle(
+      vm::ray3d{{64, -256, 0}, vm::normalize(vm::vec3d{736, 756, 0})},
+      camera,
+      3.0,
+      grid,
+      pickResult);
+
+    REQUIRE(pickResult.size() == 1);
+    CHECK(
+      std::get<0>(pickResult.all()[0].target<EdgeHandleManager::HitData>()) == longEdge);
+  }
+}
+
+} // namespace tb::mdl
@@ -288,6 +288,50 @@ TEST_CASE("WorldNodeTest.rebuildNodeTree")
   CHECK(nodeTree.contains(patchNode));
 }
 
+TEST_CASE("WorldNodeTest.addNodes")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto* layerNode = new LayerNode{Layer{"layer"}};
+  auto* groupNode = new GroupNode{Group{"group"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushNode = new BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "material") | kdl::value()};
+
+  // clang-format off
+  auto* patchNode = new PatchNode{BezierPatch{3, 3, {
+    {0, 0, 0}, {1, 0, 1}, {2, 0, 0},
+    {0, 1, 1}, {1, 1, 2}, {2, 1, 1},
+    {0, 2, 0}, {1, 2, 1}, {2, 2, 0} }, "material"}};
+  // clang-format on
+
+  groupNode->addChild(patchNode);
+
+  const auto& nodeTree = worldNode.nodeTree();
+
+  worldNode.addNodes({
+    {&worldNode, {layerNode}},
+    {worldNode.defaultLayer(), {entityNode, groupNode}},
+  });
+  CHECK(worldNode.children() == std::vector<Node*>{worldNode.defaultLayer(), layerNode});
+  CHECK(
+    worldNode.defaultLayer()->children() == std::vector<Node*>{entityNode, groupNode});
+  CHECK_FALSE(nodeTree.contains(layerNode));
+  CHECK_FALSE(nodeTree.contains(groupNode));
+  CHECK(nodeTree.contains(entityNode));
+  CHECK(nodeTree.contains(patchNode));
+  CHECK(groupNode->persistentId() != std::nullopt);
+  CHECK(layerNode->persistentId() != std::nullopt);
+
+  worldNode.addNodes({{layerNode, {brushNode}}});
+  CHECK(nodeTree.contains(brushNode));
+  CHECK_THAT(
+    nodeTree.find_containers(vm::vec3d{0, 0, 0}),
+    UnorderedEquals(std::vector<Node*>{entityNode, brushNode, patchNode}));
+}
+
 TEST_CASE("WorldNodeTest.disableNodeTreeUpdates")
 {
   constexpr auto worldBounds = vm::bbox3d{8192.0};
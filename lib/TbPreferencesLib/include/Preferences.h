@@ -208,6 +208,10 @@ inline auto EnableMSAA = Preference<bool>{"render/Enable multisampling", true};
 inline auto AlignmentLock = Preference<bool>{"Editor/Texture lock", true};
 inline auto UVLock = Preference<bool>{"Editor/UV lock", false};
 
+// The maximum memory used by the undo history in MiB, or 0 for no limit. The limit is
+// opt-in because the oldest undo steps are discarded when it is exceeded.
+inline auto UndoMemoryLimit = Preference<int>{"Editor/Undo memory limit", 0};
+
 inline auto RendererFontPath = Preference<std::filesystem::path>{
   "render/Font name", "fonts/SourceSansPro-Regular.otf"};
 
@@ -44,6 +44,7 @@ namespace mdl
 class BrushNode;
 class BrushFace;
 class EditorContext;
+class MaterialIndex;
 } // namespace mdl
 
 namespace render
@@ -205,7 +206,13 @@ public:
    * lingering Material* pointers.
    */
   void invalidate();
-  void invalidateMaterials(const std::vector<const gl::Material*>& materials);
+  /**
+   * Invalidates the brushes that have faces with any of the given materials. The brushes
+   * are looked up in the given material index.
+   */
+  void invalidateMaterials(
+    const std::vector<const gl::Material*>& materials,
+    const mdl::MaterialIndex& materialIndex);
   void invalidateBrush(const mdl::BrushNode& brush);
   void invalidateMaterial(const gl::Material& material);
   bool valid() const;
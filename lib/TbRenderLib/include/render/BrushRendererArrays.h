@@ -220,6 +220,8 @@ public:
 
   size_t size() const { return m_snapshot.size(); }
 
+  const std::vector<T>& elements() const { return m_snapshot; }
+
   void bindBlock(gl::Gl& gl) { m_vbo->bind(gl); }
 
   void unbindBlock(gl::Gl& gl) { m_vbo->unbind(gl); }
@@ -23,14 +23,18 @@
 #include "Macros.h"
 #include "render/LinkRenderer.h"
 
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace tb
 {
 namespace mdl
 {
+class EntityNodeBase;
 class Map;
-}
+class Node;
+} // namespace mdl
 
 namespace render
 {
@@ -42,15 +46,48 @@ class EntityLinkRenderer : public LinkRenderer
   Color m_defaultColor = RgbaF{0.5f, 1.0f, 0.5f, 1.0f};
   Color m_selectedColor = RgbaF{1.0f, 0.0f, 0.0f, 1.0f};
 
+  // When all links are shown, the links are stored per source node. These maps record
+  // the targets of the links that are currently rendered for each source node and vice
+  // versa, so that only the links affected by a change need to be rebuilt.
+  using EntityNodeSet = std::unordered_set<const mdl::EntityNodeBase*>;
+
+  std::unordered_map<const mdl::EntityNodeBase*, std::vector<const mdl::EntityNodeBase*>>
+    m_renderedTargets;
+  std::unordered_map<const mdl::EntityNodeBase*, EntityNodeSet> m_renderedSources;
+  EntityNodeSet m_invalidNodes;
+
 public:
   explicit EntityLinkRenderer(mdl::Map& map);
 
   void setDefaultColor(const Color& color);
   void setSelectedColor(const Color& color);
 
+  /**
+   * Rebuilds the links from and to the given nodes. Brush and patch nodes affect the
+   * links of their containing entity. Nodes that cannot have links are ignored.
+   *
+   * If not all links are shown, the renderer is invalidated instead.
+   */
+  void invalidateNodes(const std::vector<mdl::Node*>& nodes);
+
+  /**
+   * Removes the links from and to the given nodes, which are about to be removed from the
+   * map.
+   *
+   * If not all links are shown, the renderer is invalidated instead.
+   */
+  void removeNodes(const std::vector<mdl::Node*>& nodes);
+
 private:
+  void updateLinks(bool rebuild) override;
   std::vector<LinkRenderer::LineVertex> getLinks() override;
 
+  bool showAllLinks() const;
+
+  void clearRenderedLinks();
+  void updateLinksFrom(const mdl::EntityNodeBase& sourceNode);
+  void removeLinksFrom(const mdl::EntityNodeBase& sourceNode);
+
   deleteCopy(EntityLinkRenderer);
 };
 
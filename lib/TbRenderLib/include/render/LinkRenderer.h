@@ -19,10 +19,14 @@
 
 #pragma once
 
-#include "gl/VertexArray.h"
 #include "gl/VertexType.h"
+#include "render/AllocationTracker.h"
 #include "render/Renderable.h"
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 namespace tb
 {
 namespace gl
@@ -36,6 +40,18 @@ namespace render
 class RenderContext;
 class RenderBatch;
 
+template <typename V>
+class LinkVertexArray;
+
+/**
+ * Renders links as lines with arrows.
+ *
+ * The links are stored in groups identified by a key, e.g. the source node of the links.
+ * Subclasses can replace or remove the links of a single group, in which case only the
+ * affected ranges of the vertex buffers are updated. When the renderer is invalidated,
+ * all links are removed and rebuilt by calling updateLinks(). The same happens when most
+ * of the vertex buffers are taken up by removed links.
+ */
 class LinkRenderer : public DirectRenderable
 {
 public:
@@ -59,17 +75,50 @@ public:
                                                                          // arrow is
                                                                          // pointing
 private:
-  gl::VertexArray m_lines;
-  gl::VertexArray m_arrows;
+  struct LinkBlocks
+  {
+    AllocationTracker::Block* lines = nullptr;
+    AllocationTracker::Block* arrows = nullptr;
+  };
+
+  std::unique_ptr<LinkVertexArray<LineVertex>> m_lines;
+  std::unique_ptr<LinkVertexArray<ArrowVertex>> m_arrows;
+  std::unordered_map<const void*, LinkBlocks> m_linkBlocks;
 
   bool m_valid = false;
 
 public:
   LinkRenderer();
+  ~LinkRenderer() override;
 
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
   void invalidate();
 
+  /**
+   * Returns the line vertices of the stored links, two per link. The links are updated
+   * when the renderer is prepared.
+   */
+  std::vector<LineVertex> links() const;
+
+protected:
+  /**
+   * Replaces the links stored under the given key with the given links.
+   */
+  void setLinks(const void* key, const std::vector<LineVertex>& links);
+
+  /**
+   * Removes the links stored under the given key.
+   */
+  void removeLinks(const void* key);
+
+  /**
+   * Called before rendering. If `rebuild` is true, then all links have been removed and
+   * must be added again. Otherwise, subclasses may update links that have changed.
+   *
+   * The default implementation stores the result of getLinks() if `rebuild` is true.
+   */
+  virtual void updateLinks(bool rebuild);
+
 private:
   void prepare(gl::Gl& gl, gl::VboManager& vboManager) override;
   void render(RenderContext& renderContext) override;
@@ -78,6 +127,8 @@ private:
   void renderArrows(RenderContext& renderContext);
 
   void validate();
+  void rebuildLinks();
+  void removeAllLinks();
 
   virtual std::vector<LinkRenderer::LineVertex> getLinks() = 0;
 
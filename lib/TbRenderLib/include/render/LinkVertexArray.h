@@ -0,0 +1,169 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "gl/GlInterface.h"
+#include "gl/PrimType.h"
+#include "render/AllocationTracker.h"
+#include "render/BrushRendererArrays.h"
+
+#include "kd/contracts.h"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace tb
+{
+namespace gl
+{
+class ShaderProgram;
+class VboManager;
+} // namespace gl
+
+namespace render
+{
+
+/**
+ * A vertex array that supports inserting and removing ranges of vertices without
+ * rebuilding the entire array. It grows as needed.
+ *
+ * Removed ranges are overwritten with default constructed (zeroed) vertices so that they
+ * form degenerate primitives, and only the modified ranges are uploaded to the VBO.
+ *
+ * The array is rendered with a single draw call over its entire capacity. The array never
+ * shrinks, so once most of its capacity is unused, isFragmented() returns true and the
+ * owner should rebuild it.
+ *
+ * Non-copyable; meant to be held in a std::unique_ptr.
+ */
+template <typename V>
+class LinkVertexArray
+{
+private:
+  // Arrays smaller than this are never considered fragmented.
+  static constexpr size_t MinFragmentedCapacity = 4096;
+
+  VertexHolder<V> m_vertexHolder;
+  AllocationTracker m_allocationTracker;
+  size_t m_vertexCount = 0;
+
+public:
+  LinkVertexArray() = default;
+  LinkVertexArray(const LinkVertexArray&) = delete;
+  LinkVertexArray& operator=(const LinkVertexArray&) = delete;
+
+  /**
+   * Copies the given vertices into the array. Returns a block which can later be passed
+   * to removeVertices().
+   */
+  AllocationTracker::Block* insertVertices(const std::vector<V>& vertices)
+  {
+    contract_pre(!vertices.empty());
+
+    auto* block = m_allocationTracker.allocate(vertices.size());
+    if (block == nullptr)
+    {
+      const auto newSize = std::max(
+        2 * m_allocationTracker.capacity(),
+        m_allocationTracker.capacity() + vertices.size());
+      m_allocationTracker.expand(newSize);
+      m_vertexHolder.resize(newSize);
+
+      block = m_allocationTracker.allocate(vertices.size());
+      contract_assert(block != nullptr);
+    }
+
+    auto* dest = m_vertexHolder.getPointerToWriteElementsTo(block->pos, block->size);
+    std::ranges::copy(vertices, dest);
+    m_vertexCount += block->size;
+    return block;
+  }
+
+  void removeVertices(AllocationTracker::Block* block)
+  {
+    const auto pos = block->pos;
+    const auto size = block->size;
+    m_allocationTracker.free(block);
+    m_vertexCount -= size;
+
+    auto* dest = m_vertexHolder.getPointerToWriteElementsTo(pos, size);
+    std::fill_n(dest, size, V{});
+  }
+
+  bool empty() const { return !m_allocationTracker.hasAllocations(); }
+
+  /**
+   * Returns the number of vertices that are currently stored.
+   */
+  size_t vertexCount() const { return m_vertexCount; }
+
+  size_t capacity() const { return m_allocationTracker.capacity(); }
+
+  /**
+   * Indicates whether less than a quarter of a large array is in use.
+   */
+  bool isFragmented() const
+  {
+    return capacity() >= MinFragmentedCapacity && 4 * m_vertexCount < capacity();
+  }
+
+  /**
+   * Returns the stored vertices ordered by their position in the array.
+   */
+  std::vector<V> vertices() const
+  {
+    const auto& elements = m_vertexHolder.elements();
+
+    auto result = std::vector<V>{};
+    result.reserve(m_vertexCount);
+    for (const auto& range : m_allocationTracker.usedBlocks())
+    {
+      result.insert(
+        result.end(),
+        std::next(elements.begin(), static_cast<std::ptrdiff_t>(range.pos)),
+        std::next(elements.begin(), static_cast<std::ptrdiff_t>(range.pos + range.size)));
+    }
+    return result;
+  }
+
+  void prepare(gl::Gl& gl, gl::VboManager& vboManager)
+  {
+    m_vertexHolder.prepare(gl, vboManager);
+  }
+
+  bool setup(gl::Gl& gl, gl::ShaderProgram& currentProgram)
+  {
+    return !empty() && m_vertexHolder.setup(gl, currentProgram);
+  }
+
+  void render(gl::Gl& gl, const gl::PrimType primType) const
+  {
+    gl.drawArrays(toGL(primType), 0, static_cast<GLsizei>(m_vertexHolder.size()));
+  }
+
+  void cleanup(gl::Gl& gl, gl::ShaderProgram& currentProgram)
+  {
+    m_vertexHolder.cleanup(gl, currentProgram);
+  }
+};
+
+} // namespace render
+} // namespace tb
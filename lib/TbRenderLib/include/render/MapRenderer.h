@@ -43,6 +43,7 @@ class GroupNode;
 class LayerNode;
 class Map;
 class Node;
+struct NodeChanges;
 struct SelectionChange;
 } // namespace mdl
 
@@ -125,12 +126,9 @@ private:
 private: // notification
   void connectObservers();
 
-  void nodesWereAdded(const std::vector<mdl::Node*>& nodes);
+  void nodeChangesDidOccur(const mdl::NodeChanges& nodeChanges);
+  void nodesWillBeRemoved(const std::vector<mdl::Node*>& nodes);
   void nodesWereRemoved(const std::vector<mdl::Node*>& nodes);
-  void nodesDidChange(const std::vector<mdl::Node*>& nodes);
-
-  void nodeVisibilityDidChange(const std::vector<mdl::Node*>& nodes);
-  void nodeLockingDidChange(const std::vector<mdl::Node*>& nodes);
 
   void groupWasOpened();
   void groupWasClosed();
@@ -46,6 +46,7 @@ class EntityModel;
 class EntityModelManager;
 class EntityNode;
 class GroupNode;
+class MaterialIndex;
 class Node;
 class PatchNode;
 } // namespace mdl
@@ -79,7 +80,9 @@ public:
 public: // object management
   void addNode(mdl::Node& node);
   void removeNode(mdl::Node& node);
-  void invalidateMaterials(const std::vector<const gl::Material*>& materials);
+  void invalidateMaterials(
+    const std::vector<const gl::Material*>& materials,
+    const mdl::MaterialIndex& materialIndex);
   void invalidateEntityModels(const std::vector<const mdl::EntityModel*>& entityModels);
   void invalidateNode(mdl::Node& node);
   void invalidate();
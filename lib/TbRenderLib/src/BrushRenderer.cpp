@@ -25,6 +25,7 @@
 #include "mdl/BrushNode.h"
 #include "mdl/BrushRendererBrushCache.h"
 #include "mdl/EditorContext.h"
+#include "mdl/MaterialIndex.h"
 #include "mdl/Polyhedron.h"
 #include "mdl/TagAttribute.h"
 #include "render/BrushRendererArrays.h"
@@ -188,15 +189,15 @@ void BrushRenderer::invalidate()
   contract_post(m_opaqueFaces->empty());
 }
 
-void BrushRenderer::invalidateMaterials(const std::vector<const gl::Material*>& materials)
+void BrushRenderer::invalidateMaterials(
+  const std::vector<const gl::Material*>& materials,
+  const mdl::MaterialIndex& materialIndex)
 {
-  const auto materialSet =
-    std::unordered_set<const gl::Material*>{materials.begin(), materials.end()};
-  for (auto* brushNode : m_allBrushes)
+  for (const auto* material : materials)
   {
-    for (const auto& face : brushNode->brush().faces())
+    for (const auto* brushNode : materialIndex.findBrushNodes(material->name()))
     {
-      if (materialSet.count(face.material()) > 0)
+      if (m_allBrushes.contains(brushNode))
       {
         brushNode->brushRendererBrushCache().invalidateVertexCache();
         invalidateBrush(*brushNode);
@@ -38,7 +38,6 @@
 #include "vm/vec.h"
 
 #include <cassert>
-#include <ranges>
 #include <unordered_set>
 
 namespace tb::render
@@ -47,16 +46,6 @@ namespace tb::render
 namespace
 {
 
-auto getLinkEnds(const auto& entityLinks)
-{
-  return entityLinks
-         | std::views::transform(
-           [](const auto& nameAndTargetNodes) -> const mdl::EntityLinkManager::LinkEnds& {
-             return nameAndTargetNodes.second;
-           })
-         | std::views::join;
-}
-
 void addLink(
   const mdl::EntityNodeBase& sourceNode,
   const mdl::EntityNodeBase& targetNode,
@@ -75,38 +64,6 @@ void addLink(
     vm::vec3f{targetNode.linkTargetAnchor()}, targetColor.to<RgbaF>().toVec());
 }
 
-struct CollectAllLinksVisitor
-{
-  const mdl::EntityLinkManager& entityLinkManager;
-  const mdl::EditorContext& editorContext;
-  Color defaultColor;
-  Color selectedColor;
-
-  void visit(
-    const mdl::EntityNodeBase& node, std::vector<LinkRenderer::LineVertex>& linkVertices)
-  {
-    if (editorContext.visible(node))
-    {
-      addLinks(node, entityLinkManager.linksFrom(node), linkVertices);
-    }
-  }
-
-  void addLinks(
-    const mdl::EntityNodeBase& sourceNode,
-    const mdl::EntityLinkManager::LinkEndsForPropertyKey& entityLinks,
-    std::vector<LinkRenderer::LineVertex>& linkVertices)
-  {
-    for (const auto& linkEnd : getLinkEnds(entityLinks))
-    {
-      const auto& targetNode = *linkEnd.node;
-      if (editorContext.visible(targetNode))
-      {
-        addLink(sourceNode, targetNode, defaultColor, selectedColor, linkVertices);
-      }
-    }
-  }
-};
-
 struct CollectTransitiveSelectedLinksVisitor
 {
   const mdl::EntityLinkManager& entityLinkManager;
@@ -121,39 +78,37 @@ struct CollectTransitiveSelectedLinksVisitor
   {
     if (visited.insert(&node).second && editorContext.visible(node))
     {
-      addLinksFrom(node, entityLinkManager.linksFrom(node), linkVertices);
-      addLinksTo(node, entityLinkManager.linksTo(node), linkVertices);
+      addLinksFrom(node, entityLinkManager.linkTargetNodes(node), linkVertices);
+      addLinksTo(node, entityLinkManager.linkSourceNodes(node), linkVertices);
     }
   }
 
   void addLinksFrom(
     const mdl::EntityNodeBase& sourceNode,
-    const mdl::EntityLinkManager::LinkEndsForPropertyKey& entityLinks,
+    const std::vector<const mdl::EntityNodeBase*>& targetNodes,
     std::vector<LinkRenderer::LineVertex>& linkVertices)
   {
-    for (const auto& linkEnd : getLinkEnds(entityLinks))
+    for (const auto* targetNode : targetNodes)
     {
-      const auto& targetNode = *linkEnd.node;
-      if (editorContext.visible(targetNode))
+      if (editorContext.visible(*targetNode))
       {
-        addLink(sourceNode, targetNode, defaultColor, selectedColor, linkVertices);
-        visit(targetNode, linkVertices);
+        addLink(sourceNode, *targetNode, defaultColor, selectedColor, linkVertices);
+        visit(*targetNode, linkVertices);
       }
     }
   }
 
   void addLinksTo(
     const mdl::EntityNodeBase& targetNode,
-    const mdl::EntityLinkManager::LinkEndsForPropertyKey& entityLinks,
+    const std::vector<const mdl::EntityNodeBase*>& sourceNodes,
     std::vector<LinkRenderer::LineVertex>& linkVertices)
   {
-    for (const auto& linkEnd : getLinkEnds(entityLinks))
+    for (const auto* sourceNode : sourceNodes)
     {
-      const auto& sourceNode = *linkEnd.node;
-      if (editorContext.visible(sourceNode))
+      if (editorContext.visible(*sourceNode))
       {
-        addLink(sourceNode, targetNode, defaultColor, selectedColor, linkVertices);
-        visit(sourceNode, linkVertices);
+        addLink(*sourceNode, targetNode, defaultColor, selectedColor, linkVertices);
+        visit(*sourceNode, linkVertices);
       }
     }
   }
@@ -171,39 +126,37 @@ struct CollectDirectSelectedLinksVisitor
   {
     if (node.selected() || node.descendantSelected())
     {
-      addLinksFrom(node, entityLinkManager.linksFrom(node), linkVertices);
-      addLinksTo(node, entityLinkManager.linksTo(node), linkVertices);
+      addLinksFrom(node, entityLinkManager.linkTargetNodes(node), linkVertices);
+      addLinksTo(node, entityLinkManager.linkSourceNodes(node), linkVertices);
     }
   }
 
   void addLinksFrom(
     const mdl::EntityNodeBase& sourceNode,
-    const mdl::EntityLinkManager::LinkEndsForPropertyKey& entityLinks,
+    const std::vector<const mdl::EntityNodeBase*>& targetNodes,
     std::vector<LinkRenderer::LineVertex>& linkVertices)
   {
-    for (const auto& linkEnd : getLinkEnds(entityLinks))
+    for (const auto* targetNode : targetNodes)
     {
-      const auto& targetNode = *linkEnd.node;
-      if (editorContext.visible(targetNode))
+      if (editorContext.visible(*targetNode))
       {
-        addLink(sourceNode, targetNode, defaultColor, selectedColor, linkVertices);
+        addLink(sourceNode, *targetNode, defaultColor, selectedColor, linkVertices);
       }
     }
   }
 
   void addLinksTo(
     const mdl::EntityNodeBase& targetNode,
-    const mdl::EntityLinkManager::LinkEndsForPropertyKey& entityLinks,
+    const std::vector<const mdl::EntityNodeBase*>& sourceNodes,
     std::vector<LinkRenderer::LineVertex>& linkVertices)
   {
-    for (const auto& linkEnd : getLinkEnds(entityLinks))
+    for (const auto* sourceNode : sourceNodes)
     {
-      const auto& sourceNode = *linkEnd.node;
       if (
-        !sourceNode.selected() && !sourceNode.descendantSelected()
-        && editorContext.visible(sourceNode))
+        !sourceNode->selected() && !sourceNode->descendantSelected()
+        && editorContext.visible(*sourceNode))
       {
-        addLink(sourceNode, targetNode, defaultColor, selectedColor, linkVertices);
+        addLink(*sourceNode, targetNode, defaultColor, selectedColor, linkVertices);
       }
     }
   }
@@ -232,31 +185,6 @@ auto collectSelectedLinks(const mdl::Selection& selection, Visitor visitor)
   return links;
 }
 
-auto getAllLinks(
-  const mdl::Map& map, const Color& defaultColor, const Color& selectedColor)
-{
-  auto links = std::vector<LinkRenderer::LineVertex>{};
-
-  auto visitor = CollectAllLinksVisitor{
-    map.entityLinkManager(), map.editorContext(), defaultColor, selectedColor};
-
-  map.worldNode().accept(kdl::overload(
-    [](auto&& thisLambda, const mdl::WorldNode& worldNode) {
-      worldNode.visitChildren(thisLambda);
-    },
-    [](auto&& thisLambda, const mdl::LayerNode& layerNode) {
-      layerNode.visitChildren(thisLambda);
-    },
-    [](auto&& thisLambda, const mdl::GroupNode& groupNode) {
-      groupNode.visitChildren(thisLambda);
-    },
-    [&](const mdl::EntityNode& entityNode) { visitor.visit(entityNode, links); },
-    [](const mdl::BrushNode&) {},
-    [](const mdl::PatchNode&) {}));
-
-  return links;
-}
-
 auto getTransitiveSelectedLinks(
   const mdl::Map& map, const Color& defaultColor, const Color& selectedColor)
 {
@@ -276,10 +204,6 @@ auto getDirectSelectedLinks(
 auto getLinks(const mdl::Map& map, const Color& defaultColor, const Color& selectedColor)
 {
   const auto entityLinkMode = pref(Preferences::EntityLinkMode);
-  if (entityLinkMode == Preferences::EntityLinkModeAll)
-  {
-    return getAllLinks(map, defaultColor, selectedColor);
-  }
   if (entityLinkMode == Preferences::EntityLinkModeTransitive)
   {
     return getTransitiveSelectedLinks(map, defaultColor, selectedColor);
@@ -292,6 +216,40 @@ auto getLinks(const mdl::Map& map, const Color& defaultColor, const Color& selec
   return std::vector<LinkRenderer::LineVertex>{};
 }
 
+/**
+ * Collects the entity nodes contained in the given node into `entityNodes`. For brush and
+ * patch nodes, the containing entity node is collected into `containingEntityNodes`.
+ * The world node is never collected because its links are not rendered.
+ */
+void collectEntityNodes(
+  const mdl::Node& node,
+  std::unordered_set<const mdl::EntityNodeBase*>& entityNodes,
+  std::unordered_set<const mdl::EntityNodeBase*>& containingEntityNodes)
+{
+  const auto addContainingEntityNode = [&](const mdl::EntityNodeBase* entityNode) {
+    if (entityNode && entityNode->parent())
+    {
+      containingEntityNodes.insert(entityNode);
+    }
+  };
+
+  node.accept(kdl::overload(
+    [](auto&& thisLambda, const mdl::WorldNode& worldNode) {
+      worldNode.visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, const mdl::LayerNode& layerNode) {
+      layerNode.visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, const mdl::GroupNode& groupNode) {
+      groupNode.visitChildren(thisLambda);
+    },
+    [&](const mdl::EntityNode& entityNode) { entityNodes.insert(&entityNode); },
+    [&](const mdl::BrushNode& brushNode) { addContainingEntityNode(brushNode.entity()); },
+    [&](const mdl::PatchNode& patchNode) {
+      addContainingEntityNode(patchNode.entity());
+    }));
+}
+
 } // namespace
 
 EntityLinkRenderer::EntityLinkRenderer(mdl::Map& map)
@@ -317,9 +275,181 @@ void EntityLinkRenderer::setSelectedColor(const Color& selectedColor)
   }
 }
 
+void EntityLinkRenderer::invalidateNodes(const std::vector<mdl::Node*>& nodes)
+{
+  if (!showAllLinks())
+  {
+    invalidate();
+    return;
+  }
+
+  for (const auto* node : nodes)
+  {
+    collectEntityNodes(*node, m_invalidNodes, m_invalidNodes);
+  }
+}
+
+void EntityLinkRenderer::removeNodes(const std::vector<mdl::Node*>& nodes)
+{
+  if (!showAllLinks())
+  {
+    invalidate();
+    return;
+  }
+
+  auto removedNodes = EntityNodeSet{};
+  auto changedNodes = EntityNodeSet{};
+  for (const auto* node : nodes)
+  {
+    collectEntityNodes(*node, removedNodes, changedNodes);
+  }
+
+  for (const auto* removedNode : removedNodes)
+  {
+    removeLinksFrom(*removedNode);
+
+    // the links to the removed node are rebuilt from their source nodes
+    if (const auto iSources = m_renderedSources.find(removedNode);
+        iSources != m_renderedSources.end())
+    {
+      m_invalidNodes.insert(iSources->second.begin(), iSources->second.end());
+      m_renderedSources.erase(iSources);
+    }
+  }
+
+  m_invalidNodes.insert(changedNodes.begin(), changedNodes.end());
+  for (const auto* removedNode : removedNodes)
+  {
+    m_invalidNodes.erase(removedNode);
+  }
+}
+
+void EntityLinkRenderer::updateLinks(const bool rebuild)
+{
+  if (rebuild)
+  {
+    clearRenderedLinks();
+
+    if (!showAllLinks())
+    {
+      LinkRenderer::updateLinks(rebuild);
+      return;
+    }
+
+    m_map.worldNode().accept(kdl::overload(
+      [](auto&& thisLambda, const mdl::WorldNode& worldNode) {
+        worldNode.visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const mdl::LayerNode& layerNode) {
+        layerNode.visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const mdl::GroupNode& groupNode) {
+        groupNode.visitChildren(thisLambda);
+      },
+      [&](const mdl::EntityNode& entityNode) { updateLinksFrom(entityNode); },
+      [](const mdl::BrushNode&) {},
+      [](const mdl::PatchNode&) {}));
+  }
+  else if (!m_invalidNodes.empty())
+  {
+    // A node affects the links from itself and the links to itself. The latter include
+    // the links that are currently rendered as well as the links that may have become
+    // visible or have been created.
+    const auto& entityLinkManager = m_map.entityLinkManager();
+
+    auto sourceNodes = EntityNodeSet{};
+    for (const auto* invalidNode : m_invalidNodes)
+    {
+      sourceNodes.insert(invalidNode);
+      if (const auto iSources = m_renderedSources.find(invalidNode);
+          iSources != m_renderedSources.end())
+      {
+        sourceNodes.insert(iSources->second.begin(), iSources->second.end());
+      }
+      for (const auto* sourceNode : entityLinkManager.linkSourceNodes(*invalidNode))
+      {
+        sourceNodes.insert(sourceNode);
+      }
+    }
+    m_invalidNodes.clear();
+
+    for (const auto* sourceNode : sourceNodes)
+    {
+      updateLinksFrom(*sourceNode);
+    }
+  }
+}
+
 std::vector<LinkRenderer::LineVertex> EntityLinkRenderer::getLinks()
 {
   return render::getLinks(m_map, m_defaultColor, m_selectedColor);
 }
 
+bool EntityLinkRenderer::showAllLinks() const
+{
+  return pref(Preferences::EntityLinkMode) == Preferences::EntityLinkModeAll;
+}
+
+void EntityLinkRenderer::clearRenderedLinks()
+{
+  m_renderedTargets.clear();
+  m_renderedSources.clear();
+  m_invalidNodes.clear();
+}
+
+void EntityLinkRenderer::updateLinksFrom(const mdl::EntityNodeBase& sourceNode)
+{
+  removeLinksFrom(sourceNode);
+
+  const auto& editorContext = m_map.editorContext();
+  if (&sourceNode == &m_map.worldNode() || !editorContext.visible(sourceNode))
+  {
+    return;
+  }
+
+  auto links = std::vector<LinkRenderer::LineVertex>{};
+  auto targetNodes = std::vector<const mdl::EntityNodeBase*>{};
+  for (const auto* targetNode : m_map.entityLinkManager().linkTargetNodes(sourceNode))
+  {
+    if (editorContext.visible(*targetNode))
+    {
+      addLink(sourceNode, *targetNode, m_defaultColor, m_selectedColor, links);
+      targetNodes.push_back(targetNode);
+    }
+  }
+
+  if (!targetNodes.empty())
+  {
+    for (const auto* targetNode : targetNodes)
+    {
+      m_renderedSources[targetNode].insert(&sourceNode);
+    }
+    m_renderedTargets[&sourceNode] = std::move(targetNodes);
+    setLinks(&sourceNode, links);
+  }
+}
+
+void EntityLinkRenderer::removeLinksFrom(const mdl::EntityNodeBase& sourceNode)
+{
+  if (const auto iTargets = m_renderedTargets.find(&sourceNode);
+      iTargets != m_renderedTargets.end())
+  {
+    for (const auto* targetNode : iTargets->second)
+    {
+      if (const auto iSources = m_renderedSources.find(targetNode);
+          iSources != m_renderedSources.end())
+      {
+        iSources->second.erase(&sourceNode);
+        if (iSources->second.empty())
+        {
+          m_renderedSources.erase(iSources);
+        }
+      }
+    }
+    m_renderedTargets.erase(iTargets);
+  }
+
+  removeLinks(&sourceNode);
+}
+
 } // namespace tb::render
@@ -24,6 +24,7 @@
 #include "gl/GlInterface.h"
 #include "gl/PrimType.h"
 #include "gl/Shaders.h"
+#include "render/LinkVertexArray.h"
 #include "render/RenderBatch.h"
 #include "render/RenderContext.h"
 
@@ -32,7 +33,13 @@
 namespace tb::render
 {
 
-LinkRenderer::LinkRenderer() = default;
+LinkRenderer::LinkRenderer()
+  : m_lines{std::make_unique<LinkVertexArray<LineVertex>>()}
+  , m_arrows{std::make_unique<LinkVertexArray<ArrowVertex>>()}
+{
+}
+
+LinkRenderer::~LinkRenderer() = default;
 
 void LinkRenderer::render(RenderContext&, RenderBatch& renderBatch)
 {
@@ -44,15 +51,17 @@ void LinkRenderer::invalidate()
   m_valid = false;
 }
 
+std::vector<LinkRenderer::LineVertex> LinkRenderer::links() const
+{
+  return m_lines->vertices();
+}
+
 void LinkRenderer::prepare(gl::Gl& gl, gl::VboManager& vboManager)
 {
-  if (!m_valid)
-  {
-    validate();
+  validate();
 
-    m_lines.prepare(gl, vboManager);
-    m_arrows.prepare(gl, vboManager);
-  }
+  m_lines->prepare(gl, vboManager);
+  m_arrows->prepare(gl, vboManager);
 }
 
 void LinkRenderer::render(RenderContext& renderContext)
@@ -74,17 +83,17 @@ void LinkRenderer::renderLines(RenderContext& renderContext)
   shader.set("MaxDistance", 6000.0f);
 
 
-  if (m_lines.setup(gl, shader.program()))
+  if (m_lines->setup(gl, shader.program()))
   {
     gl.disable(GL_DEPTH_TEST);
     shader.set("Alpha", 0.4f);
-    m_lines.render(gl, gl::PrimType::Lines);
+    m_lines->render(gl, gl::PrimType::Lines);
 
     gl.enable(GL_DEPTH_TEST);
     shader.set("Alpha", 1.0f);
-    m_lines.render(gl, gl::PrimType::Lines);
+    m_lines->render(gl, gl::PrimType::Lines);
 
-    m_lines.cleanup(gl, shader.program());
+    m_lines->cleanup(gl, shader.program());
   }
 }
 
@@ -99,16 +108,16 @@ void LinkRenderer::renderArrows(RenderContext& renderContext)
   shader.set("MaxDistance", 6000.0f);
   shader.set("Zoom", renderContext.camera().zoom());
 
-  if (m_arrows.setup(gl, shader.program()))
+  if (m_arrows->setup(gl, shader.program()))
   {
     gl.disable(GL_DEPTH_TEST);
     shader.set("Alpha", 0.4f);
-    m_arrows.render(gl, gl::PrimType::Quads);
+    m_arrows->render(gl, gl::PrimType::Quads);
 
     gl.enable(GL_DEPTH_TEST);
     shader.set("Alpha", 1.0f);
-    m_arrows.render(gl, gl::PrimType::Lines);
-    m_arrows.cleanup(gl, shader.program());
+    m_arrows->render(gl, gl::PrimType::Lines);
+    m_arrows->cleanup(gl, shader.program());
   }
 }
 
@@ -169,15 +178,68 @@ static std::vector<LinkRenderer::ArrowVertex> getArrows(
   return arrows;
 }
 
+void LinkRenderer::setLinks(const void* key, const std::vector<LineVertex>& links)
+{
+  removeLinks(key);
+
+  if (!links.empty())
+  {
+    const auto arrows = getArrows(links);
+    m_linkBlocks[key] = LinkBlocks{
+      m_lines->insertVertices(links),
+      m_arrows->insertVertices(arrows),
+    };
+  }
+}
+
+void LinkRenderer::removeLinks(const void* key)
+{
+  if (const auto iBlocks = m_linkBlocks.find(key); iBlocks != m_linkBlocks.end())
+  {
+    m_lines->removeVertices(iBlocks->second.lines);
+    m_arrows->removeVertices(iBlocks->second.arrows);
+    m_linkBlocks.erase(iBlocks);
+  }
+}
+
 void LinkRenderer::validate()
 {
-  auto links = getLinks();
-  auto arrows = getArrows(links);
+  if (!m_valid)
+  {
+    rebuildLinks();
+    m_valid = true;
+  }
+  else
+  {
+    updateLinks(false);
+
+    // the arrays never shrink, so rebuild them once most of their space is unused
+    if (m_lines->isFragmented() || m_arrows->isFragmented())
+    {
+      rebuildLinks();
+    }
+  }
+}
+
+void LinkRenderer::rebuildLinks()
+{
+  removeAllLinks();
+  updateLinks(true);
+}
 
-  m_lines = gl::VertexArray::move(std::move(links));
-  m_arrows = gl::VertexArray::move(std::move(arrows));
+void LinkRenderer::removeAllLinks()
+{
+  m_linkBlocks.clear();
+  m_lines = std::make_unique<LinkVertexArray<LineVertex>>();
+  m_arrows = std::make_unique<LinkVertexArray<ArrowVertex>>();
+}
 
-  m_valid = true;
+void LinkRenderer::updateLinks(const bool rebuild)
+{
+  if (rebuild)
+  {
+    setLinks(this, getLinks());
+  }
 }
 
 } // namespace tb::render
@@ -35,6 +35,7 @@
 #include "mdl/LayerNode.h"
 #include "mdl/Map.h"
 #include "mdl/Node.h"
+#include "mdl/NodeChanges.h"
 #include "mdl/NodeQueries.h"
 #include "mdl/PatchNode.h"
 #include "mdl/SelectionChange.h"
@@ -49,6 +50,7 @@
 
 #include "kd/overload.h"
 #include "kd/path_utils.h"
+#include "kd/vector_utils.h"
 
 #include <vector>
 
@@ -649,15 +651,11 @@ void MapRenderer::reloadEntityModels()
 void MapRenderer::connectObservers()
 {
   m_notifierConnection +=
-    m_map.nodesWereAddedNotifier.connect(this, &MapRenderer::nodesWereAdded);
+    m_map.nodeChangesNotifier.connect(this, &MapRenderer::nodeChangesDidOccur);
   m_notifierConnection +=
-    m_map.nodesWereRemovedNotifier.connect(this, &MapRenderer::nodesWereRemoved);
-  m_notifierConnection +=
-    m_map.nodesDidChangeNotifier.connect(this, &MapRenderer::nodesDidChange);
-  m_notifierConnection += m_map.nodeVisibilityDidChangeNotifier.connect(
-    this, &MapRenderer::nodeVisibilityDidChange);
+    m_map.nodesWillBeRemovedNotifier.connect(this, &MapRenderer::nodesWillBeRemoved);
   m_notifierConnection +=
-    m_map.nodeLockingDidChangeNotifier.connect(this, &MapRenderer::nodeLockingDidChange);
+    m_map.nodesWereRemovedNotifier.connect(this, &MapRenderer::nodesWereRemoved);
   m_notifierConnection +=
     m_map.groupWasOpenedNotifier.connect(this, &MapRenderer::groupWasOpened);
   m_notifierConnection +=
@@ -681,82 +679,83 @@ void MapRenderer::connectObservers()
     prefs.preferenceDidChangeNotifier.connect(this, &MapRenderer::preferenceDidChange);
 }
 
-void MapRenderer::nodesWereAdded(const std::vector<mdl::Node*>& nodes)
+void MapRenderer::nodeChangesDidOccur(const mdl::NodeChanges& nodeChanges)
 {
-  for (auto* node : nodes)
+  for (auto* node : nodeChanges.addedNodes)
   {
     // The nodes passed in don't include recursive children, so we need to visit them
     // ourselves.
     updateAndInvalidateNodeRecursive(*node);
   }
-  invalidateGroupLinkRenderer();
-  invalidateEntityLinkRenderer();
-}
 
-void MapRenderer::nodesWereRemoved(const std::vector<mdl::Node*>& nodes)
-{
-  for (auto* node : nodes)
-  {
-    // The nodes passed in don't include recursive children, so we need to visit them
-    // ourselves. Otherwise deleting a group doesn't delete the brushes within.
-    removeNodeRecursive(*node);
-  }
-  invalidateGroupLinkRenderer();
-  invalidateEntityLinkRenderer();
-}
-
-void MapRenderer::nodesDidChange(const std::vector<mdl::Node*>& nodes)
-{
-  for (auto* node : mdl::collectNodesAndAncestors(nodes))
+  for (auto* node : mdl::collectNodesAndAncestors(nodeChanges.changedNodes))
   {
     // We update the ancestors along with the nodes, i.e. the world node. So, don't update
     // recursively here as it would cause the entire map to be invalidated on every
     // change.
     updateAndInvalidateNode(*node);
   }
-  invalidateEntityLinkRenderer();
-  invalidateGroupLinkRenderer();
-}
 
-void MapRenderer::nodeVisibilityDidChange(const std::vector<mdl::Node*>& nodes)
-{
-  for (auto* node : nodes)
+  for (auto* node : kdl::vec_concat(
+         nodeChanges.visibilityChangedNodes, nodeChanges.lockingChangedNodes))
   {
     updateAndInvalidateNodeRecursive(*node);
   }
-  invalidateEntityLinkRenderer();
+
+  // entity links don't depend on locking
+  m_entityLinkRenderer->invalidateNodes(kdl::vec_concat(
+    nodeChanges.addedNodes,
+    nodeChanges.changedNodes,
+    nodeChanges.visibilityChangedNodes));
+
+  if (!nodeChanges.addedNodes.empty() || !nodeChanges.changedNodes.empty())
+  {
+    invalidateGroupLinkRenderer();
+  }
+}
+
+void MapRenderer::nodesWillBeRemoved(const std::vector<mdl::Node*>& nodes)
+{
+  // The entity link renderer must forget the removed nodes while they are still attached
+  // to their parents.
+  m_entityLinkRenderer->removeNodes(nodes);
 }
 
-void MapRenderer::nodeLockingDidChange(const std::vector<mdl::Node*>& nodes)
+void MapRenderer::nodesWereRemoved(const std::vector<mdl::Node*>& nodes)
 {
   for (auto* node : nodes)
   {
-    updateAndInvalidateNodeRecursive(*node);
+    // The nodes passed in don't include recursive children, so we need to visit them
+    // ourselves. Otherwise deleting a group doesn't delete the brushes within.
+    removeNodeRecursive(*node);
   }
-  invalidateEntityLinkRenderer();
+  invalidateGroupLinkRenderer();
 }
 
 void MapRenderer::groupWasOpened()
 {
   invalidateGroupLinkRenderer();
-  invalidateEntityLinkRenderer();
 }
 
 void MapRenderer::groupWasClosed()
 {
   invalidateGroupLinkRenderer();
-  invalidateEntityLinkRenderer();
 }
 
 void MapRenderer::selectionDidChange(const mdl::SelectionChange& selectionChange)
 {
+  auto entityLinkNodes =
+    kdl::vec_concat(selectionChange.deselectedNodes, selectionChange.selectedNodes);
+
   for (const auto& face : selectionChange.deselectedBrushFaces)
   {
     updateAndInvalidateNode(*face.node());
+    entityLinkNodes.push_back(face.node());
   }
   for (const auto& face : selectionChange.selectedBrushFaces)
   {
     updateAndInvalidateNode(*face.node());
+    entityLinkNodes.push_back(face.node());
   }
   // These need to be recursive otherwise selecting a Group doesn't render the contents
   // selected
@@ -769,7 +768,7 @@ void MapRenderer::selectionDidChange(const mdl::SelectionChange& selectionChange
     updateAndInvalidateNodeRecursive(*node);
   }
 
-  invalidateEntityLinkRenderer();
+  m_entityLinkRenderer->invalidateNodes(entityLinkNodes);
   invalidateGroupLinkRenderer();
 }
 
@@ -778,9 +777,10 @@ void MapRenderer::resourcesWereProcessed(const std::vector<gl::ResourceId>& reso
   const auto& materialManager = m_map.materialManager();
   const auto materials = materialManager.findMaterialsByTextureResourceId(resourceIds);
 
-  m_defaultRenderer->invalidateMaterials(materials);
-  m_selectionRenderer->invalidateMaterials(materials);
-  m_lockedRenderer->invalidateMaterials(materials);
+  const auto& materialIndex = m_map.materialIndex();
+  m_defaultRenderer->invalidateMaterials(materials, materialIndex);
+  m_selectionRenderer->invalidateMaterials(materials, materialIndex);
+  m_lockedRenderer->invalidateMaterials(materials, materialIndex);
 
   const auto& entityModelManager = m_map.entityModelManager();
   const auto entityModels =
@@ -49,9 +49,10 @@ void ObjectRenderer::removeNode(mdl::Node& node)
 }
 
 void ObjectRenderer::invalidateMaterials(
-  const std::vector<const gl::Material*>& materials)
+  const std::vector<const gl::Material*>& materials,
+  const mdl::MaterialIndex& materialIndex)
 {
-  m_brushRenderer.invalidateMaterials(materials);
+  m_brushRenderer.invalidateMaterials(materials, materialIndex);
   m_patchRenderer.invalidate();
 }
 
@@ -44,6 +44,8 @@
 #include "vm/vec.h"
 
 #include <ranges>
+#include <tuple>
+#include <vector>
 
 namespace tb::render
 {
@@ -153,26 +155,41 @@ void PatchRenderer::render(RenderContext& renderContext, RenderBatch& renderBatc
   }
 }
 
-static gl::MaterialIndexArrayRenderer buildMeshRenderer(
+using RenderGrid = std::tuple<const mdl::PatchNode*, mdl::PatchGrid>;
+
+static std::vector<RenderGrid> computeRenderGrids(
   const std::vector<const mdl::PatchNode*>& patchNodes,
   const mdl::EditorContext& editorContext)
 {
-  size_t vertexCount = 0u;
-  auto indexArrayMapSize = gl::MaterialIndexArrayMap::Size{};
+  auto result = std::vector<RenderGrid>{};
+  result.reserve(patchNodes.size());
 
   for (const auto* patchNode : patchNodes)
   {
     if (editorContext.visible(*patchNode))
     {
-      vertexCount += patchNode->grid().pointRowCount * patchNode->grid().pointColumnCount;
-
-      const auto* material = patchNode->patch().material();
-      const auto quadCount =
-        patchNode->grid().quadRowCount() * patchNode->grid().quadColumnCount();
-      indexArrayMapSize.inc(material, gl::PrimType::Triangles, 6u * quadCount);
+      result.emplace_back(patchNode, patchNode->renderGrid());
     }
   }
 
+  return result;
+}
+
+static gl::MaterialIndexArrayRenderer buildMeshRenderer(
+  const std::vector<RenderGrid>& renderGrids)
+{
+  size_t vertexCount = 0u;
+  auto indexArrayMapSize = gl::MaterialIndexArrayMap::Size{};
+
+  for (const auto& [patchNode, grid] : renderGrids)
+  {
+    vertexCount += grid.pointRowCount * grid.pointColumnCount;
+
+    const auto* material = patchNode->patch().material();
+    const auto quadCount = grid.quadRowCount() * grid.quadColumnCount();
+    indexArrayMapSize.inc(material, gl::PrimType::Triangles, 6u * quadCount);
+  }
+
   using Vertex = gl::VertexTypes::P3NT2::Vertex;
   auto vertices = std::vector<Vertex>{};
   vertices.reserve(vertexCount);
@@ -180,44 +197,40 @@ static gl::MaterialIndexArrayRenderer buildMeshRenderer(
   auto indexArrayMapBuilder = gl::MaterialIndexArrayMapBuilder{indexArrayMapSize};
   using Index = gl::MaterialIndexArrayMapBuilder::Index;
 
-  for (const auto* patchNode : patchNodes)
+  for (const auto& [patchNode, grid] : renderGrids)
   {
-    if (editorContext.visible(*patchNode))
-    {
-      const auto vertexOffset = vertices.size();
+    const auto vertexOffset = vertices.size();
 
-      const auto& grid = patchNode->grid();
-      auto gridVertices =
-        grid.points | std::views::transform([](const auto& p) {
-          return Vertex{
-            vm::vec3f{p.position}, vm::vec3f{p.normal}, vm::vec2f{p.uvCoords}};
-        })
-        | kdl::ranges::to<std::vector>();
-      vertices = kdl::vec_concat(std::move(vertices), std::move(gridVertices));
+    auto gridVertices =
+      grid.points | std::views::transform([](const auto& p) {
+        return Vertex{
+          vm::vec3f{p.position}, vm::vec3f{p.normal}, vm::vec2f{p.uvCoords}};
+      })
+      | kdl::ranges::to<std::vector>();
+    vertices = kdl::vec_concat(std::move(vertices), std::move(gridVertices));
 
-      const auto* material = patchNode->patch().material();
+    const auto* material = patchNode->patch().material();
 
-      const auto pointsPerRow = grid.pointColumnCount;
-      for (size_t row = 0u; row < grid.quadRowCount(); ++row)
+    const auto pointsPerRow = grid.pointColumnCount;
+    for (size_t row = 0u; row < grid.quadRowCount(); ++row)
+    {
+      for (size_t col = 0u; col < grid.quadColumnCount(); ++col)
       {
-        for (size_t col = 0u; col < grid.quadColumnCount(); ++col)
-        {
-          const auto i0 = vertexOffset + row * pointsPerRow + col;
-          const auto i1 = vertexOffset + row * pointsPerRow + col + 1u;
-          const auto i2 = vertexOffset + (row + 1u) * pointsPerRow + col + 1u;
-          const auto i3 = vertexOffset + (row + 1u) * pointsPerRow + col;
-
-          indexArrayMapBuilder.addTriangle(
-            material,
-            static_cast<Index>(i0),
-            static_cast<Index>(i1),
-            static_cast<Index>(i2));
-          indexArrayMapBuilder.addTriangle(
-            material,
-            static_cast<Index>(i2),
-            static_cast<Index>(i3),
-            static_cast<Index>(i0));
-        }
+        const auto i0 = vertexOffset + row * pointsPerRow + col;
+        const auto i1 = vertexOffset + row * pointsPerRow + col + 1u;
+        const auto i2 = vertexOffset + (row + 1u) * pointsPerRow + col + 1u;
+        const auto i3 = vertexOffset + (row + 1u) * pointsPerRow + col;
+
+        indexArrayMapBuilder.addTriangle(
+          material,
+          static_cast<Index>(i0),
+          static_cast<Index>(i1),
+          static_cast<Index>(i2));
+        indexArrayMapBuilder.addTriangle(
+          material,
+          static_cast<Index>(i2),
+          static_cast<Index>(i3),
+          static_cast<Index>(i0));
       }
     }
   }
@@ -230,72 +243,61 @@ static gl::MaterialIndexArrayRenderer buildMeshRenderer(
     std::move(indexArrayMapBuilder.ranges())};
 }
 
-static DirectEdgeRenderer buildEdgeRenderer(
-  const std::vector<const mdl::PatchNode*>& patchNodes,
-  const mdl::EditorContext& editorContext)
+static DirectEdgeRenderer buildEdgeRenderer(const std::vector<RenderGrid>& renderGrids)
 {
   size_t vertexCount = 0u;
   auto indexRangeMapSize = gl::IndexRangeMap::Size{};
 
-  for (const auto* patchNode : patchNodes)
+  for (const auto& [patchNode, grid] : renderGrids)
   {
-    if (editorContext.visible(*patchNode))
-    {
-      vertexCount +=
-        (patchNode->grid().pointRowCount + patchNode->grid().pointColumnCount - 2u) * 2u;
-      indexRangeMapSize.inc(gl::PrimType::LineLoop, vertexCount);
-    }
+    vertexCount += (grid.pointRowCount + grid.pointColumnCount - 2u) * 2u;
+    indexRangeMapSize.inc(gl::PrimType::LineLoop, vertexCount);
   }
 
   auto indexRangeMapBuilder =
     gl::IndexRangeMapBuilder<gl::VertexTypes::P3>{vertexCount, indexRangeMapSize};
 
-  for (const auto* patchNode : patchNodes)
+  for (const auto& [patchNode, grid] : renderGrids)
   {
-    if (editorContext.visible(*patchNode))
-    {
-      const auto& grid = patchNode->grid();
-
-      auto edgeLoopVertices = std::vector<gl::VertexTypes::P3::Vertex>{};
-      edgeLoopVertices.reserve((grid.pointRowCount + grid.pointColumnCount - 2u) * 2u);
+    auto edgeLoopVertices = std::vector<gl::VertexTypes::P3::Vertex>{};
+    edgeLoopVertices.reserve((grid.pointRowCount + grid.pointColumnCount - 2u) * 2u);
 
-      // walk around the patch to collect the edge vertices
-      // for each side, collect the first vertex up to but not including the last vertex
+    // walk around the patch to collect the edge vertices
+    // for each side, collect the first vertex up to but not including the last vertex
 
-      const auto t = 0u;
-      const auto b = grid.pointRowCount - 1u;
-      const auto l = 0u;
-      const auto r = grid.pointColumnCount - 1u;
+    const auto t = 0u;
+    const auto b = grid.pointRowCount - 1u;
+    const auto l = 0u;
+    const auto r = grid.pointColumnCount - 1u;
 
-      auto row = t;
-      auto col = l;
+    auto row = t;
+    auto col = l;
 
-      while (col < r)
-      {
-        edgeLoopVertices.emplace_back(vm::vec3f{grid.point(row, col++).position});
-      }
-      contract_assert(row == t && col == r);
-
-      while (row < b)
-      {
-        edgeLoopVertices.emplace_back(vm::vec3f{grid.point(row++, col).position});
-      }
-      contract_assert(row == b && col == r);
+    while (col < r)
+    {
+      edgeLoopVertices.emplace_back(vm::vec3f{grid.point(row, col++).position});
+    }
+    contract_assert(row == t && col == r);
 
-      while (col > l)
-      {
-        edgeLoopVertices.emplace_back(vm::vec3f{grid.point(row, col--).position});
-      }
-      contract_assert(row == b && col == l);
+    while (row < b)
+    {
+      edgeLoopVertices.emplace_back(vm::vec3f{grid.point(row++, col).position});
+    }
+    contract_assert(row == b && col == r);
 
-      while (row > t)
-      {
-        edgeLoopVertices.emplace_back(vm::vec3f{grid.point(row--, col).position});
-      }
-      contract_assert(row == t && col == l);
+    while (col > l)
+    {
+      edgeLoopVertices.emplace_back(vm::vec3f{grid.point(row, col--).position});
+    }
+    contract_assert(row == b && col == l);
 
-      indexRangeMapBuilder.addLineLoop(edgeLoopVertices);
+    while (row > t)
+    {
+      edgeLoopVertices.emplace_back(vm::vec3f{grid.point(row--, col).position});
     }
+    contract_assert(row == t && col == l);
+
+    indexRangeMapBuilder.addLineLoop(edgeLoopVertices);
   }
 
   auto vertexArray = gl::VertexArray::move(std::move(indexRangeMapBuilder.vertices()));
@@ -307,8 +309,9 @@ void PatchRenderer::validate()
 {
   if (!m_valid)
   {
-    m_patchMeshRenderer = buildMeshRenderer(m_patchNodes.get_data(), m_editorContext);
-    m_edgeRenderer = buildEdgeRenderer(m_patchNodes.get_data(), m_editorContext);
+    const auto renderGrids = computeRenderGrids(m_patchNodes.get_data(), m_editorContext);
+    m_patchMeshRenderer = buildMeshRenderer(renderGrids);
+    m_edgeRenderer = buildEdgeRenderer(renderGrids);
 
     m_valid = true;
   }
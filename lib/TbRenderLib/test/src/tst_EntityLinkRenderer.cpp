@@ -0,0 +1,278 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NotifierConnection.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
+#include "TestPreferenceStore.h"
+#include "gl/TestGl.h"
+#include "gl/VboManager.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityDefinitionManager.h"
+#include "mdl/EntityNode.h"
+#include "mdl/Map.h"
+#include "mdl/MapFixture.h"
+#include "mdl/Map_Entities.h"
+#include "mdl/Map_Geometry.h"
+#include "mdl/Map_NodeVisibility.h"
+#include "mdl/Map_Nodes.h"
+#include "mdl/Map_Selection.h"
+#include "mdl/NodeChanges.h"
+#include "mdl/SelectionChange.h"
+#include "render/EntityLinkRenderer.h"
+
+#include "kd/vector_utils.h"
+
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace tb::render
+{
+namespace
+{
+
+using Link = std::pair<vm::vec3f, vm::vec3f>;
+
+struct PreferenceManagerGuard
+{
+  PreferenceManagerGuard()
+  {
+    PreferenceManager::createInstance(std::make_unique<TestPreferenceStore>(), true);
+  }
+
+  ~PreferenceManagerGuard() { PreferenceManager::destroyInstance(); }
+};
+
+struct TestVboManager
+{
+  gl::TestGl gl;
+  gl::VboManager vboManager;
+
+  ~TestVboManager() { vboManager.destroyPendingVbos(gl); }
+};
+
+Link makeLink(const mdl::EntityNode& sourceNode, const mdl::EntityNode& targetNode)
+{
+  return {
+    vm::vec3f{sourceNode.linkSourceAnchor()},
+    vm::vec3f{targetNode.linkTargetAnchor()},
+  };
+}
+
+auto getLinks(EntityLinkRenderer& renderer, TestVboManager& vboManager)
+{
+  static_cast<DirectRenderable&>(renderer).prepare(vboManager.gl, vboManager.vboManager);
+
+  const auto vertices = renderer.links();
+
+  auto result = std::vector<Link>{};
+  for (size_t i = 0; i + 1 < vertices.size(); i += 2)
+  {
+    result.emplace_back(
+      getVertexComponent<0>(vertices[i]), getVertexComponent<0>(vertices[i + 1]));
+  }
+  return kdl::vec_sort(std::move(result));
+}
+
+} // namespace
+
+TEST_CASE("EntityLinkRenderer")
+{
+  using namespace mdl::EntityPropertyKeys;
+
+  const auto preferenceManagerGuard = PreferenceManagerGuard{};
+  setPref(Preferences::EntityLinkMode, std::string{Preferences::EntityLinkModeAll});
+
+  auto fixture = mdl::MapFixture{};
+  auto& map = fixture.create();
+
+  constexpr auto sourceClassname = "source_definition";
+  constexpr auto targetClassname = "target_definition";
+
+  map.entityDefinitionManager().setDefinitions(
+    {{sourceClassname,
+      {},
+      {},
+      {
+        {Target, mdl::PropertyValueTypes::LinkSource{}, {}, {}},
+      }},
+     {targetClassname,
+      {},
+      {},
+      {
+        {Targetname, mdl::PropertyValueTypes::LinkTarget{}, {}, {}},
+      }}});
+
+  auto vboManager = TestVboManager{};
+  auto renderer = EntityLinkRenderer{map};
+
+  // forward the notifications like MapRenderer does
+  auto notifierConnection = NotifierConnection{};
+  notifierConnection +=
+    map.nodeChangesNotifier.connect([&](const mdl::NodeChanges& nodeChanges) {
+      renderer.invalidateNodes(kdl::vec_concat(
+        nodeChanges.addedNodes,
+        nodeChanges.changedNodes,
+        nodeChanges.visibilityChangedNodes));
+    });
+  notifierConnection += map.nodesWillBeRemovedNotifier.connect(
+    [&](const std::vector<mdl::Node*>& nodes) { renderer.removeNodes(nodes); });
+  notifierConnection +=
+    map.selectionDidChangeNotifier.connect([&](const mdl::SelectionChange& change) {
+      renderer.invalidateNodes(
+        kdl::vec_concat(change.deselectedNodes, change.selectedNodes));
+    });
+
+  auto* sourceNode = new mdl::EntityNode{mdl::Entity{{
+    {Classname, sourceClassname},
+    {Target, "some_name"},
+    {Origin, "0 0 0"},
+  }}};
+
+  auto* targetNode = new mdl::EntityNode{mdl::Entity{{
+    {Classname, targetClassname},
+    {Targetname, "some_name"},
+    {Origin, "64 0 0"},
+  }}};
+
+  mdl::addNodes(map, {{mdl::parentForNodes(map), {sourceNode, targetNode}}});
+
+  REQUIRE(
+    getLinks(renderer, vboManager)
+    == std::vector<Link>{makeLink(*sourceNode, *targetNode)});
+
+  SECTION("Adding a source node adds its links")
+  {
+    auto* otherSourceNode = new mdl::EntityNode{mdl::Entity{{
+      {Classname, sourceClassname},
+      {Target, "some_name"},
+      {Origin, "0 64 0"},
+    }}};
+
+    mdl::addNodes(map, {{mdl::parentForNodes(map), {otherSourceNode}}});
+
+    CHECK(
+      getLinks(renderer, vboManager)
+      == kdl::vec_sort(std::vector<Link>{
+        makeLink(*sourceNode, *targetNode),
+        makeLink(*otherSourceNode, *targetNode),
+      }));
+  }
+
+  SECTION("Adding a target node adds the links to it")
+  {
+    auto* otherTargetNode = new mdl::EntityNode{mdl::Entity{{
+      {Classname, targetClassname},
+      {Targetname, "some_name"},
+      {Origin, "0 64 0"},
+    }}};
+
+    mdl::addNodes(map, {{mdl::parentForNodes(map), {otherTargetNode}}});
+
+    CHECK(
+      getLinks(renderer, vboManager)
+      == kdl::vec_sort(std::vector<Link>{
+        makeLink(*sourceNode, *targetNode),
+        makeLink(*sourceNode, *otherTargetNode),
+      }));
+  }
+
+  SECTION("Moving a target node updates the links to it")
+  {
+    mdl::selectNodes(map, {targetNode});
+    REQUIRE(mdl::translateSelection(map, vm::vec3d{0, 0, 32}));
+
+    CHECK(
+      getLinks(renderer, vboManager)
+      == std::vector<Link>{makeLink(*sourceNode, *targetNode)});
+  }
+
+  SECTION("Changing a link property updates the links")
+  {
+    mdl::selectNodes(map, {sourceNode});
+    REQUIRE(mdl::setEntityProperty(map, Target, "some_other_name"));
+
+    CHECK(getLinks(renderer, vboManager).empty());
+
+    REQUIRE(mdl::setEntityProperty(map, Target, "some_name"));
+
+    CHECK(
+      getLinks(renderer, vboManager)
+      == std::vector<Link>{makeLink(*sourceNode, *targetNode)});
+  }
+
+  SECTION("Removing a node removes the links from and to it")
+  {
+    const auto nodeToRemove = GENERATE_COPY(sourceNode, targetNode);
+
+    mdl::removeNodes(map, {nodeToRemove});
+    CHECK(getLinks(renderer, vboManager).empty());
+
+    map.undoCommand();
+    CHECK(
+      getLinks(renderer, vboManager)
+      == std::vector<Link>{makeLink(*sourceNode, *targetNode)});
+  }
+
+  SECTION("Hiding a node removes the links from and to it")
+  {
+    const auto nodeToHide = GENERATE_COPY(sourceNode, targetNode);
+
+    mdl::hideNodes(map, {nodeToHide});
+    CHECK(getLinks(renderer, vboManager).empty());
+
+    mdl::showAllNodes(map);
+    CHECK(
+      getLinks(renderer, vboManager)
+      == std::vector<Link>{makeLink(*sourceNode, *targetNode)});
+  }
+
+  SECTION("Removing most links rebuilds the renderer")
+  {
+    auto nodes = std::vector<mdl::Node*>{};
+    for (size_t i = 0; i < 1024; ++i)
+    {
+      nodes.push_back(new mdl::EntityNode{mdl::Entity{{
+        {Classname, sourceClassname},
+        {Target, "some_name"},
+        {Origin, fmt::format("{} 0 0", 16 * i)},
+      }}});
+    }
+    mdl::addNodes(map, {{mdl::parentForNodes(map), nodes}});
+    REQUIRE(getLinks(renderer, vboManager).size() == 1025u);
+
+    mdl::removeNodes(map, std::vector<mdl::Node*>(nodes.begin(), nodes.begin() + 1000));
+
+    const auto links = getLinks(renderer, vboManager);
+    CHECK(links.size() == 25u);
+
+    renderer.invalidate();
+    CHECK(getLinks(renderer, vboManager) == links);
+  }
+}
+
+} // namespace tb::render
@@ -0,0 +1,150 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gl/VertexType.h"
+#include "render/LinkVertexArray.h"
+
+#include "kd/ranges/to.h"
+
+#include "vm/vec.h"
+
+#include <ranges>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::render
+{
+namespace
+{
+
+using Vertex = gl::VertexTypes::P3::Vertex;
+
+auto makeVertices(const size_t count, const float x)
+{
+  auto result = std::vector<Vertex>{};
+  for (size_t i = 0; i < count; ++i)
+  {
+    result.emplace_back(vm::vec3f{x, float(i), 0});
+  }
+  return result;
+}
+
+auto getPositions(const std::vector<Vertex>& vertices)
+{
+  return vertices
+         | std::views::transform([](const auto& v) { return getVertexComponent<0>(v); })
+         | kdl::ranges::to<std::vector>();
+}
+
+} // namespace
+
+TEST_CASE("LinkVertexArray")
+{
+  auto array = LinkVertexArray<Vertex>{};
+  REQUIRE(array.empty());
+  REQUIRE(array.vertexCount() == 0u);
+  REQUIRE(array.capacity() == 0u);
+
+  SECTION("insertVertices")
+  {
+    auto* block1 = array.insertVertices(makeVertices(2, 1));
+    auto* block2 = array.insertVertices(makeVertices(4, 2));
+
+    CHECK(block1->pos == 0u);
+    CHECK(block1->size == 2u);
+    CHECK(block2->pos == 2u);
+    CHECK(block2->size == 4u);
+
+    CHECK_FALSE(array.empty());
+    CHECK(array.vertexCount() == 6u);
+    CHECK(array.capacity() >= 6u);
+    CHECK(
+      getPositions(array.vertices())
+      == std::vector<vm::vec3f>{
+        {1, 0, 0},
+        {1, 1, 0},
+        {2, 0, 0},
+        {2, 1, 0},
+        {2, 2, 0},
+        {2, 3, 0},
+      });
+  }
+
+  SECTION("removeVertices")
+  {
+    auto* block1 = array.insertVertices(makeVertices(2, 1));
+    auto* block2 = array.insertVertices(makeVertices(2, 2));
+    const auto capacity = array.capacity();
+
+    array.removeVertices(block1);
+    CHECK(array.vertexCount() == 2u);
+    CHECK(array.capacity() == capacity);
+    CHECK(
+      getPositions(array.vertices()) == std::vector<vm::vec3f>{{2, 0, 0}, {2, 1, 0}});
+
+    SECTION("Removed ranges are reused")
+    {
+      auto* block3 = array.insertVertices(makeVertices(2, 3));
+      CHECK(block3->pos == 0u);
+      CHECK(array.capacity() == capacity);
+      CHECK(
+        getPositions(array.vertices())
+        == std::vector<vm::vec3f>{{3, 0, 0}, {3, 1, 0}, {2, 0, 0}, {2, 1, 0}});
+    }
+
+    SECTION("Removing all vertices")
+    {
+      array.removeVertices(block2);
+      CHECK(array.empty());
+      CHECK(array.vertexCount() == 0u);
+      CHECK(array.vertices().empty());
+    }
+  }
+
+  SECTION("isFragmented")
+  {
+    auto blocks = std::vector<AllocationTracker::Block*>{};
+    for (size_t i = 0; i < 1024; ++i)
+    {
+      blocks.push_back(array.insertVertices(makeVertices(8, float(i))));
+    }
+    REQUIRE(array.capacity() >= 8192u);
+    CHECK_FALSE(array.isFragmented());
+
+    const auto capacity = array.capacity();
+    while (4 * array.vertexCount() >= capacity)
+    {
+      array.removeVertices(blocks.back());
+      blocks.pop_back();
+    }
+    CHECK(array.isFragmented());
+
+    SECTION("Small arrays are never fragmented")
+    {
+      auto smallArray = LinkVertexArray<Vertex>{};
+      auto* block = smallArray.insertVertices(makeVertices(64, 1));
+      smallArray.insertVertices(makeVertices(2, 2));
+      smallArray.removeVertices(block);
+      CHECK_FALSE(smallArray.isFragmented());
+    }
+  }
+}
+
+} // namespace tb::render
@@ -52,6 +52,7 @@ class GlManager;
 
 namespace mdl
 {
+class GameAssetContextManager;
 class GameManager;
 struct EnvironmentConfig;
 } // namespace mdl
@@ -71,6 +72,7 @@ private:
   std::unique_ptr<kdl::task_manager> m_taskManager;
   std::unique_ptr<mdl::EnvironmentConfig> m_environmentConfig;
   std::unique_ptr<mdl::GameManager> m_gameManager;
+  std::unique_ptr<mdl::GameAssetContextManager> m_gameAssetContextManager;
 
   std::unique_ptr<gl::GlManager> m_glManager;
 
@@ -115,6 +117,8 @@ public:
 
   mdl::GameManager& gameManager();
 
+  mdl::GameAssetContextManager& gameAssetContextManager();
+
   upd::Updater& updater();
 
   MapWindowManager& mapWindowManager();
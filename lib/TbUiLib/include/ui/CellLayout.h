@@ -20,6 +20,7 @@
 #pragma once
 
 #include <any>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -216,6 +217,13 @@ public:
   LayoutBounds bounds() const;
 
   const std::vector<LayoutRow>& rows() const;
+
+  /**
+   * Returns the rows that intersect the given vertical range. Since the rows are ordered
+   * by their vertical position, this is found by binary search.
+   */
+  std::span<const LayoutRow> rowsIntersectingY(float y, float height) const;
+
   size_t indexOfRowAt(float y) const;
   const LayoutCell* cellAt(float x, float y) const;
 
@@ -292,6 +300,14 @@ public:
   void setWidth(float width);
 
   const std::vector<LayoutGroup>& groups();
+
+  /**
+   * Returns the groups that intersect the given vertical range. Together with
+   * LayoutGroup::rowsIntersectingY, this allows visiting only the cells within a visible
+   * rect without iterating over the entire layout.
+   */
+  std::span<const LayoutGroup> groupsIntersectingY(float y, float height);
+
   const LayoutCell* cellAt(float x, float y);
 
   void addGroup(std::string title, float titleHeight);
@@ -24,12 +24,14 @@
 #include "gl/FontDescriptor.h"
 #include "gl/VertexType.h"
 #include "ui/CellView.h"
+#include "ui/TrigramIndex.h"
 
 #include "vm/bbox.h"
 #include "vm/quat.h" // IWYU pragma: keep
 
 #include <optional>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace tb
@@ -97,6 +99,9 @@ private:
   mdl::EntityDefinitionSortOrder m_sortOrder;
   std::string m_filterText;
 
+  std::vector<const mdl::EntityDefinition*> m_indexedDefinitions;
+  TrigramIndex m_definitionNameIndex;
+
   NotifierConnection m_notifierConnection;
 
 public:
@@ -122,13 +127,18 @@ private:
 
   void resourcesWereProcessed(const std::vector<gl::ResourceId>& resources);
 
+  void updateDefinitionNameIndex();
+  std::unordered_set<const mdl::EntityDefinition*> findMatchingDefinitions() const;
+
   void addEntitiesToLayout(
     Layout& layout,
     const std::vector<const mdl::EntityDefinition*>& definitions,
+    const std::unordered_set<const mdl::EntityDefinition*>& matchingDefinitions,
     const gl::FontDescriptor& font);
   void addEntityToLayout(
     Layout& layout,
     const mdl::EntityDefinition& definition,
+    const std::unordered_set<const mdl::EntityDefinition*>& matchingDefinitions,
     const gl::FontDescriptor& font);
 
   void doClear() override;
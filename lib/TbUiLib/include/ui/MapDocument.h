@@ -53,6 +53,7 @@ namespace mdl
 {
 class Autosaver;
 class Command;
+class GameAssetContextManager;
 class Map;
 class Node;
 class PickResult;
@@ -155,6 +156,7 @@ private:
   // pointer so that MapDocument can be moveable
   kdl::task_manager* m_taskManager;
   gl::ResourceManager* m_resourceManager;
+  mdl::GameAssetContextManager* m_assetContextManager;
   std::unique_ptr<LoggingHub> m_loggingHub;
 
   std::unique_ptr<mdl::Map> m_map;
@@ -171,8 +173,10 @@ private:
   NotifierConnection m_notifierConnection;
 
 public:
-  explicit MapDocument(
-    kdl::task_manager& taskManager, gl::ResourceManager& resourceManager);
+  MapDocument(
+    kdl::task_manager& taskManager,
+    gl::ResourceManager& resourceManager,
+    mdl::GameAssetContextManager& assetContextManager);
 
   MapDocument(MapDocument&&) noexcept;
   MapDocument& operator=(MapDocument&&) noexcept;
@@ -183,7 +187,8 @@ public:
     mdl::MapFormat mapFormat,
     const vm::bbox3d& worldBounds,
     kdl::task_manager& taskManager,
-    gl::ResourceManager& resourceManager);
+    gl::ResourceManager& resourceManager,
+    mdl::GameAssetContextManager& assetContextManager);
 
   static Result<std::unique_ptr<MapDocument>> loadDocument(
     const mdl::EnvironmentConfig& environmentConfig,
@@ -192,7 +197,8 @@ public:
     const vm::bbox3d& worldBounds,
     std::filesystem::path path,
     kdl::task_manager& taskManager,
-    gl::ResourceManager& resourceManager);
+    gl::ResourceManager& resourceManager,
+    mdl::GameAssetContextManager& assetContextManager);
 
   ~MapDocument();
 
@@ -22,8 +22,10 @@
 #include "NotifierConnection.h"
 #include "gl/FontDescriptor.h"
 #include "ui/CellView.h"
+#include "ui/TrigramIndex.h"
 
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 class QScrollBar;
@@ -62,6 +64,9 @@ private:
 
   const gl::Material* m_selectedMaterial = nullptr;
 
+  std::vector<const gl::Material*> m_indexedMaterials;
+  TrigramIndex m_materialNameIndex;
+
   NotifierConnection m_notifierConnection;
 
 public:
@@ -96,11 +101,17 @@ private:
 
   std::vector<const gl::MaterialCollection*> getCollections() const;
   std::vector<const gl::Material*> getMaterials(
-    const gl::MaterialCollection& collection) const;
-  std::vector<const gl::Material*> getMaterials() const;
+    const gl::MaterialCollection& collection,
+    const std::unordered_set<const gl::Material*>& matchingMaterials) const;
+  std::vector<const gl::Material*> getMaterials(
+    const std::unordered_set<const gl::Material*>& matchingMaterials) const;
+
+  void updateMaterialNameIndex();
+  std::unordered_set<const gl::Material*> findMatchingMaterials() const;
 
   std::vector<const gl::Material*> filterMaterials(
-    std::vector<const gl::Material*> materials) const;
+    std::vector<const gl::Material*> materials,
+    const std::unordered_set<const gl::Material*>& matchingMaterials) const;
   std::vector<const gl::Material*> sortMaterials(
     std::vector<const gl::Material*> materials) const;
 
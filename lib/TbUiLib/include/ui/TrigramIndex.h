@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::ui
+{
+
+/**
+ * Answers case insensitive substring queries over a fixed list of keys.
+ *
+ * Every key is broken into its trigrams (substrings of length 3), and for every trigram,
+ * the index stores the sorted positions of the keys containing it. A query intersects
+ * the position lists of the pattern's trigrams and only checks the remaining candidates
+ * for an actual match. Patterns shorter than three characters fall back to a linear
+ * scan.
+ *
+ * All queries return positions into the list of keys the index was built from, in
+ * ascending order.
+ */
+class TrigramIndex
+{
+private:
+  std::vector<std::string> m_keys;
+  std::unordered_map<uint32_t, std::vector<size_t>> m_positions;
+
+public:
+  TrigramIndex();
+  explicit TrigramIndex(const std::vector<std::string>& keys);
+
+  size_t size() const;
+
+  /**
+   * Returns the positions of all keys that contain the given pattern.
+   */
+  std::vector<size_t> find(std::string_view pattern) const;
+
+  /**
+   * Returns the positions of all keys that contain at least one of the given patterns.
+   */
+  std::vector<size_t> findAny(const std::vector<std::string>& patterns) const;
+
+  /**
+   * Returns the positions of all keys that contain every one of the given patterns.
+   */
+  std::vector<size_t> findAll(const std::vector<std::string>& patterns) const;
+};
+
+} // namespace tb::ui
@@ -39,6 +39,7 @@
 #include "gl/ResourceManager.h"
 #include "gl/VboManager.h"
 #include "mdl/EnvironmentConfig.h"
+#include "mdl/GameAssetContextManager.h"
 #include "mdl/GameManager.h"
 #include "mdl/MapHeader.h"
 #include "ui/AboutDialog.h"
@@ -164,6 +165,7 @@ AppController::AppController(
   : m_taskManager{std::move(taskManager)}
   , m_environmentConfig{std::move(environmentConfig)}
   , m_gameManager{std::move(gameManager)}
+  , m_gameAssetContextManager{std::make_unique<mdl::GameAssetContextManager>()}
   , m_glManager{std::make_unique<gl::GlManager>(
       [](const auto& path) { return SystemPaths::findResourceFile(path); })}
   , m_networkManager{new QNetworkAccessManager{this}}
@@ -224,6 +226,11 @@ mdl::GameManager& AppController::gameManager()
   return *m_gameManager;
 }
 
+mdl::GameAssetContextManager& AppController::gameAssetContextManager()
+{
+  return *m_gameAssetContextManager;
+}
+
 upd::Updater& AppController::updater()
 {
   return *m_updater;
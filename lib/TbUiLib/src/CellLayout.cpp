@@ -22,6 +22,7 @@
 #include "kd/contracts.h"
 
 #include <algorithm>
+#include <iterator>
 
 namespace tb::ui
 {
@@ -212,24 +213,13 @@ const std::vector<LayoutCell>& LayoutRow::cells() const
 
 const LayoutCell* LayoutRow::cellAt(const float x, const float y) const
 {
-  for (size_t i = 0; i < m_cells.size(); ++i)
+  const auto it = std::ranges::partition_point(
+    m_cells, [&](const auto& cell) { return x > cell.cellBounds().right(); });
+  if (it == m_cells.end() || x < it->cellBounds().left())
   {
-    const auto& cell = m_cells[i];
-    const auto& cellBounds = cell.cellBounds();
-    if (x > cellBounds.right())
-    {
-      continue;
-    }
-    if (x < cellBounds.left())
-    {
-      return nullptr;
-    }
-    if (cell.hitTest(x, y))
-    {
-      return &cell;
-    }
+    return nullptr;
   }
-  return nullptr;
+  return it->hitTest(x, y) ? &*it : nullptr;
 }
 
 bool LayoutRow::intersectsY(const float y, const float height) const
@@ -446,42 +436,34 @@ const std::vector<LayoutRow>& LayoutGroup::rows() const
   return m_rows;
 }
 
-size_t LayoutGroup::indexOfRowAt(const float y) const
+std::span<const LayoutRow> LayoutGroup::rowsIntersectingY(
+  const float y, const float height) const
 {
-  for (size_t i = 0; i < m_rows.size(); ++i)
-  {
-    const auto& row = m_rows[i];
-    const auto& rowBounds = row.bounds();
-    if (y < rowBounds.bottom())
-    {
-      return i;
-    }
-  }
+  const auto first = std::ranges::partition_point(
+    m_rows, [&](const auto& row) { return row.bounds().bottom() < y; });
+  const auto last =
+    std::ranges::partition_point(first, m_rows.end(), [&](const auto& row) {
+      return row.bounds().top() <= y + height;
+    });
+  return {first, last};
+}
 
-  return m_rows.size();
+size_t LayoutGroup::indexOfRowAt(const float y) const
+{
+  const auto it = std::ranges::partition_point(
+    m_rows, [&](const auto& row) { return y >= row.bounds().bottom(); });
+  return size_t(std::distance(m_rows.begin(), it));
 }
 
 const LayoutCell* LayoutGroup::cellAt(const float x, const float y) const
 {
-  for (size_t i = 0; i < m_rows.size(); ++i)
+  const auto it = std::ranges::partition_point(
+    m_rows, [&](const auto& row) { return y > row.bounds().bottom(); });
+  if (it == m_rows.end() || y < it->bounds().top())
   {
-    const auto& row = m_rows[i];
-    const auto& rowBounds = row.bounds();
-    if (y > rowBounds.bottom())
-    {
-      continue;
-    }
-    if (y < rowBounds.top())
-    {
-      return nullptr;
-    }
-    if (const auto* cell = row.cellAt(x, y))
-    {
-      return cell;
-    }
+    return nullptr;
   }
-
-  return nullptr;
+  return it->cellAt(x, y);
 }
 
 bool LayoutGroup::hitTest(const float x, const float y) const
@@ -723,18 +705,10 @@ float CellLayout::rowPosition(const float y, const int offset)
     validate();
   }
 
-  auto groupIndex = m_groups.size();
-  for (size_t i = 0; i < m_groups.size(); ++i)
-  {
-    const LayoutGroup& candidate = m_groups[i];
-    const LayoutBounds groupBounds = candidate.bounds();
-    if (y + m_rowMargin > groupBounds.bottom())
-    {
-      continue;
-    }
-    groupIndex = i;
-    break;
-  }
+  auto groupIndex = size_t(std::distance(
+    m_groups.begin(), std::ranges::partition_point(m_groups, [&](const auto& group) {
+      return y + m_rowMargin > group.bounds().bottom();
+    })));
 
   if (groupIndex == m_groups.size())
   {
@@ -803,32 +777,37 @@ const std::vector<LayoutGroup>& CellLayout::groups()
   return m_groups;
 }
 
-const LayoutCell* CellLayout::cellAt(const float x, const float y)
+std::span<const LayoutGroup> CellLayout::groupsIntersectingY(
+  const float y, const float height)
 {
   if (!m_valid)
   {
     validate();
   }
 
-  for (size_t i = 0; i < m_groups.size(); ++i)
+  const auto first = std::ranges::partition_point(
+    m_groups, [&](const auto& group) { return group.bounds().bottom() < y; });
+  const auto last =
+    std::ranges::partition_point(first, m_groups.end(), [&](const auto& group) {
+      return group.bounds().top() <= y + height;
+    });
+  return {first, last};
+}
+
+const LayoutCell* CellLayout::cellAt(const float x, const float y)
+{
+  if (!m_valid)
   {
-    const auto& group = m_groups[i];
-    const auto groupBounds = group.bounds();
-    if (y > groupBounds.bottom())
-    {
-      continue;
-    }
-    if (y < groupBounds.top())
-    {
-      return nullptr;
-    }
-    if (const auto* cell = group.cellAt(x, y))
-    {
-      return cell;
-    }
+    validate();
   }
 
-  return nullptr;
+  const auto it = std::ranges::partition_point(
+    m_groups, [&](const auto& group) { return y > group.bounds().bottom(); });
+  if (it == m_groups.end() || y < it->bounds().top())
+  {
+    return nullptr;
+  }
+  return it->cellAt(x, y);
 }
 
 void CellLayout::addGroup(std::string title, const float titleHeight)
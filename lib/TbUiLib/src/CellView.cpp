@@ -412,9 +412,9 @@ void CellView::renderTitleBackgrounds(gl::Gl& gl, float y, float height)
   using Vertex = gl::VertexTypes::P2::Vertex;
   auto vertices = std::vector<Vertex>{};
 
-  for (const auto& group : m_layout.groups())
+  for (const auto& group : m_layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height) && !group.title().empty())
+    if (!group.title().empty())
     {
       const auto titleBounds = m_layout.titleBoundsForVisibleRect(group, y, height);
       vertices.emplace_back(
@@ -456,60 +456,52 @@ auto collectStringVertices(
   const auto textColor = pref(Preferences::BrowserTextColor);
 
   auto stringVertices = std::map<gl::FontDescriptor, std::vector<TextVertex>>{};
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    const auto& groupTitle = group.title();
+    if (!groupTitle.empty())
     {
-      const auto& groupTitle = group.title();
-      if (!groupTitle.empty())
+      const auto titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
+      const auto offset = vm::vec2f(
+        titleBounds.left() + 2.0f, height - (titleBounds.top() - y) - titleBounds.height);
+
+      auto& font = fontManager.font(defaultFont);
+      const auto quads = font.quads(groupTitle, false, offset);
+
+      const auto titleVertices = TextVertex::toList(kdl::views::zip(
+        quads | kdl::views::stride(2),
+        quads | std::views::drop(1) | kdl::views::stride(2),
+        kdl::views::repeat(textColor.to<RgbaF>().toVec())));
+
+      auto& vertices = stringVertices[defaultFont];
+      vertices.insert(
+        std::end(vertices), std::begin(titleVertices), std::end(titleVertices));
+    }
+
+    for (const auto& row : group.rowsIntersectingY(y, height))
+    {
+      for (const auto& cell : row.cells())
       {
-        const auto titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
-        const auto offset = vm::vec2f(
-          titleBounds.left() + 2.0f,
-          height - (titleBounds.top() - y) - titleBounds.height);
+        const auto& title = cell.title();
+        const auto bounds = cell.titleBounds();
+        const auto fontDescriptor =
+          fontManager.selectFontSize(defaultFont, title, bounds.width, 6);
+        const auto& font = fontManager.font(fontDescriptor);
+        const auto size = font.measure(title);
+
+        const auto x = bounds.left() + std::max((bounds.width - size.x()) / 2.0f, 0.0f);
 
-        auto& font = fontManager.font(defaultFont);
-        const auto quads = font.quads(groupTitle, false, offset);
+        // y is relative to top, but OpenGL coords are relative to bottom, so invert
+        const auto yOffset = vm::vec2f{x, y + height - bounds.bottom()};
 
-        const auto titleVertices = TextVertex::toList(kdl::views::zip(
+        const auto quads = font.quads(title, false, yOffset);
+        const auto vertices = TextVertex::toList(kdl::views::zip(
           quads | kdl::views::stride(2),
           quads | std::views::drop(1) | kdl::views::stride(2),
           kdl::views::repeat(textColor.to<RgbaF>().toVec())));
 
-        auto& vertices = stringVertices[defaultFont];
-        vertices.insert(
-          std::end(vertices), std::begin(titleVertices), std::end(titleVertices));
-      }
-
-      for (const auto& row : group.rows())
-      {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const auto& title = cell.title();
-            const auto bounds = cell.titleBounds();
-            const auto fontDescriptor =
-              fontManager.selectFontSize(defaultFont, title, bounds.width, 6);
-            const auto& font = fontManager.font(fontDescriptor);
-            const auto size = font.measure(title);
-
-            const auto x =
-              bounds.left() + std::max((bounds.width - size.x()) / 2.0f, 0.0f);
-
-            // y is relative to top, but OpenGL coords are relative to bottom, so invert
-            const auto yOffset = vm::vec2f{x, y + height - bounds.bottom()};
-
-            const auto quads = font.quads(title, false, yOffset);
-            const auto vertices = TextVertex::toList(kdl::views::zip(
-              quads | kdl::views::stride(2),
-              quads | std::views::drop(1) | kdl::views::stride(2),
-              kdl::views::repeat(textColor.to<RgbaF>().toVec())));
-
-            stringVertices[fontDescriptor] =
-              kdl::vec_concat(std::move(stringVertices[fontDescriptor]), vertices);
-          }
-        }
+        stringVertices[fontDescriptor] =
+          kdl::vec_concat(std::move(stringVertices[fontDescriptor]), vertices);
       }
     }
   }
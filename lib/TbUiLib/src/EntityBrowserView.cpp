@@ -46,7 +46,7 @@
 #include "ui/MapDocument.h"
 
 #include "kd/contracts.h"
-#include "kd/string_compare.h"
+#include "kd/ranges/to.h"
 #include "kd/string_utils.h"
 
 #include "vm/mat.h"
@@ -55,7 +55,9 @@
 #include "vm/vec.h"
 
 #include <algorithm>
+#include <ranges>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace tb::ui
@@ -146,6 +148,9 @@ void EntityBrowserView::doReloadLayout(Layout& layout)
   const auto& entityDefinitionManager = m_document.map().entityDefinitionManager();
   const auto font = gl::FontDescriptor{fontPath, static_cast<size_t>(fontSize)};
 
+  updateDefinitionNameIndex();
+  const auto matchingDefinitions = findMatchingDefinitions();
+
   if (m_group)
   {
     for (const auto& group : entityDefinitionManager.groups())
@@ -156,7 +161,7 @@ void EntityBrowserView::doReloadLayout(Layout& layout)
       {
         layout.addGroup(displayName(group), static_cast<float>(fontSize) + 2.0f);
 
-        addEntitiesToLayout(layout, definitions, font);
+        addEntitiesToLayout(layout, definitions, matchingDefinitions, font);
       }
     }
   }
@@ -164,7 +169,7 @@ void EntityBrowserView::doReloadLayout(Layout& layout)
   {
     const auto& definitions =
       entityDefinitionManager.definitions(mdl::EntityDefinitionType::Point, m_sortOrder);
-    addEntitiesToLayout(layout, definitions, font);
+    addEntitiesToLayout(layout, definitions, matchingDefinitions, font);
   }
 }
 
@@ -185,32 +190,51 @@ void EntityBrowserView::resourcesWereProcessed(const std::vector<gl::ResourceId>
   invalidate();
 }
 
+/**
+ * Rebuilds the definition name index if the entity definitions have changed since it was
+ * last built.
+ */
+void EntityBrowserView::updateDefinitionNameIndex()
+{
+  auto definitions = m_document.map().entityDefinitionManager().definitions()
+                     | std::views::transform([](const auto& d) { return &d; })
+                     | kdl::ranges::to<std::vector>();
+
+  if (definitions != m_indexedDefinitions)
+  {
+    m_definitionNameIndex = TrigramIndex{
+      definitions
+      | std::views::transform([](const auto* definition) { return definition->name; })
+      | kdl::ranges::to<std::vector>()};
+    m_indexedDefinitions = std::move(definitions);
+  }
+}
+
+std::unordered_set<const mdl::EntityDefinition*> EntityBrowserView::
+  findMatchingDefinitions() const
+{
+  return m_definitionNameIndex.findAll(kdl::str_split(m_filterText, " "))
+         | std::views::transform([&](const auto i) { return m_indexedDefinitions[i]; })
+         | kdl::ranges::to<std::unordered_set>();
+}
+
 void EntityBrowserView::addEntitiesToLayout(
   Layout& layout,
   const std::vector<const mdl::EntityDefinition*>& definitions,
+  const std::unordered_set<const mdl::EntityDefinition*>& matchingDefinitions,
   const gl::FontDescriptor& font)
 {
   for (const auto* definition : definitions)
   {
-    addEntityToLayout(layout, *definition, font);
+    addEntityToLayout(layout, *definition, matchingDefinitions, font);
   }
 }
 
-namespace
-{
-bool matchesFilterText(
-  const mdl::EntityDefinition& definition, const std::string& filterText)
-{
-  return filterText.empty()
-         || std::ranges::all_of(
-           kdl::str_split(filterText, " "), [&](const auto& pattern) {
-             return kdl::ci::str_contains(definition.name, pattern);
-           });
-}
-} // namespace
-
 void EntityBrowserView::addEntityToLayout(
-  Layout& layout, const mdl::EntityDefinition& definition, const gl::FontDescriptor& font)
+  Layout& layout,
+  const mdl::EntityDefinition& definition,
+  const std::unordered_set<const mdl::EntityDefinition*>& matchingDefinitions,
+  const gl::FontDescriptor& font)
 {
   auto& map = m_document.map();
   const auto name =
@@ -218,7 +242,7 @@ void EntityBrowserView::addEntityToLayout(
 
   if (
     (!m_hideUnused || definition.usageCount() > 0)
-    && matchesFilterText(definition, m_filterText))
+    && matchingDefinitions.contains(&definition))
   {
     contract_assert(definition.pointEntityDefinition != std::nullopt);
     const auto& pointEntityDefinition = *definition.pointEntityDefinition;
@@ -323,31 +347,25 @@ void EntityBrowserView::renderBounds(
   using BoundsVertex = gl::VertexTypes::P3C4::Vertex;
   auto vertices = std::vector<BoundsVertex>{};
 
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& cell : row.cells())
       {
-        if (row.intersectsY(y, height))
+        const auto& definition = cellData(cell).entityDefinition;
+        const auto& pointEntityDefinition = *definition.pointEntityDefinition;
+        auto* modelRenderer = cellData(cell).modelRenderer;
+
+        if (modelRenderer == nullptr)
         {
-          for (const auto& cell : row.cells())
-          {
-            const auto& definition = cellData(cell).entityDefinition;
-            const auto& pointEntityDefinition = *definition.pointEntityDefinition;
-            auto* modelRenderer = cellData(cell).modelRenderer;
-
-            if (modelRenderer == nullptr)
-            {
-              const auto itemTrans = itemTransformation(cell, y, height);
-              const auto& color = definition.color;
-              vm::bbox3f{pointEntityDefinition.bounds}.for_each_edge(
-                [&](const vm::vec3f& v1, const vm::vec3f& v2) {
-                  vertices.emplace_back(itemTrans * v1, color.to<RgbaF>().toVec());
-                  vertices.emplace_back(itemTrans * v2, color.to<RgbaF>().toVec());
-                });
-            }
-          }
+          const auto itemTrans = itemTransformation(cell, y, height);
+          const auto& color = definition.color;
+          vm::bbox3f{pointEntityDefinition.bounds}.for_each_edge(
+            [&](const vm::vec3f& v1, const vm::vec3f& v2) {
+              vertices.emplace_back(itemTrans * v1, color.to<RgbaF>().toVec());
+              vertices.emplace_back(itemTrans * v2, color.to<RgbaF>().toVec());
+            });
         }
       }
     }
@@ -387,32 +405,24 @@ void EntityBrowserView::renderModels(
   shader.set("CameraUp", CameraUp);
   shader.set("ViewMatrix", transformation.viewMatrix());
 
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& cell : row.cells())
       {
-        if (row.intersectsY(y, height))
+        if (auto* modelRenderer = cellData(cell).modelRenderer)
         {
-          for (const auto& cell : row.cells())
-          {
-            if (auto* modelRenderer = cellData(cell).modelRenderer)
-            {
-              shader.set(
-                "Orientation", static_cast<int>(cellData(cell).modelOrientation));
-
-              const auto itemTrans = itemTransformation(cell, y, height);
-              shader.set("ModelMatrix", itemTrans);
-
-              const auto multMatrix =
-                render::MultiplyModelMatrix{transformation, itemTrans};
-
-              auto renderFunc = gl::DefaultMaterialRenderFunc{
-                pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter)};
-              modelRenderer->render(gl, shader.program(), renderFunc);
-            }
-          }
+          shader.set("Orientation", static_cast<int>(cellData(cell).modelOrientation));
+
+          const auto itemTrans = itemTransformation(cell, y, height);
+          shader.set("ModelMatrix", itemTrans);
+
+          const auto multMatrix = render::MultiplyModelMatrix{transformation, itemTrans};
+
+          auto renderFunc = gl::DefaultMaterialRenderFunc{
+            pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter)};
+          modelRenderer->render(gl, shader.program(), renderFunc);
         }
       }
     }
@@ -30,6 +30,7 @@
 #include "mdl/EditorContext.h"
 #include "mdl/EntityDefinitionManager.h"
 #include "mdl/EntityModelManager.h"
+#include "mdl/GameAssetContextManager.h"
 #include "mdl/GameInfo.h"
 #include "mdl/Grid.h"
 #include "mdl/LinkedGroupUtils.h"
@@ -57,6 +58,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -68,9 +70,12 @@ namespace tb::ui
 const vm::bbox3d MapDocument::DefaultWorldBounds(-32768.0, 32768.0);
 
 MapDocument::MapDocument(
-  kdl::task_manager& taskManager, gl::ResourceManager& resourceManager)
+  kdl::task_manager& taskManager,
+  gl::ResourceManager& resourceManager,
+  mdl::GameAssetContextManager& assetContextManager)
   : m_taskManager{&taskManager}
   , m_resourceManager{&resourceManager}
+  , m_assetContextManager{&assetContextManager}
   , m_loggingHub{std::make_unique<LoggingHub>()}
 {
   connectObservers();
@@ -85,9 +90,11 @@ Result<std::unique_ptr<MapDocument>> MapDocument::createDocument(
   mdl::MapFormat mapFormat,
   const vm::bbox3d& worldBounds,
   kdl::task_manager& taskManager,
-  gl::ResourceManager& resourceManager)
+  gl::ResourceManager& resourceManager,
+  mdl::GameAssetContextManager& assetContextManager)
 {
-  auto document = std::make_unique<MapDocument>(taskManager, resourceManager);
+  auto document =
+    std::make_unique<MapDocument>(taskManager, resourceManager, assetContextManager);
   return document->create(environmentConfig, gameInfo, mapFormat, worldBounds)
          | kdl::transform([&]() { return std::move(document); });
 }
@@ -99,9 +106,11 @@ Result<std::unique_ptr<MapDocument>> MapDocument::loadDocument(
   const vm::bbox3d& worldBounds,
   std::filesystem::path path,
   kdl::task_manager& taskManager,
-  gl::ResourceManager& resourceManager)
+  gl::ResourceManager& resourceManager,
+  mdl::GameAssetContextManager& assetContextManager)
 {
-  auto document = std::make_unique<MapDocument>(taskManager, resourceManager);
+  auto document =
+    std::make_unique<MapDocument>(taskManager, resourceManager, assetContextManager);
   return document->load(
            environmentConfig, gameInfo, mapFormat, worldBounds, std::move(path))
          | kdl::transform([&]() { return std::move(document); });
@@ -133,6 +142,7 @@ Result<void> MapDocument::create(
            worldBounds,
            *m_taskManager,
            *m_resourceManager,
+           m_assetContextManager->acquire(gameInfo.gameConfig.name),
            logger())
          | kdl::transform([&](auto map) {
              setMap(std::move(map));
@@ -156,6 +166,7 @@ Result<void> MapDocument::load(
            std::move(path),
            *m_taskManager,
            *m_resourceManager,
+           m_assetContextManager->acquire(gameInfo.gameConfig.name),
            logger())
          | kdl::transform([&](auto map) {
              setMap(std::move(map));
@@ -194,6 +205,11 @@ void MapDocument::updateMapFromPreferences()
   m_map->editorContext().setShowBrushes(pref(Preferences::ShowBrushes));
   m_map->editorContext().setAlignmentLock(pref(Preferences::AlignmentLock));
   m_map->editorContext().setUVLock(pref(Preferences::UVLock));
+
+  const auto undoMemoryLimit = pref(Preferences::UndoMemoryLimit);
+  m_map->setUndoMemoryLimit(
+    undoMemoryLimit > 0 ? std::optional{size_t(undoMemoryLimit) * 1024 * 1024}
+                        : std::nullopt);
 }
 
 mdl::Map& MapDocument::map()
@@ -67,7 +67,8 @@ Result<void> MapWindowManager::createDocument(
              mapFormat,
              worldBounds,
              m_appController.taskManager(),
-             m_appController.glManager().resourceManager())
+             m_appController.glManager().resourceManager(),
+             m_appController.gameAssetContextManager())
            | kdl::transform([&](auto document) { createMapWindow(std::move(document)); });
   }
 
@@ -93,7 +94,8 @@ Result<void> MapWindowManager::loadDocument(
              worldBounds,
              std::move(path),
              m_appController.taskManager(),
-             m_appController.glManager().resourceManager())
+             m_appController.glManager().resourceManager(),
+             m_appController.gameAssetContextManager())
            | kdl::transform([&](auto document) { createMapWindow(std::move(document)); });
   }
 
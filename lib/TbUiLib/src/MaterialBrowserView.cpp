@@ -56,6 +56,7 @@
 
 #include <ranges>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace tb::ui
@@ -167,17 +168,20 @@ void MaterialBrowserView::doReloadLayout(Layout& layout)
 
   const auto font = gl::FontDescriptor{fontPath, size_t(fontSize)};
 
+  updateMaterialNameIndex();
+  const auto matchingMaterials = findMatchingMaterials();
+
   if (m_group)
   {
     for (const auto* collection : getCollections())
     {
       layout.addGroup(collection->path().string(), float(fontSize) + 2.0f);
-      addMaterialsToLayout(layout, getMaterials(*collection), font);
+      addMaterialsToLayout(layout, getMaterials(*collection, matchingMaterials), font);
     }
   }
   else
   {
-    addMaterialsToLayout(layout, getMaterials(), font);
+    addMaterialsToLayout(layout, getMaterials(matchingMaterials), font);
   }
 }
 
@@ -231,28 +235,57 @@ std::vector<const gl::MaterialCollection*> MaterialBrowserView::getCollections()
 }
 
 std::vector<const gl::Material*> MaterialBrowserView::getMaterials(
-  const gl::MaterialCollection& collection) const
+  const gl::MaterialCollection& collection,
+  const std::unordered_set<const gl::Material*>& matchingMaterials) const
 {
   return sortMaterials(filterMaterials(
     collection.materials() | std::views::transform([](const auto& t) { return &t; })
-    | kdl::ranges::to<std::vector>()));
+      | kdl::ranges::to<std::vector>(),
+    matchingMaterials));
+}
+
+std::vector<const gl::Material*> MaterialBrowserView::getMaterials(
+  const std::unordered_set<const gl::Material*>& matchingMaterials) const
+{
+  return sortMaterials(filterMaterials(m_indexedMaterials, matchingMaterials));
 }
 
-std::vector<const gl::Material*> MaterialBrowserView::getMaterials() const
+/**
+ * Rebuilds the material name index if the materials of the enabled collections have
+ * changed since it was last built. Typing into the filter box leaves them unchanged, so
+ * the index is only rebuilt when materials are loaded or collections are toggled.
+ */
+void MaterialBrowserView::updateMaterialNameIndex()
 {
   auto materials = std::vector<const gl::Material*>{};
-  for (const auto& collection : getCollections())
+  for (const auto* collection : getCollections())
   {
     for (const auto& material : collection->materials())
     {
       materials.push_back(&material);
     }
   }
-  return sortMaterials(filterMaterials(materials));
+
+  if (materials != m_indexedMaterials)
+  {
+    m_materialNameIndex = TrigramIndex{
+      materials
+      | std::views::transform([](const auto* material) { return material->name(); })
+      | kdl::ranges::to<std::vector>()};
+    m_indexedMaterials = std::move(materials);
+  }
+}
+
+std::unordered_set<const gl::Material*> MaterialBrowserView::findMatchingMaterials() const
+{
+  return m_materialNameIndex.findAny(kdl::str_split(m_filterText, " "))
+         | std::views::transform([&](const auto i) { return m_indexedMaterials[i]; })
+         | kdl::ranges::to<std::unordered_set>();
 }
 
 std::vector<const gl::Material*> MaterialBrowserView::filterMaterials(
-  std::vector<const gl::Material*> materials) const
+  std::vector<const gl::Material*> materials,
+  const std::unordered_set<const gl::Material*>& matchingMaterials) const
 {
   if (m_hideUnused)
   {
@@ -262,10 +295,7 @@ std::vector<const gl::Material*> MaterialBrowserView::filterMaterials(
   if (!m_filterText.empty())
   {
     std::erase_if(materials, [&](const auto* material) {
-      return std::ranges::none_of(
-        kdl::str_split(m_filterText, " "), [&](const auto& pattern) {
-          return kdl::ci::str_contains(material->name(), pattern);
-        });
+      return !matchingMaterials.contains(material);
     });
   }
   return materials;
@@ -328,33 +358,27 @@ void MaterialBrowserView::renderBounds(
   using BoundsVertex = gl::VertexTypes::P2C4::Vertex;
   auto vertices = std::vector<BoundsVertex>{};
 
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& cell : row.cells())
       {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const auto& bounds = cell.itemBounds();
-            const auto& material = cellData(cell);
-            const auto& color = materialColor(material);
-            vertices.emplace_back(
-              vm::vec2f{bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)},
-              color.to<RgbaF>().toVec());
-            vertices.emplace_back(
-              vm::vec2f{bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)},
-              color.to<RgbaF>().toVec());
-            vertices.emplace_back(
-              vm::vec2f{bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)},
-              color.to<RgbaF>().toVec());
-            vertices.emplace_back(
-              vm::vec2f{bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)},
-              color.to<RgbaF>().toVec());
-          }
-        }
+        const auto& bounds = cell.itemBounds();
+        const auto& material = cellData(cell);
+        const auto& color = materialColor(material);
+        vertices.emplace_back(
+          vm::vec2f{bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)},
+          color.to<RgbaF>().toVec());
+        vertices.emplace_back(
+          vm::vec2f{bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)},
+          color.to<RgbaF>().toVec());
+        vertices.emplace_back(
+          vm::vec2f{bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)},
+          color.to<RgbaF>().toVec());
+        vertices.emplace_back(
+          vm::vec2f{bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)},
+          color.to<RgbaF>().toVec());
       }
     }
   }
@@ -395,42 +419,34 @@ void MaterialBrowserView::renderMaterials(
   shader.set("Material", 0);
   shader.set("Brightness", pref(Preferences::Brightness));
 
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& cell : row.cells())
       {
-        if (row.intersectsY(y, height))
+        const auto& bounds = cell.itemBounds();
+        const auto& material = cellData(cell);
+
+        auto vertexArray = gl::VertexArray::move(std::vector<Vertex>{
+          Vertex{{bounds.left(), height - (bounds.top() - y)}, {0, 0}},
+          Vertex{{bounds.left(), height - (bounds.bottom() - y)}, {0, 1}},
+          Vertex{{bounds.right(), height - (bounds.bottom() - y)}, {1, 1}},
+          Vertex{{bounds.right(), height - (bounds.top() - y)}, {1, 0}},
+        });
+
+        material.activate(
+          gl, pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
+
+        vertexArray.prepare(gl, vboManager());
+
+        if (vertexArray.setup(gl, shader.program()))
         {
-          for (const auto& cell : row.cells())
-          {
-            const auto& bounds = cell.itemBounds();
-            const auto& material = cellData(cell);
-
-            auto vertexArray = gl::VertexArray::move(std::vector<Vertex>{
-              Vertex{{bounds.left(), height - (bounds.top() - y)}, {0, 0}},
-              Vertex{{bounds.left(), height - (bounds.bottom() - y)}, {0, 1}},
-              Vertex{{bounds.right(), height - (bounds.bottom() - y)}, {1, 1}},
-              Vertex{{bounds.right(), height - (bounds.top() - y)}, {1, 0}},
-            });
-
-            material.activate(
-              gl,
-              pref(Preferences::TextureMinFilter),
-              pref(Preferences::TextureMagFilter));
-
-            vertexArray.prepare(gl, vboManager());
-
-            if (vertexArray.setup(gl, shader.program()))
-            {
-              vertexArray.render(gl, gl::PrimType::Quads);
-              vertexArray.cleanup(gl, shader.program());
-            }
-
-            material.deactivate(gl);
-          }
+          vertexArray.render(gl, gl::PrimType::Quads);
+          vertexArray.cleanup(gl, shader.program());
         }
+
+        material.deactivate(gl);
       }
     }
   }
@@ -30,11 +30,10 @@
 #include "mdl/Map.h"
 #include "mdl/Map_Brushes.h"
 #include "mdl/Map_Selection.h"
-#include "mdl/NodeQueries.h"
+#include "mdl/MaterialIndex.h"
 #include "mdl/PushSelection.h"
 #include "mdl/Transaction.h"
 #include "mdl/UpdateBrushFaceAttributes.h" // IWYU pragma: keep
-#include "mdl/WorldNode.h"                 // IWYU pragma: keep
 #include "ui/BorderLine.h"
 #include "ui/DialogButtonLayout.h"
 #include "ui/MapDocument.h"
@@ -120,7 +119,7 @@ std::vector<mdl::BrushFaceHandle> ReplaceMaterialDialog::getApplicableFaces() co
   auto faces = map.selection().allBrushFaces();
   if (faces.empty())
   {
-    faces = mdl::collectBrushFaces({&map.worldNode()});
+    faces = map.materialIndex().findBrushFaces(subject->name());
   }
 
   return faces | std::views::filter([&](const auto& handle) {
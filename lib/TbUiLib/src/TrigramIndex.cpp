@@ -0,0 +1,144 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ui/TrigramIndex.h"
+
+#include "kd/string_format.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+namespace tb::ui
+{
+namespace
+{
+
+uint32_t trigramAt(const std::string_view str, const size_t i)
+{
+  return uint32_t(uint8_t(str[i])) << 16 | uint32_t(uint8_t(str[i + 1])) << 8
+         | uint32_t(uint8_t(str[i + 2]));
+}
+
+std::vector<size_t> allPositions(const size_t count)
+{
+  auto result = std::vector<size_t>(count);
+  std::iota(result.begin(), result.end(), size_t(0));
+  return result;
+}
+
+} // namespace
+
+TrigramIndex::TrigramIndex() = default;
+
+TrigramIndex::TrigramIndex(const std::vector<std::string>& keys)
+{
+  m_keys.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i)
+  {
+    const auto& key = m_keys.emplace_back(kdl::str_to_lower(keys[i]));
+    for (size_t j = 0; j + 2 < key.size(); ++j)
+    {
+      auto& positions = m_positions[trigramAt(key, j)];
+      if (positions.empty() || positions.back() != i)
+      {
+        positions.push_back(i);
+      }
+    }
+  }
+}
+
+size_t TrigramIndex::size() const
+{
+  return m_keys.size();
+}
+
+std::vector<size_t> TrigramIndex::find(const std::string_view pattern) const
+{
+  const auto lowerPattern = kdl::str_to_lower(pattern);
+
+  auto result = std::vector<size_t>{};
+  if (lowerPattern.size() < 3)
+  {
+    result = allPositions(m_keys.size());
+  }
+  else
+  {
+    auto positionLists = std::vector<const std::vector<size_t>*>{};
+    for (size_t j = 0; j + 2 < lowerPattern.size(); ++j)
+    {
+      const auto it = m_positions.find(trigramAt(lowerPattern, j));
+      if (it == m_positions.end())
+      {
+        return {};
+      }
+      positionLists.push_back(&it->second);
+    }
+
+    std::ranges::sort(positionLists, [](const auto* lhs, const auto* rhs) {
+      return lhs->size() < rhs->size();
+    });
+
+    result = *positionLists.front();
+    for (size_t j = 1; j < positionLists.size() && !result.empty(); ++j)
+    {
+      auto intersection = std::vector<size_t>{};
+      std::ranges::set_intersection(
+        result, *positionLists[j], std::back_inserter(intersection));
+      result = std::move(intersection);
+    }
+  }
+
+  // the trigrams of a key may occur in a different order than in the pattern
+  std::erase_if(result, [&](const auto i) {
+    return m_keys[i].find(lowerPattern) == std::string::npos;
+  });
+  return result;
+}
+
+std::vector<size_t> TrigramIndex::findAny(const std::vector<std::string>& patterns) const
+{
+  auto result = std::vector<size_t>{};
+  for (const auto& pattern : patterns)
+  {
+    auto matches = std::vector<size_t>{};
+    std::ranges::set_union(result, find(pattern), std::back_inserter(matches));
+    result = std::move(matches);
+  }
+  return result;
+}
+
+std::vector<size_t> TrigramIndex::findAll(const std::vector<std::string>& patterns) const
+{
+  auto result = allPositions(m_keys.size());
+  for (const auto& pattern : patterns)
+  {
+    if (result.empty())
+    {
+      break;
+    }
+
+    auto matches = std::vector<size_t>{};
+    std::ranges::set_intersection(result, find(pattern), std::back_inserter(matches));
+    result = std::move(matches);
+  }
+  return result;
+}
+
+} // namespace tb::ui
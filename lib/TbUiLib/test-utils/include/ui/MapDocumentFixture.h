@@ -40,6 +40,11 @@ namespace gl
 class ResourceManager;
 }
 
+namespace mdl
+{
+class GameAssetContextManager;
+}
+
 namespace ui
 {
 class MapDocument;
@@ -47,19 +52,22 @@ class MapDocument;
 Result<std::unique_ptr<MapDocument>> createFixtureDocument(
   mdl::MapFixtureConfig& config,
   kdl::task_manager& taskManager,
-  gl::ResourceManager& resourceManager);
+  gl::ResourceManager& resourceManager,
+  mdl::GameAssetContextManager& assetContextManager);
 
 Result<std::unique_ptr<MapDocument>> loadFixtureDocument(
   const std::filesystem::path& path,
   mdl::MapFixtureConfig& config,
   kdl::task_manager& taskManager,
-  gl::ResourceManager& resourceManager);
+  gl::ResourceManager& resourceManager,
+  mdl::GameAssetContextManager& assetContextManager);
 
 class MapDocumentFixture
 {
 private:
   std::unique_ptr<kdl::task_manager> m_taskManager;
   std::unique_ptr<gl::ResourceManager> m_resourceManager;
+  std::unique_ptr<mdl::GameAssetContextManager> m_assetContextManager;
   std::unique_ptr<MapDocument> m_document;
 
   std::optional<mdl::MapFixtureConfig> m_config;
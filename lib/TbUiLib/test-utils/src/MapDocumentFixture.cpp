@@ -23,6 +23,7 @@
 #include "gl/ResourceManager.h"
 #include "gl/TestGl.h"
 #include "gl/TestUtils.h"
+#include "mdl/GameAssetContextManager.h"
 #include "mdl/Map.h"
 #include "mdl/TestUtils.h"
 #include "ui/MapDocument.h"
@@ -35,7 +36,8 @@ namespace tb::ui
 Result<std::unique_ptr<MapDocument>> createFixtureDocument(
   mdl::MapFixtureConfig& config,
   kdl::task_manager& taskManager,
-  gl::ResourceManager& resourceManager)
+  gl::ResourceManager& resourceManager,
+  mdl::GameAssetContextManager& assetContextManager)
 {
   const auto mapFormat = config.mapFormat.value_or(mdl::MapFormat::Standard);
 
@@ -45,7 +47,8 @@ Result<std::unique_ptr<MapDocument>> createFixtureDocument(
            mapFormat,
            vm::bbox3d{8192.0},
            taskManager,
-           resourceManager)
+           resourceManager,
+           assetContextManager)
          | kdl::transform([&](auto document) {
              document->map().setIsCommandCollationEnabled(false);
              return document;
@@ -56,7 +59,8 @@ Result<std::unique_ptr<MapDocument>> loadFixtureDocument(
   const std::filesystem::path& path,
   mdl::MapFixtureConfig& config,
   kdl::task_manager& taskManager,
-  gl::ResourceManager& resourceManager)
+  gl::ResourceManager& resourceManager,
+  mdl::GameAssetContextManager& assetContextManager)
 {
   const auto mapFormat = config.mapFormat.value_or(mdl::MapFormat::Standard);
 
@@ -67,7 +71,8 @@ Result<std::unique_ptr<MapDocument>> loadFixtureDocument(
            vm::bbox3d{8192.0},
            path,
            taskManager,
-           resourceManager)
+           resourceManager,
+           assetContextManager)
          | kdl::transform([&](auto document) {
              document->map().setIsCommandCollationEnabled(false);
 
@@ -82,6 +87,7 @@ Result<std::unique_ptr<MapDocument>> loadFixtureDocument(
 MapDocumentFixture::MapDocumentFixture()
   : m_taskManager{createTestTaskManager()}
   , m_resourceManager{std::make_unique<gl::ResourceManager>()}
+  , m_assetContextManager{std::make_unique<mdl::GameAssetContextManager>()}
 {
 }
 
@@ -92,7 +98,8 @@ MapDocument& MapDocumentFixture::create(mdl::MapFixtureConfig config)
   m_config = std::move(config);
 
   contract_assert(
-    createFixtureDocument(*m_config, *m_taskManager, *m_resourceManager)
+    createFixtureDocument(
+      *m_config, *m_taskManager, *m_resourceManager, *m_assetContextManager)
     | kdl::transform([&](auto document) { m_document = std::move(document); })
     | kdl::is_success());
 
@@ -107,7 +114,8 @@ MapDocument& MapDocumentFixture::load(
   const auto absPath = path.is_absolute() ? path : std::filesystem::current_path() / path;
 
   contract_assert(
-    loadFixtureDocument(absPath, *m_config, *m_taskManager, *m_resourceManager)
+    loadFixtureDocument(
+      absPath, *m_config, *m_taskManager, *m_resourceManager, *m_assetContextManager)
     | kdl::transform([&](auto document) { m_document = std::move(document); })
     | kdl::is_success());
 
@@ -0,0 +1,148 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ui/CatchConfig.h"
+#include "ui/CellLayout.h"
+
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::ui
+{
+
+TEST_CASE("CellLayout")
+{
+  // every row holds two 32x32 cells, and the rows are separated by a 10 unit margin
+  auto layout = CellLayout{};
+  layout.setWidth(100.0f);
+  layout.setRowMargin(10.0f);
+  layout.setGroupMargin(20.0f);
+  layout.setCellMargin(4.0f);
+  layout.setCellWidth(32.0f, 32.0f);
+  layout.setCellHeight(32.0f, 32.0f);
+
+  for (size_t g = 0; g < 3; ++g)
+  {
+    layout.addGroup("group" + std::to_string(g), 12.0f);
+    for (size_t i = 0; i < 10; ++i)
+    {
+      layout.addItem(g * 10 + i, std::to_string(i), 32.0f, 32.0f, 32.0f, 0.0f);
+    }
+  }
+
+  const auto& groups = layout.groups();
+  REQUIRE(groups.size() == 3);
+  REQUIRE(groups[0].rows().size() == 5);
+
+  SECTION("groupsIntersectingY")
+  {
+    const auto& group1Bounds = groups[1].bounds();
+
+    CHECK(layout.groupsIntersectingY(-100.0f, 50.0f).empty());
+    CHECK(layout.groupsIntersectingY(0.0f, 10.0f).size() == 1);
+    CHECK(layout.groupsIntersectingY(0.0f, layout.height()).size() == 3);
+
+    const auto groupsInGroup1 =
+      layout.groupsIntersectingY(group1Bounds.top() + 1.0f, group1Bounds.height - 2.0f);
+    REQUIRE(groupsInGroup1.size() == 1);
+    CHECK(&groupsInGroup1.front() == &groups[1]);
+
+    const auto groupsAtGroup1Bottom =
+      layout.groupsIntersectingY(group1Bounds.bottom() - 1.0f, 100.0f);
+    REQUIRE(groupsAtGroup1Bottom.size() == 2);
+    CHECK(&groupsAtGroup1Bottom.front() == &groups[1]);
+  }
+
+  SECTION("rowsIntersectingY")
+  {
+    const auto& group = groups[1];
+    const auto& rows = group.rows();
+
+    const auto& row2Bounds = rows[2].bounds();
+    const auto visibleRows = group.rowsIntersectingY(row2Bounds.top(), 5.0f);
+    REQUIRE(visibleRows.size() == 1);
+    CHECK(&visibleRows.front() == &rows[2]);
+
+    // a range that falls into the margin between two rows
+    CHECK(group.rowsIntersectingY(row2Bounds.bottom() + 1.0f, 5.0f).empty());
+
+    const auto twoRows = group.rowsIntersectingY(row2Bounds.bottom() - 1.0f, 12.0f);
+    REQUIRE(twoRows.size() == 2);
+    CHECK(&twoRows.front() == &rows[2]);
+
+    for (const auto& row : rows)
+    {
+      const auto& bounds = row.bounds();
+      for (const auto& candidate : group.rowsIntersectingY(bounds.top(), bounds.height))
+      {
+        CHECK(candidate.intersectsY(bounds.top(), bounds.height));
+      }
+    }
+  }
+
+  SECTION("cellAt")
+  {
+    for (const auto& group : groups)
+    {
+      for (const auto& row : group.rows())
+      {
+        for (const auto& cell : row.cells())
+        {
+          const auto& bounds = cell.cellBounds();
+          const auto x = bounds.left() + bounds.width / 2.0f;
+          const auto y = bounds.top() + bounds.height / 2.0f;
+          CHECK(layout.cellAt(x, y) == &cell);
+        }
+      }
+    }
+
+    const auto& row = groups[2].rows()[1];
+    const auto& firstCell = row.cells()[0];
+    const auto& secondCell = row.cells()[1];
+
+    // between the cells of a row and right of the last cell
+    CHECK(
+      layout.cellAt(firstCell.cellBounds().right() + 1.0f, firstCell.cellBounds().top())
+      == nullptr);
+    CHECK(
+      layout.cellAt(secondCell.cellBounds().right() + 1.0f, secondCell.cellBounds().top())
+      == nullptr);
+
+    // between two rows
+    CHECK(
+      layout.cellAt(firstCell.cellBounds().left(), row.bounds().bottom() + 1.0f)
+      == nullptr);
+
+    // below the last group
+    CHECK(layout.cellAt(10.0f, layout.height() + 10.0f) == nullptr);
+  }
+
+  SECTION("rowPosition")
+  {
+    const auto& rows = groups[0].rows();
+    CHECK(layout.rowPosition(rows[1].bounds().top(), 1) == rows[2].bounds().top());
+    CHECK(layout.rowPosition(rows[1].bounds().top(), -1) == rows[0].bounds().top());
+    CHECK(
+      layout.rowPosition(rows[4].bounds().top(), 1)
+      == groups[1].rows()[0].bounds().top());
+  }
+}
+
+} // namespace tb::ui
@@ -22,6 +22,7 @@
 #include "gl/ResourceManager.h"
 #include "mdl/EntityNode.h"
 #include "mdl/EnvironmentConfig.h"
+#include "mdl/GameAssetContextManager.h"
 #include "mdl/GameConfigFixture.h"
 #include "mdl/LayerNode.h"
 #include "mdl/Map.h"
@@ -43,6 +44,7 @@ TEST_CASE("MapDocument")
   const auto environmentConfig = mdl::EnvironmentConfig{};
   auto taskManager = createTestTaskManager();
   auto resourceManager = gl::ResourceManager{};
+  auto assetContextManager = mdl::GameAssetContextManager{};
 
   SECTION("createDocument")
   {
@@ -52,7 +54,8 @@ TEST_CASE("MapDocument")
       mdl::MapFormat::Valve,
       vm::bbox3d{8192.0},
       *taskManager,
-      resourceManager)
+      resourceManager,
+      assetContextManager)
       | kdl::transform([&](auto document) {
           SECTION("creates a new map with the given game")
           {
@@ -70,7 +73,8 @@ TEST_CASE("MapDocument")
                       mdl::MapFormat::Valve,
                       vm::bbox3d{8192.0},
                       *taskManager,
-                      resourceManager)
+                      resourceManager,
+                      assetContextManager)
                     | kdl::value();
 
     auto documentWasLoaded = Observer<>{document->documentWasLoadedNotifier};
@@ -110,7 +114,8 @@ TEST_CASE("MapDocument")
       vm::bbox3d{8192.0},
       path,
       *taskManager,
-      resourceManager)
+      resourceManager,
+      assetContextManager)
       | kdl::transform([&](auto document) {
           SECTION("loads map at given path")
           {
@@ -129,7 +134,8 @@ TEST_CASE("MapDocument")
                       mdl::MapFormat::Valve,
                       vm::bbox3d{8192.0},
                       *taskManager,
-                      resourceManager)
+                      resourceManager,
+                      assetContextManager)
                     | kdl::value();
 
     auto documentWasLoaded = Observer<>{document->documentWasLoadedNotifier};
@@ -169,7 +175,8 @@ TEST_CASE("MapDocument")
                       mdl::MapFormat::Valve,
                       vm::bbox3d{8192.0},
                       *taskManager,
-                      resourceManager)
+                      resourceManager,
+                      assetContextManager)
                     | kdl::value();
 
     const auto path =
@@ -59,7 +59,8 @@ TEST_CASE("MapWindow")
                     mdl::MapFormat::Valve,
                     vm::bbox3d{8192.0},
                     appController.taskManager(),
-                    appController.glManager().resourceManager())
+                    appController.glManager().resourceManager(),
+                    appController.gameAssetContextManager())
                   | kdl::value();
 
   auto window = MapWindow{appController, std::move(document)};
@@ -0,0 +1,105 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ui/CatchConfig.h"
+#include "ui/TrigramIndex.h"
+
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace tb::ui
+{
+
+TEST_CASE("TrigramIndex")
+{
+  const auto index = TrigramIndex{std::vector<std::string>{
+    "base_wall1",
+    "base_floor",
+    "Metal/WALL_Trim",
+    "sky",
+    "trim_wallwall",
+  }};
+
+  REQUIRE(index.size() == 5);
+
+  SECTION("find")
+  {
+    using T = std::tuple<std::string, std::vector<size_t>>;
+
+    // clang-format off
+    const auto
+    [pattern,    expectedPositions] = GENERATE(values<T>({
+    {"",         {0, 1, 2, 3, 4}},
+    {"a",        {0, 1, 2, 4}},
+    {"sk",       {3}},
+    {"wall",     {0, 2, 4}},
+    {"WALL",     {0, 2, 4}},
+    {"_wall",    {0, 4}},
+    {"wallwall", {4}},
+    {"llwa",     {4}},
+    {"trim",     {2, 4}},
+    {"base_f",   {1}},
+    {"floors",   {}},
+    {"xyz",      {}},
+    }));
+    // clang-format on
+
+    CAPTURE(pattern);
+
+    CHECK(index.find(pattern) == expectedPositions);
+  }
+
+  SECTION("find does not match trigrams in a different order")
+  {
+    // "all_wa" contains the trigrams "all", "ll_", "l_w", and "_wa"; "base_wall1"
+    // contains "all" and "_wa", but not "ll_" or "l_w"
+    CHECK(index.find("all_wa").empty());
+    CHECK(index.find("wallbase").empty());
+  }
+
+  SECTION("findAny")
+  {
+    CHECK(index.findAny({}).empty());
+    CHECK(index.findAny({"sky", "floor"}) == std::vector<size_t>{1, 3});
+    CHECK(index.findAny({"trim", "wall"}) == std::vector<size_t>{0, 2, 4});
+    CHECK(index.findAny({"xyz"}).empty());
+  }
+
+  SECTION("findAll")
+  {
+    CHECK(index.findAll({}) == std::vector<size_t>{0, 1, 2, 3, 4});
+    CHECK(index.findAll({"trim", "wall"}) == std::vector<size_t>{2, 4});
+    CHECK(index.findAll({"base", "wall"}) == std::vector<size_t>{0});
+    CHECK(index.findAll({"sky", "floor"}).empty());
+  }
+
+  SECTION("empty index")
+  {
+    const auto emptyIndex = TrigramIndex{};
+    CHECK(emptyIndex.size() == 0);
+    CHECK(emptyIndex.find("").empty());
+    CHECK(emptyIndex.find("wall").empty());
+    CHECK(emptyIndex.findAll({}).empty());
+  }
+}
+
+} // namespace tb::ui
@@ -0,0 +1,297 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "vm/bbox.h"
+#include "vm/mat.h"
+#include "vm/plane.h"
+#include "vm/scalar.h"
+#include "vm/vec.h"
+
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Operations on contiguous ranges of vectors. Each function performs the same computation
+ * as the corresponding single vector operation, but the loop invariant parts such as the
+ * matrix columns are loaded once, and the loop bodies are free of branches so that the
+ * compiler can vectorize them.
+ *
+ * The span parameters are excluded from template argument deduction so that vectors and
+ * arrays can be passed directly.
+ */
+
+namespace vm
+{
+namespace detail
+{
+/**
+ * Checks whether the last row of the given matrix is (0, ..., 0, 1). Multiplying a point
+ * with such a matrix yields a homogeneous coordinate of 1.
+ */
+template <typename T, std::size_t R>
+constexpr bool is_affine(const mat<T, R, R>& transform)
+{
+  for (std::size_t c = 0; c < R - 1; ++c)
+  {
+    if (transform[c][R - 1] != T(0))
+    {
+      return false;
+    }
+  }
+  return transform[R - 1][R - 1] == T(1);
+}
+} // namespace detail
+
+/**
+ * Multiplies each of the given points with the given matrix and stores the products in
+ * the given result span. The result is the same as computing transform * point for each
+ * point. The given spans may be identical, but must not overlap otherwise.
+ *
+ * @tparam T the component type
+ * @tparam R the number of rows and columns of the matrix
+ * @param transform the matrix
+ * @param points the points to transform
+ * @param result the span to store the transformed points in, must be as large as points
+ */
+template <typename T, std::size_t R>
+constexpr void transform_points(
+  const mat<T, R, R>& transform,
+  const std::type_identity_t<std::span<const vec<T, R - 1>>> points,
+  const std::type_identity_t<std::span<vec<T, R - 1>>> result)
+{
+  constexpr auto S = R - 1;
+  assert(result.size() == points.size());
+
+  // the transformed point is the sum of the columns weighted by its components
+  vec<T, R> columns[R];
+  for (std::size_t c = 0; c < R; ++c)
+  {
+    columns[c] = transform[c];
+  }
+
+  if (detail::is_affine(transform))
+  {
+    vec<T, S> affineColumns[R];
+    for (std::size_t c = 0; c < R; ++c)
+    {
+      affineColumns[c] = slice<S>(columns[c], 0);
+    }
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      const auto& p = points[i];
+      auto t = affineColumns[0] * p[0];
+      for (std::size_t c = 1; c < S; ++c)
+      {
+        t = t + affineColumns[c] * p[c];
+      }
+      result[i] = t + affineColumns[S];
+    }
+  }
+  else
+  {
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      const auto& p = points[i];
+      auto t = columns[0] * p[0];
+      for (std::size_t c = 1; c < S; ++c)
+      {
+        t = t + columns[c] * p[c];
+      }
+      result[i] = to_cartesian_coords(t + columns[S]);
+    }
+  }
+}
+
+/**
+ * Multiplies each of the given points with the given matrix in place.
+ *
+ * @tparam T the component type
+ * @tparam R the number of rows and columns of the matrix
+ * @param transform the matrix
+ * @param points the points to transform
+ */
+template <typename T, std::size_t R>
+constexpr void transform_points(
+  const mat<T, R, R>& transform,
+  const std::type_identity_t<std::span<vec<T, R - 1>>> points)
+{
+  transform_points(transform, std::span<const vec<T, R - 1>>{points}, points);
+}
+
+/**
+ * Multiplies each of the given directions with the upper left (R-1)x(R-1) submatrix of
+ * the given matrix, i.e., the translation and projection parts of the matrix are
+ * ignored. The directions are not normalized. The given spans may be identical, but must
+ * not overlap otherwise.
+ *
+ * @tparam T the component type
+ * @tparam R the number of rows and columns of the matrix
+ * @param transform the matrix
+ * @param directions the directions to transform
+ * @param result the span to store the transformed directions in, must be as large as
+ * directions
+ */
+template <typename T, std::size_t R>
+constexpr void transform_directions(
+  const mat<T, R, R>& transform,
+  const std::type_identity_t<std::span<const vec<T, R - 1>>> directions,
+  const std::type_identity_t<std::span<vec<T, R - 1>>> result)
+{
+  constexpr auto S = R - 1;
+  assert(result.size() == directions.size());
+
+  vec<T, S> columns[S];
+  for (std::size_t c = 0; c < S; ++c)
+  {
+    columns[c] = slice<S>(transform[c], 0);
+  }
+
+  for (std::size_t i = 0; i < directions.size(); ++i)
+  {
+    const auto& d = directions[i];
+    auto t = columns[0] * d[0];
+    for (std::size_t c = 1; c < S; ++c)
+    {
+      t = t + columns[c] * d[c];
+    }
+    result[i] = t;
+  }
+}
+
+/**
+ * Multiplies each of the given directions with the upper left (R-1)x(R-1) submatrix of
+ * the given matrix in place.
+ *
+ * @tparam T the component type
+ * @tparam R the number of rows and columns of the matrix
+ * @param transform the matrix
+ * @param directions the directions to transform
+ */
+template <typename T, std::size_t R>
+constexpr void transform_directions(
+  const mat<T, R, R>& transform,
+  const std::type_identity_t<std::span<vec<T, R - 1>>> directions)
+{
+  transform_directions(
+    transform, std::span<const vec<T, R - 1>>{directions}, directions);
+}
+
+/**
+ * Computes the signed distances of the given point to each of the given planes. The
+ * result is the same as computing plane.point_distance(point) for each plane.
+ *
+ * @tparam T the component type
+ * @tparam S the number of components
+ * @param planes the planes
+ * @param point the point
+ * @param result the span to store the distances in, must be as large as planes
+ */
+template <typename T, std::size_t S>
+constexpr void point_distances(
+  const std::type_identity_t<std::span<const plane<T, S>>> planes,
+  const vec<T, S>& point,
+  const std::type_identity_t<std::span<T>> result)
+{
+  assert(result.size() == planes.size());
+
+  const auto p = point;
+  for (std::size_t i = 0; i < planes.size(); ++i)
+  {
+    const auto& plane = planes[i];
+    auto d = T(0);
+    for (std::size_t c = 0; c < S; ++c)
+    {
+      d += p[c] * plane.normal[c];
+    }
+    result[i] = d - plane.distance;
+  }
+}
+
+/**
+ * Computes the signed distances of the given point to each of the given planes.
+ *
+ * @tparam T the component type
+ * @tparam S the number of components
+ * @param planes the planes
+ * @param point the point
+ * @return the distances, in the order of the given planes
+ */
+template <typename T, std::size_t S>
+std::vector<T> point_distances(
+  const std::type_identity_t<std::span<const plane<T, S>>> planes, const vec<T, S>& point)
+{
+  auto result = std::vector<T>(planes.size());
+  point_distances<T, S>(planes, point, result);
+  return result;
+}
+
+/**
+ * Returns the smallest bounding box that contains all of the given points. The result is
+ * the same as calling bbox<T, S>::merge_all for the given points. The given span must
+ * not be empty.
+ *
+ * @tparam T the component type
+ * @tparam S the number of components
+ * @param points the points
+ * @return the bounding box
+ */
+template <typename T, std::size_t S>
+constexpr bbox<T, S> bounds(const std::span<const vec<T, S>> points)
+{
+  assert(!points.empty());
+
+  auto result = bbox<T, S>{points.front(), points.front()};
+  for (std::size_t c = 0; c < S; ++c)
+  {
+    auto lo = result.min[c];
+    auto hi = result.max[c];
+    for (std::size_t i = 1; i < points.size(); ++i)
+    {
+      lo = min(lo, points[i][c]);
+      hi = max(hi, points[i][c]);
+    }
+    result.min[c] = lo;
+    result.max[c] = hi;
+  }
+  return result;
+}
+
+/**
+ * Returns the smallest bounding box that contains all of the given points. The given
+ * vector must not be empty.
+ *
+ * @tparam T the component type
+ * @tparam S the number of components
+ * @param points the points
+ * @return the bounding box
+ */
+template <typename T, std::size_t S>
+constexpr bbox<T, S> bounds(const std::vector<vec<T, S>>& points)
+{
+  return bounds(std::span<const vec<T, S>>{points});
+}
+
+} // namespace vm
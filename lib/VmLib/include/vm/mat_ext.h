@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include "vm/batch.h"
 #include "vm/bbox.h"
 #include "vm/mat.h"
 #include "vm/quat.h"
@@ -93,13 +94,22 @@ template <typename T, std::size_t R, std::size_t C>
 std::vector<vec<T, C - 1>> operator*(
   const mat<T, R, C>& lhs, const std::vector<vec<T, C - 1>>& rhs)
 {
-  std::vector<vec<T, C - 1>> result;
-  result.reserve(rhs.size());
-  for (const auto& v : rhs)
+  if constexpr (R == C)
   {
-    result.push_back(lhs * v);
+    auto result = std::vector<vec<T, C - 1>>(rhs.size());
+    transform_points(lhs, rhs, result);
+    return result;
+  }
+  else
+  {
+    std::vector<vec<T, C - 1>> result;
+    result.reserve(rhs.size());
+    for (const auto& v : rhs)
+    {
+      result.push_back(lhs * v);
+    }
+    return result;
   }
-  return result;
 }
 
 /**
@@ -0,0 +1,132 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "test_utils.h"
+
+#include "vm/approx.h"
+#include "vm/batch.h"
+#include "vm/bbox.h"
+#include "vm/bbox_io.h" // IWYU pragma: keep
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
+#include "vm/plane.h"
+#include "vm/vec.h"
+#include "vm/vec_io.h" // IWYU pragma: keep
+
+#include <array>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace vm
+{
+
+TEST_CASE("batch")
+{
+  const auto points = std::vector<vec3d>{
+    vec3d{1, 2, 3},
+    vec3d{-4, 5, -6},
+    vec3d{0.5, -0.25, 8},
+    vec3d{-7, -3, 1},
+    vec3d{2, 9, -1},
+  };
+
+  SECTION("transform_points")
+  {
+    const auto affine = translation_matrix(vec3d{1, -2, 3})
+                        * rotation_matrix(vec3d{0, 0, 1}, to_radians(30.0))
+                        * scaling_matrix(vec3d{2, 3, 4});
+    const auto projective =
+      mat4x4d{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 1, 2, 3, 100};
+
+    for (const auto& transform : {affine, projective})
+    {
+      auto result = std::vector<vec3d>(points.size());
+      transform_points(transform, points, result);
+
+      for (size_t i = 0; i < points.size(); ++i)
+      {
+        CHECK(result[i] == approx(transform * points[i]));
+      }
+
+      auto inPlace = points;
+      transform_points(transform, inPlace);
+      CHECK(inPlace == result);
+    }
+
+    constexpr auto transformed = []() {
+      auto result = std::array<vec2f, 2>{vec2f{1, 2}, vec2f{3, 4}};
+      transform_points(mat3x3f{1, 0, 5, 0, 2, 6, 0, 0, 1}, result);
+      return result;
+    }();
+    CER_CHECK(transformed == std::array<vec2f, 2>{vec2f{6, 10}, vec2f{8, 14}});
+  }
+
+  SECTION("transform_directions")
+  {
+    const auto transform = translation_matrix(vec3d{1, -2, 3})
+                           * rotation_matrix(vec3d{0, 0, 1}, to_radians(30.0));
+
+    auto result = std::vector<vec3d>(points.size());
+    transform_directions(transform, points, result);
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      CHECK(result[i] == approx(strip_translation(transform) * points[i]));
+      CHECK(length(result[i]) == approx(length(points[i])));
+    }
+
+    auto inPlace = points;
+    transform_directions(transform, inPlace);
+    CHECK(inPlace == result);
+  }
+
+  SECTION("point_distances")
+  {
+    const auto planes = std::vector<plane3d>{
+      plane3d{1, vec3d{1, 0, 0}},
+      plane3d{-2, vec3d{0, 1, 0}},
+      plane3d{3, normalize(vec3d{1, 1, 1})},
+    };
+
+    for (const auto& point : points)
+    {
+      const auto distances = point_distances(planes, point);
+      REQUIRE(distances.size() == planes.size());
+      for (size_t i = 0; i < planes.size(); ++i)
+      {
+        CHECK(distances[i] == approx(planes[i].point_distance(point)));
+      }
+    }
+
+    CHECK(point_distances(std::vector<plane3d>{}, points.front()).empty());
+  }
+
+  SECTION("bounds")
+  {
+    CHECK(bounds(points) == bbox3d::merge_all(points.begin(), points.end()));
+    CHECK(bounds(std::vector<vec3d>{vec3d{1, 2, 3}}) == bbox3d{{1, 2, 3}, {1, 2, 3}});
+
+    constexpr auto array = std::array<vec2f, 3>{vec2f{1, 2}, vec2f{-3, 4}, vec2f{0, -5}};
+    CER_CHECK(bounds(std::span<const vec2f>{array}) == bbox2f{{-3, -5}, {1, 4}});
+  }
+}
+
+} // namespace vm